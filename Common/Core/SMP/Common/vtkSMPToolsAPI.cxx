@@ -6,6 +6,8 @@
 #include "vtkSetGet.h" // For vtkWarningMacro
 
 #include <algorithm> // For std::toupper
+#include <atomic>    // For std::atomic
+#include <chrono>    // For std::chrono
 #include <cstdlib>   // For std::getenv
 #include <iostream>  // For std::cerr
 #include <string>    // For std::string
@@ -235,6 +237,33 @@ bool vtkSMPToolsAPI::GetSingleThread()
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+std::atomic<SMPTaskObserverType> SMPTaskObserver(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void SetSMPTaskObserver(SMPTaskObserverType observer)
+{
+  SMPTaskObserver = observer;
+}
+
+//------------------------------------------------------------------------------
+SMPTaskObserverType GetSMPTaskObserver()
+{
+  return SMPTaskObserver.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+double GetSMPTaskTime()
+{
+  using Seconds = std::chrono::duration<double>;
+  return std::chrono::duration_cast<Seconds>(
+    std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
@@ -117,6 +117,32 @@ private:
 
 using ExecuteFunctorPtrType = void (*)(void*, vtkIdType, vtkIdType, vtkIdType);
 
+/**
+ * Observer of the tasks executed by the threads of the STDThread, TBB and
+ * OpenMP backends, called with the range of the task and its start and end
+ * times in seconds, as returned by GetSMPTaskTime(). It is set by profiling
+ * tools such as vtkPipelineProfiler and is null by default.
+ */
+using SMPTaskObserverType = void (*)(vtkIdType first, vtkIdType last, double start, double end);
+void VTKCOMMONCORE_EXPORT SetSMPTaskObserver(SMPTaskObserverType observer);
+SMPTaskObserverType VTKCOMMONCORE_EXPORT GetSMPTaskObserver();
+double VTKCOMMONCORE_EXPORT GetSMPTaskTime();
+
+//--------------------------------------------------------------------------------
+template <typename FunctorInternal>
+void ExecuteSMPTask(FunctorInternal& fi, vtkIdType first, vtkIdType last)
+{
+  SMPTaskObserverType observer = GetSMPTaskObserver();
+  if (!observer)
+  {
+    fi.Execute(first, last);
+    return;
+  }
+  const double start = GetSMPTaskTime();
+  fi.Execute(first, last);
+  observer(first, last, start, GetSMPTaskTime());
+}
+
 VTK_ABI_NAMESPACE_END
 } // namespace smp
 } // namespace detail
@@ -30,7 +30,7 @@ void ExecuteFunctorOpenMP(void* functor, vtkIdType from, vtkIdType grain, vtkIdT
   const vtkIdType to = std::min(from + grain, last);
 
   FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
-  fi.Execute(from, to);
+  ExecuteSMPTask(fi, from, to);
 }
 
 //--------------------------------------------------------------------------------
@@ -53,7 +53,7 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
     for (vtkIdType from = first; from < last; from += grain)
     {
       const auto to = (std::min)(from + grain, last);
-      proxy.DoJob([&fi, from, to] { fi.Execute(from, to); });
+      proxy.DoJob([&fi, from, to] { ExecuteSMPTask(fi, from, to); });
     }
 
     proxy.Join();
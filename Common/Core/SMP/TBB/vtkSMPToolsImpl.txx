@@ -41,7 +41,10 @@ class FuncCall
   void operator=(const FuncCall&) = delete;
 
 public:
-  void operator()(const tbb::blocked_range<vtkIdType>& r) const { o.Execute(r.begin(), r.end()); }
+  void operator()(const tbb::blocked_range<vtkIdType>& r) const
+  {
+    ExecuteSMPTask(o, r.begin(), r.end());
+  }
 
   FuncCall(T& _o)
     : o(_o)
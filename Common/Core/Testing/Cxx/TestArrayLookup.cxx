@@ -761,6 +761,83 @@ int TestMultiComponent()
   return errors;
 }
 
+int TestAppendAndBatchLookup()
+{
+  int errors = 0;
+  vtkNew<vtkIdTypeArray> ids;
+  for (vtkIdType i = 0; i < 10000; ++i)
+  {
+    ids->InsertNextValue((i * 7919) % 5000);
+  }
+  if (ids->LookupValue(4999) != 2321 || ids->LookupValue(5000) != -1)
+  {
+    cerr << "TestAppendAndBatchLookup: unexpected lookup before appending" << endl;
+    ++errors;
+  }
+
+  // Appended values are merged in the lookup without calling DataChanged()
+  ids->InsertNextValue(5000);
+  ids->InsertNextValue(4999);
+  vtkNew<vtkIdList> list;
+  ids->LookupValue(4999, list);
+  if (ids->LookupValue(5000) != 10000 || list->GetNumberOfIds() != 3 || list->GetId(0) != 2321 ||
+    list->GetId(1) != 7321 || list->GetId(2) != 10001)
+  {
+    cerr << "TestAppendAndBatchLookup: appended values are not found" << endl;
+    ++errors;
+  }
+
+  // Batch lookups, with the same value type and through variants
+  vtkNew<vtkIdTypeArray> values;
+  vtkNew<vtkFloatArray> floatValues;
+  for (vtkIdType value = -1; value <= 5001; ++value)
+  {
+    values->InsertNextValue(value);
+    floatValues->InsertNextValue(static_cast<float>(value));
+  }
+  vtkNew<vtkIdList> found;
+  vtkNew<vtkIdList> floatFound;
+  ids->LookupValues(values, found);
+  ids->LookupValues(floatValues, floatFound);
+  if (found->GetNumberOfIds() != values->GetNumberOfValues() ||
+    floatFound->GetNumberOfIds() != values->GetNumberOfValues())
+  {
+    cerr << "TestAppendAndBatchLookup: wrong number of batch results" << endl;
+    return errors + 1;
+  }
+  for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+  {
+    const vtkIdType expected = ids->LookupValue(values->GetValue(i));
+    if (found->GetId(i) != expected || floatFound->GetId(i) != expected)
+    {
+      cerr << "TestAppendAndBatchLookup: batch lookup of " << values->GetValue(i) << " returned "
+           << found->GetId(i) << " and " << floatFound->GetId(i) << " instead of " << expected
+           << endl;
+      ++errors;
+    }
+  }
+
+  // NaN values appended to a float array
+  vtkNew<vtkFloatArray> floats;
+  floats->InsertNextValue(1.0f);
+  floats->LookupValue(1.0);
+  floats->InsertNextValue(std::numeric_limits<float>::quiet_NaN());
+  floats->InsertNextValue(1.0f);
+  floats->LookupValue(std::numeric_limits<float>::quiet_NaN(), list);
+  if (list->GetNumberOfIds() != 1 || list->GetId(0) != 1)
+  {
+    cerr << "TestAppendAndBatchLookup: appended NaN is not found" << endl;
+    ++errors;
+  }
+  floats->LookupValue(1.0, list);
+  if (list->GetNumberOfIds() != 2 || list->GetId(0) != 0 || list->GetId(1) != 2)
+  {
+    cerr << "TestAppendAndBatchLookup: lookup of 1 after appending NaN" << endl;
+    ++errors;
+  }
+  return errors;
+}
+
 int TestArrayLookup(int argc, char* argv[])
 {
   vtkIdType min = 100;
@@ -835,5 +912,6 @@ int TestArrayLookup(int argc, char* argv[])
     cerr << endl;
   }
   errors += TestMultiComponent();
+  errors += TestAppendAndBatchLookup();
   return errors;
 }
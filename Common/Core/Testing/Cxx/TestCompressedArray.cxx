@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompressedArray.h"
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkVTK_DISPATCH_IMPLICIT_ARRAYS.h"
+
+#ifdef VTK_DISPATCH_COMPRESSED_ARRAYS
+#include "vtkArrayDispatch.h"
+#endif // VTK_DISPATCH_COMPRESSED_ARRAYS
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+#ifdef VTK_DISPATCH_COMPRESSED_ARRAYS
+struct SumWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, double& sum)
+  {
+    for (auto value : vtk::DataArrayValueRange(array))
+    {
+      sum += value;
+    }
+  }
+};
+#endif // VTK_DISPATCH_COMPRESSED_ARRAYS
+
+template <typename ValueType>
+bool CheckRoundTrip(vtkDataArray* base, vtkIdType chunkSize, int cacheSize, const char* name)
+{
+  vtkNew<vtkCompressedArray<ValueType>> compressed;
+  compressed->ConstructBackend(base, chunkSize, cacheSize);
+  compressed->SetNumberOfComponents(base->GetNumberOfComponents());
+  compressed->SetNumberOfTuples(base->GetNumberOfTuples());
+
+  const auto baseRange = vtk::DataArrayValueRange(base);
+  vtkIdType idx = 0;
+  for (const ValueType value : vtk::DataArrayValueRange(compressed))
+  {
+    const ValueType expected = static_cast<ValueType>(baseRange[idx]);
+    if (std::memcmp(&value, &expected, sizeof(ValueType)) != 0)
+    {
+      std::cout << name << ": value " << idx << " differs after compression" << std::endl;
+      return false;
+    }
+    ++idx;
+  }
+
+  // Random access, with tuples spanning chunks
+  const int numComps = base->GetNumberOfComponents();
+  std::vector<ValueType> tuple(numComps);
+  for (vtkIdType tupleIdx = base->GetNumberOfTuples() - 1; tupleIdx >= 0; tupleIdx -= 7)
+  {
+    compressed->GetTypedTuple(tupleIdx, tuple.data());
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      if (tuple[comp] != static_cast<ValueType>(base->GetComponent(tupleIdx, comp)))
+      {
+        std::cout << name << ": tuple " << tupleIdx << " differs after compression" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // Concurrent reads use one chunk cache per thread
+  std::atomic<vtkIdType> mismatches(0);
+  vtkSMPTools::For(0, base->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (compressed->GetValue(i) != static_cast<ValueType>(baseRange[i]))
+      {
+        ++mismatches;
+      }
+    }
+  });
+  if (mismatches != 0)
+  {
+    std::cout << name << ": concurrent reads differ after compression" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCompressedArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  vtkNew<vtkDoubleArray> smooth;
+  smooth->SetNumberOfComponents(3);
+  smooth->SetNumberOfTuples(100000);
+  for (vtkIdType i = 0; i < smooth->GetNumberOfTuples(); ++i)
+  {
+    smooth->SetTuple3(i, std::floor(i / 1000.0), std::sin(i * 1.0e-3), 1.5);
+  }
+  if (!::CheckRoundTrip<double>(smooth, 0, 4, "smooth doubles") ||
+    !::CheckRoundTrip<float>(smooth, 1000, 1, "smooth doubles to floats"))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkCompressedArray<double>> compressed;
+  compressed->ConstructBackend(smooth);
+  compressed->SetNumberOfComponents(3);
+  compressed->SetNumberOfTuples(smooth->GetNumberOfTuples());
+  auto backend = compressed->GetBackend();
+  if (backend->GetChunkSize() != 16386 || backend->GetNumberOfChunks() != 19 ||
+    backend->GetCompressionRatio() < 2.0 ||
+    compressed->GetActualMemorySize() >= smooth->GetActualMemorySize())
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Unexpected compression of smooth doubles: ratio "
+              << backend->GetCompressionRatio() << ", " << compressed->GetActualMemorySize()
+              << " KiB for " << smooth->GetActualMemorySize() << " KiB" << std::endl;
+  }
+
+  vtkNew<vtkMinimalStandardRandomSequence> sequence;
+  sequence->SetSeed(42);
+  vtkNew<vtkDoubleArray> noise;
+  noise->SetNumberOfValues(10000);
+  vtkNew<vtkIntArray> labels;
+  labels->SetNumberOfValues(10000);
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetNumberOfValues(10000);
+  for (vtkIdType i = 0; i < 10000; ++i)
+  {
+    noise->SetValue(i, sequence->GetNextRangeValue(-1.0e10, 1.0e10));
+    labels->SetValue(i, i / 500 - 10);
+    bytes->SetValue(i, static_cast<unsigned char>(sequence->GetNextRangeValue(0, 255)));
+  }
+  if (!::CheckRoundTrip<double>(noise, 100, 2, "noise") ||
+    !::CheckRoundTrip<int>(labels, 0, 4, "labels") ||
+    !::CheckRoundTrip<unsigned char>(bytes, 333, 4, "bytes"))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  vtkNew<vtkCompressedArray<int>> compressedLabels;
+  compressedLabels->ConstructBackend(labels);
+  compressedLabels->SetNumberOfTuples(labels->GetNumberOfTuples());
+  if (compressedLabels->GetBackend()->GetCompressionRatio() < 20.0)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Unexpected compression of labels: ratio "
+              << compressedLabels->GetBackend()->GetCompressionRatio() << std::endl;
+  }
+
+  vtkNew<vtkDoubleArray> empty;
+  vtkNew<vtkCompressedArray<double>> compressedEmpty;
+  compressedEmpty->ConstructBackend(empty);
+  if (compressedEmpty->GetBackend()->GetNumberOfChunks() != 0 ||
+    compressedEmpty->GetNumberOfValues() != 0)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Unexpected compression of an empty array" << std::endl;
+  }
+
+#ifdef VTK_DISPATCH_COMPRESSED_ARRAYS
+  std::cout << "vtkCompressedArray: performing dispatch tests" << std::endl;
+  double sum = 0.0;
+  ::SumWorker worker;
+  using Dispatcher = vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::ReadOnlyArrays>;
+  if (!Dispatcher::Execute(compressedLabels, worker, sum))
+  {
+    res = EXIT_FAILURE;
+    std::cout << "vtkArrayDispatch failed with vtkCompressedArray" << std::endl;
+  }
+  else if (sum != -5000.0)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "dispatch computed the wrong sum " << sum << std::endl;
+  }
+#endif // VTK_DISPATCH_COMPRESSED_ARRAYS
+  return res;
+};
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLazyArray.h"
+
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+vtkSmartPointer<vtkFloatArray> CreateVectors(vtkIdType numberOfTuples)
+{
+  auto vectors = vtkSmartPointer<vtkFloatArray>::New();
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numberOfTuples);
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    vectors->SetTuple3(i, i, 2.0 * i, -1.0);
+  }
+  return vectors;
+}
+}
+
+int TestLazyArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+  constexpr vtkIdType numberOfTuples = 100000;
+
+  // Nothing is loaded until the values are accessed
+  std::atomic<int> numberOfLoads(0);
+  vtkNew<vtkLazyArray<float>> lazy;
+  lazy->ConstructBackend(
+    [&numberOfLoads]() -> vtkSmartPointer<vtkDataArray> {
+      ++numberOfLoads;
+      return ::CreateVectors(numberOfTuples);
+    },
+    numberOfTuples, 3);
+  lazy->SetName("vectors");
+  lazy->SetNumberOfComponents(3);
+  lazy->SetNumberOfTuples(numberOfTuples);
+  if (numberOfLoads != 0 || lazy->GetBackend()->IsLoaded() || lazy->GetActualMemorySize() != 0 ||
+    lazy->GetNumberOfValues() != 3 * numberOfTuples)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Values loaded before being accessed" << std::endl;
+  }
+
+  // Concurrent first accesses load the values once
+  std::atomic<vtkIdType> mismatches(0);
+  vtkSMPTools::For(0, numberOfTuples, [&](vtkIdType begin, vtkIdType end) {
+    float tuple[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      lazy->GetTypedTuple(i, tuple);
+      if (tuple[0] != i || tuple[1] != 2.0f * i || tuple[2] != -1.0f ||
+        lazy->GetValue(3 * i + 1) != 2.0f * i)
+      {
+        ++mismatches;
+      }
+    }
+  });
+  if (numberOfLoads != 1 || mismatches != 0 || !lazy->GetBackend()->IsLoaded())
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Wrong concurrent load: " << numberOfLoads << " loads, " << mismatches
+              << " mismatches" << std::endl;
+  }
+  if (lazy->GetActualMemorySize() < 3 * numberOfTuples * sizeof(float) / 1024)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Memory of the loaded values not reported" << std::endl;
+  }
+
+  // Raw pointers give the loaded values without another copy
+  if (lazy->GetVoidPointer(0) != lazy->GetBackend()->getArray()->GetPointer(0) ||
+    static_cast<float*>(lazy->GetVoidPointer(3))[1] != 2.0f)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "GetVoidPointer does not share the loaded values" << std::endl;
+  }
+
+  // Values are converted to the type of the lazy array, and what the loader
+  // captured is released once loaded
+  vtkNew<vtkIntArray> labels;
+  labels->SetNumberOfValues(1000);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    labels->SetValue(i, static_cast<int>(i % 17) - 8);
+  }
+  vtkSmartPointer<vtkIntArray> captured = labels.Get();
+  vtkNew<vtkLazyArray<double>> converted;
+  converted->ConstructBackend(
+    [captured]() -> vtkSmartPointer<vtkDataArray> { return captured; }, 1000, 1);
+  converted->SetNumberOfTuples(1000);
+  captured = nullptr;
+  converted->GetBackend()->Load();
+  if (labels->GetReferenceCount() != 1)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Loader not released after loading" << std::endl;
+  }
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    if (converted->GetValue(i) != static_cast<double>(labels->GetValue(i)))
+    {
+      res = EXIT_FAILURE;
+      std::cout << "Wrong converted value " << converted->GetValue(i) << " at " << i << std::endl;
+      break;
+    }
+  }
+
+  // Failed loads give zeros
+  vtkObject::GlobalWarningDisplayOff();
+  vtkNew<vtkLazyArray<int>> failed;
+  failed->ConstructBackend([]() { return vtkSmartPointer<vtkDataArray>(); }, 10, 2);
+  failed->SetNumberOfComponents(2);
+  failed->SetNumberOfTuples(10);
+  if (failed->GetValue(19) != 0 || !failed->GetBackend()->IsLoaded())
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Wrong values after a failed load" << std::endl;
+  }
+  vtkNew<vtkLazyArray<float>> wrongSize;
+  wrongSize->ConstructBackend([]() { return ::CreateVectors(5); }, 10, 3);
+  wrongSize->SetNumberOfComponents(3);
+  wrongSize->SetNumberOfTuples(10);
+  if (wrongSize->GetValue(29) != 0.0f)
+  {
+    res = EXIT_FAILURE;
+    std::cout << "Wrong values after loading an array of the wrong size" << std::endl;
+  }
+  vtkObject::GlobalWarningDisplayOn();
+  return res;
+}
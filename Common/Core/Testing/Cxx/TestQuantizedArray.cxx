@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks the accuracy of vtkQuantizedArray, the memory it uses and its use as
+// point coordinates, and reports the memory used and the throughput of the
+// decoding compared to a float array.
+#include "vtkQuantizedArray.h"
+
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkTimerLog.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+template <typename ArrayT>
+double SumCoordinates(ArrayT* array)
+{
+  double sum = 0.0;
+  for (const auto tuple : vtk::DataArrayTupleRange<3>(array))
+  {
+    sum += tuple[0] + tuple[1] + tuple[2];
+  }
+  return sum;
+}
+
+bool CheckAccuracy(vtkDataArray* original, vtkQuantizedArray<float>* quantized)
+{
+  auto backend = quantized->GetBackend();
+  const auto originalRange = vtk::DataArrayTupleRange<3>(original);
+  const auto quantizedRange = vtk::DataArrayTupleRange<3>(quantized);
+  for (vtkIdType tupleIdx = 0; tupleIdx < original->GetNumberOfTuples(); ++tupleIdx)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      const double error = std::abs(
+        static_cast<double>(quantizedRange[tupleIdx][comp]) - originalRange[tupleIdx][comp]);
+      // Half a step, plus the rounding of the decoded float
+      const double tolerance = 0.5 * backend->GetScale(comp) +
+        std::abs(originalRange[tupleIdx][comp]) * std::numeric_limits<float>::epsilon();
+      if (error > tolerance)
+      {
+        std::cout << "Value " << tupleIdx << ", " << comp << " decoded with an error of " << error
+                  << " above " << tolerance << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestQuantizedArray(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  int res = EXIT_SUCCESS;
+
+  // A scan-like point cloud, spread on x and y and thin on z
+  const vtkIdType numPoints = 1000000;
+  vtkNew<vtkMinimalStandardRandomSequence> sequence;
+  sequence->SetSeed(7);
+  vtkNew<vtkFloatArray> coordinates;
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    const double x = sequence->GetNextRangeValue(-250.0, 750.0);
+    const double y = sequence->GetNextRangeValue(1000.0, 1400.0);
+    const double z = 12.0 + 0.01 * std::sin(x) + sequence->GetNextRangeValue(0.0, 0.5);
+    coordinates->SetTuple3(i, x, y, z);
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkNew<vtkQuantizedArray<float>> quantized;
+  quantized->ConstructBackend(coordinates);
+  quantized->SetNumberOfComponents(3);
+  quantized->SetNumberOfTuples(numPoints);
+  timer->StopTimer();
+  std::cout << "Quantization of " << numPoints << " points: " << timer->GetElapsedTime() << " s"
+            << std::endl;
+
+  if (!::CheckAccuracy(coordinates, quantized))
+  {
+    res = EXIT_FAILURE;
+  }
+
+  const unsigned long originalSize = coordinates->GetActualMemorySize();
+  const unsigned long quantizedSize = quantized->GetActualMemorySize();
+  std::cout << "Memory: " << originalSize << " KiB as floats, " << quantizedSize
+            << " KiB quantized" << std::endl;
+  if (2 * quantizedSize > originalSize + 1)
+  {
+    std::cout << "Quantized coordinates use " << quantizedSize << " KiB instead of half of "
+              << originalSize << " KiB" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // Bounds are computed from the quantization parameters
+  vtkNew<vtkPoints> points;
+  points->SetData(quantized);
+  double bounds[6];
+  timer->StartTimer();
+  points->GetBounds(bounds);
+  timer->StopTimer();
+  std::cout << "Bounds of the quantized points: " << timer->GetElapsedTime() << " s" << std::endl;
+  double expectedBounds[6];
+  quantized->GetRange(expectedBounds, 0);
+  quantized->GetRange(expectedBounds + 2, 1);
+  quantized->GetRange(expectedBounds + 4, 2);
+  const double* originalBounds = coordinates->GetRange(0);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (bounds[i] != expectedBounds[i])
+    {
+      std::cout << "Bound " << i << " is " << bounds[i] << " instead of " << expectedBounds[i]
+                << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+  if (std::abs(bounds[0] - originalBounds[0]) > 1.0e-4 ||
+    std::abs(bounds[1] - originalBounds[1]) > 1.0e-4)
+  {
+    std::cout << "The quantized bounds do not match the original ones" << std::endl;
+    res = EXIT_FAILURE;
+  }
+  double point[3];
+  points->GetPoint(4242, point);
+  float expectedPoint[3];
+  quantized->GetTypedTuple(4242, expectedPoint);
+  if (point[0] != expectedPoint[0] || point[1] != expectedPoint[1] || point[2] != expectedPoint[2])
+  {
+    std::cout << "vtkPoints::GetPoint does not return the decoded point" << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // Throughput of a traversal of the coordinates through the tuple range
+  timer->StartTimer();
+  const double originalSum = ::SumCoordinates(coordinates.Get());
+  timer->StopTimer();
+  const double originalTime = timer->GetElapsedTime();
+  timer->StartTimer();
+  const double quantizedSum = ::SumCoordinates(quantized.Get());
+  timer->StopTimer();
+  const double quantizedTime = timer->GetElapsedTime();
+  std::cout << "Traversal: " << numPoints / originalTime * 1.0e-6 << " Mpoints/s as floats, "
+            << numPoints / quantizedTime * 1.0e-6 << " Mpoints/s quantized" << std::endl;
+  if (std::abs(originalSum - quantizedSum) > 1.0e-3 * std::abs(originalSum))
+  {
+    std::cout << "Traversals differ: " << originalSum << " != " << quantizedSum << std::endl;
+    res = EXIT_FAILURE;
+  }
+
+  // Constant, infinite and NaN values
+  vtkNew<vtkDoubleArray> special;
+  special->InsertNextValue(2.0);
+  special->InsertNextValue(std::numeric_limits<double>::infinity());
+  special->InsertNextValue(std::numeric_limits<double>::quiet_NaN());
+  special->InsertNextValue(2.0);
+  vtkNew<vtkQuantizedArray<double>> quantizedSpecial;
+  quantizedSpecial->ConstructBackend(special);
+  quantizedSpecial->SetNumberOfTuples(4);
+  for (vtkIdType i = 0; i < 4; ++i)
+  {
+    if (quantizedSpecial->GetValue(i) != 2.0)
+    {
+      std::cout << "Special value " << i << " decoded as " << quantizedSpecial->GetValue(i)
+                << std::endl;
+      res = EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkFloatArray> empty;
+  empty->SetNumberOfComponents(3);
+  vtkNew<vtkQuantizedArray<float>> quantizedEmpty;
+  quantizedEmpty->ConstructBackend(empty);
+  quantizedEmpty->SetNumberOfComponents(3);
+  points->SetData(quantizedEmpty);
+  points->GetBounds(bounds);
+  if (points->GetNumberOfPoints() != 0 || quantizedEmpty->GetActualMemorySize() != 1)
+  {
+    std::cout << "Unexpected quantization of an empty array" << std::endl;
+    res = EXIT_FAILURE;
+  }
+  return res;
+}
@@ -242,6 +242,7 @@ public:
   int GetArrayType() const override { return vtkAbstractArray::AoSDataArrayTemplate; }
   VTK_NEWINSTANCE vtkArrayIterator* NewIterator() override;
   bool HasStandardMemoryLayout() const override { return true; }
+  bool IsMemoryExclusivelyOwned() const override { return this->Buffer->IsExclusivelyOwned(); }
   void ShallowCopy(vtkDataArray* other) override;
 
   // Reimplemented for efficiency:
@@ -266,6 +266,12 @@ bool vtkAbstractArray::HasStandardMemoryLayout() const
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkAbstractArray::IsMemoryExclusivelyOwned() const
+{
+  return false;
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractArray::DeepCopy(vtkAbstractArray* da)
 {
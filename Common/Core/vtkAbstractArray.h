@@ -244,6 +244,15 @@ public:
    */
   virtual bool HasStandardMemoryLayout() const;
 
+  /**
+   * Returns true if this array is the only owner of its memory: the memory
+   * is neither shared with another array (e.g. by ShallowCopy()) nor
+   * provided by the caller with SetVoidArray() or a custom free function.
+   * Writing to such an array cannot modify any other data. The default
+   * implementation returns false.
+   */
+  virtual bool IsMemoryExclusivelyOwned() const;
+
   /**
    * Return a void pointer. For image pipeline interface and other
    * special pointer manipulation.
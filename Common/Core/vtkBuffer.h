@@ -76,6 +76,13 @@ public:
    */
   bool Reallocate(vtkIdType newsize);
 
+  /**
+   * Return true if this buffer is referenced once and frees its memory with
+   * the default free function, i.e. its memory was not handed over with
+   * SetBuffer() by a caller that keeps it or frees it with its own function.
+   */
+  bool IsExclusivelyOwned() const;
+
 protected:
   vtkBuffer()
     : Pointer(nullptr)
@@ -153,6 +160,15 @@ void vtkBuffer<ScalarT>::SetFreeFunction(bool noFreeFunction, vtkFreeingFunction
   }
 }
 
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+bool vtkBuffer<ScalarT>::IsExclusivelyOwned() const
+{
+  return this->ReferenceCount == 1 && this->DeleteFunction &&
+    (this->DeleteFunction == free ||
+      this->DeleteFunction == vtkObjectBase::GetCurrentFreeFunction());
+}
+
 //------------------------------------------------------------------------------
 template <typename ScalarT>
 bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
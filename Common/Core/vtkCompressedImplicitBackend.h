@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkCompressedImplicitBackend_h
+#define vtkCompressedImplicitBackend_h
+
+/**
+ * \class vtkCompressedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework keeping the values of an existing data array
+ * compressed in memory. It is meant for attribute arrays that are kept around but rarely accessed,
+ * for instance the arrays of many time steps held for interactive analysis.
+ *
+ * At construction, the values of the array are split in chunks of a fixed number of values that
+ * are compressed independently with a lossless codec: the bit pattern of each value is XOR-ed with
+ * the one of the same component in the previous tuple, the bytes of the results are regrouped by
+ * significance and component, and the resulting byte planes are run length encoded. Smooth or
+ * constant data, as well as integer arrays with a small range, compress well, while noisy floating
+ * point data only shrinks by the bytes holding the sign and exponent.
+ *
+ * Values are decompressed on access, one chunk at a time, into a small cache of recently used
+ * chunks. Each thread has its own cache, so that the array can be read concurrently, e.g. from
+ * vtkSMPTools functors. Sequential access patterns decompress every chunk once per thread.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkFloatArray> baseArray;
+ * ...
+ * vtkNew<vtkCompressedArray<float>> compressed; // vtkImplicitArray<vtkCompressedImplicitBackend>
+ * compressed->ConstructBackend(baseArray);
+ * compressed->SetNumberOfComponents(baseArray->GetNumberOfComponents());
+ * compressed->SetNumberOfTuples(baseArray->GetNumberOfTuples());
+ * CHECK(compressed->GetValue(42) == baseArray->GetValue(42));
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkCompressedArray
+ */
+
+#include "vtkCommonCoreModule.h"
+#include "vtkType.h"
+
+#include <cstddef>
+#include <memory>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend final
+{
+public:
+  /**
+   * Constructor compressing all the values of the given array.
+   * @param array the array to compress, it is not referenced afterwards
+   * @param chunkSize number of values compressed together, rounded up to a whole number of tuples;
+   * 0 selects the default of 16384 values
+   * @param cacheSize number of decompressed chunks kept by each thread
+   */
+  vtkCompressedImplicitBackend(vtkDataArray* array, vtkIdType chunkSize = 0, int cacheSize = 4);
+  ~vtkCompressedImplicitBackend();
+
+  /**
+   * Indexing operation for the compressed array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType map(vtkIdType idx) const;
+
+  /**
+   * Copy the tuple at @a tupleIdx in @a tuple.
+   */
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+
+  /**
+   * Return the memory held by the compressed chunks, in kibibytes.
+   */
+  unsigned long getMemorySize() const;
+
+  ///@{
+  /**
+   * Get the parameters and the result of the compression.
+   */
+  vtkIdType GetChunkSize() const;
+  vtkIdType GetNumberOfChunks() const;
+  std::size_t GetCompressedSize() const;
+  double GetCompressionRatio() const;
+  ///@}
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkCompressedImplicitBackend_h
+
+#ifdef VTK_COMPRESSED_BACKEND_INSTANTIATING
+#define VTK_INSTANTIATE_COMPRESSED_BACKEND(ValueType)                                              \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkCompressedImplicitBackend<ValueType>;                     \
+  VTK_ABI_NAMESPACE_END
+#endif
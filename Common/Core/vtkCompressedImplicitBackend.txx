@@ -0,0 +1,374 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCompressedImplicitBackend.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace vtkCompressedImplicitBackendDetail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+// Unsigned integer type holding the bit pattern of a value
+template <std::size_t Size>
+struct BitsType;
+template <>
+struct BitsType<1>
+{
+  using type = vtkTypeUInt8;
+};
+template <>
+struct BitsType<2>
+{
+  using type = vtkTypeUInt16;
+};
+template <>
+struct BitsType<4>
+{
+  using type = vtkTypeUInt32;
+};
+template <>
+struct BitsType<8>
+{
+  using type = vtkTypeUInt64;
+};
+
+//-----------------------------------------------------------------------
+// A control byte below 0x80 announces (byte + 1) literal bytes, a control byte c above announces
+// a run of (c - 0x80 + MinRun) copies of the following byte.
+constexpr vtkIdType MinRun = 3;
+constexpr vtkIdType MaxRun = 0x7f + MinRun;
+constexpr vtkIdType MaxLiterals = 0x80;
+
+inline void FlushLiterals(
+  const unsigned char* bytes, vtkIdType begin, vtkIdType end, std::vector<unsigned char>& out)
+{
+  while (begin < end)
+  {
+    const vtkIdType length = std::min(MaxLiterals, end - begin);
+    out.push_back(static_cast<unsigned char>(length - 1));
+    out.insert(out.end(), bytes + begin, bytes + begin + length);
+    begin += length;
+  }
+}
+
+inline void EncodeRuns(const unsigned char* bytes, vtkIdType size, std::vector<unsigned char>& out)
+{
+  vtkIdType literalStart = 0;
+  vtkIdType i = 0;
+  while (i < size)
+  {
+    vtkIdType run = 1;
+    while (i + run < size && run < MaxRun && bytes[i + run] == bytes[i])
+    {
+      ++run;
+    }
+    if (run >= MinRun)
+    {
+      FlushLiterals(bytes, literalStart, i, out);
+      out.push_back(static_cast<unsigned char>(0x80 + run - MinRun));
+      out.push_back(bytes[i]);
+      literalStart = i + run;
+    }
+    i += run;
+  }
+  FlushLiterals(bytes, literalStart, size, out);
+}
+
+inline const unsigned char* DecodeRuns(
+  const unsigned char* in, unsigned char* bytes, vtkIdType size)
+{
+  vtkIdType i = 0;
+  while (i < size)
+  {
+    const unsigned char control = *in++;
+    if (control & 0x80)
+    {
+      const vtkIdType run = control - 0x80 + MinRun;
+      std::fill(bytes + i, bytes + i + run, *in++);
+      i += run;
+    }
+    else
+    {
+      const vtkIdType length = control + 1;
+      std::copy(in, in + length, bytes + i);
+      in += length;
+      i += length;
+    }
+  }
+  return in;
+}
+
+//-----------------------------------------------------------------------
+// Values are XOR-ed with the same component of the previous tuple and the byte planes list the
+// values component by component, so that constant components produce long runs. Chunks hold a
+// whole number of tuples of stride components.
+template <typename ValueType>
+void EncodeChunk(
+  const ValueType* values, vtkIdType size, int stride, std::vector<unsigned char>& out)
+{
+  using UIntT = typename BitsType<sizeof(ValueType)>::type;
+  std::vector<UIntT> bits(size);
+  std::memcpy(bits.data(), values, size * sizeof(ValueType));
+  std::vector<UIntT> residuals(bits);
+  for (vtkIdType i = stride; i < size; ++i)
+  {
+    residuals[i] ^= bits[i - stride];
+  }
+  std::vector<unsigned char> plane(size);
+  for (std::size_t b = 0; b < sizeof(ValueType); ++b)
+  {
+    vtkIdType p = 0;
+    for (int comp = 0; comp < stride; ++comp)
+    {
+      for (vtkIdType i = comp; i < size; i += stride)
+      {
+        plane[p++] = static_cast<unsigned char>(residuals[i] >> (8 * b));
+      }
+    }
+    EncodeRuns(plane.data(), size, out);
+  }
+}
+
+template <typename ValueType>
+void DecodeChunk(const unsigned char* in, vtkIdType size, int stride, ValueType* values)
+{
+  using UIntT = typename BitsType<sizeof(ValueType)>::type;
+  std::vector<UIntT> residuals(size, 0);
+  std::vector<unsigned char> plane(size);
+  for (std::size_t b = 0; b < sizeof(ValueType); ++b)
+  {
+    in = DecodeRuns(in, plane.data(), size);
+    vtkIdType p = 0;
+    for (int comp = 0; comp < stride; ++comp)
+    {
+      for (vtkIdType i = comp; i < size; i += stride)
+      {
+        residuals[i] |= static_cast<UIntT>(static_cast<UIntT>(plane[p++]) << (8 * b));
+      }
+    }
+  }
+  for (vtkIdType i = stride; i < size; ++i)
+  {
+    residuals[i] ^= residuals[i - stride];
+  }
+  std::memcpy(values, residuals.data(), size * sizeof(ValueType));
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct CompressWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, vtkIdType chunkSize, std::vector<std::vector<unsigned char>>& out)
+  {
+    const int stride = array->GetNumberOfComponents();
+    const auto range = vtk::DataArrayValueRange(array);
+    const vtkIdType numValues = range.size();
+    vtkSMPTools::For(0, static_cast<vtkIdType>(out.size()), [&](vtkIdType begin, vtkIdType end) {
+      std::vector<ValueType> values;
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const vtkIdType first = chunk * chunkSize;
+        const vtkIdType last = std::min(first + chunkSize, numValues);
+        values.resize(last - first);
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          values[i - first] = static_cast<ValueType>(range[i]);
+        }
+        EncodeChunk(values.data(), last - first, stride, out[chunk]);
+      }
+    });
+  }
+};
+
+//-----------------------------------------------------------------------
+// Decompressed chunks of one thread, the least recently used one is replaced on a miss
+template <typename ValueType>
+struct ChunkCache
+{
+  struct Entry
+  {
+    vtkIdType Chunk = -1;
+    unsigned long long LastUse = 0;
+    std::vector<ValueType> Values;
+  };
+  std::vector<Entry> Entries;
+  std::size_t MostRecent = 0;
+  unsigned long long Clock = 0;
+};
+VTK_ABI_NAMESPACE_END
+} // namespace vtkCompressedImplicitBackendDetail
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkCompressedImplicitBackend<ValueType>::Internals
+{
+  Internals(vtkDataArray* array, vtkIdType chunkSize, int cacheSize)
+    : ChunkSize(chunkSize > 0 ? chunkSize : 16384)
+    , CacheSize(std::max(cacheSize, 1))
+  {
+    if (!array)
+    {
+      vtkErrorWithObjectMacro(nullptr, "Cannot compress a nullptr array");
+      return;
+    }
+    this->NumberOfComponents = array->GetNumberOfComponents();
+    this->ChunkSize += (this->NumberOfComponents - this->ChunkSize % this->NumberOfComponents) %
+      this->NumberOfComponents;
+    this->NumberOfValues = array->GetNumberOfValues();
+    const vtkIdType numChunks = (this->NumberOfValues + this->ChunkSize - 1) / this->ChunkSize;
+
+    std::vector<std::vector<unsigned char>> chunks(numChunks);
+    vtkCompressedImplicitBackendDetail::CompressWorker<ValueType> worker;
+    if (!vtkArrayDispatch::Dispatch::Execute(array, worker, this->ChunkSize, chunks))
+    {
+      worker(array, this->ChunkSize, chunks);
+    }
+
+    // Gather the chunks in a single buffer to avoid one allocation per chunk
+    this->ChunkOffsets.resize(numChunks + 1, 0);
+    for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+    {
+      this->ChunkOffsets[chunk + 1] = this->ChunkOffsets[chunk] + chunks[chunk].size();
+    }
+    this->Data.resize(this->ChunkOffsets.back());
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        std::copy(chunks[chunk].begin(), chunks[chunk].end(),
+          this->Data.begin() + this->ChunkOffsets[chunk]);
+      }
+    });
+  }
+
+  const ValueType* GetChunk(vtkIdType chunk) const
+  {
+    auto& cache = this->Caches.Local();
+    if (cache.Entries.empty())
+    {
+      cache.Entries.resize(this->CacheSize);
+    }
+    auto* entry = &cache.Entries[cache.MostRecent];
+    if (entry->Chunk != chunk)
+    {
+      std::size_t selected = 0;
+      for (std::size_t i = 0; i < cache.Entries.size(); ++i)
+      {
+        if (cache.Entries[i].Chunk == chunk)
+        {
+          selected = i;
+          break;
+        }
+        if (cache.Entries[i].LastUse < cache.Entries[selected].LastUse)
+        {
+          selected = i;
+        }
+      }
+      entry = &cache.Entries[selected];
+      cache.MostRecent = selected;
+      if (entry->Chunk != chunk)
+      {
+        const vtkIdType first = chunk * this->ChunkSize;
+        const vtkIdType size = std::min(this->ChunkSize, this->NumberOfValues - first);
+        entry->Values.resize(size);
+        vtkCompressedImplicitBackendDetail::DecodeChunk(
+          this->Data.data() + this->ChunkOffsets[chunk], size, this->NumberOfComponents,
+          entry->Values.data());
+        entry->Chunk = chunk;
+      }
+    }
+    entry->LastUse = ++cache.Clock;
+    return entry->Values.data();
+  }
+
+  vtkIdType ChunkSize;
+  std::size_t CacheSize;
+  int NumberOfComponents = 1;
+  vtkIdType NumberOfValues = 0;
+  std::vector<unsigned char> Data;
+  std::vector<std::size_t> ChunkOffsets{ 0 };
+  mutable vtkSMPThreadLocal<vtkCompressedImplicitBackendDetail::ChunkCache<ValueType>> Caches;
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::vtkCompressedImplicitBackend(
+  vtkDataArray* array, vtkIdType chunkSize, int cacheSize)
+  : Internal(std::unique_ptr<Internals>(new Internals(array, chunkSize, cacheSize)))
+{
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkCompressedImplicitBackend<ValueType>::~vtkCompressedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkCompressedImplicitBackend<ValueType>::map(vtkIdType idx) const
+{
+  const vtkIdType chunk = idx / this->Internal->ChunkSize;
+  return this->Internal->GetChunk(chunk)[idx - chunk * this->Internal->ChunkSize];
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkCompressedImplicitBackend<ValueType>::mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+{
+  const int numComps = this->Internal->NumberOfComponents;
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    tuple[comp] = this->map(tupleIdx * numComps + comp);
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkCompressedImplicitBackend<ValueType>::getMemorySize() const
+{
+  const std::size_t size = this->Internal->Data.capacity() +
+    this->Internal->ChunkOffsets.capacity() * sizeof(std::size_t);
+  return static_cast<unsigned long>((size + 1023) / 1024);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkCompressedImplicitBackend<ValueType>::GetChunkSize() const
+{
+  return this->Internal->ChunkSize;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkIdType vtkCompressedImplicitBackend<ValueType>::GetNumberOfChunks() const
+{
+  return static_cast<vtkIdType>(this->Internal->ChunkOffsets.size()) - 1;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+std::size_t vtkCompressedImplicitBackend<ValueType>::GetCompressedSize() const
+{
+  return this->Internal->Data.size();
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+double vtkCompressedImplicitBackend<ValueType>::GetCompressionRatio() const
+{
+  const std::size_t compressed = this->Internal->Data.size();
+  if (compressed == 0)
+  {
+    return 1.0;
+  }
+  return static_cast<double>(this->Internal->NumberOfValues * sizeof(ValueType)) / compressed;
+}
+VTK_ABI_NAMESPACE_END
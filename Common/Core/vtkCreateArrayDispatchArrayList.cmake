@@ -19,9 +19,14 @@
 # - VTK_DISPATCH_AFFINE_ARRAYS (default: OFF)
 #   Include vtkAffineArray<ValueType> for the basic types supported
 #   by VTK.
+# - VTK_DISPATCH_COMPRESSED_ARRAYS (default: OFF)
+#   Include vtkCompressedArray<ValueType> for the basic types supported
+#   by VTK.
 # - VTK_DISPATCH_CONSTANT_ARRAYS (default: OFF)
 #   Include vtkConstantArray<ValueType> for the basic types supported
 #   by VTK.
+# - VTK_DISPATCH_QUANTIZED_ARRAYS (default: OFF)
+#   Include vtkQuantizedArray<ValueType> for float and double.
 # - VTK_DISPATCH_STD_FUNCTION_ARRAYS (default: OFF)
 #   Include vtkStdFunctionArray<ValueType> for the basic types supported
 #   by VTK.
@@ -188,9 +193,15 @@ endmacro()
 _vtkCreateArrayDispatchImplicit(VTK_DISPATCH_AFFINE_ARRAYS "vtkAffineArray"
   "${vtkArrayDispatch_all_types}")
 
+_vtkCreateArrayDispatchImplicit(VTK_DISPATCH_COMPRESSED_ARRAYS "vtkCompressedArray"
+  "${vtkArrayDispatch_all_types}")
+
 _vtkCreateArrayDispatchImplicit(VTK_DISPATCH_CONSTANT_ARRAYS "vtkConstantArray"
   "${vtkArrayDispatch_all_types}")
 
+_vtkCreateArrayDispatchImplicit(VTK_DISPATCH_QUANTIZED_ARRAYS "vtkQuantizedArray"
+  "float;double")
+
 _vtkCreateArrayDispatchImplicit(VTK_DISPATCH_STD_FUNCTION_ARRAYS "vtkStdFunctionArray"
   "${vtkArrayDispatch_all_types}")
 
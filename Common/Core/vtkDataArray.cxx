@@ -1537,6 +1537,17 @@ void vtkDataArray::CopyComponent(int dstComponent, vtkDataArray* src, int srcCom
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkDataArray::LookupValues(vtkDataArray* values, vtkIdList* valueIds)
+{
+  const vtkIdType numValues = values->GetNumberOfValues();
+  valueIds->SetNumberOfIds(numValues);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    valueIds->SetId(i, this->LookupValue(values->GetVariantValue(i)));
+  }
+}
+
 //------------------------------------------------------------------------------
 double vtkDataArray::GetMaxNorm()
 {
@@ -300,6 +300,16 @@ public:
    */
   virtual void CopyComponent(int dstComponent, vtkDataArray* src, int srcComponent);
 
+  /**
+   * Look up all the values of the given array at once. On return, valueIds
+   * holds one id per value of `values`: the index of the first occurrence of
+   * the value in this array, or -1 if it is not found. The values are
+   * converted as in LookupValue(vtkVariant). Subclasses with a fast lookup
+   * structure perform the queries in parallel; the same warning about
+   * outdated lookups as for LookupValue() applies.
+   */
+  virtual void LookupValues(vtkDataArray* values, vtkIdList* valueIds);
+
   /**
    * Get the address of a particular data index. Make sure data is allocated
    * for the number of items requested. If needed, increase MaxId to mark any
@@ -320,6 +320,7 @@ public:
   virtual vtkIdType LookupTypedValue(ValueType value);
   void LookupValue(vtkVariant value, vtkIdList* valueIds) override;
   virtual void LookupTypedValue(ValueType value, vtkIdList* valueIds);
+  void LookupValues(vtkDataArray* values, vtkIdList* valueIds) override;
   void ClearLookup() override;
   void DataChanged() override;
   void FillComponent(int compIdx, double value) override;
@@ -307,6 +307,36 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::LookupTypedValue(ValueType value
   this->Lookup.LookupValue(value, ids);
 }
 
+//-----------------------------------------------------------------------------
+template <class DerivedT, class ValueTypeT>
+void vtkGenericDataArray<DerivedT, ValueTypeT>::LookupValues(
+  vtkDataArray* values, vtkIdList* valueIds)
+{
+  const vtkIdType numValues = values->GetNumberOfValues();
+  valueIds->SetNumberOfIds(numValues);
+  if (DerivedT* typedValues = vtkArrayDownCast<DerivedT>(values))
+  {
+    this->Lookup.LookupValues(
+      numValues,
+      [typedValues](vtkIdType valueIdx, ValueType& value) {
+        value = typedValues->GetValue(valueIdx);
+        return true;
+      },
+      valueIds->GetPointer(0));
+  }
+  else
+  {
+    this->Lookup.LookupValues(
+      numValues,
+      [values](vtkIdType valueIdx, ValueType& value) {
+        bool valid = true;
+        value = vtkVariantCast<ValueType>(values->GetVariantValue(valueIdx), &valid);
+        return valid;
+      },
+      valueIds->GetPointer(0));
+  }
+}
+
 //-----------------------------------------------------------------------------
 template <class DerivedT, class ValueTypeT>
 void vtkGenericDataArray<DerivedT, ValueTypeT>::ClearLookup()
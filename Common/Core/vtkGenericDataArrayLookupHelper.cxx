@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkGenericDataArrayLookupHelper.h"
+
+#include "vtkSMPTools.h"
+
+namespace vtkGenericDataArrayLookupHelper_detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//------------------------------------------------------------------------------
+void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  const std::function<void(vtkIdType, vtkIdType)>& function)
+{
+  auto worker = [&function](vtkIdType begin, vtkIdType end) { function(begin, end); };
+  if (grain > 0)
+  {
+    vtkSMPTools::For(first, last, grain, worker);
+  }
+  else
+  {
+    vtkSMPTools::For(first, last, worker);
+  }
+}
+
+//------------------------------------------------------------------------------
+int GetNumberOfThreads()
+{
+  return vtkSMPTools::GetEstimatedNumberOfThreads();
+}
+VTK_ABI_NAMESPACE_END
+} // namespace vtkGenericDataArrayLookupHelper_detail
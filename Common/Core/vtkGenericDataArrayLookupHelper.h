@@ -5,16 +5,25 @@
  * @brief   internal class used by
  * vtkGenericDataArray to support LookupValue.
  *
+ * The values of the array are indexed in a vector of (value, index) pairs
+ * sorted in parallel on the first lookup, and searched with binary searches.
+ * Values appended to the array afterwards are sorted and merged in the
+ * existing index on the next lookup, while DataChanged() clears it.
+ *
+ * The parallel loops go through a ParallelFor function compiled in
+ * vtkGenericDataArrayLookupHelper.cxx, so that this widely included header
+ * does not include vtkSMPTools.h.
  */
 
 #ifndef vtkGenericDataArrayLookupHelper_h
 #define vtkGenericDataArrayLookupHelper_h
 
+#include "vtkCommonCoreModule.h" // For export macro
 #include "vtkIdList.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 
 namespace vtkGenericDataArrayLookupHelper_detail
@@ -41,6 +50,47 @@ bool isnan(T x)
   // Select the correct partially specialized type.
   return has_NaN<T, std::numeric_limits<T>::has_quiet_NaN>::isnan(x);
 }
+
+// Call function(begin, end) on sub-ranges of [first, last) with vtkSMPTools::For.
+// A positive grain is passed on to vtkSMPTools::For.
+VTKCOMMONCORE_EXPORT void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  const std::function<void(vtkIdType, vtkIdType)>& function);
+
+// Return vtkSMPTools::GetEstimatedNumberOfThreads().
+VTKCOMMONCORE_EXPORT int GetNumberOfThreads();
+
+// Sort [begin, end): one chunk per thread is sorted with std::sort, then the
+// sorted chunks are merged pairwise.
+template <typename Iterator, typename Compare>
+void ParallelSort(Iterator begin, Iterator end, Compare comp)
+{
+  const vtkIdType size = static_cast<vtkIdType>(end - begin);
+  const vtkIdType numChunks =
+    std::min(static_cast<vtkIdType>(GetNumberOfThreads()), size / 1024 + 1);
+  if (numChunks < 2)
+  {
+    std::sort(begin, end, comp);
+    return;
+  }
+  const vtkIdType chunkSize = (size + numChunks - 1) / numChunks;
+  ParallelFor(0, numChunks, 1, [&](vtkIdType chunk, vtkIdType endChunk) {
+    for (; chunk < endChunk; ++chunk)
+    {
+      std::sort(begin + chunk * chunkSize, begin + std::min(size, (chunk + 1) * chunkSize), comp);
+    }
+  });
+  for (vtkIdType width = chunkSize; width < size; width *= 2)
+  {
+    ParallelFor(0, (size + 2 * width - 1) / (2 * width), 1, [&](vtkIdType pair, vtkIdType endPair) {
+      for (; pair < endPair; ++pair)
+      {
+        const vtkIdType start = pair * 2 * width;
+        std::inplace_merge(begin + start, begin + std::min(size, start + width),
+          begin + std::min(size, start + 2 * width), comp);
+      }
+    });
+  }
+}
 VTK_ABI_NAMESPACE_END
 } // namespace detail
 
@@ -68,37 +118,58 @@ public:
   vtkIdType LookupValue(ValueType elem)
   {
     this->UpdateLookup();
-    auto indices = FindIndexVec(elem);
-    if (indices == nullptr)
-    {
-      return -1;
-    }
-    return indices->front();
+    return this->FindIndex(elem);
   }
 
   void LookupValue(ValueType elem, vtkIdList* ids)
   {
     ids->Reset();
     this->UpdateLookup();
-    auto indices = FindIndexVec(elem);
-    if (indices)
+    if (vtkGenericDataArrayLookupHelper_detail::isnan(elem))
     {
-      ids->Allocate(static_cast<vtkIdType>(indices->size()));
-      for (auto index : *indices)
-      {
-        ids->InsertNextId(index);
-      }
+      ids->SetNumberOfIds(static_cast<vtkIdType>(this->NanIndices.size()));
+      std::copy(this->NanIndices.begin(), this->NanIndices.end(), ids->GetPointer(0));
+      return;
+    }
+    auto range =
+      std::equal_range(this->SortedArray.begin(), this->SortedArray.end(), elem, ValueLess());
+    ids->SetNumberOfIds(static_cast<vtkIdType>(range.second - range.first));
+    vtkIdType* idsPtr = ids->GetPointer(0);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      *idsPtr++ = it->Index;
     }
   }
 
+  /**
+   * Look up several values in parallel. For each index i in [0, numValues),
+   * `getValue(i, value)` must set `value` and return true if it can be looked
+   * up. The index of the first occurrence of the value, or -1, is stored in
+   * `ids[i]`.
+   */
+  template <typename ValueGetter>
+  void LookupValues(vtkIdType numValues, const ValueGetter& getValue, vtkIdType* ids)
+  {
+    this->UpdateLookup();
+    vtkGenericDataArrayLookupHelper_detail::ParallelFor(
+      0, numValues, 0, [this, &getValue, ids](vtkIdType begin, vtkIdType end) {
+        ValueType value;
+        for (; begin < end; ++begin)
+        {
+          ids[begin] = getValue(begin, value) ? this->FindIndex(value) : -1;
+        }
+      });
+  }
+
   ///@{
   /**
    * Release any allocated memory for internal data-structures.
    */
   void ClearLookup()
   {
-    this->ValueMap.clear();
-    this->NanIndices.clear();
+    std::vector<ValueWithIndex>().swap(this->SortedArray);
+    std::vector<vtkIdType>().swap(this->NanIndices);
+    this->NumberOfIndexedValues = 0;
   }
   ///@}
 
@@ -106,47 +177,109 @@ private:
   vtkGenericDataArrayLookupHelper(const vtkGenericDataArrayLookupHelper&) = delete;
   void operator=(const vtkGenericDataArrayLookupHelper&) = delete;
 
+  struct ValueWithIndex
+  {
+    ValueType Value;
+    vtkIdType Index;
+  };
+
+  // Orders by value then by index, with NaN values after all the others.
+  struct EntryLess
+  {
+    bool operator()(const ValueWithIndex& a, const ValueWithIndex& b) const
+    {
+      const bool aIsNan = vtkGenericDataArrayLookupHelper_detail::isnan(a.Value);
+      const bool bIsNan = vtkGenericDataArrayLookupHelper_detail::isnan(b.Value);
+      if (aIsNan || bIsNan)
+      {
+        return bIsNan && (!aIsNan || a.Index < b.Index);
+      }
+      return a.Value < b.Value || (!(b.Value < a.Value) && a.Index < b.Index);
+    }
+  };
+
+  // Compares entries with a value, for binary searches.
+  struct ValueLess
+  {
+    bool operator()(const ValueWithIndex& a, ValueType b) const { return a.Value < b; }
+    bool operator()(ValueType a, const ValueWithIndex& b) const { return a < b.Value; }
+  };
+
+  // Index the values of the array that are not indexed yet. Values are
+  // expected to only be appended between two calls: any other modification
+  // must go through DataChanged(), which clears the lookup.
   void UpdateLookup()
   {
-    if (!this->AssociatedArray || (this->AssociatedArray->GetNumberOfTuples() < 1) ||
-      (!this->ValueMap.empty() || !this->NanIndices.empty()))
+    if (!this->AssociatedArray || (this->AssociatedArray->GetNumberOfTuples() < 1))
     {
       return;
     }
 
-    vtkIdType num = this->AssociatedArray->GetNumberOfValues();
-    this->ValueMap.reserve(num);
-    for (vtkIdType i = 0; i < num; ++i)
+    const vtkIdType num = this->AssociatedArray->GetNumberOfValues();
+    if (num < this->NumberOfIndexedValues)
     {
-      auto value = this->AssociatedArray->GetValue(i);
-      if (vtkGenericDataArrayLookupHelper_detail::isnan(value))
-      {
-        NanIndices.push_back(i);
-      }
-      this->ValueMap[value].push_back(i);
+      this->ClearLookup();
+    }
+    const vtkIdType first = this->NumberOfIndexedValues;
+    if (num == first)
+    {
+      return;
+    }
+
+    // Sort the new (value, index) pairs, moving NaN values at the end
+    const std::size_t numSorted = this->SortedArray.size();
+    this->SortedArray.resize(numSorted + static_cast<std::size_t>(num - first));
+    ArrayTypeT* array = this->AssociatedArray;
+    ValueWithIndex* entries = this->SortedArray.data() + numSorted;
+    vtkGenericDataArrayLookupHelper_detail::ParallelFor(
+      first, num, 0, [array, entries, first](vtkIdType begin, vtkIdType end) {
+        for (; begin < end; ++begin)
+        {
+          entries[begin - first].Value = array->GetValue(begin);
+          entries[begin - first].Index = begin;
+        }
+      });
+    const auto newBegin = this->SortedArray.begin() + numSorted;
+    vtkGenericDataArrayLookupHelper_detail::ParallelSort(
+      newBegin, this->SortedArray.end(), EntryLess());
+
+    const auto firstNan = std::partition_point(
+      newBegin, this->SortedArray.end(), [](const ValueWithIndex& entry) {
+        return !vtkGenericDataArrayLookupHelper_detail::isnan(entry.Value);
+      });
+    for (auto it = firstNan; it != this->SortedArray.end(); ++it)
+    {
+      this->NanIndices.push_back(it->Index);
     }
+    this->SortedArray.erase(firstNan, this->SortedArray.end());
+
+    // Appended indices are larger than the indexed ones, so merging keeps
+    // the first occurrence of each value in front.
+    std::inplace_merge(this->SortedArray.begin(), this->SortedArray.begin() + numSorted,
+      this->SortedArray.end(), EntryLess());
+    this->NumberOfIndexedValues = num;
   }
 
-  // Return a pointer to the relevant vector of indices if specified value was
-  // found in the array.
-  std::vector<vtkIdType>* FindIndexVec(ValueType value)
+  // Return the index of the first occurrence of the value, or -1.
+  vtkIdType FindIndex(ValueType value) const
   {
-    std::vector<vtkIdType>* indices{ nullptr };
-    if (vtkGenericDataArrayLookupHelper_detail::isnan(value) && !this->NanIndices.empty())
+    if (vtkGenericDataArrayLookupHelper_detail::isnan(value))
     {
-      indices = &this->NanIndices;
+      return this->NanIndices.empty() ? -1 : this->NanIndices.front();
     }
-    const auto& pos = this->ValueMap.find(value);
-    if (pos != this->ValueMap.end())
+    auto pos =
+      std::lower_bound(this->SortedArray.begin(), this->SortedArray.end(), value, ValueLess());
+    if (pos != this->SortedArray.end() && !(value < pos->Value))
     {
-      indices = &pos->second;
+      return pos->Index;
     }
-    return indices;
+    return -1;
   }
 
   ArrayTypeT* AssociatedArray{ nullptr };
-  std::unordered_map<ValueType, std::vector<vtkIdType>> ValueMap;
+  std::vector<ValueWithIndex> SortedArray;
   std::vector<vtkIdType> NanIndices;
+  vtkIdType NumberOfIndexedValues{ 0 };
 };
 
 VTK_ABI_NAMESPACE_END
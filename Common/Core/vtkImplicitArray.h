@@ -235,7 +235,9 @@ public:
 
   /**
    * Use of this method is discouraged, it creates a memory copy of the data into
-   * a contiguous AoS-ordered buffer internally.
+   * a contiguous AoS-ordered buffer internally. Backends implementing a
+   * `getArray() const` method returning the `vtkAOSDataArrayTemplate` holding their
+   * values share that array instead of a copy.
    */
   void* GetVoidPointer(vtkIdType valueIdx) override;
 
@@ -244,6 +246,16 @@ public:
    */
   void Squeeze() override;
 
+  /**
+   * Return the memory in kibibytes (1024 bytes) consumed by this array. Backends implementing an
+   * integral `getMemorySize() const` method report their own footprint, otherwise the size of the
+   * equivalent explicit array is returned.
+   */
+  unsigned long GetActualMemorySize() const override
+  {
+    return this->GetActualMemorySizeImpl<BackendT>();
+  }
+
   /**
    * Get the type of array this is when down casting
    */
@@ -362,6 +374,40 @@ private:
   }
   ///@}
 
+  ///@{
+  /**
+   * Static dispatch memory size for backends reporting their memory usage
+   */
+  template <typename U>
+  typename std::enable_if<vtk::detail::implicit_array_traits<U>::can_get_memory_size,
+    unsigned long>::type
+  GetActualMemorySizeImpl() const
+  {
+    return this->Backend ? static_cast<unsigned long>(this->Backend->getMemorySize()) : 0;
+  }
+
+  template <typename U>
+  typename std::enable_if<!vtk::detail::implicit_array_traits<U>::can_get_memory_size,
+    unsigned long>::type
+  GetActualMemorySizeImpl() const
+  {
+    return this->GenericDataArrayType::GetActualMemorySize();
+  }
+  ///@}
+
+  ///@{
+  /**
+   * Static dispatch of the creation of the buffer returned by GetVoidPointer
+   */
+  template <typename U>
+  typename std::enable_if<vtk::detail::implicit_array_traits<U>::can_get_array, void>::type
+  CreateCacheImpl();
+
+  template <typename U>
+  typename std::enable_if<!vtk::detail::implicit_array_traits<U>::can_get_array, void>::type
+  CreateCacheImpl();
+  ///@}
+
   ///@{
   /**
    * Static dispatch tuple mapping for compatible backends
@@ -63,12 +63,30 @@ void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType idx)
 {
   if (!this->Internals->Cache)
   {
-    this->Internals->Cache = vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>>::New();
-    this->Internals->Cache->DeepCopy(this);
+    this->CreateCacheImpl<BackendT>();
   }
   return this->Internals->Cache->GetVoidPointer(idx);
 }
 
+//-----------------------------------------------------------------------------
+template <class BackendT>
+template <typename U>
+typename std::enable_if<vtk::detail::implicit_array_traits<U>::can_get_array, void>::type
+vtkImplicitArray<BackendT>::CreateCacheImpl()
+{
+  this->Internals->Cache = this->Backend->getArray();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+template <typename U>
+typename std::enable_if<!vtk::detail::implicit_array_traits<U>::can_get_array, void>::type
+vtkImplicitArray<BackendT>::CreateCacheImpl()
+{
+  this->Internals->Cache = vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>>::New();
+  this->Internals->Cache->DeepCopy(this);
+}
+
 //-----------------------------------------------------------------------------
 template <class BackendT>
 void vtkImplicitArray<BackendT>::Squeeze()
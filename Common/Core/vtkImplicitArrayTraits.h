@@ -7,6 +7,7 @@
 #include "vtkSystemIncludes.h"
 #include <numeric>
 #include <type_traits>
+#include <utility>
 
 /**
  * This file contains the traits for the implicit array mechanism in VTK. These traits are very much
@@ -21,6 +22,9 @@
  * There is 1 mandatory traits that a template type to vtkImplicitArray must implement:
  * - has_map_trait || is_closure_trait: ensures an implementation of int -> value
  *
+ * The optional has_get_memory_size_trait lets the backend report the memory it holds (in
+ * kibibytes) through vtkImplicitArray::GetActualMemorySize.
+ *
  * Potential improvements to implicit arrays which would allow for write access would include the
  * following 2 optional traits:
  * - has_insert_trait || is_reference_closure_trait: provides an implementation to update the
@@ -227,6 +231,43 @@ struct has_map_component_trait<R(ArgTupIdx, ArgCompIdx)>
 };
 ///@}
 
+///@{
+/**
+ * \struct has_get_memory_size_trait
+ * \brief used to check whether the template type has a const method named getMemorySize
+ */
+template <typename, typename = void>
+struct has_get_memory_size_trait : std::false_type
+{
+};
+
+template <typename T>
+struct has_get_memory_size_trait<T, void_t<decltype(std::declval<const T&>().getMemorySize())>>
+  : std::true_type
+{
+  static_assert(std::is_integral<decltype(std::declval<const T&>().getMemorySize())>::value,
+    "getMemorySize must return an integral number of kibibytes");
+};
+///@}
+
+///@{
+/**
+ * \struct has_get_array_trait
+ * \brief used to check whether the template type has a const method named getArray returning
+ * the contiguous array holding its values
+ */
+template <typename, typename = void>
+struct has_get_array_trait : std::false_type
+{
+};
+
+template <typename T>
+struct has_get_array_trait<T, void_t<decltype(std::declval<const T&>().getArray())>>
+  : std::true_type
+{
+};
+///@}
+
 namespace iarrays
 {
 /**
@@ -351,6 +392,8 @@ struct implicit_array_traits
   static constexpr bool default_constructible = std::is_default_constructible<T>::value;
   static constexpr bool can_direct_read_tuple = can_map_tuple_trait<T>::value;
   static constexpr bool can_direct_read_component = can_map_component_trait<T>::value;
+  static constexpr bool can_get_memory_size = has_get_memory_size_trait<T>::value;
+  static constexpr bool can_get_array = has_get_array_trait<T>::value;
 };
 
 VTK_ABI_NAMESPACE_END
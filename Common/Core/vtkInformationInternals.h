@@ -15,13 +15,9 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#include <cstdint>
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-#include <unordered_map>
-#else
-#include <map>
-#endif
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -30,26 +26,54 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+
+  // Information objects hold a few tens of keys at most. A linear search in a
+  // contiguous vector is faster than hashing for so few keys, and creating or
+  // copying an information object requires at most one allocation.
+  class MapType
   {
-    size_t operator()(KeyType key) const
+  public:
+    typedef std::pair<KeyType, DataType> value_type;
+    typedef std::vector<value_type>::iterator iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() { return this->Entries.begin(); }
+    iterator end() { return this->Entries.end(); }
+    const_iterator begin() const { return this->Entries.begin(); }
+    const_iterator end() const { return this->Entries.end(); }
+    size_t size() const { return this->Entries.size(); }
+    bool empty() const { return this->Entries.empty(); }
+
+    iterator find(KeyType key)
+    {
+      return std::find_if(this->Entries.begin(), this->Entries.end(),
+        [key](const value_type& entry) { return entry.first == key; });
+    }
+    const_iterator find(KeyType key) const
     {
-      return reinterpret_cast<uintptr_t>(key) / sizeof(vtkInformationKey);
+      return std::find_if(this->Entries.begin(), this->Entries.end(),
+        [key](const value_type& entry) { return entry.first == key; });
     }
+
+    std::pair<iterator, bool> insert(const value_type& entry)
+    {
+      iterator i = this->find(entry.first);
+      if (i != this->Entries.end())
+      {
+        return std::make_pair(i, false);
+      }
+      this->Entries.push_back(entry);
+      return std::make_pair(this->Entries.end() - 1, true);
+    }
+
+    iterator erase(iterator i) { return this->Entries.erase(i); }
+
+  private:
+    std::vector<value_type> Entries;
   };
-  typedef std::unordered_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef std::map<KeyType, DataType> MapType;
-#endif
   MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals()
-    : Map(33)
-  {
-  }
-#endif
+  vtkInformationInternals() = default;
 
   ~vtkInformationInternals()
   {
@@ -62,14 +86,10 @@ public:
     }
   }
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
 private:
   vtkInformationInternals(vtkInformationInternals const&) = delete;
-#endif
 };
 
-#undef VTK_INFORMATION_USE_HASH_MAP
-
 VTK_ABI_NAMESPACE_END
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
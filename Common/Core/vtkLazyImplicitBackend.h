@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkLazyImplicitBackend_h
+#define vtkLazyImplicitBackend_h
+
+/**
+ * \class vtkLazyImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework deferring the creation of the values of an array
+ * until they are first accessed. It is meant for readers publishing arrays that downstream filters
+ * may never use: only the metadata of the array (type, number of tuples and components) is needed
+ * up front, and the values are loaded from the file when needed.
+ *
+ * The values are produced by a loader function returning a `vtkDataArray` with the expected number
+ * of tuples and components. It is called at most once, on the first access to any value, even when
+ * the array is read concurrently from several threads, e.g. from vtkSMPTools functors: the other
+ * threads wait until the values are available. The loader is released once it has been called, so
+ * that the resources it captures, such as file handles, are not kept. If the loader fails or
+ * returns an array of the wrong size, a warning is issued and the values are all 0.
+ *
+ * When the loaded array is a `vtkAOSDataArrayTemplate<ValueType>`, its memory is used directly,
+ * otherwise the values are converted to `ValueType`. That array is also what `GetVoidPointer`
+ * returns, so raw pointer accesses do not copy the values again.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * auto loader = [fileName]() -> vtkSmartPointer<vtkDataArray> { return ReadArray(fileName); };
+ * vtkNew<vtkLazyArray<float>> lazy; // vtkImplicitArray<vtkLazyImplicitBackend>
+ * lazy->ConstructBackend(loader, numberOfTuples, numberOfComponents);
+ * lazy->SetNumberOfComponents(numberOfComponents);
+ * lazy->SetNumberOfTuples(numberOfTuples);
+ * CHECK(!lazy->GetBackend()->IsLoaded());
+ * float value = lazy->GetValue(42); // calls the loader
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkLazyArray
+ */
+
+#include "vtkCommonCoreModule.h"
+#include "vtkSmartPointer.h" // for the loader return type
+#include "vtkType.h"
+
+#include <functional> // for the loader
+#include <memory>     // for std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class vtkAOSDataArrayTemplate;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkLazyImplicitBackend final
+{
+public:
+  using LoaderType = std::function<vtkSmartPointer<vtkDataArray>()>;
+
+  /**
+   * Constructor storing the loader of the values and the expected shape of the loaded array.
+   * Nothing is loaded until the first access.
+   */
+  vtkLazyImplicitBackend(LoaderType loader, vtkIdType numberOfTuples, int numberOfComponents);
+  ~vtkLazyImplicitBackend();
+
+  /**
+   * Indexing operation for the lazy array respecting the backend expectations of
+   * `vtkImplicitArray`. Loads the values on the first call.
+   */
+  ValueType map(vtkIdType idx) const;
+
+  /**
+   * Copy the tuple at @a tupleIdx in @a tuple. Loads the values on the first call.
+   */
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+
+  /**
+   * Return the memory held by the loaded values in kibibytes, 0 until they are loaded.
+   */
+  unsigned long getMemorySize() const;
+
+  /**
+   * Return the array holding the loaded values. Loads the values on the first call.
+   */
+  vtkAOSDataArrayTemplate<ValueType>* getArray() const;
+
+  /**
+   * Return true once the values have been loaded.
+   */
+  bool IsLoaded() const;
+
+  /**
+   * Load the values now if they are not loaded yet, e.g. to control when the I/O happens.
+   */
+  void Load() const;
+
+private:
+  struct Internals;
+  std::unique_ptr<Internals> Internal;
+
+  const ValueType* GetValues() const;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkLazyImplicitBackend_h
+
+#ifdef VTK_LAZY_BACKEND_INSTANTIATING
+#define VTK_INSTANTIATE_LAZY_BACKEND(ValueType)                                                    \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkLazyImplicitBackend<ValueType>;                           \
+  VTK_ABI_NAMESPACE_END
+#endif
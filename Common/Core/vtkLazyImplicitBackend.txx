@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLazyImplicitBackend.h"
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDataArray.h"
+#include "vtkObject.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+struct vtkLazyImplicitBackend<ValueType>::Internals
+{
+  using ArrayType = vtkAOSDataArrayTemplate<ValueType>;
+
+  Internals(LoaderType&& loader, vtkIdType numberOfTuples, int numberOfComponents)
+    : Loader(std::move(loader))
+    , NumberOfTuples(numberOfTuples)
+    , NumberOfComponents(numberOfComponents)
+  {
+  }
+
+  void LoadValues()
+  {
+    vtkSmartPointer<vtkDataArray> loaded;
+    if (this->Loader)
+    {
+      loaded = this->Loader();
+    }
+    // release what the loader captured
+    this->Loader = nullptr;
+
+    if (!loaded || loaded->GetNumberOfTuples() != this->NumberOfTuples ||
+      loaded->GetNumberOfComponents() != this->NumberOfComponents)
+    {
+      vtkGenericWarningMacro("Failed to load the values of a lazy array, they are set to 0.");
+      this->Array = vtkSmartPointer<ArrayType>::New();
+      this->Array->SetNumberOfComponents(this->NumberOfComponents);
+      this->Array->SetNumberOfTuples(this->NumberOfTuples);
+      this->Array->Fill(0);
+    }
+    else if (ArrayType* array = ArrayType::FastDownCast(loaded))
+    {
+      this->Array = array;
+    }
+    else
+    {
+      this->Array = vtkSmartPointer<ArrayType>::New();
+      this->Array->DeepCopy(loaded);
+    }
+    this->Values.store(this->Array->GetPointer(0), std::memory_order_release);
+    this->Loaded.store(true, std::memory_order_release);
+  }
+
+  LoaderType Loader;
+  const vtkIdType NumberOfTuples;
+  const int NumberOfComponents;
+  vtkSmartPointer<ArrayType> Array;
+  std::once_flag LoadFlag;
+  // null until the values are loaded, lets accesses skip std::call_once afterwards
+  std::atomic<const ValueType*> Values{ nullptr };
+  std::atomic<bool> Loaded{ false };
+};
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkLazyImplicitBackend<ValueType>::vtkLazyImplicitBackend(
+  LoaderType loader, vtkIdType numberOfTuples, int numberOfComponents)
+  : Internal(std::unique_ptr<Internals>(
+      new Internals(std::move(loader), numberOfTuples, numberOfComponents)))
+{
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkLazyImplicitBackend<ValueType>::~vtkLazyImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+const ValueType* vtkLazyImplicitBackend<ValueType>::GetValues() const
+{
+  const ValueType* values = this->Internal->Values.load(std::memory_order_acquire);
+  if (!values)
+  {
+    this->Load();
+    values = this->Internal->Values.load(std::memory_order_acquire);
+  }
+  return values;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkLazyImplicitBackend<ValueType>::Load() const
+{
+  Internals* internal = this->Internal.get();
+  std::call_once(internal->LoadFlag, [internal]() { internal->LoadValues(); });
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+bool vtkLazyImplicitBackend<ValueType>::IsLoaded() const
+{
+  return this->Internal->Loaded.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+ValueType vtkLazyImplicitBackend<ValueType>::map(vtkIdType idx) const
+{
+  return this->GetValues()[idx];
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+void vtkLazyImplicitBackend<ValueType>::mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+{
+  const int numComps = this->Internal->NumberOfComponents;
+  const ValueType* values = this->GetValues() + tupleIdx * numComps;
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    tuple[comp] = values[comp];
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkAOSDataArrayTemplate<ValueType>* vtkLazyImplicitBackend<ValueType>::getArray() const
+{
+  this->Load();
+  return this->Internal->Array;
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkLazyImplicitBackend<ValueType>::getMemorySize() const
+{
+  return this->IsLoaded() ? this->Internal->Array->GetActualMemorySize() : 0;
+}
+VTK_ABI_NAMESPACE_END
@@ -8,6 +8,7 @@
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
+#include "vtkQuantizedArray.h"
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -108,13 +109,37 @@ void vtkPoints::GetPoints(vtkIdList* ptIds, vtkPoints* outPoints)
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// The range of quantized coordinates is known from the quantization parameters.
+template <typename ValueType>
+bool ComputeQuantizedBounds(vtkDataArray* data, double bounds[6])
+{
+  auto quantized = vtkArrayDownCast<vtkQuantizedArray<ValueType>>(data);
+  if (!quantized || quantized->GetNumberOfTuples() == 0)
+  {
+    return false;
+  }
+  for (int comp = 0; comp < 3; ++comp)
+  {
+    quantized->GetBackend()->GetComponentRange(comp, bounds + 2 * comp);
+  }
+  return true;
+}
+}
+
 //------------------------------------------------------------------------------
 // Determine (xmin,xmax, ymin,ymax, zmin,zmax) bounds of points.
 void vtkPoints::ComputeBounds()
 {
   if (this->GetMTime() > this->ComputeTime)
   {
-    this->Data->ComputeScalarRange(this->Bounds);
+    if (!::ComputeQuantizedBounds<float>(this->Data, this->Bounds) &&
+      !::ComputeQuantizedBounds<double>(this->Data, this->Bounds))
+    {
+      this->Data->ComputeScalarRange(this->Bounds);
+    }
     this->ComputeTime.Modified();
   }
 }
@@ -215,6 +215,8 @@ public:
 
   /**
    * Determine (xmin,xmax, ymin,ymax, zmin,zmax) bounds of points.
+   * The bounds of points stored in a vtkQuantizedArray are computed from its
+   * quantization parameters, without decoding the coordinates.
    */
   virtual void ComputeBounds();
 
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkQuantizedImplicitBackend_h
+#define vtkQuantizedImplicitBackend_h
+
+/**
+ * \class vtkQuantizedImplicitBackend
+ *
+ * A backend for the `vtkImplicitArray` framework storing the values of an array as 16 bit codes
+ * relative to the range of each component. The value of component c of a tuple is decoded on the
+ * fly as `offset[c] + scale[c] * code`, in the spirit of vtkScaledSOADataArrayTemplate. It is
+ * meant for large point clouds whose coordinates do not need more than 16 bits of precision
+ * relative to their bounding box, e.g. scanned data, where it divides the memory used by the
+ * coordinates by 2 for floats and by 4 for doubles.
+ *
+ * The quantization is lossy: the decoded values are within half a quantization step, GetScale(),
+ * of the original ones, up to the rounding of the decoded value. The finite range of each component
+ * is mapped on the 65536 codes, infinite values are clamped to this range and NaN values are
+ * decoded as its minimum. The range of the decoded values is known without decoding them, see
+ * GetComponentRange(), which allows vtkPoints to compute its bounds directly.
+ *
+ * An example of potential usage in a `vtkImplicitArray`:
+ * ```
+ * vtkNew<vtkFloatArray> coordinates;
+ * ...
+ * vtkNew<vtkQuantizedArray<float>> quantized; // vtkImplicitArray<vtkQuantizedImplicitBackend>
+ * quantized->ConstructBackend(coordinates);
+ * quantized->SetNumberOfComponents(3);
+ * quantized->SetNumberOfTuples(coordinates->GetNumberOfTuples());
+ * points->SetData(quantized);
+ * ```
+ *
+ * @sa
+ * vtkImplicitArray, vtkQuantizedArray, vtkScaledSOADataArrayTemplate
+ */
+
+#include "vtkCommonCoreModule.h"
+#include "vtkType.h"
+
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+template <typename ValueType>
+class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend final
+{
+public:
+  /**
+   * Constructor quantizing all the values of the given array, it is not referenced afterwards.
+   */
+  vtkQuantizedImplicitBackend(vtkDataArray* array);
+  ~vtkQuantizedImplicitBackend();
+
+  /**
+   * Indexing operation for the quantized array respecting the backend expectations of
+   * `vtkImplicitArray`
+   */
+  ValueType map(vtkIdType idx) const
+  {
+    const int comp = static_cast<int>(idx % this->NumberOfComponents);
+    return this->Decode(this->Codes[idx], comp);
+  }
+
+  /**
+   * Decode the tuple at @a tupleIdx in @a tuple.
+   */
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const vtkTypeUInt16* codes = this->Codes.data() + tupleIdx * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+      tuple[comp] = this->Decode(codes[comp], comp);
+    }
+  }
+
+  /**
+   * Decode the component @a comp of the tuple at @a tupleIdx.
+   */
+  ValueType mapComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->Decode(this->Codes[tupleIdx * this->NumberOfComponents + comp], comp);
+  }
+
+  /**
+   * Return the memory held by the codes, in kibibytes.
+   */
+  unsigned long getMemorySize() const;
+
+  ///@{
+  /**
+   * Get the parameters of the quantization of a component. The scale is also the
+   * quantization step.
+   */
+  double GetScale(int comp) const { return this->Scales[comp]; }
+  double GetOffset(int comp) const { return this->Offsets[comp]; }
+  ///@}
+
+  /**
+   * Get the range of the decoded values of a component, without decoding them. The range is only
+   * meaningful for non-empty arrays.
+   */
+  void GetComponentRange(int comp, double range[2]) const
+  {
+    range[0] = static_cast<double>(this->Decode(0, comp));
+    range[1] = static_cast<double>(this->Decode(this->Scales[comp] > 0.0 ? 0xffff : 0, comp));
+  }
+
+  /**
+   * Get the raw codes, tuple by tuple.
+   */
+  const vtkTypeUInt16* GetCodes() const { return this->Codes.data(); }
+
+private:
+  ValueType Decode(vtkTypeUInt16 code, int comp) const
+  {
+    return static_cast<ValueType>(this->Offsets[comp] + this->Scales[comp] * code);
+  }
+
+  int NumberOfComponents = 1;
+  std::vector<vtkTypeUInt16> Codes;
+  std::vector<double> Scales;
+  std::vector<double> Offsets;
+};
+VTK_ABI_NAMESPACE_END
+
+#endif // vtkQuantizedImplicitBackend_h
+
+#ifdef VTK_QUANTIZED_BACKEND_INSTANTIATING
+#define VTK_INSTANTIATE_QUANTIZED_BACKEND(ValueType)                                               \
+  VTK_ABI_NAMESPACE_BEGIN                                                                          \
+  template class VTKCOMMONCORE_EXPORT vtkQuantizedImplicitBackend<ValueType>;                      \
+  VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkQuantizedImplicitBackend.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+
+namespace vtkQuantizedImplicitBackendDetail
+{
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+struct QuantizeWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const std::vector<double>& offsets,
+    const std::vector<double>& invScales, vtkTypeUInt16* codes)
+  {
+    const int numComps = array->GetNumberOfComponents();
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      vtkTypeUInt16* out = codes + begin * numComps;
+      for (const auto tuple : vtk::DataArrayTupleRange(array, begin, end))
+      {
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          // Round to the nearest code, NaN fails both comparisons and gets the first code
+          const double code =
+            (static_cast<double>(tuple[comp]) - offsets[comp]) * invScales[comp] + 0.5;
+          *out++ = code > 0.0 ? (code < 65535.0 ? static_cast<vtkTypeUInt16>(code) : 0xffff) : 0;
+        }
+      }
+    });
+  }
+};
+VTK_ABI_NAMESPACE_END
+} // namespace vtkQuantizedImplicitBackendDetail
+
+VTK_ABI_NAMESPACE_BEGIN
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkQuantizedImplicitBackend<ValueType>::vtkQuantizedImplicitBackend(vtkDataArray* array)
+{
+  this->NumberOfComponents = array ? std::max(1, array->GetNumberOfComponents()) : 1;
+  this->Scales.resize(this->NumberOfComponents, 0.0);
+  this->Offsets.resize(this->NumberOfComponents, 0.0);
+  if (!array)
+  {
+    return;
+  }
+
+  std::vector<double> invScales(this->NumberOfComponents, 0.0);
+  for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+  {
+    double range[2];
+    array->GetFiniteRange(range, comp);
+    if (range[0] <= range[1])
+    {
+      this->Offsets[comp] = range[0];
+      this->Scales[comp] = (range[1] - range[0]) / 65535.0;
+      invScales[comp] = this->Scales[comp] > 0.0 ? 1.0 / this->Scales[comp] : 0.0;
+    }
+  }
+
+  this->Codes.resize(array->GetNumberOfValues());
+  vtkQuantizedImplicitBackendDetail::QuantizeWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        array, worker, this->Offsets, invScales, this->Codes.data()))
+  {
+    worker(array, this->Offsets, invScales, this->Codes.data());
+  }
+}
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+vtkQuantizedImplicitBackend<ValueType>::~vtkQuantizedImplicitBackend() = default;
+
+//-----------------------------------------------------------------------
+template <typename ValueType>
+unsigned long vtkQuantizedImplicitBackend<ValueType>::getMemorySize() const
+{
+  const std::size_t bytes = this->Codes.size() * sizeof(vtkTypeUInt16) +
+    (this->Scales.size() + this->Offsets.size()) * sizeof(double);
+  return static_cast<unsigned long>((bytes + 1023) / 1024);
+}
+VTK_ABI_NAMESPACE_END
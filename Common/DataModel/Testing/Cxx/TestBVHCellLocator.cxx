@@ -0,0 +1,301 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks the queries of vtkBVHCellLocator against vtkStaticCellLocator and
+// brute force searches on a tetrahedral mesh with strongly graded cells, and
+// the vtkOBBTree style intersection on a closed surface.
+#include "vtkBVHCellLocator.h"
+#include "vtkBox.h"
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// A tetrahedralized box whose cells shrink geometrically towards the origin.
+void MakeGradedGrid(vtkUnstructuredGrid* grid, int n)
+{
+  std::vector<double> coords(n);
+  for (int i = 0; i < n; ++i)
+  {
+    coords[i] = (std::pow(1.5, i) - 1.0) / (std::pow(1.5, n - 1) - 1.0);
+  }
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        points->InsertNextPoint(coords[i], coords[j], coords[k]);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(5 * (n - 1) * (n - 1) * (n - 1));
+  for (int k = 0; k < n - 1; ++k)
+  {
+    for (int j = 0; j < n - 1; ++j)
+    {
+      for (int i = 0; i < n - 1; ++i)
+      {
+        vtkIdType v[8];
+        for (int c = 0; c < 8; ++c)
+        {
+          v[c] = (i + (c & 1)) + n * ((j + ((c >> 1) & 1)) + n * (k + ((c >> 2) & 1)));
+        }
+        const vtkIdType tets[5][4] = { { v[0], v[1], v[3], v[5] }, { v[0], v[3], v[2], v[6] },
+          { v[0], v[5], v[6], v[4] }, { v[3], v[5], v[7], v[6] }, { v[0], v[3], v[6], v[5] } };
+        for (int t = 0; t < 5; ++t)
+        {
+          grid->InsertNextCell(VTK_TETRA, 4, tets[t]);
+        }
+      }
+    }
+  }
+}
+
+// The surface of the unit cube, two triangles per face.
+void MakeCube(vtkPolyData* cube)
+{
+  vtkNew<vtkPoints> points;
+  for (int c = 0; c < 8; ++c)
+  {
+    points->InsertNextPoint(c & 1, (c >> 1) & 1, (c >> 2) & 1);
+  }
+  const vtkIdType quads[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+    { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+  vtkNew<vtkCellArray> polys;
+  for (int f = 0; f < 6; ++f)
+  {
+    const vtkIdType t0[3] = { quads[f][0], quads[f][1], quads[f][2] };
+    const vtkIdType t1[3] = { quads[f][0], quads[f][2], quads[f][3] };
+    polys->InsertNextCell(3, t0);
+    polys->InsertNextCell(3, t1);
+  }
+  cube->SetPoints(points);
+  cube->SetPolys(polys);
+}
+
+void RandomPoint(double x[3], double min, double max)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = vtkMath::Random(min, max);
+  }
+}
+
+bool TestQueries(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(grid);
+  bvh->BuildLocator();
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(grid);
+  reference->BuildLocator();
+  if (bvh->GetNumberOfNodes() < 2)
+  {
+    cerr << "ERROR: Unexpected number of nodes " << bvh->GetNumberOfNodes() << endl;
+    return false;
+  }
+
+  vtkMath::RandomSeed(4242);
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(grid->GetMaxCellSize());
+  double x[3], pcoords[3], closest[3], refClosest[3], dist2, refDist2, t, hit[3];
+  int subId;
+  vtkIdType cellId, refCellId;
+
+  const int numQueries = 2000;
+  vtkNew<vtkDoubleArray> p1;
+  vtkNew<vtkDoubleArray> p2;
+  p1->SetNumberOfComponents(3);
+  p2->SetNumberOfComponents(3);
+  for (int q = 0; q < numQueries; ++q)
+  {
+    // Most queries in the region of small cells.
+    RandomPoint(x, -0.05, q % 4 ? 0.1 : 1.05);
+    // Points on a face shared by two cells may be found in either one.
+    cellId = bvh->FindCell(x, 0.0, cell, subId, pcoords, weights.data());
+    refCellId = reference->FindCell(x, 0.0, cell, subId, pcoords, weights.data());
+    if (cellId != refCellId && (cellId < 0 || refCellId < 0))
+    {
+      cerr << "ERROR: FindCell differs for query " << q << endl;
+      return false;
+    }
+
+    bvh->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    reference->FindClosestPoint(x, refClosest, cell, refCellId, subId, refDist2);
+    if (std::abs(dist2 - refDist2) > 1.0e-12)
+    {
+      cerr << "ERROR: FindClosestPoint differs for query " << q << ": " << dist2
+           << " != " << refDist2 << endl;
+      return false;
+    }
+
+    double y[3];
+    RandomPoint(y, -0.5, 1.5);
+    p1->InsertNextTuple(x);
+    p2->InsertNextTuple(y);
+
+    // The cells whose bounds the segment crosses, the only ones it may hit.
+    std::vector<vtkIdType> b;
+    double dir[3];
+    vtkMath::Subtract(y, x, dir);
+    for (vtkIdType id = 0; id < grid->GetNumberOfCells(); ++id)
+    {
+      double cellBounds[6], coord[3], tBox;
+      grid->GetCellBounds(id, cellBounds);
+      if (vtkBox::IntersectBox(cellBounds, x, dir, coord, tBox, 0.0))
+      {
+        b.push_back(id);
+      }
+    }
+
+    // vtkStaticCellLocator may return a hit that is not the first one, so the
+    // first hit is searched among the crossed cells.
+    const int found = bvh->IntersectWithLine(x, y, 0.0, t, hit, pcoords, subId, cellId, cell);
+    double firstT = VTK_DOUBLE_MAX;
+    for (vtkIdType id : b)
+    {
+      double cellT;
+      grid->GetCell(id, cell);
+      if (cell->IntersectWithLine(x, y, 0.0, cellT, hit, pcoords, subId) && cellT < firstT)
+      {
+        firstT = cellT;
+      }
+    }
+    const int firstFound = firstT != VTK_DOUBLE_MAX;
+    if (found != firstFound || (found && std::abs(t - firstT) > 1.0e-9))
+    {
+      cerr << "ERROR: IntersectWithLine differs for query " << q << endl;
+      return false;
+    }
+
+    // FindCellsAlongLine returns the cells whose bounds the segment crosses.
+    vtkNew<vtkIdList> cells;
+    bvh->FindCellsAlongLine(x, y, 0.0, cells);
+    std::vector<vtkIdType> a(cells->begin(), cells->end());
+    std::sort(a.begin(), a.end());
+    if (a != b)
+    {
+      cerr << "ERROR: FindCellsAlongLine differs for query " << q << endl;
+      return false;
+    }
+
+    double bbox[6] = { x[0], x[0] + 0.02, x[1], x[1] + 0.02, x[2], x[2] + 0.02 };
+    bvh->FindCellsWithinBounds(bbox, cells);
+    a.assign(cells->begin(), cells->end());
+    std::sort(a.begin(), a.end());
+    if (a.empty() && bvh->FindCell(x, 0.0, cell, subId, pcoords, weights.data()) >= 0)
+    {
+      cerr << "ERROR: FindCellsWithinBounds missed the cell containing query " << q << endl;
+      return false;
+    }
+    for (vtkIdType id : a)
+    {
+      double cellBounds[6];
+      grid->GetCellBounds(id, cellBounds);
+      if (cellBounds[0] > bbox[1] || cellBounds[1] < bbox[0] || cellBounds[2] > bbox[3] ||
+        cellBounds[3] < bbox[2] || cellBounds[4] > bbox[5] || cellBounds[5] < bbox[4])
+      {
+        cerr << "ERROR: FindCellsWithinBounds returned a cell outside the box." << endl;
+        return false;
+      }
+    }
+  }
+
+  // Batched queries traverse packets of rays and must match single queries.
+  vtkNew<vtkIdTypeArray> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  bvh->BatchIntersectWithLine(p1, p2, 0.0, cellIds, ts);
+  for (int q = 0; q < numQueries; ++q)
+  {
+    double a[3], b[3];
+    p1->GetTuple(q, a);
+    p2->GetTuple(q, b);
+    if (!bvh->IntersectWithLine(a, b, 0.0, t, hit, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellIds->GetValue(q) != cellId || (cellId >= 0 && ts->GetValue(q) != t))
+    {
+      cerr << "ERROR: BatchIntersectWithLine differs for query " << q << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestClosedSurface()
+{
+  vtkNew<vtkPolyData> cube;
+  MakeCube(cube);
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(cube);
+  bvh->BuildLocator();
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdList> cellIds;
+  const double inside[3] = { 0.3, 0.4, 0.6 };
+  const double outside[3] = { 2.0, 0.45, 0.55 };
+  const double farAway[3] = { 3.0, 0.45, 0.55 };
+  if (bvh->IntersectWithLine(inside, outside, points, cellIds) != -1 ||
+    points->GetNumberOfPoints() != 1 || std::abs(points->GetPoint(0)[0] - 1.0) > 1.0e-9)
+  {
+    cerr << "ERROR: Segment starting inside the cube not detected." << endl;
+    return false;
+  }
+  const double before[3] = { -1.0, 0.45, 0.55 };
+  if (bvh->IntersectWithLine(before, outside, points, cellIds) != 1 ||
+    points->GetNumberOfPoints() != 2 || cellIds->GetNumberOfIds() != 2)
+  {
+    cerr << "ERROR: Segment crossing the cube not detected." << endl;
+    return false;
+  }
+  // p2 does not need to be outside: the first hit enters the cube.
+  if (bvh->IntersectWithLine(before, inside, points, cellIds) != 1 ||
+    points->GetNumberOfPoints() != 1)
+  {
+    cerr << "ERROR: Segment ending inside the cube not classified." << endl;
+    return false;
+  }
+  // Along a face diagonal, the segment crosses edges shared by two triangles.
+  const double diagonalStart[3] = { -1.0, 0.5, 0.5 };
+  const double diagonalEnd[3] = { 2.0, 0.5, 0.5 };
+  if (bvh->IntersectWithLine(diagonalStart, diagonalEnd, points, cellIds) != 1 ||
+    points->GetNumberOfPoints() != 2)
+  {
+    cerr << "ERROR: Hits on shared edges are not merged." << endl;
+    return false;
+  }
+  if (bvh->IntersectWithLine(outside, farAway, points, cellIds) != 0)
+  {
+    cerr << "ERROR: Segment outside the cube intersects it." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  ::MakeGradedGrid(grid, 16);
+  if (!::TestQueries(grid) || !::TestClosedSurface())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -14,12 +14,14 @@
 #include "vtkNew.h"
 #include "vtkPolyData.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSetGet.h"
 #include "vtkSmartPointer.h"
 #include "vtkTypeInt32Array.h"
 #include "vtkTypeInt64Array.h"
 
 #include <algorithm>
+#include <atomic>
 #include <initializer_list>
 #include <stdexcept>
 #include <type_traits>
@@ -978,6 +980,234 @@ void TestAppend64(vtkSmartPointer<vtkCellArray> cellArray)
   TestAppendImpl(cellArray, NewCellArray(true));
 }
 
+vtkSmartPointer<vtkCellArray> NewFixedSizeCellArray(bool use64BitStorage, vtkIdType cellSize)
+{
+  auto cellArray = vtkSmartPointer<vtkCellArray>::New();
+  if (use64BitStorage)
+  {
+    cellArray->UseFixedSize64BitStorage(cellSize);
+  }
+  else
+  {
+    cellArray->UseFixedSize32BitStorage(cellSize);
+  }
+
+  TEST_ASSERT(cellArray->IsStorage64Bit() == use64BitStorage);
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+
+  return cellArray;
+}
+
+void ValidateTriangles(vtkCellArray* cellArray, vtkIdType numCells)
+{
+  TEST_ASSERT(cellArray->GetNumberOfCells() == numCells);
+  TEST_ASSERT(cellArray->GetNumberOfOffsets() == numCells + 1);
+  TEST_ASSERT(cellArray->GetNumberOfConnectivityIds() == 3 * numCells);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  auto it = vtk::TakeSmartPointer(cellArray->NewIterator());
+  for (it->GoToFirstCell(); !it->IsDoneWithTraversal(); it->GoToNextCell())
+  {
+    const vtkIdType cellId = it->GetCurrentCellId();
+    it->GetCurrentCell(npts, pts);
+    TEST_ASSERT(npts == 3);
+    TEST_ASSERT(pts[0] == cellId && pts[1] == cellId + 1 && pts[2] == cellId + 2);
+    TEST_ASSERT(cellArray->GetOffset(cellId) == 3 * cellId);
+    TEST_ASSERT(cellArray->GetCellSize(cellId) == 3);
+  }
+  TEST_ASSERT(it->GetCurrentCellId() == numCells);
+}
+
+struct TestDispatchImpl
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state) const
+  {
+    vtkIdType sum = 0;
+    for (vtkIdType cellId = 0; cellId < state.GetNumberOfCells(); ++cellId)
+    {
+      sum += state.GetCellSize(cellId) + state.GetBeginOffset(cellId);
+    }
+    return sum;
+  }
+};
+
+void TestFixedSizeStorage(vtkSmartPointer<vtkCellArray> cellArray)
+{
+  vtkLogScopeFunction(INFO);
+
+  const bool use64BitStorage = cellArray->IsStorage64Bit();
+  cellArray = NewFixedSizeCellArray(use64BitStorage, 3);
+  TEST_ASSERT(cellArray->GetNumberOfCells() == 0);
+  TEST_ASSERT(cellArray->IsHomogeneous() == 0);
+  TEST_ASSERT(cellArray->IsValid());
+
+  for (vtkIdType cellId = 0; cellId < 1000; ++cellId)
+  {
+    TEST_ASSERT(cellArray->InsertNextCell({ cellId, cellId + 1, cellId + 2 }) == cellId);
+  }
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  ValidateTriangles(cellArray, 1000);
+  TEST_ASSERT(cellArray->IsHomogeneous() == 3);
+  TEST_ASSERT(cellArray->GetMaxCellSize() == 3);
+  TEST_ASSERT(cellArray->IsValid());
+  TEST_ASSERT(cellArray->Dispatch(TestDispatchImpl{}) == 1000 * 3 + 3 * (999 * 1000) / 2);
+
+  // Same content as explicit storage, in less memory.
+  vtkNew<vtkCellArray> explicitCells;
+  explicitCells->DeepCopy(cellArray);
+  TEST_ASSERT(explicitCells->IsStorageFixedSize());
+  TEST_ASSERT(explicitCells->ConvertToExplicitStorage());
+  TEST_ASSERT(!explicitCells->IsStorageFixedSize());
+  ValidateTriangles(explicitCells, 1000);
+  TEST_ASSERT(explicitCells->IsValid());
+  cellArray->Squeeze();
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  TEST_ASSERT(cellArray->GetActualMemorySize() < explicitCells->GetActualMemorySize());
+  vtkNew<vtkIdTypeArray> legacy;
+  vtkNew<vtkIdTypeArray> explicitLegacy;
+  cellArray->ExportLegacyFormat(legacy);
+  explicitCells->ExportLegacyFormat(explicitLegacy);
+  TEST_ASSERT(std::equal(vtk::DataArrayValueRange<1>(legacy).begin(),
+    vtk::DataArrayValueRange<1>(legacy).end(),
+    vtk::DataArrayValueRange<1>(explicitLegacy).begin()));
+
+  // Legacy import of cells of the same size keeps the storage.
+  cellArray->ImportLegacyFormat(legacy);
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  ValidateTriangles(cellArray, 1000);
+
+  // Inserting a cell of another size switches to explicit offsets.
+  cellArray->InsertNextCell({ 5, 6, 7, 8 });
+  TEST_ASSERT(!cellArray->IsStorageFixedSize());
+  TEST_ASSERT(cellArray->IsStorage64Bit() == use64BitStorage);
+  TEST_ASSERT(cellArray->GetNumberOfCells() == 1001);
+  TEST_ASSERT(cellArray->GetCellSize(1000) == 4);
+  TEST_ASSERT(cellArray->GetOffset(1000) == 3000);
+  TEST_ASSERT(cellArray->IsHomogeneous() == -1);
+  TEST_ASSERT(!cellArray->ConvertToFixedSizeStorage());
+  TEST_ASSERT(cellArray->IsValid());
+
+  // As does the incremental API.
+  cellArray = NewFixedSizeCellArray(use64BitStorage, 2);
+  cellArray->InsertNextCell({ 0, 1 });
+  cellArray->InsertNextCell(2);
+  cellArray->InsertCellPoint(1);
+  cellArray->InsertCellPoint(2);
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  cellArray->InsertNextCell(2);
+  cellArray->InsertCellPoint(3);
+  cellArray->UpdateCellCount(1);
+  TEST_ASSERT(!cellArray->IsStorageFixedSize());
+  TEST_ASSERT(cellArray->GetNumberOfCells() == 3);
+  TEST_ASSERT(cellArray->GetCellSize(1) == 2 && cellArray->GetCellSize(2) == 1);
+  TEST_ASSERT(cellArray->IsValid());
+
+  cellArray = NewFixedSizeCellArray(use64BitStorage, 2);
+  cellArray->InsertNextCell({ 0, 1 });
+  cellArray->Initialize();
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  TEST_ASSERT(cellArray->GetNumberOfCells() == 0 && cellArray->IsValid());
+}
+
+void TestFixedSizeConversions(vtkSmartPointer<vtkCellArray> cellArray)
+{
+  vtkLogScopeFunction(INFO);
+
+  vtkNew<vtkIdTypeArray> conn;
+  for (vtkIdType cellId = 0; cellId < 10; ++cellId)
+  {
+    conn->InsertNextValue(cellId);
+    conn->InsertNextValue(cellId + 1);
+    conn->InsertNextValue(cellId + 2);
+  }
+  TEST_ASSERT(!cellArray->SetData(4, conn));
+
+  // SetData() keeps the storage mode.
+  TEST_ASSERT(cellArray->SetData(3, conn));
+  TEST_ASSERT(!cellArray->IsStorageFixedSize());
+  ValidateTriangles(cellArray, 10);
+  cellArray->UseFixedSizeDefaultStorage(3);
+  TEST_ASSERT(cellArray->SetData(3, conn));
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  ValidateTriangles(cellArray, 10);
+
+  // 32/64-bit conversions preserve fixed-size storage.
+  TEST_ASSERT(cellArray->ConvertTo32BitStorage());
+  TEST_ASSERT(cellArray->IsStorageFixedSize() && !cellArray->IsStorage64Bit());
+  ValidateTriangles(cellArray, 10);
+  TEST_ASSERT(cellArray->ConvertTo64BitStorage());
+  TEST_ASSERT(cellArray->IsStorageFixedSize() && cellArray->IsStorage64Bit());
+  ValidateTriangles(cellArray, 10);
+
+  // Copies.
+  vtkNew<vtkCellArray> copy;
+  copy->DeepCopy(cellArray);
+  TEST_ASSERT(copy->IsStorageFixedSize());
+  ValidateTriangles(copy, 10);
+  copy->ShallowCopy(cellArray);
+  TEST_ASSERT(copy->IsStorageFixedSize());
+  TEST_ASSERT(copy->GetConnectivityArray() == cellArray->GetConnectivityArray());
+  ValidateTriangles(copy, 10);
+  for (bool use64Bit : { true, false })
+  {
+    TEST_ASSERT(use64Bit ? cellArray->ConvertTo64BitStorage() : cellArray->ConvertTo32BitStorage());
+    vtkNew<vtkCellArray> shallowCopy;
+    shallowCopy->ShallowCopy(cellArray);
+    TEST_ASSERT(shallowCopy->IsStorageFixedSize());
+    TEST_ASSERT(shallowCopy->IsStorage64Bit() == use64Bit);
+    TEST_ASSERT(shallowCopy->GetConnectivityArray() == cellArray->GetConnectivityArray());
+    ValidateTriangles(shallowCopy, 10);
+  }
+
+  // Appending cells of the same size keeps the storage.
+  vtkNew<vtkCellArray> appended;
+  appended->UseFixedSizeDefaultStorage(3);
+  appended->Append(cellArray);
+  appended->Append(cellArray, 10);
+  TEST_ASSERT(appended->IsStorageFixedSize());
+  ValidateTriangles(appended, 20);
+  vtkNew<vtkCellArray> quads;
+  quads->InsertNextCell({ 0, 1, 2, 3 });
+  appended->Append(quads);
+  TEST_ASSERT(!appended->IsStorageFixedSize());
+  TEST_ASSERT(appended->GetNumberOfCells() == 21 && appended->GetCellSize(20) == 4);
+  TEST_ASSERT(appended->IsValid());
+
+  // Const Visit() never modifies the cell array, so it can run concurrently
+  // with the other const accessors.
+  const vtkCellArray* constCells = cellArray;
+  const vtkIdType expected = cellArray->Dispatch(TestDispatchImpl{});
+  std::atomic<bool> sameVisits(true);
+  vtkSMPTools::For(0, 100, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (constCells->Visit(TestDispatchImpl{}) != expected ||
+        constCells->GetCellSize(i % 10) != 3)
+      {
+        sameVisits = false;
+      }
+    }
+  });
+  TEST_ASSERT(sameVisits);
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+
+  // Non-const Visit() and the explicit offsets accessors convert the storage.
+  TEST_ASSERT(cellArray->Visit(TestDispatchImpl{}) == cellArray->Dispatch(TestDispatchImpl{}));
+  TEST_ASSERT(!cellArray->IsStorageFixedSize());
+  ValidateTriangles(cellArray, 10);
+  TEST_ASSERT(cellArray->ConvertToFixedSizeStorage());
+  TEST_ASSERT(cellArray->IsStorageFixedSize());
+  ValidateTriangles(cellArray, 10);
+  vtkDataArray* offsets = cellArray->GetOffsetsArray();
+  TEST_ASSERT(!cellArray->IsStorageFixedSize());
+  TEST_ASSERT(offsets->GetNumberOfValues() == 11);
+  for (vtkIdType cellId = 0; cellId <= 10; ++cellId)
+  {
+    TEST_ASSERT(offsets->GetComponent(cellId, 0) == 3 * cellId);
+  }
+}
+
 void TestLegacyFormatImportExportAppend(vtkSmartPointer<vtkCellArray> cellArray)
 {
   vtkLogScopeFunction(INFO);
@@ -1389,6 +1619,8 @@ void RunTests(bool use64BitStorage)
   TestAppend32(NewCellArray(use64BitStorage));
   TestAppend64(NewCellArray(use64BitStorage));
   TestLegacyFormatImportExportAppend(NewCellArray(use64BitStorage));
+  TestFixedSizeStorage(NewCellArray(use64BitStorage));
+  TestFixedSizeConversions(NewCellArray(use64BitStorage));
 
   RunLegacyTests(use64BitStorage);
 }
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkCellLinks built in parallel match a sequential build, and
+// the promotion of static links to editable links.
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+// A grid of n x n points with triangles, one line per row and one vertex per
+// point, so that the cell ids of the polydata span several cell arrays.
+void MakePolyData(vtkPolyData* pdata, int n)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const vtkIdType ptId = points->InsertNextPoint(i, j, 0.0);
+      verts->InsertNextCell(1, &ptId);
+      if (i < n - 1 && j < n - 1)
+      {
+        const vtkIdType t0[3] = { ptId, ptId + 1, ptId + n + 1 };
+        const vtkIdType t1[3] = { ptId, ptId + n + 1, ptId + n };
+        polys->InsertNextCell(3, t0);
+        polys->InsertNextCell(3, t1);
+      }
+    }
+    lines->InsertNextCell(n);
+    for (int i = 0; i < n; ++i)
+    {
+      lines->InsertCellPoint(j * n + i);
+    }
+  }
+  pdata->SetPoints(points);
+  pdata->SetVerts(verts);
+  pdata->SetLines(lines);
+  pdata->SetPolys(polys);
+}
+
+bool SameLinks(vtkCellLinks* a, vtkCellLinks* b, vtkIdType numPts)
+{
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (a->GetNcells(ptId) != b->GetNcells(ptId))
+    {
+      return false;
+    }
+    for (vtkIdType i = 0; i < a->GetNcells(ptId); ++i)
+    {
+      if (a->GetCells(ptId)[i] != b->GetCells(ptId)[i])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareBuilds(vtkDataSet* ds, const char* name)
+{
+  vtkNew<vtkCellLinks> sequential;
+  sequential->SetDataSet(ds);
+  sequential->SequentialProcessingOn();
+  sequential->BuildLinks();
+  vtkNew<vtkCellLinks> threaded;
+  threaded->SetDataSet(ds);
+  threaded->BuildLinks();
+  if (!::SameLinks(sequential, threaded, ds->GetNumberOfPoints()))
+  {
+    cerr << "ERROR: " << name << ": threaded links differ from sequential ones." << endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < ds->GetNumberOfPoints(); ++ptId)
+  {
+    for (vtkIdType i = 1; i < threaded->GetNcells(ptId); ++i)
+    {
+      if (threaded->GetCells(ptId)[i - 1] >= threaded->GetCells(ptId)[i])
+      {
+        cerr << "ERROR: " << name << ": cells of point " << ptId << " are not sorted." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestCellLinks(int, char*[])
+{
+  vtkNew<vtkPolyData> pdata;
+  ::MakePolyData(pdata, 60);
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 20, 20);
+  if (!::CompareBuilds(pdata, "polydata") || !::CompareBuilds(image, "image"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The first point is used by its vertex, the first line and two triangles.
+  pdata->BuildLinks();
+  vtkIdType ncells;
+  vtkIdType* cells;
+  pdata->GetPointCells(0, ncells, cells);
+  if (ncells != 4 || cells[0] != 0 || cells[1] != 3600)
+  {
+    cerr << "ERROR: Unexpected links of the first point." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Unstructured grid with static links, made editable afterwards.
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  ugrid->SetPoints(pdata->GetPoints());
+  ugrid->SetCells(VTK_TRIANGLE, pdata->GetPolys());
+  if (!::CompareBuilds(ugrid, "unstructured grid"))
+  {
+    return EXIT_FAILURE;
+  }
+  ugrid->BuildLinks();
+  if (!vtkStaticCellLinks::SafeDownCast(ugrid->GetCellLinks()))
+  {
+    cerr << "ERROR: Expected static links." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkCellLinks> reference;
+  reference->SetDataSet(ugrid);
+  reference->BuildLinks();
+
+  ugrid->EditableOn();
+  ugrid->BuildLinks();
+  auto promoted = vtkCellLinks::SafeDownCast(ugrid->GetCellLinks());
+  if (!promoted || !::SameLinks(reference, promoted, ugrid->GetNumberOfPoints()))
+  {
+    cerr << "ERROR: Static links were not promoted to editable links." << endl;
+    return EXIT_FAILURE;
+  }
+  ugrid->RemoveReferenceToCell(61, 0);
+  ugrid->GetPointCells(61, ncells, cells);
+  if (ncells != reference->GetNcells(61) - 1)
+  {
+    cerr << "ERROR: Promoted links cannot be edited." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // vtkPolyData::SetLinks() promotes static links as well.
+  vtkNew<vtkStaticCellLinks> staticLinks;
+  staticLinks->SetDataSet(pdata);
+  vtkNew<vtkPolyData> other;
+  other->ShallowCopy(pdata);
+  other->SetLinks(staticLinks);
+  auto otherLinks = vtkCellLinks::SafeDownCast(other->GetLinks());
+  vtkNew<vtkCellLinks> pdataReference;
+  pdataReference->SetDataSet(pdata);
+  pdataReference->BuildLinks();
+  if (!otherLinks || !::SameLinks(pdataReference, otherLinks, pdata->GetNumberOfPoints()))
+  {
+    cerr << "ERROR: vtkPolyData::SetLinks() did not promote static links." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
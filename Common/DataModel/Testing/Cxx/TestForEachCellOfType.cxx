@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks vtk::ForEachCellOfType() and vtk::ForEachCellOfTypes() on
+// unstructured grids and polydata against the vtkCell API, and reports the
+// time taken by the vtkCell API and by both visitors to compute the volume of
+// the tetrahedra of a grid.
+#include "vtkForEachCellOfType.h"
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTetra.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// A grid of n^3 voxels, each split in 5 tetrahedra, with one hexahedron
+// inserted every 10 cells to mix the cell types.
+void MakeGrid(vtkUnstructuredGrid* grid, int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(i, j + 0.1 * i, k + 0.05 * j * j);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->AllocateEstimate(5 * n * n * n, 4);
+  const auto id = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+  static const int tets[5][4] = { { 0, 1, 3, 4 }, { 1, 2, 3, 6 }, { 1, 4, 5, 6 }, { 3, 4, 6, 7 },
+    { 1, 3, 4, 6 } };
+  vtkIdType count = 0;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType hex[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        if (++count % 10 == 0)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          continue;
+        }
+        for (int t = 0; t < 5; ++t)
+        {
+          const vtkIdType tet[4] = { hex[tets[t][0]], hex[tets[t][1]], hex[tets[t][2]],
+            hex[tets[t][3]] };
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+      }
+    }
+  }
+}
+
+double TetraVolume(const double* x)
+{
+  double p[4][3];
+  std::copy(x, x + 12, &p[0][0]);
+  return vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3]);
+}
+}
+
+int TestForEachCellOfType(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  ::MakeGrid(grid, 60);
+  const vtkIdType numCells = grid->GetNumberOfCells();
+
+  // Reference through vtkGenericCell
+  vtkNew<vtkTimerLog> timer;
+  std::vector<double> expected(numCells, 0.0);
+  std::vector<int> expectedTypes(numCells, VTK_EMPTY_CELL);
+  vtkNew<vtkGenericCell> cell;
+  timer->StartTimer();
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    grid->GetCell(cellId, cell);
+    expectedTypes[cellId] = cell->GetCellType();
+    if (cell->GetCellType() == VTK_TETRA)
+    {
+      double x[12];
+      for (int i = 0; i < 4; ++i)
+      {
+        cell->GetPoints()->GetPoint(i, x + 3 * i);
+      }
+      expected[cellId] = ::TetraVolume(x);
+    }
+  }
+  timer->StopTimer();
+  const double cellTime = timer->GetElapsedTime();
+
+  // The visitor specialized for tetrahedra, then the one selecting the cell
+  // types at run time.
+  double visitorTimes[2];
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<double> volumes(numCells, 0.0);
+    timer->StartTimer();
+    if (pass == 0)
+    {
+      vtk::ForEachCellOfType<VTK_TETRA>(
+        grid.Get(), [&](vtkIdType cellId, vtkIdType npts, const vtkIdType*, const double* x) {
+          if (npts == 4)
+          {
+            volumes[cellId] = ::TetraVolume(x);
+          }
+        });
+    }
+    else
+    {
+      vtk::ForEachCellOfTypes(grid.Get(), { VTK_TETRA },
+        [&](vtkIdType cellId, int, vtkIdType npts, const vtkIdType*, const double* x) {
+          if (npts == 4)
+          {
+            volumes[cellId] = ::TetraVolume(x);
+          }
+        });
+    }
+    timer->StopTimer();
+    visitorTimes[pass] = timer->GetElapsedTime();
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      if (volumes[cellId] != expected[cellId])
+      {
+        std::cerr << "ERROR: Volume of cell " << cellId << " is " << volumes[cellId]
+                  << " instead of " << expected[cellId] << " in pass " << pass << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  std::cout << "Volume of " << numCells << " cells: " << cellTime << " s with vtkGenericCell, "
+            << visitorTimes[0] << " s with ForEachCellOfType (speedup "
+            << cellTime / std::max(visitorTimes[0], 1e-9) << "), " << visitorTimes[1]
+            << " s with ForEachCellOfTypes (speedup "
+            << cellTime / std::max(visitorTimes[1], 1e-9) << ")" << std::endl;
+
+  // Tetrahedra and hexahedra visited in a single pass
+  std::vector<int> types(numCells, VTK_EMPTY_CELL);
+  vtk::ForEachCellOfTypes(grid.Get(), { VTK_TETRA, VTK_HEXAHEDRON },
+    [&](vtkIdType cellId, int cellType, vtkIdType npts, const vtkIdType*, const double*) {
+      types[cellId] = npts == (cellType == VTK_TETRA ? 4 : 8) ? cellType : VTK_EMPTY_CELL;
+    });
+  if (types != expectedTypes)
+  {
+    std::cerr << "ERROR: Unexpected cells visited by ForEachCellOfTypes()." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Polydata with every type of cells, whose cells are built by the visitors
+  vtkNew<vtkPolyData> pdata;
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 10; ++i)
+  {
+    points->InsertNextPoint(i, i * i, 0.0);
+  }
+  pdata->SetPoints(points);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ 0 });
+  verts->InsertNextCell({ 1, 2 });
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 2, 3 });
+  vtkNew<vtkCellArray> polys;
+  polys->InsertNextCell({ 0, 1, 2 });
+  polys->InsertNextCell({ 0, 1, 2, 3, 4 });
+  polys->InsertNextCell({ 5, 6, 7 });
+  polys->InsertNextCell({ 3, 4, 5, 6 });
+  pdata->SetVerts(verts);
+  pdata->SetLines(lines);
+  pdata->SetPolys(polys);
+
+  std::vector<double> area(pdata->GetNumberOfCells(), 0.0);
+  vtk::ForEachCellOfType<VTK_TRIANGLE>(pdata.Get(),
+    [&](vtkIdType cellId, vtkIdType npts, const vtkIdType* pts, const double* x) {
+      double v0[3], v1[3], n[3];
+      vtkMath::Subtract(x + 3, x, v0);
+      vtkMath::Subtract(x + 6, x, v1);
+      vtkMath::Cross(v0, v1, n);
+      area[cellId] = npts == 3 && pts[2] == pts[0] + 2 ? 0.5 * vtkMath::Norm(n) : -1.0;
+    });
+  bool polyVertex = false;
+  vtk::ForEachCellOfType<VTK_POLY_VERTEX>(pdata.Get(),
+    [&](vtkIdType cellId, vtkIdType npts, const vtkIdType*, const double*) {
+      polyVertex = cellId == 1 && npts == 2;
+    });
+  if (area[0] != 0.0 || area[3] != 1.0 || area[4] != 0.0 || area[5] != 1.0 || area[6] != 0.0 ||
+    !polyVertex)
+  {
+    std::cerr << "ERROR: Unexpected polydata cells." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  pdata->DeleteCell(1);
+  bool deleted = true;
+  vtk::ForEachCellOfType<VTK_POLY_VERTEX>(
+    pdata.Get(), [&](vtkIdType, vtkIdType, const vtkIdType*, const double*) { deleted = false; });
+  if (!deleted)
+  {
+    std::cerr << "ERROR: A deleted cell was visited." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
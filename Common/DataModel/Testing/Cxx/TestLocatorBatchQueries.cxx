@@ -0,0 +1,243 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that the batched locator queries return the same results as the
+// per-query methods.
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+void RandomPoints(vtkDoubleArray* points, vtkIdType n, double min, double max)
+{
+  points->SetNumberOfComponents(3);
+  points->SetNumberOfTuples(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    points->SetTuple3(
+      i, vtkMath::Random(min, max), vtkMath::Random(min, max), vtkMath::Random(min, max));
+  }
+}
+
+// Compare the compressed row output of a batched query to per-query results.
+// The order of the points found within a radius is not specified, so both
+// lists are sorted before being compared.
+bool CheckRows(const std::vector<std::vector<vtkIdType>>& expected, vtkIdTypeArray* offsets,
+  vtkIdTypeArray* ids, vtkDoubleArray* distances2, vtkPoints* points, vtkDoubleArray* queries,
+  bool sort)
+{
+  if (offsets->GetNumberOfTuples() != static_cast<vtkIdType>(expected.size()) + 1 ||
+    ids->GetNumberOfTuples() != offsets->GetValue(offsets->GetNumberOfTuples() - 1) ||
+    distances2->GetNumberOfTuples() != ids->GetNumberOfTuples())
+  {
+    cerr << "ERROR: Unexpected batched output sizes." << endl;
+    return false;
+  }
+  for (size_t q = 0; q < expected.size(); ++q)
+  {
+    const vtkIdType begin = offsets->GetValue(q);
+    const vtkIdType end = offsets->GetValue(q + 1);
+    std::vector<vtkIdType> row(ids->GetPointer(begin), ids->GetPointer(0) + end);
+    std::vector<vtkIdType> reference = expected[q];
+    if (sort)
+    {
+      std::sort(row.begin(), row.end());
+      std::sort(reference.begin(), reference.end());
+    }
+    if (row != reference)
+    {
+      cerr << "ERROR: Batched query " << q << " returned different points." << endl;
+      return false;
+    }
+    double x[3];
+    queries->GetTuple(q, x);
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const double d2 = vtkMath::Distance2BetweenPoints(x, points->GetPoint(ids->GetValue(i)));
+      if (std::abs(d2 - distances2->GetValue(i)) > 1.0e-12)
+      {
+        cerr << "ERROR: Wrong distance for batched query " << q << "." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestPointLocator(vtkIdType numPoints, vtkIdType numQueries)
+{
+  vtkMath::RandomSeed(31415);
+  vtkNew<vtkDoubleArray> coordinates;
+  ::RandomPoints(coordinates, numPoints, -1.0, 1.0);
+  vtkNew<vtkPoints> points;
+  points->SetData(coordinates);
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkDoubleArray> queries;
+  ::RandomPoints(queries, numQueries, -1.0, 1.0);
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(polyData);
+  locator->BuildLocator();
+
+  vtkNew<vtkIdList> result;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkDoubleArray> distances2;
+
+  // Closest point.
+  std::vector<vtkIdType> closest(numQueries);
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    closest[q] = locator->FindClosestPoint(queries->GetTuple(q));
+  }
+  locator->BatchFindClosestPoint(queries, ids, distances2);
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    double x[3];
+    queries->GetTuple(q, x);
+    if (ids->GetValue(q) != closest[q] ||
+      std::abs(distances2->GetValue(q) -
+        vtkMath::Distance2BetweenPoints(x, points->GetPoint(closest[q]))) > 1.0e-12)
+    {
+      cerr << "ERROR: BatchFindClosestPoint differs for query " << q << "." << endl;
+      return false;
+    }
+  }
+
+  // Closest N points.
+  const int N = 10;
+  std::vector<std::vector<vtkIdType>> expected(numQueries);
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    locator->FindClosestNPoints(N, queries->GetTuple(q), result);
+    expected[q].assign(result->begin(), result->end());
+  }
+  locator->BatchFindClosestNPoints(N, queries, offsets, ids, distances2);
+  if (!::CheckRows(expected, offsets, ids, distances2, points, queries, false))
+  {
+    return false;
+  }
+
+  // Points within radius.
+  const double R = 0.05;
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    locator->FindPointsWithinRadius(R, queries->GetTuple(q), result);
+    expected[q].assign(result->begin(), result->end());
+  }
+  locator->BatchFindPointsWithinRadius(R, queries, offsets, ids, distances2);
+  return ::CheckRows(expected, offsets, ids, distances2, points, queries, true);
+}
+
+bool TestCellLocator(vtkIdType numQueries)
+{
+  // A tetrahedralized box, so that FindCell has to evaluate real cells.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(30, 30, 30);
+  image->SetSpacing(1.0 / 29, 1.0 / 29, 1.0 / 29);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    points->SetPoint(i, image->GetPoint(i));
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->Allocate(5 * image->GetNumberOfCells());
+  vtkNew<vtkIdList> voxel;
+  for (vtkIdType c = 0; c < image->GetNumberOfCells(); ++c)
+  {
+    image->GetCellPoints(c, voxel);
+    const vtkIdType* v = voxel->GetPointer(0);
+    const vtkIdType tets[5][4] = { { v[0], v[1], v[3], v[5] }, { v[0], v[3], v[2], v[6] },
+      { v[0], v[5], v[6], v[4] }, { v[3], v[5], v[7], v[6] }, { v[0], v[3], v[6], v[5] } };
+    for (int t = 0; t < 5; ++t)
+    {
+      grid->InsertNextCell(VTK_TETRA, 4, tets[t]);
+    }
+  }
+
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+
+  vtkMath::RandomSeed(27182);
+  vtkNew<vtkDoubleArray> queries;
+  ::RandomPoints(queries, numQueries, -0.1, 1.1);
+
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(grid->GetMaxCellSize());
+  std::vector<vtkIdType> expected(numQueries);
+  double x[3], pcoords[3];
+  int subId;
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    queries->GetTuple(q, x);
+    expected[q] = locator->FindCell(x, 0.0, cell, subId, pcoords, weights.data());
+  }
+  vtkNew<vtkIdTypeArray> cellIds;
+  vtkNew<vtkDoubleArray> batchPCoords;
+  locator->BatchFindCell(queries, 0.0, cellIds, batchPCoords);
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    if (cellIds->GetValue(q) != expected[q])
+    {
+      cerr << "ERROR: BatchFindCell differs for query " << q << "." << endl;
+      return false;
+    }
+  }
+
+  // Segments crossing the box.
+  vtkNew<vtkDoubleArray> p2;
+  ::RandomPoints(p2, numQueries, -0.1, 1.1);
+  double t, hit[3];
+  vtkIdType cellId;
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    double a[3], b[3];
+    queries->GetTuple(q, a);
+    p2->GetTuple(q, b);
+    cellId = -1;
+    if (!locator->IntersectWithLine(a, b, 0.0, t, hit, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    expected[q] = cellId;
+  }
+  vtkNew<vtkDoubleArray> batchT;
+  locator->BatchIntersectWithLine(queries, p2, 0.0, cellIds, batchT);
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    if (cellIds->GetValue(q) != expected[q])
+    {
+      cerr << "ERROR: BatchIntersectWithLine differs for query " << q << "." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestLocatorBatchQueries(int, char*[])
+{
+  if (!::TestPointLocator(100000, 20000) || !::TestCellLocator(20000))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
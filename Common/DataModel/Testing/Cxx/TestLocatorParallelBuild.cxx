@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkKdTree and vtkCellTreeLocator build the same trees with one
+// thread and with the default number of threads.
+#include "vtkCellArray.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkKdTree.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Small triangles clustered around a few centers, so that the trees are
+// unbalanced and the top levels hold many cells.
+void MakeTriangles(vtkPolyData* polyData, int numberOfTriangles)
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  const double centers[3][3] = { { 0.0, 0.0, 0.0 }, { 5.0, 1.0, 0.0 }, { 2.0, 8.0, 3.0 } };
+  for (int i = 0; i < numberOfTriangles; ++i)
+  {
+    const double* center = centers[i % 3];
+    const double scale = 0.1 + (i % 7);
+    vtkIdType ids[3];
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = center[j] + vtkMath::Gaussian(0.0, scale);
+    }
+    for (int v = 0; v < 3; ++v)
+    {
+      ids[v] = points->InsertNextPoint(x[0] + vtkMath::Random(-0.01, 0.01),
+        x[1] + vtkMath::Random(-0.01, 0.01), x[2] + vtkMath::Random(-0.01, 0.01));
+    }
+    polys->InsertNextCell(3, ids);
+  }
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+}
+
+bool SameKdTrees(vtkKdTree* a, vtkKdTree* b)
+{
+  if (a->GetNumberOfRegions() != b->GetNumberOfRegions() || a->GetLevel() != b->GetLevel())
+  {
+    return false;
+  }
+  for (int region = 0; region < a->GetNumberOfRegions(); ++region)
+  {
+    double aBounds[6], bBounds[6], aDataBounds[6], bDataBounds[6];
+    a->GetRegionBounds(region, aBounds);
+    b->GetRegionBounds(region, bBounds);
+    a->GetRegionDataBounds(region, aDataBounds);
+    b->GetRegionDataBounds(region, bDataBounds);
+    for (int i = 0; i < 6; ++i)
+    {
+      if (aBounds[i] != bBounds[i] || aDataBounds[i] != bDataBounds[i])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The boxes of the leaves of a cell tree, which are generated in the order of
+// the nodes.
+void GenerateLeafBoxes(vtkCellTreeLocator* locator, vtkPolyData* representation)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  representation->SetPoints(points);
+  representation->SetLines(lines);
+  locator->GenerateRepresentation(-1, representation);
+}
+
+bool SameCellTrees(vtkCellTreeLocator* a, vtkCellTreeLocator* b, vtkPolyData* polyData)
+{
+  vtkNew<vtkPolyData> aRepresentation;
+  vtkNew<vtkPolyData> bRepresentation;
+  ::GenerateLeafBoxes(a, aRepresentation);
+  ::GenerateLeafBoxes(b, bRepresentation);
+  const vtkIdType numberOfPoints = aRepresentation->GetNumberOfPoints();
+  if (numberOfPoints == 0 || numberOfPoints != bRepresentation->GetNumberOfPoints())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3], y[3];
+    aRepresentation->GetPoint(i, x);
+    bRepresentation->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      return false;
+    }
+  }
+
+  // The cells of the leaves are stored in the same order.
+  double bounds[6];
+  polyData->GetBounds(bounds);
+  vtkNew<vtkIdList> aCells;
+  vtkNew<vtkIdList> bCells;
+  for (int i = 0; i < 100; ++i)
+  {
+    double box[6];
+    for (int d = 0; d < 3; ++d)
+    {
+      box[2 * d] = vtkMath::Random(bounds[2 * d], bounds[2 * d + 1]);
+      box[2 * d + 1] = box[2 * d] + 0.05 * (bounds[2 * d + 1] - bounds[2 * d]);
+    }
+    a->FindCellsWithinBounds(box, aCells);
+    b->FindCellsWithinBounds(box, bCells);
+    if (aCells->GetNumberOfIds() != bCells->GetNumberOfIds() ||
+      !std::equal(aCells->begin(), aCells->end(), bCells->begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestLocatorParallelBuild(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  ::MakeTriangles(polyData, 60000);
+
+  vtkSmartPointer<vtkKdTree> kdTrees[2];
+  vtkSmartPointer<vtkCellTreeLocator> cellTrees[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    kdTrees[i] = vtkSmartPointer<vtkKdTree>::New();
+    kdTrees[i]->SetMinCells(4);
+    kdTrees[i]->SetDataSet(polyData);
+    cellTrees[i] = vtkSmartPointer<vtkCellTreeLocator>::New();
+    cellTrees[i]->SetDataSet(polyData);
+  }
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() {
+    kdTrees[0]->BuildLocator();
+    cellTrees[0]->BuildLocator();
+  });
+  kdTrees[1]->BuildLocator();
+  cellTrees[1]->BuildLocator();
+
+  if (!::SameKdTrees(kdTrees[0], kdTrees[1]))
+  {
+    cerr << "ERROR: vtkKdTree depends on the number of threads." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!::SameCellTrees(cellTrees[0], cellTrees[1], polyData))
+  {
+    cerr << "ERROR: vtkCellTreeLocator depends on the number of threads." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Trees built from points.
+  vtkNew<vtkKdTree> pointTrees[2];
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+    [&]() { pointTrees[0]->BuildLocatorFromPoints(polyData->GetPoints()); });
+  pointTrees[1]->BuildLocatorFromPoints(polyData->GetPoints());
+  if (!::SameKdTrees(pointTrees[0], pointTrees[1]))
+  {
+    cerr << "ERROR: vtkKdTree built from points depends on the number of threads." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
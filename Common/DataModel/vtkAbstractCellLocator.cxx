@@ -6,6 +6,7 @@
 #include "vtkCellArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -13,9 +14,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -258,6 +263,122 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::BatchFindCell(
+  vtkDataArray* queryPoints, double tol2, vtkIdTypeArray* cellIds, vtkDoubleArray* pcoords)
+{
+  if (!queryPoints || queryPoints->GetNumberOfComponents() != 3)
+  {
+    vtkErrorMacro("BatchFindCell requires a 3-component array of query points.");
+    return;
+  }
+  if (!this->DataSet)
+  {
+    vtkErrorMacro("BatchFindCell requires a dataset.");
+    return;
+  }
+  this->BuildLocator();
+  const int maxCellSize = std::max(this->DataSet->GetMaxCellSize(), 1);
+
+  const vtkIdType numQueries = queryPoints->GetNumberOfTuples();
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* pcoordsPtr = nullptr;
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+    pcoordsPtr = pcoords->GetPointer(0);
+  }
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<std::vector<double>> tlWeights;
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    std::vector<double>& weights = tlWeights.Local();
+    weights.resize(maxCellSize);
+    double x[3], pc[3];
+    int subId;
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      queryPoints->GetTuple(q, x);
+      cellIdsPtr[q] = this->FindCell(x, tol2, cell, subId, pc, weights.data());
+      if (pcoordsPtr)
+      {
+        std::copy(pc, pc + 3, pcoordsPtr + 3 * q);
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::BatchIntersectWithLine(vtkDataArray* p1, vtkDataArray* p2,
+  double tol, vtkIdTypeArray* cellIds, vtkDoubleArray* t, vtkDoubleArray* x)
+{
+  if (!p1 || !p2 || p1->GetNumberOfComponents() != 3 || p2->GetNumberOfComponents() != 3 ||
+    p1->GetNumberOfTuples() != p2->GetNumberOfTuples())
+  {
+    vtkErrorMacro("BatchIntersectWithLine requires two 3-component arrays of segment end points "
+                  "with the same number of tuples.");
+    return;
+  }
+  if (!this->DataSet)
+  {
+    vtkErrorMacro("BatchIntersectWithLine requires a dataset.");
+    return;
+  }
+  this->BuildLocator();
+
+  const vtkIdType numQueries = p1->GetNumberOfTuples();
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* tPtr = nullptr;
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numQueries);
+    tPtr = t->GetPointer(0);
+  }
+  double* xPtr = nullptr;
+  if (x)
+  {
+    x->SetNumberOfComponents(3);
+    x->SetNumberOfTuples(numQueries);
+    xPtr = x->GetPointer(0);
+  }
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    double a[3], b[3], hitX[3], pcoords[3], hitT;
+    int subId;
+    vtkIdType cellId;
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      p1->GetTuple(q, a);
+      p2->GetTuple(q, b);
+      cellId = -1;
+      hitT = 0.0;
+      hitX[0] = hitX[1] = hitX[2] = 0.0;
+      if (!this->IntersectWithLine(a, b, tol, hitT, hitX, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+      }
+      cellIdsPtr[q] = cellId;
+      if (tPtr)
+      {
+        tPtr[q] = hitT;
+      }
+      if (xPtr)
+      {
+        std::copy(hitX, hitX + 3, xPtr + 3 * q);
+      }
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
@@ -35,8 +35,11 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDataArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractCellLocator : public vtkLocator
@@ -305,6 +308,28 @@ public:
     double pcoords[3], double* weights);
   ///@}
 
+  /**
+   * Batched version of FindCell(). queryPoints is a 3-component array holding
+   * one position per tuple. cellIds receives the id of the cell containing
+   * each position, or -1, and pcoords, when given, the parametric coordinates
+   * of the position in that cell. The queries are executed in parallel using
+   * vtkSMPTools, after BuildLocator() has been called from the calling thread.
+   */
+  virtual void BatchFindCell(vtkDataArray* queryPoints, double tol2, vtkIdTypeArray* cellIds,
+    vtkDoubleArray* pcoords = nullptr);
+
+  /**
+   * Batched version of IntersectWithLine() returning the first intersection
+   * of every segment p1[i]-p2[i], where p1 and p2 are 3-component arrays with
+   * the same number of tuples. cellIds receives the id of the intersected
+   * cell, or -1 when the segment does not intersect any cell, t the parametric
+   * coordinate of the intersection along the segment and x its position. t
+   * and x are optional. The queries are executed in parallel using
+   * vtkSMPTools, after BuildLocator() has been called from the calling thread.
+   */
+  virtual void BatchIntersectWithLine(vtkDataArray* p1, vtkDataArray* p2, double tol,
+    vtkIdTypeArray* cellIds, vtkDoubleArray* t = nullptr, vtkDoubleArray* x = nullptr);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
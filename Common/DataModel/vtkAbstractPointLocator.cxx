@@ -2,11 +2,196 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkAbstractPointLocator.h"
 
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
-//------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Number of queries processed as a unit by the batched queries. The results
+// of a block are gathered before being copied to the output arrays.
+constexpr vtkIdType BatchBlockSize = 1024;
+
+//------------------------------------------------------------------------------
+// Fetch point coordinates, reading float and double points directly.
+struct PointCoordinates
+{
+  vtkDataSet* DataSet = nullptr;
+  const float* FloatPoints = nullptr;
+  const double* DoublePoints = nullptr;
+
+  explicit PointCoordinates(vtkDataSet* dataSet)
+    : DataSet(dataSet)
+  {
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataSet);
+    vtkDataArray* data =
+      pointSet && pointSet->GetPoints() ? pointSet->GetPoints()->GetData() : nullptr;
+    if (vtkFloatArray* floats = vtkFloatArray::FastDownCast(data))
+    {
+      this->FloatPoints = floats->GetPointer(0);
+    }
+    else if (vtkDoubleArray* doubles = vtkDoubleArray::FastDownCast(data))
+    {
+      this->DoublePoints = doubles->GetPointer(0);
+    }
+  }
+
+  // Compute the squared distances between x and the n given points. The
+  // coordinates are first gathered in structure-of-arrays form so that the
+  // distance loop vectorizes.
+  void Distances2(const double x[3], const vtkIdType* ids, vtkIdType n, double* distances2,
+    std::vector<double>& buffer) const
+  {
+    buffer.resize(3 * n);
+    double* xs = buffer.data();
+    double* ys = xs + n;
+    double* zs = ys + n;
+    if (this->FloatPoints)
+    {
+      for (vtkIdType i = 0; i < n; ++i)
+      {
+        const float* p = this->FloatPoints + 3 * ids[i];
+        xs[i] = p[0];
+        ys[i] = p[1];
+        zs[i] = p[2];
+      }
+    }
+    else if (this->DoublePoints)
+    {
+      for (vtkIdType i = 0; i < n; ++i)
+      {
+        const double* p = this->DoublePoints + 3 * ids[i];
+        xs[i] = p[0];
+        ys[i] = p[1];
+        zs[i] = p[2];
+      }
+    }
+    else
+    {
+      double p[3];
+      for (vtkIdType i = 0; i < n; ++i)
+      {
+        this->DataSet->GetPoint(ids[i], p);
+        xs[i] = p[0];
+        ys[i] = p[1];
+        zs[i] = p[2];
+      }
+    }
+    const double x0 = x[0];
+    const double x1 = x[1];
+    const double x2 = x[2];
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      const double dx = xs[i] - x0;
+      const double dy = ys[i] - x1;
+      const double dz = zs[i] - x2;
+      distances2[i] = dx * dx + dy * dy + dz * dz;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Run a query returning a list of points for every query position, and store
+// the results in compressed row layout.
+template <typename QueryFunctor>
+void RunBatchListQuery(vtkDataSet* dataSet, vtkDataArray* queryPoints, vtkIdTypeArray* offsets,
+  vtkIdTypeArray* ids, vtkDoubleArray* distances2, QueryFunctor query)
+{
+  struct Block
+  {
+    std::vector<vtkIdType> Ids;
+    std::vector<double> Distances2;
+  };
+
+  const vtkIdType numQueries = queryPoints->GetNumberOfTuples();
+  const vtkIdType numBlocks = (numQueries + BatchBlockSize - 1) / BatchBlockSize;
+  std::vector<Block> blocks(numBlocks);
+  PointCoordinates coordinates(dataSet);
+
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueries + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+
+  vtkSMPThreadLocalObject<vtkIdList> tlResult;
+  vtkSMPThreadLocal<std::vector<double>> tlBuffer;
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    vtkIdList* result = tlResult.Local();
+    std::vector<double>& buffer = tlBuffer.Local();
+    double x[3];
+    for (vtkIdType b = beginBlock; b < endBlock; ++b)
+    {
+      Block& block = blocks[b];
+      const vtkIdType endQuery = std::min(numQueries, (b + 1) * BatchBlockSize);
+      for (vtkIdType q = b * BatchBlockSize; q < endQuery; ++q)
+      {
+        queryPoints->GetTuple(q, x);
+        query(x, result);
+        const vtkIdType n = result->GetNumberOfIds();
+        const vtkIdType* found = result->GetPointer(0);
+        offsetsPtr[q + 1] = n;
+        if (n == 0)
+        {
+          continue;
+        }
+        block.Ids.insert(block.Ids.end(), found, found + n);
+        if (distances2)
+        {
+          block.Distances2.resize(block.Ids.size());
+          coordinates.Distances2(
+            x, found, n, block.Distances2.data() + block.Distances2.size() - n, buffer);
+        }
+      }
+    }
+  });
+
+  // Turn the per-query counts into offsets.
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    offsetsPtr[q + 1] += offsetsPtr[q];
+  }
+
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfTuples(offsetsPtr[numQueries]);
+  vtkIdType* idsPtr = ids->GetPointer(0);
+  double* distances2Ptr = nullptr;
+  if (distances2)
+  {
+    distances2->SetNumberOfComponents(1);
+    distances2->SetNumberOfTuples(offsetsPtr[numQueries]);
+    distances2Ptr = distances2->GetPointer(0);
+  }
+
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    for (vtkIdType b = beginBlock; b < endBlock; ++b)
+    {
+      Block& block = blocks[b];
+      const vtkIdType offset = offsetsPtr[b * BatchBlockSize];
+      std::copy(block.Ids.begin(), block.Ids.end(), idsPtr + offset);
+      if (distances2Ptr)
+      {
+        std::copy(block.Distances2.begin(), block.Distances2.end(), distances2Ptr + offset);
+      }
+      std::vector<vtkIdType>().swap(block.Ids);
+      std::vector<double>().swap(block.Distances2);
+    }
+  });
+}
+}
+
+//------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
 {
   for (int i = 0; i < 6; i++)
@@ -53,6 +238,102 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+bool vtkAbstractPointLocator::PrepareBatchQuery(vtkDataArray* queryPoints, bool needDistances)
+{
+  if (!queryPoints || queryPoints->GetNumberOfComponents() != 3)
+  {
+    vtkErrorMacro("Batched queries require a 3-component array of query points.");
+    return false;
+  }
+  if (needDistances && !this->DataSet)
+  {
+    vtkErrorMacro("Batched queries require a dataset to compute distances.");
+    return false;
+  }
+  // Locators initialized for point insertion have no dataset and are already
+  // built.
+  if (this->DataSet)
+  {
+    this->BuildLocator();
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindClosestPoint(
+  vtkDataArray* queryPoints, vtkIdTypeArray* closestIds, vtkDoubleArray* distances2)
+{
+  if (!this->PrepareBatchQuery(queryPoints, distances2 != nullptr))
+  {
+    return;
+  }
+
+  const vtkIdType numQueries = queryPoints->GetNumberOfTuples();
+  closestIds->SetNumberOfComponents(1);
+  closestIds->SetNumberOfTuples(numQueries);
+  vtkIdType* idsPtr = closestIds->GetPointer(0);
+  double* distances2Ptr = nullptr;
+  if (distances2)
+  {
+    distances2->SetNumberOfComponents(1);
+    distances2->SetNumberOfTuples(numQueries);
+    distances2Ptr = distances2->GetPointer(0);
+  }
+
+  PointCoordinates coordinates(this->DataSet);
+  vtkSMPThreadLocal<std::vector<double>> tlBuffer;
+  vtkSMPTools::For(0, numQueries, BatchBlockSize, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      queryPoints->GetTuple(q, x);
+      idsPtr[q] = this->FindClosestPoint(x);
+    }
+    if (!distances2Ptr)
+    {
+      return;
+    }
+    std::vector<double>& buffer = tlBuffer.Local();
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      if (idsPtr[q] < 0)
+      {
+        distances2Ptr[q] = VTK_DOUBLE_MAX;
+        continue;
+      }
+      queryPoints->GetTuple(q, x);
+      coordinates.Distances2(x, idsPtr + q, 1, distances2Ptr + q, buffer);
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindClosestNPoints(int N, vtkDataArray* queryPoints,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* distances2)
+{
+  if (!this->PrepareBatchQuery(queryPoints, distances2 != nullptr))
+  {
+    return;
+  }
+  ::RunBatchListQuery(this->DataSet, queryPoints, offsets, ids, distances2,
+    [this, N](const double x[3], vtkIdList* result) { this->FindClosestNPoints(N, x, result); });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindPointsWithinRadius(double R, vtkDataArray* queryPoints,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* distances2)
+{
+  if (!this->PrepareBatchQuery(queryPoints, distances2 != nullptr))
+  {
+    return;
+  }
+  ::RunBatchListQuery(this->DataSet, queryPoints, offsets, ids, distances2,
+    [this, R](const double x[3], vtkIdList* result) {
+      this->FindPointsWithinRadius(R, x, result);
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
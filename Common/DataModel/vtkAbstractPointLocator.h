@@ -22,7 +22,10 @@
 #include "vtkLocator.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -78,6 +81,30 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   ///@}
 
+  ///@{
+  /**
+   * Batched versions of FindClosestPoint(), FindClosestNPoints() and
+   * FindPointsWithinRadius(). queryPoints is a 3-component array holding one
+   * query position per tuple. The queries are executed in parallel using
+   * vtkSMPTools, after BuildLocator() has been called from the calling thread.
+   *
+   * BatchFindClosestPoint() stores the closest point id of each query in
+   * closestIds. The other methods store their results in a compressed row
+   * layout: offsets gets one more tuple than there are queries, and the ids
+   * found for query i are ids[offsets[i]] to ids[offsets[i+1]-1], in the
+   * order returned by the per-query method. When distances2 is given, it
+   * receives the squared distance of every returned point to its query
+   * position, with the same layout as the ids (VTK_DOUBLE_MAX when no point
+   * is found). Distances are only available when a dataset is set.
+   */
+  virtual void BatchFindClosestPoint(
+    vtkDataArray* queryPoints, vtkIdTypeArray* closestIds, vtkDoubleArray* distances2 = nullptr);
+  virtual void BatchFindClosestNPoints(int N, vtkDataArray* queryPoints, vtkIdTypeArray* offsets,
+    vtkIdTypeArray* ids, vtkDoubleArray* distances2 = nullptr);
+  virtual void BatchFindPointsWithinRadius(double R, vtkDataArray* queryPoints,
+    vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* distances2 = nullptr);
+  ///@}
+
   ///@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
@@ -98,6 +125,11 @@ protected:
   vtkAbstractPointLocator();
   ~vtkAbstractPointLocator() override;
 
+  /**
+   * Check the query points and build the locator before a batched query.
+   */
+  bool PrepareBatchQuery(vtkDataArray* queryPoints, bool needDistances);
+
   double Bounds[6];          // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
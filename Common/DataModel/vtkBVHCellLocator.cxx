@@ -0,0 +1,1442 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBVHCellLocator.h"
+
+#include "vtkBox.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+// Ranges of cells larger than this are split using parallel binning, smaller
+// ones are built serially, concurrently with each other. The value does not
+// depend on the number of threads so that the tree does not either.
+constexpr vtkIdType SerialBuildThreshold = 4096;
+
+// Cost of traversing a node relative to the cost of intersecting a cell,
+// used by the surface area heuristic.
+constexpr double TraversalCost = 0.5;
+
+// Number of rays traversed together by BatchIntersectWithLine().
+constexpr int PacketSize = 8;
+
+//------------------------------------------------------------------------------
+// Node of the binary tree built first.
+struct BinaryNode
+{
+  double Bounds[6];
+  vtkIdType Children[2] = { -1, -1 }; // -1 for leaves
+  vtkIdType Start = 0;                // first cell in the sorted cell ids
+  vtkIdType Count = 0;                // number of cells below this node
+  vtkIdType Subtree = -1;             // root of a serially built subtree, if any
+};
+
+//------------------------------------------------------------------------------
+// Node of the 4-wide tree used for queries. The child bounds are stored in
+// single precision, rounded outwards, in a structure of arrays layout.
+struct BVHNode
+{
+  float Min[3][4];
+  float Max[3][4];
+  // Index of the node of an inner child, offset of the cells of a leaf.
+  vtkIdType Index[4];
+  // Number of cells of a leaf, 0 for an inner child and -1 for an empty slot.
+  int Count[4];
+};
+
+//------------------------------------------------------------------------------
+void InitializeBounds(double bounds[6])
+{
+  bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+  bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+}
+
+void AddBounds(double bounds[6], const double other[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] = std::min(bounds[2 * i], other[2 * i]);
+    bounds[2 * i + 1] = std::max(bounds[2 * i + 1], other[2 * i + 1]);
+  }
+}
+
+void AddPoint(double bounds[6], const double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] = std::min(bounds[2 * i], x[i]);
+    bounds[2 * i + 1] = std::max(bounds[2 * i + 1], x[i]);
+  }
+}
+
+// Half of the surface area of a box.
+double HalfArea(const double bounds[6])
+{
+  const double dx = bounds[1] - bounds[0];
+  const double dy = bounds[3] - bounds[2];
+  const double dz = bounds[5] - bounds[4];
+  if (dx < 0.0 || dy < 0.0 || dz < 0.0)
+  {
+    return 0.0;
+  }
+  return dx * dy + dy * dz + dz * dx;
+}
+
+float RoundDown(double value)
+{
+  float f = static_cast<float>(value);
+  if (static_cast<double>(f) > value)
+  {
+    f = std::nextafter(f, -std::numeric_limits<float>::infinity());
+  }
+  return f;
+}
+
+float RoundUp(double value)
+{
+  float f = static_cast<float>(value);
+  if (static_cast<double>(f) < value)
+  {
+    f = std::nextafter(f, std::numeric_limits<float>::infinity());
+  }
+  return f;
+}
+
+//------------------------------------------------------------------------------
+// A segment p1 + t * (p2 - p1), t in [0, 1], and its closest intersection.
+struct BVHRay
+{
+  double P1[3];
+  double P2[3];
+  double InvDir[3];
+  double T = VTK_DOUBLE_MAX;
+  double X[3] = { 0.0, 0.0, 0.0 };
+  double PCoords[3] = { 0.0, 0.0, 0.0 };
+  int SubId = -1;
+  vtkIdType CellId = -1;
+
+  void Initialize(const double p1[3], const double p2[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->P1[i] = p1[i];
+      this->P2[i] = p2[i];
+      const double d = p2[i] - p1[i];
+      // A tiny direction component instead of zero keeps the slab test free
+      // of 0 * inf products.
+      this->InvDir[i] = 1.0 / (std::abs(d) > 1.0e-300 ? d : std::copysign(1.0e-300, d));
+    }
+  }
+
+  double TMax() const { return std::min(1.0, this->T); }
+};
+
+//------------------------------------------------------------------------------
+// Intersect a segment with the four child boxes of a node, padded by tol.
+// Return the mask of the children hit for t in [0, tMax], and their entry
+// parameters in tEntry.
+int IntersectChildren(
+  const BVHNode& node, const BVHRay& ray, double tol, double tMax, double tEntry[4])
+{
+  double tNear[4] = { 0.0, 0.0, 0.0, 0.0 };
+  double tFar[4] = { tMax, tMax, tMax, tMax };
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double origin = ray.P1[axis];
+    const double invDir = ray.InvDir[axis];
+    for (int i = 0; i < 4; ++i)
+    {
+      const double t0 = (node.Min[axis][i] - tol - origin) * invDir;
+      const double t1 = (node.Max[axis][i] + tol - origin) * invDir;
+      tNear[i] = std::max(tNear[i], std::min(t0, t1));
+      tFar[i] = std::min(tFar[i], std::max(t0, t1));
+    }
+  }
+  int mask = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    tEntry[i] = tNear[i];
+    mask |= (tNear[i] <= tFar[i] && node.Count[i] >= 0) ? (1 << i) : 0;
+  }
+  return mask;
+}
+
+// Scalar version of IntersectChildren() for the bounds of a cell.
+bool IntersectBounds(const double bounds[6], const BVHRay& ray, double tol, double tMax)
+{
+  double tNear = 0.0;
+  double tFar = tMax;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double t0 = (bounds[2 * axis] - tol - ray.P1[axis]) * ray.InvDir[axis];
+    const double t1 = (bounds[2 * axis + 1] + tol - ray.P1[axis]) * ray.InvDir[axis];
+    tNear = std::max(tNear, std::min(t0, t1));
+    tFar = std::min(tFar, std::max(t0, t1));
+  }
+  return tNear <= tFar;
+}
+
+// Squared distance between a point and the four child boxes of a node.
+void DistancesToChildren(const BVHNode& node, const double x[3], double distances2[4])
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    distances2[i] = 0.0;
+  }
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      const double d =
+        std::max(std::max(node.Min[axis][i] - x[axis], 0.0), x[axis] - node.Max[axis][i]);
+      distances2[i] += d * d;
+    }
+  }
+}
+
+double DistanceToBounds(const double bounds[6], const double x[3])
+{
+  double distance2 = 0.0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double d =
+      std::max(std::max(bounds[2 * axis] - x[axis], 0.0), x[axis] - bounds[2 * axis + 1]);
+    distance2 += d * d;
+  }
+  return distance2;
+}
+
+//------------------------------------------------------------------------------
+void AddBox(vtkPoints* points, vtkCellArray* lines, const double bounds[6])
+{
+  vtkIdType ids[8];
+  for (int i = 0; i < 8; ++i)
+  {
+    ids[i] = points->InsertNextPoint(
+      bounds[(i & 1) ? 1 : 0], bounds[(i & 2) ? 3 : 2], bounds[(i & 4) ? 5 : 4]);
+  }
+  static const int edges[12][2] = { { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 0, 2 }, { 1, 3 },
+    { 4, 6 }, { 5, 7 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+  for (int e = 0; e < 12; ++e)
+  {
+    vtkIdType line[2] = { ids[edges[e][0]], ids[edges[e][1]] };
+    lines->InsertNextCell(2, line);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Build the binary tree with the binned surface area heuristic.
+class BVHBuilder
+{
+public:
+  BVHBuilder(const double* cellBounds, vtkIdType numCells, int numBins, int maxLeafSize)
+    : CellBounds(cellBounds)
+    , NumberOfCells(numCells)
+    , NumberOfBins(numBins)
+    , MaxLeafSize(std::max(maxLeafSize, 1))
+    , Centroids(3 * numCells)
+    , CellIds(numCells)
+  {
+  }
+
+  // Build the tree, then flatten it into nodes.
+  void Build(std::vector<BVHNode>& nodes, double bounds[6])
+  {
+    vtkSMPTools::For(0, this->NumberOfCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const double* b = this->CellBounds + 6 * cellId;
+        for (int i = 0; i < 3; ++i)
+        {
+          this->Centroids[3 * cellId + i] = 0.5 * (b[2 * i] + b[2 * i + 1]);
+        }
+        this->CellIds[cellId] = cellId;
+      }
+    });
+
+    this->BuildTopLevels();
+
+    this->Subtrees.resize(this->Tasks.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Tasks.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType task = begin; task < end; ++task)
+        {
+          const BinaryNode& top = this->TopNodes[this->Tasks[task]];
+          this->BuildSubtree(top.Start, top.Count, this->Subtrees[task]);
+        }
+      });
+
+    NodeRef root{ -1, 0 };
+    std::copy_n(this->Resolve(root).Bounds, 6, bounds);
+    this->Collapse(nodes);
+  }
+
+  std::vector<vtkIdType>& GetCellIds() { return this->CellIds; }
+
+private:
+  struct Bin
+  {
+    double Bounds[6];
+    vtkIdType Count;
+  };
+
+  // Reference to a node of the top tree (Tree == -1) or of a subtree.
+  struct NodeRef
+  {
+    vtkIdType Tree;
+    vtkIdType Index;
+  };
+
+  struct Split
+  {
+    int Axis = -1;
+    int Bin = -1;
+    double Cost = VTK_DOUBLE_MAX;
+  };
+
+  //----------------------------------------------------------------------------
+  int BinOf(vtkIdType cellId, int axis, const double centroidBounds[6]) const
+  {
+    const double min = centroidBounds[2 * axis];
+    const double extent = centroidBounds[2 * axis + 1] - min;
+    const int bin =
+      static_cast<int>((this->Centroids[3 * cellId + axis] - min) * this->NumberOfBins / extent);
+    return std::min(std::max(bin, 0), this->NumberOfBins - 1);
+  }
+
+  //----------------------------------------------------------------------------
+  // Compute the bounds of a range of cells and of their centroids, and bin
+  // them along the three axes.
+  void BinRange(vtkIdType start, vtkIdType count, double bounds[6], double centroidBounds[6],
+    std::vector<Bin>& bins, bool parallel) const
+  {
+    auto computeBounds = [&](vtkIdType begin, vtkIdType end, double b[6], double cb[6]) {
+      ::InitializeBounds(b);
+      ::InitializeBounds(cb);
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType cellId = this->CellIds[i];
+        ::AddBounds(b, this->CellBounds + 6 * cellId);
+        ::AddPoint(cb, this->Centroids.data() + 3 * cellId);
+      }
+    };
+    auto binCells = [&](vtkIdType begin, vtkIdType end, std::vector<Bin>& b) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkIdType cellId = this->CellIds[i];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          if (centroidBounds[2 * axis + 1] > centroidBounds[2 * axis])
+          {
+            Bin& bin = b[axis * this->NumberOfBins + this->BinOf(cellId, axis, centroidBounds)];
+            ::AddBounds(bin.Bounds, this->CellBounds + 6 * cellId);
+            ++bin.Count;
+          }
+        }
+      }
+    };
+
+    bins.resize(3 * this->NumberOfBins);
+    for (Bin& bin : bins)
+    {
+      ::InitializeBounds(bin.Bounds);
+      bin.Count = 0;
+    }
+
+    if (!parallel)
+    {
+      computeBounds(start, start + count, bounds, centroidBounds);
+      binCells(start, start + count, bins);
+      return;
+    }
+
+    // Bounds and bin contents are reduced with min, max and sums, so the
+    // result does not depend on how the range is divided between threads.
+    using BoundsPair = std::array<double, 12>;
+    BoundsPair emptyBounds;
+    ::InitializeBounds(emptyBounds.data());
+    ::InitializeBounds(emptyBounds.data() + 6);
+    vtkSMPThreadLocal<BoundsPair> tlBounds(emptyBounds);
+    vtkSMPTools::For(start, start + count, [&](vtkIdType begin, vtkIdType end) {
+      BoundsPair local;
+      computeBounds(begin, end, local.data(), local.data() + 6);
+      BoundsPair& b = tlBounds.Local();
+      ::AddBounds(b.data(), local.data());
+      ::AddBounds(b.data() + 6, local.data() + 6);
+    });
+    ::InitializeBounds(bounds);
+    ::InitializeBounds(centroidBounds);
+    for (const BoundsPair& b : tlBounds)
+    {
+      ::AddBounds(bounds, b.data());
+      ::AddBounds(centroidBounds, b.data() + 6);
+    }
+
+    vtkSMPThreadLocal<std::vector<Bin>> tlBins(bins);
+    vtkSMPTools::For(start, start + count,
+      [&](vtkIdType begin, vtkIdType end) { binCells(begin, end, tlBins.Local()); });
+    for (const std::vector<Bin>& b : tlBins)
+    {
+      for (size_t i = 0; i < bins.size(); ++i)
+      {
+        ::AddBounds(bins[i].Bounds, b[i].Bounds);
+        bins[i].Count += b[i].Count;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Find the split with the lowest surface area heuristic cost, expressed
+  // relative to the cost of intersecting one cell.
+  Split FindSplit(const std::vector<Bin>& bins, const double bounds[6]) const
+  {
+    Split best;
+    const double area = ::HalfArea(bounds);
+    const int numBins = this->NumberOfBins;
+    std::vector<double> rightAreas(numBins);
+    std::vector<vtkIdType> rightCounts(numBins);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const Bin* axisBins = bins.data() + axis * numBins;
+      double rightBounds[6];
+      ::InitializeBounds(rightBounds);
+      vtkIdType rightCount = 0;
+      for (int b = numBins - 1; b > 0; --b)
+      {
+        ::AddBounds(rightBounds, axisBins[b].Bounds);
+        rightCount += axisBins[b].Count;
+        rightAreas[b] = ::HalfArea(rightBounds);
+        rightCounts[b] = rightCount;
+      }
+      double leftBounds[6];
+      ::InitializeBounds(leftBounds);
+      vtkIdType leftCount = 0;
+      for (int b = 1; b < numBins; ++b)
+      {
+        ::AddBounds(leftBounds, axisBins[b - 1].Bounds);
+        leftCount += axisBins[b - 1].Count;
+        if (leftCount == 0 || rightCounts[b] == 0)
+        {
+          continue;
+        }
+        const double cost = TraversalCost +
+          (area > 0.0 ? (::HalfArea(leftBounds) * leftCount + rightAreas[b] * rightCounts[b]) / area
+                      : static_cast<double>(leftCount + rightCounts[b]));
+        if (cost < best.Cost)
+        {
+          best.Cost = cost;
+          best.Axis = axis;
+          best.Bin = b;
+        }
+      }
+    }
+    return best;
+  }
+
+  //----------------------------------------------------------------------------
+  // Split a node, or decide that it is a leaf. Return the number of cells on
+  // the left, or 0 for a leaf.
+  vtkIdType SplitNode(BinaryNode& node, bool parallel)
+  {
+    double centroidBounds[6];
+    std::vector<Bin> bins;
+    this->BinRange(node.Start, node.Count, node.Bounds, centroidBounds, bins, parallel);
+    if (node.Count <= 1)
+    {
+      return 0;
+    }
+    const Split split = this->FindSplit(bins, node.Bounds);
+    const double leafCost = static_cast<double>(node.Count);
+    if (node.Count <= this->MaxLeafSize && (split.Axis < 0 || leafCost <= split.Cost))
+    {
+      return 0;
+    }
+
+    vtkIdType* first = this->CellIds.data() + node.Start;
+    vtkIdType* last = first + node.Count;
+    vtkIdType numLeft = 0;
+    if (split.Axis >= 0)
+    {
+      const int axis = split.Axis;
+      vtkIdType* middle = std::partition(first, last, [&](vtkIdType cellId) {
+        return this->BinOf(cellId, axis, centroidBounds) < split.Bin;
+      });
+      numLeft = middle - first;
+    }
+    if (numLeft == 0 || numLeft == node.Count)
+    {
+      // All the centroids are at the same position: split the range in two.
+      numLeft = node.Count / 2;
+    }
+    return numLeft;
+  }
+
+  //----------------------------------------------------------------------------
+  void BuildTopLevels()
+  {
+    BinaryNode root;
+    root.Start = 0;
+    root.Count = this->NumberOfCells;
+    this->TopNodes.push_back(root);
+    std::vector<vtkIdType> stack(1, 0);
+    while (!stack.empty())
+    {
+      const vtkIdType index = stack.back();
+      stack.pop_back();
+      if (this->TopNodes[index].Count <= SerialBuildThreshold)
+      {
+        this->TopNodes[index].Subtree = static_cast<vtkIdType>(this->Tasks.size());
+        this->Tasks.push_back(index);
+        continue;
+      }
+      const vtkIdType numLeft = this->SplitNode(this->TopNodes[index], true);
+      if (numLeft == 0)
+      {
+        continue;
+      }
+      BinaryNode left;
+      left.Start = this->TopNodes[index].Start;
+      left.Count = numLeft;
+      BinaryNode right;
+      right.Start = left.Start + numLeft;
+      right.Count = this->TopNodes[index].Count - numLeft;
+      const vtkIdType leftIndex = static_cast<vtkIdType>(this->TopNodes.size());
+      this->TopNodes[index].Children[0] = leftIndex;
+      this->TopNodes[index].Children[1] = leftIndex + 1;
+      this->TopNodes.push_back(left);
+      this->TopNodes.push_back(right);
+      stack.push_back(leftIndex + 1);
+      stack.push_back(leftIndex);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void BuildSubtree(vtkIdType start, vtkIdType count, std::vector<BinaryNode>& nodes)
+  {
+    BinaryNode root;
+    root.Start = start;
+    root.Count = count;
+    nodes.push_back(root);
+    std::vector<vtkIdType> stack(1, 0);
+    while (!stack.empty())
+    {
+      const vtkIdType index = stack.back();
+      stack.pop_back();
+      const vtkIdType numLeft = this->SplitNode(nodes[index], false);
+      if (numLeft == 0)
+      {
+        continue;
+      }
+      BinaryNode left;
+      left.Start = nodes[index].Start;
+      left.Count = numLeft;
+      BinaryNode right;
+      right.Start = left.Start + numLeft;
+      right.Count = nodes[index].Count - numLeft;
+      const vtkIdType leftIndex = static_cast<vtkIdType>(nodes.size());
+      nodes[index].Children[0] = leftIndex;
+      nodes[index].Children[1] = leftIndex + 1;
+      nodes.push_back(left);
+      nodes.push_back(right);
+      stack.push_back(leftIndex + 1);
+      stack.push_back(leftIndex);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Return the node referenced, following top nodes to the root of their
+  // subtree.
+  const BinaryNode& Resolve(NodeRef& ref) const
+  {
+    if (ref.Tree < 0 && this->TopNodes[ref.Index].Subtree >= 0)
+    {
+      ref.Tree = this->TopNodes[ref.Index].Subtree;
+      ref.Index = 0;
+    }
+    return ref.Tree < 0 ? this->TopNodes[ref.Index] : this->Subtrees[ref.Tree][ref.Index];
+  }
+
+  //----------------------------------------------------------------------------
+  // Collapse the binary tree into a 4-wide tree. Each inner binary node
+  // adopts the children of its largest inner children until it has four.
+  void Collapse(std::vector<BVHNode>& nodes) const
+  {
+    struct WorkItem
+    {
+      NodeRef Ref;
+      vtkIdType Node;
+    };
+
+    nodes.clear();
+    nodes.emplace_back();
+    std::vector<WorkItem> stack;
+    stack.push_back(WorkItem{ NodeRef{ -1, 0 }, 0 });
+    while (!stack.empty())
+    {
+      WorkItem item = stack.back();
+      stack.pop_back();
+
+      std::vector<NodeRef> children;
+      const BinaryNode& parent = this->Resolve(item.Ref);
+      if (parent.Children[0] < 0)
+      {
+        // Only the root may be a leaf.
+        children.push_back(item.Ref);
+      }
+      else
+      {
+        children.push_back(NodeRef{ item.Ref.Tree, parent.Children[0] });
+        children.push_back(NodeRef{ item.Ref.Tree, parent.Children[1] });
+      }
+      while (children.size() < 4)
+      {
+        int largest = -1;
+        double largestArea = -1.0;
+        for (size_t c = 0; c < children.size(); ++c)
+        {
+          const BinaryNode& child = this->Resolve(children[c]);
+          if (child.Children[0] >= 0 && ::HalfArea(child.Bounds) > largestArea)
+          {
+            largestArea = ::HalfArea(child.Bounds);
+            largest = static_cast<int>(c);
+          }
+        }
+        if (largest < 0)
+        {
+          break;
+        }
+        NodeRef ref = children[largest];
+        const BinaryNode& child = this->Resolve(ref);
+        children[largest] = NodeRef{ ref.Tree, child.Children[0] };
+        children.push_back(NodeRef{ ref.Tree, child.Children[1] });
+      }
+
+      for (int slot = 0; slot < 4; ++slot)
+      {
+        BVHNode& node = nodes[item.Node];
+        if (slot >= static_cast<int>(children.size()))
+        {
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            node.Min[axis][slot] = 0.0f;
+            node.Max[axis][slot] = 0.0f;
+          }
+          node.Index[slot] = 0;
+          node.Count[slot] = -1;
+          continue;
+        }
+        NodeRef ref = children[slot];
+        const BinaryNode& child = this->Resolve(ref);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          node.Min[axis][slot] = ::RoundDown(child.Bounds[2 * axis]);
+          node.Max[axis][slot] = ::RoundUp(child.Bounds[2 * axis + 1]);
+        }
+        if (child.Children[0] < 0)
+        {
+          node.Index[slot] = child.Start;
+          node.Count[slot] = static_cast<int>(child.Count);
+        }
+        else
+        {
+          const vtkIdType childNode = static_cast<vtkIdType>(nodes.size());
+          node.Index[slot] = childNode;
+          node.Count[slot] = 0;
+          // node is invalidated by the insertion.
+          nodes.emplace_back();
+          stack.push_back(WorkItem{ ref, childNode });
+        }
+      }
+    }
+  }
+
+  const double* CellBounds;
+  vtkIdType NumberOfCells;
+  int NumberOfBins;
+  vtkIdType MaxLeafSize;
+  std::vector<double> Centroids;
+  std::vector<vtkIdType> CellIds;
+  std::vector<BinaryNode> TopNodes;
+  std::vector<vtkIdType> Tasks;
+  std::vector<std::vector<BinaryNode>> Subtrees;
+};
+
+//------------------------------------------------------------------------------
+struct IntersectionInfo
+{
+  vtkIdType CellId;
+  double X[3];
+  double T;
+};
+}
+
+//------------------------------------------------------------------------------
+struct vtkBVHCellLocator::vtkInternals
+{
+  std::vector<BVHNode> Nodes;
+  std::vector<vtkIdType> CellIds;
+  double Bounds[6];
+
+  //----------------------------------------------------------------------------
+  // Find the closest intersection of each ray of a packet. A node is visited
+  // once for all the rays of the packet that may intersect it.
+  void IntersectPacket(
+    vtkBVHCellLocator* self, BVHRay* rays, int numRays, double tol, vtkGenericCell* cell) const
+  {
+    struct StackEntry
+    {
+      vtkIdType Node;
+      int RayMask;
+    };
+
+    vtkDataSet* dataSet = self->DataSet;
+    const double* cellBounds = self->CellBounds;
+    double t, x[3], pcoords[3];
+    int subId;
+
+    std::vector<StackEntry> stack;
+    stack.reserve(64);
+    stack.push_back(StackEntry{ 0, (1 << numRays) - 1 });
+    while (!stack.empty())
+    {
+      const StackEntry entry = stack.back();
+      stack.pop_back();
+      const BVHNode& node = this->Nodes[entry.Node];
+
+      int childMasks[4] = { 0, 0, 0, 0 };
+      double childEntry[4] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+      for (int r = 0; r < numRays; ++r)
+      {
+        if (!(entry.RayMask & (1 << r)))
+        {
+          continue;
+        }
+        double tEntry[4];
+        const int hits = ::IntersectChildren(node, rays[r], tol, rays[r].TMax(), tEntry);
+        for (int c = 0; c < 4; ++c)
+        {
+          if (hits & (1 << c))
+          {
+            childMasks[c] |= 1 << r;
+            childEntry[c] = std::min(childEntry[c], tEntry[c]);
+          }
+        }
+      }
+
+      // Visit the children from the nearest to the farthest: leaves now,
+      // inner nodes by pushing them in reverse order.
+      int order[4] = { 0, 1, 2, 3 };
+      std::sort(order, order + 4, [&](int a, int b) { return childEntry[a] < childEntry[b]; });
+      int numInner = 0;
+      int inner[4];
+      for (int k = 0; k < 4; ++k)
+      {
+        const int c = order[k];
+        if (!childMasks[c])
+        {
+          continue;
+        }
+        if (node.Count[c] == 0)
+        {
+          inner[numInner++] = c;
+          continue;
+        }
+        for (vtkIdType i = node.Index[c]; i < node.Index[c] + node.Count[c]; ++i)
+        {
+          const vtkIdType cellId = this->CellIds[i];
+          bool cellLoaded = false;
+          for (int r = 0; r < numRays; ++r)
+          {
+            BVHRay& ray = rays[r];
+            if (!(childMasks[c] & (1 << r)) ||
+              (cellBounds && !::IntersectBounds(cellBounds + 6 * cellId, ray, tol, ray.TMax())))
+            {
+              continue;
+            }
+            if (!cellLoaded)
+            {
+              dataSet->GetCell(cellId, cell);
+              cellLoaded = true;
+            }
+            // Hits at the same parameter, e.g. on a shared face, keep the
+            // smallest cell id whatever the traversal order of the packet.
+            if (cell->IntersectWithLine(ray.P1, ray.P2, tol, t, x, pcoords, subId) &&
+              (t < ray.T || (t == ray.T && cellId < ray.CellId)))
+            {
+              ray.T = t;
+              std::copy_n(x, 3, ray.X);
+              std::copy_n(pcoords, 3, ray.PCoords);
+              ray.SubId = subId;
+              ray.CellId = cellId;
+            }
+          }
+        }
+      }
+      for (int k = numInner - 1; k >= 0; --k)
+      {
+        stack.push_back(StackEntry{ node.Index[inner[k]], childMasks[inner[k]] });
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Collect all the intersections of a segment, or all the cells whose bounds
+  // it intersects when cell is nullptr.
+  void IntersectAll(vtkBVHCellLocator* self, const BVHRay& ray, double tol, vtkGenericCell* cell,
+    std::vector<IntersectionInfo>& intersections) const
+  {
+    vtkDataSet* dataSet = self->DataSet;
+    double rayDir[3];
+    vtkMath::Subtract(ray.P2, ray.P1, rayDir);
+    double cellBounds[6], *cellBoundsPtr;
+    double t, x[3], pcoords[3];
+    int subId;
+
+    std::vector<vtkIdType> stack(1, 0);
+    while (!stack.empty())
+    {
+      const BVHNode& node = this->Nodes[stack.back()];
+      stack.pop_back();
+      double tEntry[4];
+      const int hits = ::IntersectChildren(node, ray, tol, 1.0, tEntry);
+      for (int c = 0; c < 4; ++c)
+      {
+        if (!(hits & (1 << c)))
+        {
+          continue;
+        }
+        if (node.Count[c] == 0)
+        {
+          stack.push_back(node.Index[c]);
+          continue;
+        }
+        for (vtkIdType i = node.Index[c]; i < node.Index[c] + node.Count[c]; ++i)
+        {
+          const vtkIdType cellId = this->CellIds[i];
+          cellBoundsPtr = cellBounds;
+          self->GetCellBounds(cellId, cellBoundsPtr);
+          double hitPosition[3], tHit;
+          if (!vtkBox::IntersectBox(cellBoundsPtr, ray.P1, rayDir, hitPosition, tHit, tol))
+          {
+            continue;
+          }
+          if (cell)
+          {
+            dataSet->GetCell(cellId, cell);
+            if (cell->IntersectWithLine(ray.P1, ray.P2, tol, t, x, pcoords, subId))
+            {
+              intersections.push_back(IntersectionInfo{ cellId, { x[0], x[1], x[2] }, t });
+            }
+          }
+          else
+          {
+            intersections.push_back(IntersectionInfo{
+              cellId, { hitPosition[0], hitPosition[1], hitPosition[2] }, tHit });
+          }
+        }
+      }
+    }
+    std::sort(intersections.begin(), intersections.end(),
+      [](const IntersectionInfo& a, const IntersectionInfo& b) { return a.T < b.T; });
+  }
+};
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+  this->FreeCellBounds();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  this->Tree.reset();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // don't rebuild if build time is newer than modified and dataset modified time
+  if (this->Tree && this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime())
+  {
+    return;
+  }
+  // don't rebuild if UseExistingSearchStructure is ON and a search structure already exists
+  if (this->Tree && this->UseExistingSearchStructure)
+  {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+  }
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ForceBuildLocator()
+{
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorInternal()
+{
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< " No Cells in the data set\n");
+    return;
+  }
+  this->FreeSearchStructure();
+  this->ComputeCellBounds();
+
+  // The builder needs the bounds of all the cells, compute them when they
+  // are not cached.
+  std::vector<double> localBounds;
+  const double* cellBounds = this->CellBounds;
+  if (!cellBounds)
+  {
+    localBounds.resize(6 * numCells);
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellBounds().
+    this->DataSet->GetCellBounds(0, localBounds.data());
+    vtkSMPTools::For(1, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->DataSet->GetCellBounds(cellId, localBounds.data() + 6 * cellId);
+      }
+    });
+    cellBounds = localBounds.data();
+  }
+
+  auto tree = std::make_shared<vtkInternals>();
+  BVHBuilder builder(cellBounds, numCells, this->NumberOfBins, this->NumberOfCellsPerNode);
+  builder.Build(tree->Nodes, tree->Bounds);
+  tree->CellIds.swap(builder.GetCellIds());
+  this->Tree = tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  cellId = -1;
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  BVHRay ray;
+  ray.Initialize(p1, p2);
+  this->Tree->IntersectPacket(this, &ray, 1, tol, cell);
+  if (ray.CellId < 0)
+  {
+    return 0;
+  }
+  // Leave the intersected cell in the generic cell.
+  this->DataSet->GetCell(ray.CellId, cell);
+  t = ray.T;
+  std::copy_n(ray.X, 3, x);
+  std::copy_n(ray.PCoords, 3, pcoords);
+  subId = ray.SubId;
+  cellId = ray.CellId;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  if (points)
+  {
+    points->Reset();
+  }
+  if (cellIds)
+  {
+    cellIds->Reset();
+  }
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  BVHRay ray;
+  ray.Initialize(p1, p2);
+  std::vector<IntersectionInfo> intersections;
+  this->Tree->IntersectAll(this, ray, tol, cell, intersections);
+  if (intersections.empty())
+  {
+    return 0;
+  }
+  const vtkIdType numIntersections = static_cast<vtkIdType>(intersections.size());
+  if (points)
+  {
+    points->SetNumberOfPoints(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      points->SetPoint(i, intersections[i].X);
+    }
+  }
+  if (cellIds)
+  {
+    cellIds->SetNumberOfIds(numIntersections);
+    for (vtkIdType i = 0; i < numIntersections; ++i)
+    {
+      cellIds->SetId(i, intersections[i].CellId);
+    }
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(
+  const double p1[3], const double p2[3], vtkPoints* points, vtkIdList* cellIds)
+{
+  this->BuildLocator();
+  if (points)
+  {
+    points->Reset();
+  }
+  if (cellIds)
+  {
+    cellIds->Reset();
+  }
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  BVHRay ray;
+  ray.Initialize(p1, p2);
+  std::vector<IntersectionInfo> intersections;
+  vtkNew<vtkGenericCell> cell;
+  this->Tree->IntersectAll(this, ray, 0.0, cell, intersections);
+
+  // Merge the hits found at the same position on several cells.
+  const double epsilon = 1.0e-10;
+  vtkIdType numIntersections = 0;
+  for (const IntersectionInfo& hit : intersections)
+  {
+    if (numIntersections > 0 && hit.T - intersections[numIntersections - 1].T <= epsilon)
+    {
+      continue;
+    }
+    intersections[numIntersections++] = hit;
+  }
+  if (numIntersections == 0)
+  {
+    return 0;
+  }
+  for (vtkIdType i = 0; i < numIntersections; ++i)
+  {
+    if (points)
+    {
+      points->InsertNextPoint(intersections[i].X);
+    }
+    if (cellIds)
+    {
+      cellIds->InsertNextId(intersections[i].CellId);
+    }
+  }
+  // As vtkOBBTree does, the sense of the first intersection tells whether p1
+  // is inside: the segment enters the surface where it runs against the
+  // normal of the cell hit. Cells without a normal fall back to the parity of
+  // the number of intersections, which assumes that p2 is outside.
+  this->DataSet->GetCell(intersections[0].CellId, cell);
+  if (cell->GetCellDimension() == 2)
+  {
+    double normal[3];
+    vtkPolygon::ComputeNormal(cell->GetPoints(), normal);
+    const double direction[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+    const double dot = vtkMath::Dot(normal, direction);
+    if (dot != 0.0)
+    {
+      return dot < 0.0 ? 1 : -1;
+    }
+  }
+  return (numIntersections % 2) ? -1 : 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  this->BuildLocator();
+  cells->Reset();
+  if (!this->Tree)
+  {
+    return;
+  }
+  double cellBounds[6], *cellBoundsPtr;
+  const std::vector<BVHNode>& nodes = this->Tree->Nodes;
+  std::vector<vtkIdType> stack(1, 0);
+  while (!stack.empty())
+  {
+    const BVHNode& node = nodes[stack.back()];
+    stack.pop_back();
+    for (int c = 0; c < 4; ++c)
+    {
+      if (node.Count[c] < 0 || node.Min[0][c] > bbox[1] || node.Max[0][c] < bbox[0] ||
+        node.Min[1][c] > bbox[3] || node.Max[1][c] < bbox[2] || node.Min[2][c] > bbox[5] ||
+        node.Max[2][c] < bbox[4])
+      {
+        continue;
+      }
+      if (node.Count[c] == 0)
+      {
+        stack.push_back(node.Index[c]);
+        continue;
+      }
+      for (vtkIdType i = node.Index[c]; i < node.Index[c] + node.Count[c]; ++i)
+      {
+        const vtkIdType cellId = this->Tree->CellIds[i];
+        cellBoundsPtr = cellBounds;
+        this->GetCellBounds(cellId, cellBoundsPtr);
+        if (cellBoundsPtr[0] <= bbox[1] && cellBoundsPtr[1] >= bbox[0] &&
+          cellBoundsPtr[2] <= bbox[3] && cellBoundsPtr[3] >= bbox[2] &&
+          cellBoundsPtr[4] <= bbox[5] && cellBoundsPtr[5] >= bbox[4])
+        {
+          cells->InsertNextId(cellId);
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double x[3], double, vtkGenericCell* cell, int& subId, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  if (!this->Tree || !this->IsInBounds(this->Tree->Bounds, x))
+  {
+    return -1;
+  }
+  double dist2;
+  const std::vector<BVHNode>& nodes = this->Tree->Nodes;
+  std::vector<vtkIdType> stack(1, 0);
+  while (!stack.empty())
+  {
+    const BVHNode& node = nodes[stack.back()];
+    stack.pop_back();
+    for (int c = 0; c < 4; ++c)
+    {
+      if (node.Count[c] < 0 || x[0] < node.Min[0][c] || x[0] > node.Max[0][c] ||
+        x[1] < node.Min[1][c] || x[1] > node.Max[1][c] || x[2] < node.Min[2][c] ||
+        x[2] > node.Max[2][c])
+      {
+        continue;
+      }
+      if (node.Count[c] == 0)
+      {
+        stack.push_back(node.Index[c]);
+        continue;
+      }
+      for (vtkIdType i = node.Index[c]; i < node.Index[c] + node.Count[c]; ++i)
+      {
+        const vtkIdType cellId = this->Tree->CellIds[i];
+        if (this->InsideCellBounds(x, cellId))
+        {
+          this->DataSet->GetCell(cellId, cell);
+          if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) == 1)
+          {
+            return cellId;
+          }
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+  int& inside)
+{
+  this->BuildLocator();
+  cellId = -1;
+  subId = -1;
+  dist2 = VTK_DOUBLE_MAX;
+  inside = 0;
+  if (!this->Tree)
+  {
+    return 0;
+  }
+
+  // Inner nodes and leaves waiting to be visited. Child is -1 for an inner
+  // node, or the slot of a leaf in the node Node.
+  struct QueueEntry
+  {
+    vtkIdType Node;
+    int Child;
+    double Distance2;
+    bool operator<(const QueueEntry& other) const { return this->Distance2 > other.Distance2; }
+  };
+
+  // Inner nodes and leaves are visited closest first from a heap, and the
+  // search stops once a cell closer than the remaining ones has been found.
+  double bestDist2 = radius * radius;
+  double cellBounds[6], *cellBoundsPtr;
+  double point[3], pcoords[3], d2;
+  int cellSubId;
+  std::vector<double> weights;
+  const std::vector<BVHNode>& nodes = this->Tree->Nodes;
+  std::vector<QueueEntry> queue(1, QueueEntry{ 0, -1, 0.0 });
+  while (!queue.empty() && queue.front().Distance2 <= bestDist2)
+  {
+    std::pop_heap(queue.begin(), queue.end());
+    const QueueEntry entry = queue.back();
+    queue.pop_back();
+    const BVHNode& node = nodes[entry.Node];
+    if (entry.Child < 0)
+    {
+      double distances2[4];
+      ::DistancesToChildren(node, x, distances2);
+      for (int c = 0; c < 4; ++c)
+      {
+        if (node.Count[c] < 0 || distances2[c] > bestDist2)
+        {
+          continue;
+        }
+        if (node.Count[c] == 0)
+        {
+          queue.push_back(QueueEntry{ node.Index[c], -1, distances2[c] });
+        }
+        else
+        {
+          queue.push_back(QueueEntry{ entry.Node, c, distances2[c] });
+        }
+        std::push_heap(queue.begin(), queue.end());
+      }
+      continue;
+    }
+    const int c = entry.Child;
+    for (vtkIdType i = node.Index[c]; i < node.Index[c] + node.Count[c]; ++i)
+    {
+      const vtkIdType id = this->Tree->CellIds[i];
+      cellBoundsPtr = cellBounds;
+      this->GetCellBounds(id, cellBoundsPtr);
+      if (::DistanceToBounds(cellBoundsPtr, x) > bestDist2)
+      {
+        continue;
+      }
+      this->DataSet->GetCell(id, cell);
+      weights.resize(std::max<vtkIdType>(cell->GetNumberOfPoints(), 1));
+      const int result = cell->EvaluatePosition(x, point, cellSubId, pcoords, d2, weights.data());
+      if (result != -1 && (cellId < 0 ? d2 <= bestDist2 : d2 < bestDist2))
+      {
+        bestDist2 = d2;
+        cellId = id;
+        subId = cellSubId;
+        inside = result;
+        std::copy_n(point, 3, closestPoint);
+      }
+    }
+  }
+  if (cellId < 0)
+  {
+    return 0;
+  }
+  // Leave the closest cell in the generic cell.
+  this->DataSet->GetCell(cellId, cell);
+  dist2 = bestDist2;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BatchIntersectWithLine(vtkDataArray* p1, vtkDataArray* p2, double tol,
+  vtkIdTypeArray* cellIds, vtkDoubleArray* t, vtkDoubleArray* x)
+{
+  if (!p1 || !p2 || p1->GetNumberOfComponents() != 3 || p2->GetNumberOfComponents() != 3 ||
+    p1->GetNumberOfTuples() != p2->GetNumberOfTuples())
+  {
+    vtkErrorMacro("BatchIntersectWithLine requires two 3-component arrays of segment end points "
+                  "with the same number of tuples.");
+    return;
+  }
+  if (!this->DataSet)
+  {
+    vtkErrorMacro("BatchIntersectWithLine requires a dataset.");
+    return;
+  }
+  this->BuildLocator();
+
+  const vtkIdType numQueries = p1->GetNumberOfTuples();
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numQueries);
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* tPtr = nullptr;
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numQueries);
+    tPtr = t->GetPointer(0);
+  }
+  double* xPtr = nullptr;
+  if (x)
+  {
+    x->SetNumberOfComponents(3);
+    x->SetNumberOfTuples(numQueries);
+    xPtr = x->GetPointer(0);
+  }
+  std::shared_ptr<vtkInternals> tree = this->Tree;
+
+  const vtkIdType numPackets = (numQueries + PacketSize - 1) / PacketSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPTools::For(0, numPackets, [&](vtkIdType beginPacket, vtkIdType endPacket) {
+    vtkGenericCell* cell = tlCell.Local();
+    BVHRay rays[PacketSize];
+    double a[3], b[3];
+    for (vtkIdType packet = beginPacket; packet < endPacket; ++packet)
+    {
+      const vtkIdType first = packet * PacketSize;
+      const int numRays = static_cast<int>(std::min<vtkIdType>(PacketSize, numQueries - first));
+      for (int r = 0; r < numRays; ++r)
+      {
+        p1->GetTuple(first + r, a);
+        p2->GetTuple(first + r, b);
+        rays[r] = BVHRay();
+        rays[r].Initialize(a, b);
+      }
+      if (tree)
+      {
+        tree->IntersectPacket(this, rays, numRays, tol, cell);
+      }
+      for (int r = 0; r < numRays; ++r)
+      {
+        const BVHRay& ray = rays[r];
+        cellIdsPtr[first + r] = ray.CellId;
+        if (tPtr)
+        {
+          tPtr[first + r] = ray.CellId < 0 ? 0.0 : ray.T;
+        }
+        if (xPtr)
+        {
+          std::copy_n(ray.X, 3, xPtr + 3 * (first + r));
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return;
+  }
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  struct StackEntry
+  {
+    vtkIdType Node;
+    int Level;
+  };
+  const std::vector<BVHNode>& nodes = this->Tree->Nodes;
+  std::vector<StackEntry> stack(1, StackEntry{ 0, 1 });
+  if (level == 0)
+  {
+    ::AddBox(points, lines, this->Tree->Bounds);
+    stack.clear();
+  }
+  while (!stack.empty())
+  {
+    const StackEntry entry = stack.back();
+    stack.pop_back();
+    const BVHNode& node = nodes[entry.Node];
+    for (int c = 0; c < 4; ++c)
+    {
+      if (node.Count[c] < 0)
+      {
+        continue;
+      }
+      // Level -1 shows the leaves, other levels show the boxes at that depth.
+      const bool isLeaf = node.Count[c] > 0;
+      if ((level < 0 && isLeaf) || entry.Level == level)
+      {
+        const double bounds[6] = { node.Min[0][c], node.Max[0][c], node.Min[1][c],
+          node.Max[1][c], node.Min[2][c], node.Max[2][c] };
+        ::AddBox(points, lines, bounds);
+      }
+      else if (!isLeaf && (level < 0 || entry.Level < level))
+      {
+        stack.push_back(StackEntry{ node.Index[c], entry.Level + 1 });
+      }
+    }
+  }
+  pd->SetPoints(points);
+  pd->SetLines(lines);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ShallowCopy(vtkAbstractCellLocator* locator)
+{
+  vtkBVHCellLocator* cellLocator = vtkBVHCellLocator::SafeDownCast(locator);
+  if (!cellLocator)
+  {
+    vtkErrorMacro("Cannot cast " << locator->GetClassName() << " to vtkBVHCellLocator.");
+    return;
+  }
+  // we only copy what's actually used by vtkBVHCellLocator
+
+  // vtkLocator parameters
+  this->SetDataSet(cellLocator->GetDataSet());
+  this->SetUseExistingSearchStructure(cellLocator->GetUseExistingSearchStructure());
+
+  // vtkAbstractCellLocator parameters
+  this->SetNumberOfCellsPerNode(cellLocator->GetNumberOfCellsPerNode());
+  this->CacheCellBounds = cellLocator->CacheCellBounds;
+  this->CellBoundsSharedPtr = cellLocator->CellBoundsSharedPtr; // This is important
+  this->CellBounds = this->CellBoundsSharedPtr.get() ? this->CellBoundsSharedPtr->data() : nullptr;
+
+  // vtkBVHCellLocator parameters
+  this->NumberOfBins = cellLocator->NumberOfBins;
+  this->Tree = cellLocator->Tree;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfBins: " << this->NumberOfBins << "\n";
+  os << indent << "NumberOfNodes: " << this->GetNumberOfNodes() << "\n";
+}
+VTK_ABI_NAMESPACE_END
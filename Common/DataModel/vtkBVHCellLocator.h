@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator organizes the cells of a dataset in a bounding volume
+ * hierarchy (BVH) built with the binned surface area heuristic (SAH). Unlike
+ * the uniform binning of vtkStaticCellLocator and vtkCellLocator, or the
+ * median splits of vtkCellTreeLocator, the SAH adapts the tree to the
+ * distribution of the cells, which keeps ray queries efficient on highly
+ * non-uniform meshes such as CAD surfaces with small details in large
+ * empty regions.
+ *
+ * The hierarchy is first built as a binary tree. The upper levels are split
+ * using parallel binning, then the subtrees below a fixed size are built
+ * concurrently using vtkSMPTools. The resulting tree does not depend on the
+ * number of threads. It is then collapsed into a 4-wide tree whose nodes
+ * store the bounds of their four children in single precision, in a
+ * structure of arrays layout, so that a ray is tested against the four child
+ * boxes at once in a loop the compiler vectorizes. Bounds are rounded
+ * outwards so that the tree stays conservative.
+ *
+ * IntersectWithLine(), FindCellsAlongLine(), FindCell(),
+ * FindClosestPointWithinRadius() and FindCellsWithinBounds() are
+ * supported, so that the locator can be used with vtkCellPicker and in place
+ * of vtkModifiedBSPTree or vtkOBBTree for line intersection.
+ * BatchIntersectWithLine() traverses the tree with packets of consecutive
+ * rays, sharing node visits between the rays of a packet.
+ *
+ * vtkBVHCellLocator utilizes the following parent class parameters:
+ * - NumberOfCellsPerNode        (default 8, maximum number of cells in a leaf)
+ * - CacheCellBounds             (default true)
+ * - UseExistingSearchStructure  (default false)
+ *
+ * vtkBVHCellLocator does NOT utilize the following parameters:
+ * - Automatic
+ * - Level
+ * - MaxLevel
+ * - Tolerance
+ * - RetainCellLists
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkCellTreeLocator vtkStaticCellLocator vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+#include <memory> // For std::shared_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  ///@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of bins used to evaluate the surface area heuristic
+   * along each axis when splitting a node. More bins give better trees at a
+   * higher build cost. Default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins, int, 2, 256);
+  vtkGetMacro(NumberOfBins, int);
+  ///@}
+
+  /**
+   * Return the number of nodes of the 4-wide tree. Valid after the locator
+   * is built.
+   */
+  vtkIdType GetNumberOfNodes();
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+  using vtkAbstractCellLocator::IntersectWithLine;
+
+  /**
+   * Return the closest intersection point (if any) AND the cell which was
+   * intersected by the finite line. The cell is returned as a cell id and as
+   * a generic cell. When several cells are hit at the closest point, e.g. on
+   * a shared face, the one with the smallest id is returned.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * The return value of the function is 0 if no intersections were found.
+   * For each intersection with the bounds of a cell or with a cell (if a cell is provided),
+   * the points and cellIds have the relevant information added sorted by t.
+   * If points or cellIds are nullptr pointers, then no information is generated for that list.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
+    vtkIdList* cellIds, vtkGenericCell* cell) override;
+
+  /**
+   * vtkOBBTree compatible intersection, assuming that the dataset is a
+   * closed surface. Return 0 if the segment does not intersect the surface,
+   * -1 if p1 lies inside the surface and +1 if it lies outside. As in
+   * vtkOBBTree, this is decided from the normal of the first cell hit, so the
+   * surface must be consistently oriented with outward normals; when that
+   * cell has no normal, p2 is assumed to lie outside and the parity of the
+   * number of intersections is used. Intersections are sorted along the
+   * segment; hits at the same position along the segment, e.g. on an edge
+   * shared by two cells, are reported once.
+   */
+  int IntersectWithLine(
+    const double p1[3], const double p2[3], vtkPoints* points, vtkIdList* cellIds) override;
+
+  /**
+   * Take the passed line segment and intersect it with the data set.
+   * For each intersection with the bounds of a cell, the cellIds
+   * have the relevant information added sort by t. If cellIds is nullptr
+   * pointer, then no information is generated for that list.
+   *
+   * Reimplemented from vtkAbstractCellLocator to showcase that it's a supported function.
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cellsIds) override
+  {
+    this->Superclass::FindCellsAlongLine(p1, p2, tolerance, cellsIds);
+  }
+
+  /**
+   * Return a list of unique cell ids inside of a given bounding box. The
+   * user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Find the cell containing a given point. returns -1 if no cell found
+   * the cell parameters are copied into the supplied variables, a cell must
+   * be provided to store the information.
+   */
+  vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
+    double pcoords[3], double* weights) override;
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius, 0 otherwise. If a closest
+   * point is found, inside returns the return value of the EvaluatePosition
+   * call to the closest cell; inside(=1) or outside(=0).
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Batched version of IntersectWithLine() returning the closest
+   * intersection of every segment. Consecutive segments are traversed
+   * together in packets of 8, which is most efficient when consecutive
+   * segments are close to each other, e.g. rays cast through neighboring
+   * pixels. See vtkAbstractCellLocator::BatchIntersectWithLine().
+   */
+  void BatchIntersectWithLine(vtkDataArray* p1, vtkDataArray* p2, double tol,
+    vtkIdTypeArray* cellIds, vtkDoubleArray* t = nullptr, vtkDoubleArray* x = nullptr) override;
+
+  ///@{
+  /**
+   * Satisfy vtkLocator abstract interface.
+   */
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  void ForceBuildLocator() override;
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  ///@}
+
+  /**
+   * Shallow copy of a vtkBVHCellLocator. The tree is shared.
+   */
+  void ShallowCopy(vtkAbstractCellLocator* locator) override;
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  void BuildLocatorInternal() override;
+
+  int NumberOfBins = 16;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+
+  struct vtkInternals;
+  std::shared_ptr<vtkInternals> Tree;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
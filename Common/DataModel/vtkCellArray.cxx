@@ -155,6 +155,13 @@ struct InitializeImpl
     cells.GetOffsets()->Initialize();
     cells.GetOffsets()->InsertNextValue(0);
   }
+
+  template <typename ArrayT>
+  void operator()(vtkCellArray::FixedSizeVisitState<ArrayT>& cells) const
+  {
+    cells.GetConnectivity()->Initialize();
+    cells.SetNumberOfCells(0);
+  }
 };
 
 struct SqueezeImpl
@@ -303,6 +310,12 @@ struct IsHomogeneousImpl
 
     return firstCellSize;
   }
+
+  template <typename ArrayT>
+  vtkIdType operator()(vtkCellArray::FixedSizeVisitState<ArrayT>& state) const
+  {
+    return state.GetNumberOfCells() > 0 ? state.GetFixedCellSize() : 0;
+  }
 };
 
 struct AllocateExactImpl
@@ -319,6 +332,13 @@ struct AllocateExactImpl
 
     return result;
   }
+
+  template <typename ArrayT>
+  bool operator()(vtkCellArray::FixedSizeVisitState<ArrayT>& cells, vtkIdType vtkNotUsed(numCells),
+    vtkIdType connectivitySize) const
+  {
+    return cells.GetConnectivity()->Allocate(connectivitySize) && cells.SetNumberOfCells(0);
+  }
 };
 
 struct ResizeExactImpl
@@ -329,6 +349,14 @@ struct ResizeExactImpl
     return (cells.GetOffsets()->SetNumberOfValues(numCells + 1) &&
       cells.GetConnectivity()->SetNumberOfValues(connectivitySize));
   }
+
+  template <typename ArrayT>
+  bool operator()(vtkCellArray::FixedSizeVisitState<ArrayT>& cells, vtkIdType numCells,
+    vtkIdType connectivitySize) const
+  {
+    return (cells.SetNumberOfCells(numCells) &&
+      cells.GetConnectivity()->SetNumberOfValues(connectivitySize));
+  }
 };
 
 struct FindMaxCell // SMP functor
@@ -361,7 +389,7 @@ struct FindMaxCell // SMP functor
   void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
     vtkIdType& lval = this->LocalResult.Local();
-    lval = std::max(lval, this->CellArray->Visit(Impl{}, cellId, endCellId));
+    lval = std::max(lval, this->CellArray->Dispatch(Impl{}, cellId, endCellId));
   }
 
   void Reduce()
@@ -381,6 +409,16 @@ struct GetActualMemorySizeImpl
     return (
       cells.GetOffsets()->GetActualMemorySize() + cells.GetConnectivity()->GetActualMemorySize());
   }
+
+  // The implicit offsets would report the size of their explicit counterpart,
+  // while they only hold the slope and intercept of their backend.
+  template <typename ArrayT>
+  unsigned long operator()(const vtkCellArray::FixedSizeVisitState<ArrayT>& cells) const
+  {
+    using BackendType = vtkAffineImplicitBackend<typename ArrayT::ValueType>;
+    const unsigned long offsetsSize = (sizeof(BackendType) + 1023) / 1024;
+    return offsetsSize + cells.GetConnectivity()->GetActualMemorySize();
+  }
 };
 
 struct PrintSelfImpl
@@ -467,15 +505,70 @@ struct AppendLegacyFormatImpl
       }
     }
   }
+
+  // All cells are known to have the fixed size.
+  template <typename ArrayT>
+  void operator()(vtkCellArray::FixedSizeVisitState<ArrayT>& cells, const vtkIdType* data,
+    const vtkIdType len, const vtkIdType ptOffset) const
+  {
+    using ValueType = typename ArrayT::ValueType;
+
+    const vtkIdType cellSize = cells.GetFixedCellSize();
+    const vtkIdType numCells = len / (cellSize + 1);
+    auto* conn = cells.GetConnectivity();
+    const vtkIdType connBegin = conn->GetNumberOfValues();
+    conn->SetNumberOfValues(connBegin + numCells * cellSize);
+    ValueType* connPtr = conn->GetPointer(connBegin);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      ++data;
+      for (vtkIdType i = 0; i < cellSize; ++i)
+      {
+        *connPtr++ = static_cast<ValueType>(*data++ + ptOffset);
+      }
+    }
+    cells.SetNumberOfCells(cells.GetNumberOfCells() + numCells);
+  }
 };
 
+// Check that all cells of a legacy cell array have the given size.
+bool LegacyFormatHasCellSize(const vtkIdType* data, vtkIdType len, vtkIdType cellSize)
+{
+  const vtkIdType* const dataEnd = data + len;
+  while (data < dataEnd)
+  {
+    if (*data != cellSize)
+    {
+      return false;
+    }
+    data += cellSize + 1;
+  }
+  return true;
+}
+
+// Fill explicit offsets for cells of a fixed size.
+template <typename ArrayT>
+void FillFixedSizeOffsets(ArrayT* offsets, vtkIdType numCells, vtkIdType cellSize)
+{
+  using ValueType = typename ArrayT::ValueType;
+
+  offsets->SetNumberOfValues(numCells + 1);
+  ValueType* offsetsPtr = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numCells + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      offsetsPtr[cellId] = static_cast<ValueType>(cellId * cellSize);
+    }
+  });
+}
+
 struct AppendImpl
 {
   // Call this signature:
   template <typename DstCellStateT>
   void operator()(DstCellStateT& dstcells, vtkCellArray* src, vtkIdType pointOffset) const
   { // dispatch on src:
-    src->Visit(*this, dstcells, pointOffset);
+    src->Dispatch(*this, dstcells, pointOffset);
   }
 
   // Above signature calls this operator in Visit:
@@ -487,6 +580,15 @@ struct AppendImpl
     this->AppendArrayWithOffset(src.GetConnectivity(), dst.GetConnectivity(), pointOffsets, false);
   }
 
+  // The source cells are known to have the fixed size of the destination.
+  template <typename SrcCellStateT, typename ArrayT>
+  void operator()(SrcCellStateT& src, vtkCellArray::FixedSizeVisitState<ArrayT>& dst,
+    vtkIdType pointOffsets) const
+  {
+    this->AppendArrayWithOffset(src.GetConnectivity(), dst.GetConnectivity(), pointOffsets, false);
+    dst.SetNumberOfCells(dst.GetNumberOfCells() + src.GetNumberOfCells());
+  }
+
   // Assumes both arrays are 1 component. src's data is appended to dst with
   // offset added to each value.
   template <typename SrcArrayT, typename DstArrayT>
@@ -540,7 +642,7 @@ vtkIdType vtkCellArray::GetSize()
 vtkIdType vtkCellArray::GetNumberOfConnectivityEntries()
 {
   // We can still compute roughly the same result, so go ahead and do that.
-  return this->Visit(GetLegacyDataSizeImpl{});
+  return this->Dispatch(GetLegacyDataSizeImpl{});
 }
 
 //------------------------------------------------------------------------------
@@ -671,7 +773,28 @@ void vtkCellArray::DeepCopy(vtkCellArray* ca)
     return;
   }
 
-  if (ca->Storage.Is64Bit())
+  if (ca->Storage.IsFixedSize())
+  {
+    const vtkIdType cellSize = ca->Storage.GetFixedCellSize();
+    if (ca->Storage.Is64Bit())
+    {
+      this->Storage.UseFixedSize64BitStorage(cellSize);
+      auto& srcStorage = ca->Storage.GetFixedSizeArrays64();
+      auto& dstStorage = this->Storage.GetFixedSizeArrays64();
+      dstStorage.SetNumberOfCells(srcStorage.GetNumberOfCells());
+      dstStorage.Connectivity->DeepCopy(srcStorage.Connectivity);
+    }
+    else
+    {
+      this->Storage.UseFixedSize32BitStorage(cellSize);
+      auto& srcStorage = ca->Storage.GetFixedSizeArrays32();
+      auto& dstStorage = this->Storage.GetFixedSizeArrays32();
+      dstStorage.SetNumberOfCells(srcStorage.GetNumberOfCells());
+      dstStorage.Connectivity->DeepCopy(srcStorage.Connectivity);
+    }
+    this->Modified();
+  }
+  else if (ca->Storage.Is64Bit())
   {
     this->Storage.Use64BitStorage();
     auto& srcStorage = ca->Storage.GetArrays64();
@@ -699,7 +822,24 @@ void vtkCellArray::ShallowCopy(vtkCellArray* ca)
     return;
   }
 
-  if (ca->Storage.Is64Bit())
+  if (ca->Storage.IsFixedSize())
+  {
+    // Share the connectivity only: the implicit offsets are resized on insertion.
+    // SetData() keeps explicit storage explicit, so switch the storage first.
+    if (ca->Storage.Is64Bit())
+    {
+      auto& srcStorage = ca->Storage.GetFixedSizeArrays64();
+      this->UseFixedSize64BitStorage(srcStorage.GetFixedCellSize());
+      this->SetData(srcStorage.GetFixedCellSize(), srcStorage.GetConnectivity());
+    }
+    else
+    {
+      auto& srcStorage = ca->Storage.GetFixedSizeArrays32();
+      this->UseFixedSize32BitStorage(srcStorage.GetFixedCellSize());
+      this->SetData(srcStorage.GetFixedCellSize(), srcStorage.GetConnectivity());
+    }
+  }
+  else if (ca->Storage.Is64Bit())
   {
     auto& srcStorage = ca->Storage.GetArrays64();
     this->SetData(srcStorage.GetOffsets(), srcStorage.GetConnectivity());
@@ -716,14 +856,18 @@ void vtkCellArray::Append(vtkCellArray* src, vtkIdType pointOffset)
 {
   if (src->GetNumberOfCells() > 0)
   {
-    this->Visit(AppendImpl{}, src, pointOffset);
+    if (this->Storage.IsFixedSize() && src->IsHomogeneous() != this->Storage.GetFixedCellSize())
+    {
+      this->ExpandFixedSizeStorage();
+    }
+    this->Dispatch(AppendImpl{}, src, pointOffset);
   }
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
-  this->Visit(InitializeImpl{});
+  this->Dispatch(InitializeImpl{});
 
   this->LegacyData->Initialize();
 }
@@ -882,19 +1026,26 @@ struct SetDataGenericImpl
   }
 };
 
-struct GenerateOffsetsImpl
+struct SetFixedSizeDataImpl
 {
+  vtkCellArray* CellArray;
   vtkIdType CellSize;
-  vtkIdType ConnectivityArraySize;
 
   template <typename ArrayT>
-  void operator()(ArrayT* offsets)
+  void operator()(ArrayT* conn)
   {
-    for (vtkIdType cc = 0, max = (offsets->GetNumberOfTuples() - 1); cc < max; ++cc)
+    using ValueType = vtk::GetAPIType<ArrayT>;
+    using StorageArrayT = typename std::conditional<sizeof(ValueType) == 4,
+      vtkCellArray::ArrayType32, vtkCellArray::ArrayType64>::type;
+
+    // Use the array directly if it is a storage array, as SetData does.
+    vtkSmartPointer<StorageArrayT> storageConn = vtkArrayDownCast<StorageArrayT>(conn);
+    if (!storageConn)
     {
-      offsets->SetTypedComponent(cc, 0, cc * this->CellSize);
+      storageConn = vtkSmartPointer<StorageArrayT>::New();
+      storageConn->ShallowCopy(conn);
     }
-    offsets->SetTypedComponent(offsets->GetNumberOfTuples() - 1, 0, this->ConnectivityArraySize);
+    this->CellArray->SetData(this->CellSize, storageConn);
   }
 };
 
@@ -939,27 +1090,81 @@ bool vtkCellArray::SetData(vtkIdType cellSize, vtkDataArray* connectivity)
     return false;
   }
 
-  vtkSmartPointer<vtkDataArray> offsets;
-  offsets.TakeReference(connectivity->NewInstance());
-  offsets->SetNumberOfTuples(1 + connectivity->GetNumberOfTuples() / cellSize);
-
-  GenerateOffsetsImpl worker{ cellSize, connectivity->GetNumberOfTuples() };
+  SetFixedSizeDataImpl worker{ this, cellSize };
   using SupportedArrays = vtkCellArray::InputArrayList;
   using Dispatch = vtkArrayDispatch::DispatchByArray<SupportedArrays>;
-  if (!Dispatch::Execute(offsets, worker))
+  if (!Dispatch::Execute(connectivity, worker))
   {
     vtkErrorMacro("Invalid array types passed to SetData: "
       << "connectivity=" << connectivity->GetClassName());
     return false;
   }
 
-  return this->SetData(offsets, connectivity);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkCellArray::SetData(vtkIdType cellSize, vtkTypeInt32Array* connectivity)
+{
+  if (cellSize <= 0 || connectivity->GetNumberOfComponents() != 1 ||
+    (connectivity->GetNumberOfValues() % cellSize) != 0)
+  {
+    vtkErrorMacro("Invalid cellSize or connectivity array.");
+    return false;
+  }
+
+  // Explicit storage stays explicit.
+  if (!this->Storage.IsFixedSize())
+  {
+    vtkNew<vtkTypeInt32Array> offsets;
+    FillFixedSizeOffsets(offsets.Get(), connectivity->GetNumberOfValues() / cellSize, cellSize);
+    this->SetData(offsets, connectivity);
+    return true;
+  }
+
+  this->Storage.UseFixedSize32BitStorage(cellSize);
+  auto& storage = this->Storage.GetFixedSizeArrays32();
+
+  // vtkArrayDownCast to ensure this works when ArrayType32 is vtkIdTypeArray.
+  storage.Connectivity = vtkArrayDownCast<ArrayType32>(connectivity);
+  storage.SetNumberOfCells(connectivity->GetNumberOfValues() / cellSize);
+  this->Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkCellArray::SetData(vtkIdType cellSize, vtkTypeInt64Array* connectivity)
+{
+  if (cellSize <= 0 || connectivity->GetNumberOfComponents() != 1 ||
+    (connectivity->GetNumberOfValues() % cellSize) != 0)
+  {
+    vtkErrorMacro("Invalid cellSize or connectivity array.");
+    return false;
+  }
+
+  // Explicit storage stays explicit.
+  if (!this->Storage.IsFixedSize())
+  {
+    vtkNew<vtkTypeInt64Array> offsets;
+    FillFixedSizeOffsets(offsets.Get(), connectivity->GetNumberOfValues() / cellSize, cellSize);
+    this->SetData(offsets, connectivity);
+    return true;
+  }
+
+  this->Storage.UseFixedSize64BitStorage(cellSize);
+  auto& storage = this->Storage.GetFixedSizeArrays64();
+
+  // vtkArrayDownCast to ensure this works when ArrayType64 is vtkIdTypeArray.
+  storage.Connectivity = vtkArrayDownCast<ArrayType64>(connectivity);
+  storage.SetNumberOfCells(connectivity->GetNumberOfValues() / cellSize);
+  this->Modified();
+  return true;
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::Use32BitStorage()
 {
-  if (!this->Storage.Is64Bit())
+  if (!this->Storage.Is64Bit() && !this->Storage.IsFixedSize())
   {
     this->Initialize();
     return;
@@ -970,7 +1175,7 @@ void vtkCellArray::Use32BitStorage()
 //------------------------------------------------------------------------------
 void vtkCellArray::Use64BitStorage()
 {
-  if (this->Storage.Is64Bit())
+  if (this->Storage.Is64Bit() && !this->Storage.IsFixedSize())
   {
     this->Initialize();
     return;
@@ -988,6 +1193,30 @@ void vtkCellArray::UseDefaultStorage()
 #endif // VTK_USE_64BIT_IDS
 }
 
+//------------------------------------------------------------------------------
+void vtkCellArray::UseFixedSize32BitStorage(vtkIdType cellSize)
+{
+  this->Storage.UseFixedSize32BitStorage(cellSize);
+  this->LegacyData->Initialize();
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::UseFixedSize64BitStorage(vtkIdType cellSize)
+{
+  this->Storage.UseFixedSize64BitStorage(cellSize);
+  this->LegacyData->Initialize();
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::UseFixedSizeDefaultStorage(vtkIdType cellSize)
+{
+#ifdef VTK_USE_64BIT_IDS
+  this->UseFixedSize64BitStorage(cellSize);
+#else  // VTK_USE_64BIT_IDS
+  this->UseFixedSize32BitStorage(cellSize);
+#endif // VTK_USE_64BIT_IDS
+}
+
 //------------------------------------------------------------------------------
 bool vtkCellArray::CanConvertTo32BitStorage() const
 {
@@ -995,7 +1224,7 @@ bool vtkCellArray::CanConvertTo32BitStorage() const
   {
     return true;
   }
-  return this->Visit(CanConvert<ArrayType32::ValueType>{});
+  return this->Dispatch(CanConvert<ArrayType32::ValueType>{});
 }
 
 //------------------------------------------------------------------------------
@@ -1021,6 +1250,17 @@ bool vtkCellArray::ConvertTo32BitStorage()
   {
     return true;
   }
+  if (this->Storage.IsFixedSize())
+  {
+    auto& storage = this->Storage.GetFixedSizeArrays64();
+    const vtkIdType cellSize = storage.GetFixedCellSize();
+    vtkNew<ArrayType32> conn;
+    if (!ExtractAndInitialize{}.Process(storage.GetConnectivity(), conn.Get()))
+    {
+      return false;
+    }
+    return this->SetData(cellSize, conn);
+  }
   vtkNew<ArrayType32> offsets;
   vtkNew<ArrayType32> conn;
   if (!this->Visit(ExtractAndInitialize{}, offsets.Get(), conn.Get()))
@@ -1039,6 +1279,17 @@ bool vtkCellArray::ConvertTo64BitStorage()
   {
     return true;
   }
+  if (this->Storage.IsFixedSize())
+  {
+    auto& storage = this->Storage.GetFixedSizeArrays32();
+    const vtkIdType cellSize = storage.GetFixedCellSize();
+    vtkNew<ArrayType64> conn;
+    if (!ExtractAndInitialize{}.Process(storage.GetConnectivity(), conn.Get()))
+    {
+      return false;
+    }
+    return this->SetData(cellSize, conn);
+  }
   vtkNew<ArrayType64> offsets;
   vtkNew<ArrayType64> conn;
   if (!this->Visit(ExtractAndInitialize{}, offsets.Get(), conn.Get()))
@@ -1071,16 +1322,104 @@ bool vtkCellArray::ConvertToSmallestStorage()
   return true;
 }
 
+//------------------------------------------------------------------------------
+bool vtkCellArray::ConvertToFixedSizeStorage()
+{
+  if (this->Storage.IsFixedSize())
+  {
+    return true;
+  }
+  const vtkIdType cellSize = this->IsHomogeneous();
+  if (cellSize <= 0)
+  {
+    return false;
+  }
+
+  // The connectivity is kept as is, only the offsets are released.
+  if (this->Storage.Is64Bit())
+  {
+    vtkSmartPointer<ArrayType64> conn = this->Storage.GetArrays64().Connectivity;
+    const vtkIdType numCells = this->GetNumberOfCells();
+    this->Storage.UseFixedSize64BitStorage(cellSize);
+    auto& storage = this->Storage.GetFixedSizeArrays64();
+    storage.Connectivity = conn;
+    storage.SetNumberOfCells(numCells);
+  }
+  else
+  {
+    vtkSmartPointer<ArrayType32> conn = this->Storage.GetArrays32().Connectivity;
+    const vtkIdType numCells = this->GetNumberOfCells();
+    this->Storage.UseFixedSize32BitStorage(cellSize);
+    auto& storage = this->Storage.GetFixedSizeArrays32();
+    storage.Connectivity = conn;
+    storage.SetNumberOfCells(numCells);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkCellArray::ConvertToExplicitStorage()
+{
+  this->ExpandFixedSizeStorage();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::ExpandFixedSizeStorage()
+{
+  if (!this->Storage.IsFixedSize())
+  {
+    return;
+  }
+
+  // The explicit state is complete before it replaces the fixed-size one, and
+  // shares its connectivity. The cells do not change, so this does not call
+  // Modified().
+  if (this->Storage.Is64Bit())
+  {
+    auto state = new VisitState<ArrayType64>;
+    this->BuildExplicitState(*state);
+    this->Storage.UseExplicitStorage(state);
+  }
+  else
+  {
+    auto state = new VisitState<ArrayType32>;
+    this->BuildExplicitState(*state);
+    this->Storage.UseExplicitStorage(state);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::BuildExplicitState(VisitState<ArrayType32>& state) const
+{
+  const auto& fixed = this->Storage.GetFixedSizeArrays32();
+  FillFixedSizeOffsets(state.Offsets.Get(), fixed.GetNumberOfCells(), fixed.GetFixedCellSize());
+  state.Connectivity = fixed.Connectivity;
+}
+
+//------------------------------------------------------------------------------
+void vtkCellArray::BuildExplicitState(VisitState<ArrayType64>& state) const
+{
+  const auto& fixed = this->Storage.GetFixedSizeArrays64();
+  FillFixedSizeOffsets(state.Offsets.Get(), fixed.GetNumberOfCells(), fixed.GetFixedCellSize());
+  state.Connectivity = fixed.Connectivity;
+}
+
 //------------------------------------------------------------------------------
 bool vtkCellArray::AllocateExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
-  return this->Visit(AllocateExactImpl{}, numCells, connectivitySize);
+  return this->Dispatch(AllocateExactImpl{}, numCells, connectivitySize);
 }
 
 //------------------------------------------------------------------------------
 bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 {
-  return this->Visit(ResizeExactImpl{}, numCells, connectivitySize);
+  if (this->Storage.IsFixedSize() &&
+    connectivitySize != numCells * this->Storage.GetFixedCellSize())
+  {
+    this->ExpandFixedSizeStorage();
+  }
+  return this->Dispatch(ResizeExactImpl{}, numCells, connectivitySize);
 }
 
 //------------------------------------------------------------------------------
@@ -1088,6 +1427,11 @@ bool vtkCellArray::ResizeExact(vtkIdType numCells, vtkIdType connectivitySize)
 // defining the cell.
 int vtkCellArray::GetMaxCellSize()
 {
+  if (this->Storage.IsFixedSize())
+  {
+    return static_cast<int>(this->IsHomogeneous());
+  }
+
   FindMaxCell finder{ this };
 
   // Grain size puts an even number of pages into each instance.
@@ -1099,7 +1443,7 @@ int vtkCellArray::GetMaxCellSize()
 //------------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize() const
 {
-  return this->Visit(GetActualMemorySizeImpl{});
+  return this->Dispatch(GetActualMemorySizeImpl{});
 }
 
 //------------------------------------------------------------------------------
@@ -1108,16 +1452,17 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "StorageIs64Bit: " << this->Storage.Is64Bit() << "\n";
+  os << indent << "StorageIsFixedSize: " << this->Storage.IsFixedSize() << "\n";
 
   PrintSelfImpl functor;
-  this->Visit(functor, os, indent);
+  this->Dispatch(functor, os, indent);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::PrintDebug(std::ostream& os)
 {
   this->Print(os);
-  this->Visit(PrintDebugImpl{}, os);
+  this->Dispatch(PrintDebugImpl{}, os);
 }
 
 //------------------------------------------------------------------------------
@@ -1135,33 +1480,33 @@ void vtkCellArray::SetTraversalCellId(vtkIdType cellId)
 //------------------------------------------------------------------------------
 void vtkCellArray::ReverseCellAtId(vtkIdType cellId)
 {
-  this->Visit(ReverseCellAtIdImpl{}, cellId);
+  this->Dispatch(ReverseCellAtIdImpl{}, cellId);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ReplaceCellAtId(vtkIdType cellId, vtkIdList* list)
 {
-  this->Visit(ReplaceCellAtIdImpl{}, cellId, list->GetNumberOfIds(), list->GetPointer(0));
+  this->Dispatch(ReplaceCellAtIdImpl{}, cellId, list->GetNumberOfIds(), list->GetPointer(0));
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ReplaceCellAtId(
   vtkIdType cellId, vtkIdType cellSize, const vtkIdType cellPoints[])
 {
-  this->Visit(ReplaceCellAtIdImpl{}, cellId, cellSize, cellPoints);
+  this->Dispatch(ReplaceCellAtIdImpl{}, cellId, cellSize, cellPoints);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ReplaceCellPointAtId(
   vtkIdType cellId, vtkIdType cellPointIndex, vtkIdType newPointId)
 {
-  this->Visit(ReplaceCellPointAtIdImpl{}, cellId, cellPointIndex, newPointId);
+  this->Dispatch(ReplaceCellPointAtIdImpl{}, cellId, cellPointIndex, newPointId);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::ExportLegacyFormat(vtkIdTypeArray* data)
 {
-  data->Allocate(this->Visit(GetLegacyDataSizeImpl{}));
+  data->Allocate(this->Dispatch(GetLegacyDataSizeImpl{}));
 
   auto it = vtk::TakeSmartPointer(this->NewIterator());
 
@@ -1200,13 +1545,18 @@ void vtkCellArray::AppendLegacyFormat(vtkIdTypeArray* data, vtkIdType ptOffset)
 //------------------------------------------------------------------------------
 void vtkCellArray::AppendLegacyFormat(const vtkIdType* data, vtkIdType len, vtkIdType ptOffset)
 {
-  this->Visit(AppendLegacyFormatImpl{}, data, len, ptOffset);
+  if (this->Storage.IsFixedSize() &&
+    !LegacyFormatHasCellSize(data, len, this->Storage.GetFixedCellSize()))
+  {
+    this->ExpandFixedSizeStorage();
+  }
+  this->Dispatch(AppendLegacyFormatImpl{}, data, len, ptOffset);
 }
 
 //------------------------------------------------------------------------------
 void vtkCellArray::Squeeze()
 {
-  this->Visit(SqueezeImpl{});
+  this->Dispatch(SqueezeImpl{});
 
   // Just delete the legacy buffer.
   this->LegacyData->Initialize();
@@ -1215,12 +1565,12 @@ void vtkCellArray::Squeeze()
 //------------------------------------------------------------------------------
 bool vtkCellArray::IsValid()
 {
-  return this->Visit(IsValidImpl{});
+  return this->Dispatch(IsValidImpl{});
 }
 
 //------------------------------------------------------------------------------
 vtkIdType vtkCellArray::IsHomogeneous()
 {
-  return this->Visit(IsHomogeneousImpl{});
+  return this->Dispatch(IsHomogeneousImpl{});
 }
 VTK_ABI_NAMESPACE_END
@@ -84,6 +84,26 @@
  * - `bool ConvertToDefaultStorage() // Depends on vtkIdType`
  * - `bool ConvertToSmallestStorage() // Depends on current values in arrays`
  *
+ * When all cells have the same number of points, e.g. in the output of a
+ * reader or filter producing only triangles or only hexahedra, the offsets
+ * can be left implicit. In fixed-size storage, only the Connectivity array
+ * is stored; the offset of a cell is `cellId * cellSize` and the Offsets
+ * array is a vtkAffineArray. Producers opt into it with:
+ *
+ * - `bool IsStorageFixedSize()`
+ * - `void UseFixedSize32BitStorage(vtkIdType cellSize)`
+ * - `void UseFixedSize64BitStorage(vtkIdType cellSize)`
+ * - `void UseFixedSizeDefaultStorage(vtkIdType cellSize) // Depends on vtkIdType`
+ * - `bool SetData(vtkIdType cellSize, vtkDataArray* connectivity)`
+ * - `bool ConvertToFixedSizeStorage()`
+ * - `bool ConvertToExplicitStorage()`
+ *
+ * The cell accessors, vtkCellArrayIterator and Dispatch() locate cells in
+ * fixed-size storage with stride arithmetic. Inserting a cell of a different
+ * size, or using a non-const API that requires an explicit offsets array,
+ * such as Visit() or GetOffsetsArray(), converts the storage to explicit
+ * offsets. Const methods never convert the storage.
+ *
  * Note that some legacy methods are still available that reflect the
  * previous storage format of this data, which embedded the cell sizes into
  * the Connectivity array:
@@ -127,6 +147,7 @@
 #include "vtkObject.h"
 
 #include "vtkAOSDataArrayTemplate.h" // Needed for inline methods
+#include "vtkAffineArray.h"          // For fixed-size storage offsets
 #include "vtkCell.h"                 // Needed for inline methods
 #include "vtkDataArrayRange.h"       // Needed for inline methods
 #include "vtkFeatures.h"             // for VTK_USE_MEMKIND
@@ -171,6 +192,8 @@ class VTKCOMMONDATAMODEL_EXPORT vtkCellArray : public vtkObject
 public:
   using ArrayType32 = vtkTypeInt32Array;
   using ArrayType64 = vtkTypeInt64Array;
+  using AffineArrayType32 = vtkAffineArray<vtkTypeInt32>;
+  using AffineArrayType64 = vtkAffineArray<vtkTypeInt64>;
 
   ///@{
   /**
@@ -300,48 +323,18 @@ public:
   /**
    * Get the number of cells in the array.
    */
-  vtkIdType GetNumberOfCells() const
-  {
-    if (this->Storage.Is64Bit())
-    {
-      return this->Storage.GetArrays64().Offsets->GetNumberOfValues() - 1;
-    }
-    else
-    {
-      return this->Storage.GetArrays32().Offsets->GetNumberOfValues() - 1;
-    }
-  }
+  vtkIdType GetNumberOfCells() const;
 
   /**
    * Get the number of elements in the offsets array. This will be the number of
    * cells + 1.
    */
-  vtkIdType GetNumberOfOffsets() const
-  {
-    if (this->Storage.Is64Bit())
-    {
-      return this->Storage.GetArrays64().Offsets->GetNumberOfValues();
-    }
-    else
-    {
-      return this->Storage.GetArrays32().Offsets->GetNumberOfValues();
-    }
-  }
+  vtkIdType GetNumberOfOffsets() const;
 
   /**
    * Get the offset (into the connectivity) for a specified cell id.
    */
-  vtkIdType GetOffset(vtkIdType cellId)
-  {
-    if (this->Storage.Is64Bit())
-    {
-      return this->Storage.GetArrays64().Offsets->GetValue(cellId);
-    }
-    else
-    {
-      return this->Storage.GetArrays32().Offsets->GetValue(cellId);
-    }
-  }
+  vtkIdType GetOffset(vtkIdType cellId);
 
   /**
    * Get the size of the connectivity array that stores the point ids.
@@ -349,17 +342,7 @@ public:
    * GetNumberOfConnectivityEntries(), which refers to the legacy memory
    * layout.
    */
-  vtkIdType GetNumberOfConnectivityIds() const
-  {
-    if (this->Storage.Is64Bit())
-    {
-      return this->Storage.GetArrays64().Connectivity->GetNumberOfValues();
-    }
-    else
-    {
-      return this->Storage.GetArrays32().Connectivity->GetNumberOfValues();
-    }
-  }
+  vtkIdType GetNumberOfConnectivityIds() const;
 
   /**
    * @brief NewIterator returns a new instance of vtkCellArrayIterator that
@@ -411,10 +394,20 @@ public:
    * - The `connectivity` array must be one of the types in InputArrayList.
    * - The `connectivity` array size must be a multiple of `cellSize`.
    *
+   * The storage mode is kept: a cell array in fixed-size storage (see
+   * UseFixedSize32BitStorage()) keeps implicit offsets, otherwise an explicit
+   * offsets array is generated. As with the other SetData() methods, the
+   * connectivity array is used directly if it is a vtkCellArray::ArrayType32
+   * or vtkCellArray::ArrayType64.
+   *
    * If invalid arrays are passed in, an error is logged and the function
    * will return false.
+   * @{
    */
   bool SetData(vtkIdType cellSize, vtkDataArray* connectivity);
+  bool SetData(vtkIdType cellSize, vtkTypeInt32Array* connectivity);
+  bool SetData(vtkIdType cellSize, vtkTypeInt64Array* connectivity);
+  /**@}*/
 
   /**
    * @return True if the internal storage is using 64 bit arrays. If false,
@@ -422,6 +415,12 @@ public:
    */
   bool IsStorage64Bit() const { return this->Storage.Is64Bit(); }
 
+  /**
+   * @return True if the internal storage holds cells of a single size with
+   * implicit offsets. See UseFixedSize32BitStorage().
+   */
+  bool IsStorageFixedSize() const { return this->Storage.IsFixedSize(); }
+
   /**
    * @return True if the internal storage can be shared as a
    * pointer to vtkIdType, i.e., the type and organization of internal
@@ -453,6 +452,25 @@ public:
   void UseDefaultStorage();
   /**@}*/
 
+  /**
+   * Initialize internal data structures to store cells of exactly @a cellSize
+   * points with 32- or 64-bit connectivity. Only the connectivity array is
+   * stored: the offsets are implicit (`cellId * cellSize`), which saves the
+   * memory of the offsets array and reduces cell lookups to stride
+   * arithmetic. If selecting default storage, the storage depends on the
+   * VTK_USE_64BIT_IDS setting.
+   *
+   * Inserting a cell of another size converts the storage to explicit
+   * offsets, see ConvertToExplicitStorage().
+   *
+   * All existing data is erased.
+   * @{
+   */
+  void UseFixedSize32BitStorage(vtkIdType cellSize);
+  void UseFixedSize64BitStorage(vtkIdType cellSize);
+  void UseFixedSizeDefaultStorage(vtkIdType cellSize);
+  /**@}*/
+
   /**
    * Check if the existing data can safely be converted to use 32- or 64- bit
    * storage. Ensures that all values can be converted to the target storage
@@ -488,13 +506,33 @@ public:
   bool ConvertToSmallestStorage();
   /**@}*/
 
+  /**
+   * Convert the internal data structures between explicit offsets and
+   * fixed-size storage. Existing data and the 32/64-bit storage type are
+   * preserved.
+   *
+   * ConvertToFixedSizeStorage() returns false, leaving the cell array
+   * unchanged, if it is empty or if its cells do not all have the same size
+   * (see IsHomogeneous()).
+   *
+   * ConvertToExplicitStorage() is called on demand by the non-const methods
+   * that need an explicit offsets array. Like any other modification, it must
+   * not run while other threads access the cell array.
+   * @{
+   */
+  bool ConvertToFixedSizeStorage();
+  bool ConvertToExplicitStorage();
+  /**@}*/
+
   /**
    * Return the array used to store cell offsets. The 32/64 variants are only
-   * valid when IsStorage64Bit() returns the appropriate value.
+   * valid when IsStorage64Bit() returns the appropriate value. Fixed-size
+   * storage is converted to explicit offsets first.
    * @{
    */
   vtkDataArray* GetOffsetsArray()
   {
+    this->ExpandFixedSizeStorage();
     if (this->Storage.Is64Bit())
     {
       return this->GetOffsetsArray64();
@@ -504,8 +542,16 @@ public:
       return this->GetOffsetsArray32();
     }
   }
-  ArrayType32* GetOffsetsArray32() { return this->Storage.GetArrays32().Offsets; }
-  ArrayType64* GetOffsetsArray64() { return this->Storage.GetArrays64().Offsets; }
+  ArrayType32* GetOffsetsArray32()
+  {
+    this->ExpandFixedSizeStorage();
+    return this->Storage.GetArrays32().Offsets;
+  }
+  ArrayType64* GetOffsetsArray64()
+  {
+    this->ExpandFixedSizeStorage();
+    return this->Storage.GetArrays64().Offsets;
+  }
   /**@}*/
 
   /**
@@ -525,8 +571,22 @@ public:
       return this->GetConnectivityArray32();
     }
   }
-  ArrayType32* GetConnectivityArray32() { return this->Storage.GetArrays32().Connectivity; }
-  ArrayType64* GetConnectivityArray64() { return this->Storage.GetArrays64().Connectivity; }
+  ArrayType32* GetConnectivityArray32()
+  {
+    if (this->Storage.IsFixedSize())
+    {
+      return this->Storage.GetFixedSizeArrays32().Connectivity;
+    }
+    return this->Storage.GetArrays32().Connectivity;
+  }
+  ArrayType64* GetConnectivityArray64()
+  {
+    if (this->Storage.IsFixedSize())
+    {
+      return this->Storage.GetFixedSizeArrays64().Connectivity;
+    }
+    return this->Storage.GetArrays64().Connectivity;
+  }
   /**@}*/
 
   /**
@@ -877,6 +937,100 @@ public:
     bool IsInMemkind = false;
   };
 
+  // Holds the connectivity array of the given ArrayType for cells of a fixed
+  // size. The offsets are implicit: GetOffsets() returns a vtkAffineArray
+  // computing `cellId * cellSize`, and cell locations are computed directly.
+  template <typename ArrayT>
+  struct FixedSizeVisitState
+  {
+    using ArrayType = ArrayT;
+    using ValueType = typename ArrayType::ValueType;
+    using OffsetsArrayType = vtkAffineArray<ValueType>;
+    using CellRangeType = decltype(vtk::DataArrayValueRange<1>(std::declval<ArrayType>()));
+
+    static constexpr bool ValueTypeIsSameAsIdType = VisitState<ArrayT>::ValueTypeIsSameAsIdType;
+
+    OffsetsArrayType* GetOffsets() { return this->Offsets; }
+    const OffsetsArrayType* GetOffsets() const { return this->Offsets; }
+
+    ArrayType* GetConnectivity() { return this->Connectivity; }
+    const ArrayType* GetConnectivity() const { return this->Connectivity; }
+
+    vtkIdType GetFixedCellSize() const { return this->CellSize; }
+
+    vtkIdType GetNumberOfCells() const { return this->Offsets->GetNumberOfValues() - 1; }
+
+    vtkIdType GetBeginOffset(vtkIdType cellId) const { return cellId * this->CellSize; }
+
+    vtkIdType GetEndOffset(vtkIdType cellId) const { return (cellId + 1) * this->CellSize; }
+
+    vtkIdType GetCellSize(vtkIdType vtkNotUsed(cellId)) const { return this->CellSize; }
+
+    CellRangeType GetCellRange(vtkIdType cellId)
+    {
+      return vtk::DataArrayValueRange<1>(
+        this->GetConnectivity(), this->GetBeginOffset(cellId), this->GetEndOffset(cellId));
+    }
+
+    // Set the number of cells, i.e. the number of implicit offsets minus one.
+    bool SetNumberOfCells(vtkIdType numCells)
+    {
+      return this->Offsets->SetNumberOfValues(numCells + 1);
+    }
+
+    friend class vtkCellArray;
+
+  protected:
+    FixedSizeVisitState(vtkIdType cellSize)
+      : CellSize(cellSize)
+    {
+      this->Connectivity = vtkSmartPointer<ArrayType>::New();
+      this->Offsets = vtkSmartPointer<OffsetsArrayType>::New();
+      this->Offsets->ConstructBackend(static_cast<ValueType>(cellSize), static_cast<ValueType>(0));
+      this->Offsets->SetNumberOfValues(1);
+      if (vtkObjectBase::GetUsingMemkind())
+      {
+        this->IsInMemkind = true;
+      }
+    }
+    ~FixedSizeVisitState() = default;
+    void* operator new(size_t nSize)
+    {
+      void* r;
+#ifdef VTK_USE_MEMKIND
+      r = vtkObjectBase::GetCurrentMallocFunction()(nSize);
+#else
+      r = malloc(nSize);
+#endif
+      return r;
+    }
+    void operator delete(void* p)
+    {
+#ifdef VTK_USE_MEMKIND
+      FixedSizeVisitState* a = static_cast<FixedSizeVisitState*>(p);
+      if (a->IsInMemkind)
+      {
+        vtkObjectBase::GetAlternateFreeFunction()(p);
+      }
+      else
+      {
+        free(p);
+      }
+#else
+      free(p);
+#endif
+    }
+
+    vtkSmartPointer<ArrayType> Connectivity;
+    vtkSmartPointer<OffsetsArrayType> Offsets;
+    vtkIdType CellSize;
+
+  private:
+    FixedSizeVisitState(const FixedSizeVisitState&) = delete;
+    FixedSizeVisitState& operator=(const FixedSizeVisitState&) = delete;
+    bool IsInMemkind = false;
+  };
+
 private: // Helpers that allow Visit to return a value:
   template <typename Functor, typename... Args>
   using GetReturnType = decltype(
@@ -955,12 +1109,19 @@ public:
    * vtkIdType largest = cellArray->Visit(FindLargestCellInRange{},
    *                                      128, 1024);
    * ```
+   *
+   * The functor always receives a VisitState. The non-const overloads
+   * convert fixed-size storage to explicit offsets first. The const
+   * overloads never modify the cell array: for fixed-size storage, they build
+   * temporary explicit offsets for each call. Call ConvertToExplicitStorage()
+   * beforehand, or use Dispatch(), to avoid that cost.
    * @{
    */
   template <typename Functor, typename... Args,
     typename = typename std::enable_if<ReturnsVoid<Functor, Args...>::value>::type>
   void Visit(Functor&& functor, Args&&... args)
   {
+    this->ExpandFixedSizeStorage();
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -981,6 +1142,24 @@ public:
     typename = typename std::enable_if<ReturnsVoid<Functor, Args...>::value>::type>
   void Visit(Functor&& functor, Args&&... args) const
   {
+    if (this->Storage.IsFixedSize())
+    {
+      // Const methods never change the storage, which may be read by other
+      // threads: the functor visits temporary explicit offsets instead.
+      if (this->Storage.Is64Bit())
+      {
+        VisitState<ArrayType64> state;
+        this->BuildExplicitState(state);
+        functor(static_cast<const VisitState<ArrayType64>&>(state), std::forward<Args>(args)...);
+      }
+      else
+      {
+        VisitState<ArrayType32> state;
+        this->BuildExplicitState(state);
+        functor(static_cast<const VisitState<ArrayType32>&>(state), std::forward<Args>(args)...);
+      }
+      return;
+    }
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -1001,6 +1180,7 @@ public:
     typename = typename std::enable_if<!ReturnsVoid<Functor, Args...>::value>::type>
   GetReturnType<Functor, Args...> Visit(Functor&& functor, Args&&... args)
   {
+    this->ExpandFixedSizeStorage();
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -1020,6 +1200,21 @@ public:
     typename = typename std::enable_if<!ReturnsVoid<Functor, Args...>::value>::type>
   GetReturnType<Functor, Args...> Visit(Functor&& functor, Args&&... args) const
   {
+    if (this->Storage.IsFixedSize())
+    {
+      // See the void overload above.
+      if (this->Storage.Is64Bit())
+      {
+        VisitState<ArrayType64> state;
+        this->BuildExplicitState(state);
+        return functor(
+          static_cast<const VisitState<ArrayType64>&>(state), std::forward<Args>(args)...);
+      }
+      VisitState<ArrayType32> state;
+      this->BuildExplicitState(state);
+      return functor(
+        static_cast<const VisitState<ArrayType32>&>(state), std::forward<Args>(args)...);
+    }
     if (this->Storage.Is64Bit())
     {
       // If you get an error on the next line, a call to Visit(functor, Args...)
@@ -1038,6 +1233,109 @@ public:
 
   /** @} */
 
+  /**
+   * @warning Advanced use only.
+   *
+   * Dispatch() works like Visit(), but calls the functor with a
+   * vtkCellArray::FixedSizeVisitState<ArrayT> instead of converting
+   * fixed-size storage to explicit offsets. FixedSizeVisitState provides the
+   * same API as VisitState, except that GetOffsets() returns a read-only
+   * vtkAffineArray, and its GetBeginOffset(), GetEndOffset() and
+   * GetCellSize() reduce to stride arithmetic. A functor that does not
+   * modify the offsets is therefore compiled for each storage mode without
+   * changes; one that does must provide an overload taking a
+   * FixedSizeVisitState.
+   * @{
+   */
+  template <typename Functor, typename... Args,
+    typename = typename std::enable_if<ReturnsVoid<Functor, Args...>::value>::type>
+  void Dispatch(Functor&& functor, Args&&... args)
+  {
+    if (this->Storage.IsFixedSize())
+    {
+      if (this->Storage.Is64Bit())
+      {
+        functor(this->Storage.GetFixedSizeArrays64(), std::forward<Args>(args)...);
+      }
+      else
+      {
+        functor(this->Storage.GetFixedSizeArrays32(), std::forward<Args>(args)...);
+      }
+    }
+    else if (this->Storage.Is64Bit())
+    {
+      functor(this->Storage.GetArrays64(), std::forward<Args>(args)...);
+    }
+    else
+    {
+      functor(this->Storage.GetArrays32(), std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename Functor, typename... Args,
+    typename = typename std::enable_if<ReturnsVoid<Functor, Args...>::value>::type>
+  void Dispatch(Functor&& functor, Args&&... args) const
+  {
+    if (this->Storage.IsFixedSize())
+    {
+      if (this->Storage.Is64Bit())
+      {
+        functor(this->Storage.GetFixedSizeArrays64(), std::forward<Args>(args)...);
+      }
+      else
+      {
+        functor(this->Storage.GetFixedSizeArrays32(), std::forward<Args>(args)...);
+      }
+    }
+    else if (this->Storage.Is64Bit())
+    {
+      functor(this->Storage.GetArrays64(), std::forward<Args>(args)...);
+    }
+    else
+    {
+      functor(this->Storage.GetArrays32(), std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename Functor, typename... Args,
+    typename = typename std::enable_if<!ReturnsVoid<Functor, Args...>::value>::type>
+  GetReturnType<Functor, Args...> Dispatch(Functor&& functor, Args&&... args)
+  {
+    if (this->Storage.IsFixedSize())
+    {
+      if (this->Storage.Is64Bit())
+      {
+        return functor(this->Storage.GetFixedSizeArrays64(), std::forward<Args>(args)...);
+      }
+      return functor(this->Storage.GetFixedSizeArrays32(), std::forward<Args>(args)...);
+    }
+    else if (this->Storage.Is64Bit())
+    {
+      return functor(this->Storage.GetArrays64(), std::forward<Args>(args)...);
+    }
+    return functor(this->Storage.GetArrays32(), std::forward<Args>(args)...);
+  }
+
+  template <typename Functor, typename... Args,
+    typename = typename std::enable_if<!ReturnsVoid<Functor, Args...>::value>::type>
+  GetReturnType<Functor, Args...> Dispatch(Functor&& functor, Args&&... args) const
+  {
+    if (this->Storage.IsFixedSize())
+    {
+      if (this->Storage.Is64Bit())
+      {
+        return functor(this->Storage.GetFixedSizeArrays64(), std::forward<Args>(args)...);
+      }
+      return functor(this->Storage.GetFixedSizeArrays32(), std::forward<Args>(args)...);
+    }
+    else if (this->Storage.Is64Bit())
+    {
+      return functor(this->Storage.GetArrays64(), std::forward<Args>(args)...);
+    }
+    return functor(this->Storage.GetArrays32(), std::forward<Args>(args)...);
+  }
+  /** @} */
+
 #endif // __VTK_WRAP__
 
   //=================== Begin Legacy Methods ===================================
@@ -1182,8 +1480,26 @@ protected:
   vtkCellArray();
   ~vtkCellArray() override;
 
+  // Converts fixed-size storage to explicit offsets, if needed.
+  void ExpandFixedSizeStorage();
+
+  // Fills state with explicit offsets for the fixed-size storage, sharing its
+  // connectivity. The cell array itself is left unchanged.
+  void BuildExplicitState(VisitState<ArrayType32>& state) const;
+  void BuildExplicitState(VisitState<ArrayType64>& state) const;
+
+  // Converts fixed-size storage to explicit offsets if it cannot hold a cell
+  // of the given size.
+  void ExpandFixedSizeStorage(vtkIdType cellSize)
+  {
+    if (this->Storage.IsFixedSize() && cellSize != this->Storage.GetFixedCellSize())
+    {
+      this->ExpandFixedSizeStorage();
+    }
+  }
+
   // Encapsulates storage of the internal arrays as a discriminated union
-  // between 32-bit and 64-bit storage.
+  // between 32-bit and 64-bit, explicit and fixed-size storage.
   struct Storage
   {
     // Union type that switches 32 and 64 bit array storage
@@ -1192,6 +1508,8 @@ protected:
       ~ArraySwitch() = default; // handle by Storage
       VisitState<ArrayType32>* Int32;
       VisitState<ArrayType64>* Int64;
+      FixedSizeVisitState<ArrayType32>* FixedSizeInt32;
+      FixedSizeVisitState<ArrayType64>* FixedSizeInt64;
     };
 
     Storage()
@@ -1227,16 +1545,7 @@ protected:
 
     ~Storage()
     {
-      if (this->StorageIs64Bit)
-      {
-        this->Arrays->Int64->~VisitState();
-        delete this->Arrays->Int64;
-      }
-      else
-      {
-        this->Arrays->Int32->~VisitState();
-        delete this->Arrays->Int32;
-      }
+      this->DeleteArrays();
 #ifdef VTK_USE_MEMKIND
       if (this->IsInMemkind)
       {
@@ -1255,15 +1564,15 @@ protected:
     // true if the storage changes.
     bool Use32BitStorage()
     {
-      if (!this->StorageIs64Bit)
+      if (!this->StorageIs64Bit && !this->StorageIsFixedSize)
       {
         return false;
       }
 
-      this->Arrays->Int64->~VisitState();
-      delete this->Arrays->Int64;
+      this->DeleteArrays();
       this->Arrays->Int32 = new VisitState<ArrayType32>;
       this->StorageIs64Bit = false;
+      this->StorageIsFixedSize = false;
 
       return true;
     }
@@ -1272,22 +1581,71 @@ protected:
     // true if the storage changes.
     bool Use64BitStorage()
     {
-      if (this->StorageIs64Bit)
+      if (this->StorageIs64Bit && !this->StorageIsFixedSize)
       {
         return false;
       }
 
-      this->Arrays->Int32->~VisitState();
-      delete this->Arrays->Int32;
+      this->DeleteArrays();
       this->Arrays->Int64 = new VisitState<ArrayType64>;
       this->StorageIs64Bit = true;
+      this->StorageIsFixedSize = false;
 
       return true;
     }
 
+    // Switch the internal arrays to be 32-bit fixed-size storage. Any old
+    // data is lost.
+    void UseFixedSize32BitStorage(vtkIdType cellSize)
+    {
+      this->DeleteArrays();
+      this->Arrays->FixedSizeInt32 = new FixedSizeVisitState<ArrayType32>(cellSize);
+      this->StorageIs64Bit = false;
+      this->StorageIsFixedSize = true;
+    }
+
+    // Switch the internal arrays to be 64-bit fixed-size storage. Any old
+    // data is lost.
+    void UseFixedSize64BitStorage(vtkIdType cellSize)
+    {
+      this->DeleteArrays();
+      this->Arrays->FixedSizeInt64 = new FixedSizeVisitState<ArrayType64>(cellSize);
+      this->StorageIs64Bit = true;
+      this->StorageIsFixedSize = true;
+    }
+
+    // Replace the current storage by a complete explicit state, taking
+    // ownership of it.
+    void UseExplicitStorage(VisitState<ArrayType32>* state)
+    {
+      this->DeleteArrays();
+      this->Arrays->Int32 = state;
+      this->StorageIs64Bit = false;
+      this->StorageIsFixedSize = false;
+    }
+
+    void UseExplicitStorage(VisitState<ArrayType64>* state)
+    {
+      this->DeleteArrays();
+      this->Arrays->Int64 = state;
+      this->StorageIs64Bit = true;
+      this->StorageIsFixedSize = false;
+    }
+
     // Returns true if the storage is currently configured to be 64 bit.
     bool Is64Bit() const { return this->StorageIs64Bit; }
 
+    // Returns true if the storage currently has implicit offsets.
+    bool IsFixedSize() const { return this->StorageIsFixedSize; }
+
+    // Returns the cell size of fixed-size storage.
+    vtkIdType GetFixedCellSize() const
+    {
+      assert(this->StorageIsFixedSize);
+      return this->StorageIs64Bit ? this->Arrays->FixedSizeInt64->CellSize
+                                  : this->Arrays->FixedSizeInt32->CellSize;
+    }
+
     // Get the VisitState for 32-bit arrays
     VisitState<ArrayType32>& GetArrays32()
     {
@@ -1314,11 +1672,66 @@ protected:
       return *this->Arrays->Int64;
     }
 
+    // Get the FixedSizeVisitState for 32-bit arrays
+    FixedSizeVisitState<ArrayType32>& GetFixedSizeArrays32()
+    {
+      assert(!this->StorageIs64Bit && this->StorageIsFixedSize);
+      return *this->Arrays->FixedSizeInt32;
+    }
+
+    const FixedSizeVisitState<ArrayType32>& GetFixedSizeArrays32() const
+    {
+      assert(!this->StorageIs64Bit && this->StorageIsFixedSize);
+      return *this->Arrays->FixedSizeInt32;
+    }
+
+    // Get the FixedSizeVisitState for 64-bit arrays
+    FixedSizeVisitState<ArrayType64>& GetFixedSizeArrays64()
+    {
+      assert(this->StorageIs64Bit && this->StorageIsFixedSize);
+      return *this->Arrays->FixedSizeInt64;
+    }
+
+    const FixedSizeVisitState<ArrayType64>& GetFixedSizeArrays64() const
+    {
+      assert(this->StorageIs64Bit && this->StorageIsFixedSize);
+      return *this->Arrays->FixedSizeInt64;
+    }
+
   private:
+    // Destroy the active member of the union.
+    void DeleteArrays()
+    {
+      if (this->StorageIsFixedSize)
+      {
+        if (this->StorageIs64Bit)
+        {
+          this->Arrays->FixedSizeInt64->~FixedSizeVisitState();
+          delete this->Arrays->FixedSizeInt64;
+        }
+        else
+        {
+          this->Arrays->FixedSizeInt32->~FixedSizeVisitState();
+          delete this->Arrays->FixedSizeInt32;
+        }
+      }
+      else if (this->StorageIs64Bit)
+      {
+        this->Arrays->Int64->~VisitState();
+        delete this->Arrays->Int64;
+      }
+      else
+      {
+        this->Arrays->Int32->~VisitState();
+        delete this->Arrays->Int32;
+      }
+    }
+
     // Access restricted to ensure proper union construction/destruction thru
     // API.
     ArraySwitch* Arrays;
     bool StorageIs64Bit;
+    bool StorageIsFixedSize = false;
     bool IsInMemkind = false;
   };
 
@@ -1392,6 +1805,25 @@ struct InsertNextCellImpl
     return cellId;
   }
 
+  // Insert full cell of the fixed size
+  template <typename ArrayT>
+  vtkIdType operator()(
+    vtkCellArray::FixedSizeVisitState<ArrayT>& state, const vtkIdType npts, const vtkIdType pts[])
+  {
+    using ValueType = typename ArrayT::ValueType;
+    auto* conn = state.GetConnectivity();
+
+    const vtkIdType cellId = state.GetNumberOfCells();
+    state.SetNumberOfCells(cellId + 1);
+
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      conn->InsertNextValue(static_cast<ValueType>(pts[i]));
+    }
+
+    return cellId;
+  }
+
   // Just update offset table (for incremental API)
   template <typename CellStateT>
   vtkIdType operator()(CellStateT& state, const vtkIdType npts)
@@ -1406,6 +1838,15 @@ struct InsertNextCellImpl
 
     return cellId;
   }
+
+  template <typename ArrayT>
+  vtkIdType operator()(
+    vtkCellArray::FixedSizeVisitState<ArrayT>& state, const vtkIdType vtkNotUsed(npts))
+  {
+    const vtkIdType cellId = state.GetNumberOfCells();
+    state.SetNumberOfCells(cellId + 1);
+    return cellId;
+  }
 };
 
 // for incremental API:
@@ -1420,6 +1861,59 @@ struct UpdateCellCountImpl
     const ValueType cellBegin = offsets->GetValue(offsets->GetMaxId() - 1);
     offsets->SetValue(offsets->GetMaxId(), static_cast<ValueType>(cellBegin + npts));
   }
+
+  // The cell size is checked before dispatching.
+  template <typename ArrayT>
+  void operator()(
+    vtkCellArray::FixedSizeVisitState<ArrayT>& vtkNotUsed(state), const vtkIdType vtkNotUsed(npts))
+  {
+  }
+};
+
+struct InsertCellPointImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, const vtkIdType id)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    state.GetConnectivity()->InsertNextValue(static_cast<ValueType>(id));
+  }
+};
+
+struct GetNumberOfCellsImpl
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state)
+  {
+    return state.GetNumberOfCells();
+  }
+};
+
+struct GetNumberOfOffsetsImpl
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state)
+  {
+    return state.GetOffsets()->GetNumberOfValues();
+  }
+};
+
+struct GetOffsetImpl
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state, vtkIdType cellId)
+  {
+    return state.GetBeginOffset(cellId);
+  }
+};
+
+struct GetNumberOfConnectivityIdsImpl
+{
+  template <typename CellStateT>
+  vtkIdType operator()(CellStateT& state)
+  {
+    return state.GetConnectivity()->GetNumberOfValues();
+  }
 };
 
 struct GetCellSizeImpl
@@ -1513,12 +2007,43 @@ struct ResetImpl
     state.GetConnectivity()->Reset();
     state.GetOffsets()->InsertNextValue(0);
   }
+
+  template <typename ArrayT>
+  void operator()(vtkCellArray::FixedSizeVisitState<ArrayT>& state)
+  {
+    state.SetNumberOfCells(0);
+    state.GetConnectivity()->Reset();
+  }
 };
 
 VTK_ABI_NAMESPACE_END
 } // end namespace vtkCellArray_detail
 
 VTK_ABI_NAMESPACE_BEGIN
+//----------------------------------------------------------------------------
+inline vtkIdType vtkCellArray::GetNumberOfCells() const
+{
+  return this->Dispatch(vtkCellArray_detail::GetNumberOfCellsImpl{});
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkCellArray::GetNumberOfOffsets() const
+{
+  return this->Dispatch(vtkCellArray_detail::GetNumberOfOffsetsImpl{});
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkCellArray::GetOffset(vtkIdType cellId)
+{
+  return this->Dispatch(vtkCellArray_detail::GetOffsetImpl{}, cellId);
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkCellArray::GetNumberOfConnectivityIds() const
+{
+  return this->Dispatch(vtkCellArray_detail::GetNumberOfConnectivityIdsImpl{});
+}
+
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InitTraversal()
 {
@@ -1556,82 +2081,75 @@ inline int vtkCellArray::GetNextCell(vtkIdList* pts)
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::GetCellSize(const vtkIdType cellId) const
 {
-  return this->Visit(vtkCellArray_detail::GetCellSizeImpl{}, cellId);
+  return this->Dispatch(vtkCellArray_detail::GetCellSizeImpl{}, cellId);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize,
   vtkIdType const*& cellPoints) VTK_SIZEHINT(cellPoints, cellSize)
 {
-  this->Visit(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, this->TempCell);
+  this->Dispatch(
+    vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, this->TempCell);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType& cellSize,
   vtkIdType const*& cellPoints, vtkIdList* ptIds) VTK_SIZEHINT(cellPoints, cellSize)
 {
-  this->Visit(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, ptIds);
+  this->Dispatch(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, cellSize, cellPoints, ptIds);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList* pts)
 {
-  this->Visit(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, pts);
+  this->Dispatch(vtkCellArray_detail::GetCellAtIdImpl{}, cellId, pts);
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts, const vtkIdType* pts)
   VTK_SIZEHINT(pts, npts)
 {
-  return this->Visit(vtkCellArray_detail::InsertNextCellImpl{}, npts, pts);
+  this->ExpandFixedSizeStorage(npts);
+  return this->Dispatch(vtkCellArray_detail::InsertNextCellImpl{}, npts, pts);
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
-  return this->Visit(vtkCellArray_detail::InsertNextCellImpl{}, npts);
+  this->ExpandFixedSizeStorage(npts);
+  return this->Dispatch(vtkCellArray_detail::InsertNextCellImpl{}, npts);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
-  if (this->Storage.Is64Bit())
-  {
-    using ValueType = typename ArrayType64::ValueType;
-    this->Storage.GetArrays64().Connectivity->InsertNextValue(static_cast<ValueType>(id));
-  }
-  else
-  {
-    using ValueType = typename ArrayType32::ValueType;
-    this->Storage.GetArrays32().Connectivity->InsertNextValue(static_cast<ValueType>(id));
-  }
+  this->Dispatch(vtkCellArray_detail::InsertCellPointImpl{}, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
-  this->Visit(vtkCellArray_detail::UpdateCellCountImpl{}, npts);
+  this->ExpandFixedSizeStorage(npts);
+  this->Dispatch(vtkCellArray_detail::UpdateCellCountImpl{}, npts);
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdList* pts)
 {
-  return this->Visit(
-    vtkCellArray_detail::InsertNextCellImpl{}, pts->GetNumberOfIds(), pts->GetPointer(0));
+  return this->InsertNextCell(pts->GetNumberOfIds(), pts->GetPointer(0));
 }
 
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(vtkCell* cell)
 {
   vtkIdList* pts = cell->GetPointIds();
-  return this->Visit(
-    vtkCellArray_detail::InsertNextCellImpl{}, pts->GetNumberOfIds(), pts->GetPointer(0));
+  return this->InsertNextCell(pts->GetNumberOfIds(), pts->GetPointer(0));
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::Reset()
 {
-  this->Visit(vtkCellArray_detail::ResetImpl{});
+  this->Dispatch(vtkCellArray_detail::ResetImpl{});
 }
 
 VTK_ABI_NAMESPACE_END
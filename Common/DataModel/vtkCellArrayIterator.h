@@ -46,6 +46,11 @@
  * referencing this storage, unpredictable and catastrophic results are
  * likely - hence do not modify the vtkCellArray while iterating.
  *
+ * When the vtkCellArray uses fixed-size storage (see
+ * vtkCellArray::UseFixedSize32BitStorage()) and its storage can be shared,
+ * the iterator locates cells by stride arithmetic on the connectivity
+ * array, without going through the offsets.
+ *
  * @sa
  * vtkCellArray
  */
@@ -92,6 +97,7 @@ public:
     this->CurrentCellId = cellId;
     this->NumberOfCells = this->CellArray->GetNumberOfCells();
     assert(cellId <= this->NumberOfCells);
+    this->UpdateFixedSizeStorage();
   }
 
   /**
@@ -136,6 +142,7 @@ public:
   {
     this->CurrentCellId = 0;
     this->NumberOfCells = this->CellArray->GetNumberOfCells();
+    this->UpdateFixedSizeStorage();
   }
 
   /**
@@ -165,8 +172,14 @@ public:
   void GetCurrentCell(vtkIdType& cellSize, vtkIdType const*& cellPoints)
   {
     assert(this->CurrentCellId < this->NumberOfCells);
-    // Either refer to vtkCellArray storage buffer, or copy into local buffer
-    if (this->CellArray->IsStorageShareable())
+    // Either stride into shared fixed-size storage, refer to vtkCellArray
+    // storage buffer, or copy into local buffer
+    if (this->FixedCellSize > 0)
+    {
+      cellSize = this->FixedCellSize;
+      cellPoints = this->FixedConnectivity + this->CurrentCellId * this->FixedCellSize;
+    }
+    else if (this->CellArray->IsStorageShareable())
     {
       this->CellArray->GetCellAtId(this->CurrentCellId, cellSize, cellPoints);
     }
@@ -239,6 +252,35 @@ protected:
   vtkIdType CurrentCellId;
   vtkIdType NumberOfCells;
 
+  // Cell size and connectivity of shared fixed-size storage, or 0 and
+  // nullptr.
+  vtkIdType FixedCellSize = 0;
+  const vtkIdType* FixedConnectivity = nullptr;
+
+  void UpdateFixedSizeStorage()
+  {
+    this->FixedCellSize = 0;
+    this->FixedConnectivity = nullptr;
+    auto& storage = this->CellArray->Storage;
+    if (!storage.IsFixedSize() || !this->CellArray->IsStorageShareable())
+    {
+      return;
+    }
+    // This is safe, IsStorageShareable() checks the size of the value type.
+    if (storage.Is64Bit())
+    {
+      this->FixedCellSize = storage.GetFixedSizeArrays64().GetFixedCellSize();
+      this->FixedConnectivity = reinterpret_cast<const vtkIdType*>(
+        storage.GetFixedSizeArrays64().GetConnectivity()->GetPointer(0));
+    }
+    else
+    {
+      this->FixedCellSize = storage.GetFixedSizeArrays32().GetFixedCellSize();
+      this->FixedConnectivity = reinterpret_cast<const vtkIdType*>(
+        storage.GetFixedSizeArrays32().GetConnectivity()->GetPointer(0));
+    }
+  }
+
 private:
   vtkCellArrayIterator(const vtkCellArrayIterator&) = delete;
   void operator=(const vtkCellArrayIterator&) = delete;
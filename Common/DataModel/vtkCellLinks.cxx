@@ -3,12 +3,22 @@
 #include "vtkCellLinks.h"
 
 #include "vtkCellArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
-#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
-
+#include "vtkStaticCellLinks.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -156,95 +166,202 @@ vtkCellLinks::Link* vtkCellLinks::Resize(vtkIdType sz)
 }
 
 //------------------------------------------------------------------------------
-// Build the link list array.
-void vtkCellLinks::BuildLinks()
+namespace
 {
-  // don't rebuild if build time is newer than modified and dataset modified time
-  if (this->Array && this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime())
+// Links are built in two passes over the cells: the uses of each point are
+// counted, then the cell ids are inserted in the preallocated lists. Both
+// passes use atomics so that cells can be processed concurrently.
+struct CountPointUses
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType beginCellId, vtkIdType endCellId,
+    std::atomic<vtkIdType>* counts)
   {
-    return;
+    const auto conn = vtk::DataArrayValueRange<1>(state.GetConnectivity(),
+      state.GetBeginOffset(beginCellId), state.GetEndOffset(endCellId - 1));
+    for (const auto ptId : conn)
+    {
+      counts[ptId].fetch_add(1, std::memory_order_relaxed);
+    }
   }
-  vtkIdType numPts = this->NumberOfPoints = this->DataSet->GetNumberOfPoints();
-  vtkIdType numCells = this->NumberOfCells = this->DataSet->GetNumberOfCells();
-  int j;
-  vtkIdType cellId;
+};
 
-  if (this->Array == nullptr)
+struct InsertPointUses
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType beginCellId, vtkIdType endCellId,
+    vtkIdType cellIdOffset, std::atomic<vtkIdType>* locations, vtkCellLinks::Link* links)
   {
-    this->Allocate(numPts);
+    for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+    {
+      for (const auto ptId : state.GetCellRange(cellId))
+      {
+        const vtkIdType loc = locations[ptId].fetch_add(1, std::memory_order_relaxed);
+        links[ptId].cells[loc] = cellId + cellIdOffset;
+      }
+    }
   }
-  // This is checked to capture changes in the size of the allocation
-  else if (this->DataSet->GetMTime() > this->BuildTime && this->DataSet->GetMTime() > this->MTime)
+};
+
+// Run the functor over [0, n), in parallel unless sequential processing is
+// requested.
+template <typename FunctorT>
+void ForEachCell(bool sequential, vtkIdType n, FunctorT& functor)
+{
+  if (sequential)
   {
-    this->Allocate(numPts);
+    functor(0, n);
   }
+  else
+  {
+    vtkSMPTools::For(0, n, functor);
+  }
+}
 
-  // fill out lists with number of references to cells
-  std::vector<vtkIdType> linkLoc(numPts, 0);
+// Visit the cells of the cell arrays of a vtkPolyData or vtkUnstructuredGrid.
+struct CellArrayPass
+{
+  vtkCellArray* Cells;
+  vtkIdType CellIdOffset;
+  std::atomic<vtkIdType>* Counts;
+  vtkCellLinks::Link* Links;
 
-  // Use fast path if polydata
-  if (this->DataSet->GetDataObjectType() == VTK_POLY_DATA)
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
   {
-    vtkIdType npts;
-    const vtkIdType* pts;
-
-    vtkPolyData* pdata = static_cast<vtkPolyData*>(this->DataSet);
-    // traverse data to determine number of uses of each point
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->Links)
     {
-      pdata->GetCellPoints(cellId, npts, pts);
-      for (j = 0; j < npts; j++)
-      {
-        this->IncrementLinkCount(pts[j]);
-      }
+      this->Cells->Dispatch(
+        InsertPointUses{}, cellId, endCellId, this->CellIdOffset, this->Counts, this->Links);
+    }
+    else
+    {
+      this->Cells->Dispatch(CountPointUses{}, cellId, endCellId, this->Counts);
     }
+  }
+};
 
-    // now allocate storage for the links
-    this->AllocateLinks(numPts);
-    this->MaxId = numPts - 1;
+// Visit the cells of any other dataset.
+struct DataSetPass
+{
+  vtkDataSet* DataSet;
+  std::atomic<vtkIdType>* Counts;
+  vtkCellLinks::Link* Links;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  DataSetPass(vtkDataSet* dataSet, std::atomic<vtkIdType>* counts, vtkCellLinks::Link* links)
+    : DataSet(dataSet)
+    , Counts(counts)
+    , Links(links)
+  {
+  }
 
-    for (cellId = 0; cellId < numCells; cellId++)
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList* ptIds = this->PointIds.Local();
+    for (; cellId < endCellId; ++cellId)
     {
-      pdata->GetCellPoints(cellId, npts, pts);
-      for (j = 0; j < npts; j++)
+      this->DataSet->GetCellPoints(cellId, ptIds);
+      for (const vtkIdType ptId : *ptIds)
       {
-        this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);
+        const vtkIdType loc = this->Counts[ptId].fetch_add(1, std::memory_order_relaxed);
+        if (this->Links)
+        {
+          this->Links[ptId].cells[loc] = cellId;
+        }
       }
     }
   }
+};
+} // namespace
 
-  else // any other type of dataset
+//------------------------------------------------------------------------------
+// Build the link list array.
+void vtkCellLinks::BuildLinks()
+{
+  // don't rebuild if build time is newer than modified and dataset modified time
+  if (this->Array && this->BuildTime > this->MTime && this->BuildTime > this->DataSet->GetMTime())
   {
-    vtkIdType numberOfPoints, ptId;
-    vtkGenericCell* cell = vtkGenericCell::New();
-
-    // traverse data to determine number of uses of each point
-    for (cellId = 0; cellId < numCells; cellId++)
+    return;
+  }
+  const vtkIdType numPts = this->DataSet->GetNumberOfPoints();
+  const vtkIdType numCells = this->DataSet->GetNumberOfCells();
+  const bool sequential = this->SequentialProcessing;
+
+  // Start from empty lists, keeping any larger allocation requested by the
+  // dataset for later insertions.
+  this->Allocate(std::max(numPts, this->Size), this->Extend);
+  this->NumberOfPoints = numPts;
+  this->NumberOfCells = numCells;
+
+  // Gather the cell arrays of the datasets providing them, other datasets are
+  // traversed through GetCellPoints().
+  std::vector<std::pair<vtkCellArray*, vtkIdType>> cellArrays;
+  if (this->DataSet->GetDataObjectType() == VTK_POLY_DATA)
+  {
+    vtkPolyData* pdata = static_cast<vtkPolyData*>(this->DataSet);
+    vtkIdType cellIdOffset = 0;
+    for (vtkCellArray* cells :
+      { pdata->GetVerts(), pdata->GetLines(), pdata->GetPolys(), pdata->GetStrips() })
     {
-      this->DataSet->GetCell(cellId, cell);
-      numberOfPoints = cell->GetNumberOfPoints();
-      for (j = 0; j < numberOfPoints; j++)
+      if (cells && cells->GetNumberOfCells() > 0)
       {
-        this->IncrementLinkCount(cell->PointIds->GetId(j));
+        cellArrays.emplace_back(cells, cellIdOffset);
+        cellIdOffset += cells->GetNumberOfCells();
       }
     }
+  }
+  else if (this->DataSet->GetDataObjectType() == VTK_UNSTRUCTURED_GRID &&
+    static_cast<vtkUnstructuredGrid*>(this->DataSet)->GetCells())
+  {
+    cellArrays.emplace_back(static_cast<vtkUnstructuredGrid*>(this->DataSet)->GetCells(), 0);
+  }
+  else if (numCells > 0)
+  {
+    // GetCellPoints() is thread safe once called from a single thread
+    vtkNew<vtkIdList> ptIds;
+    this->DataSet->GetCellPoints(0, ptIds);
+  }
 
-    // now allocate storage for the links
-    this->AllocateLinks(numPts);
-    this->MaxId = numPts - 1;
+  // Count the uses of each point, then allocate the lists of cells
+  std::unique_ptr<std::atomic<vtkIdType>[]> counts(new std::atomic<vtkIdType>[numPts]());
+  auto traverse = [&](vtkCellLinks::Link* links) {
+    if (cellArrays.empty())
+    {
+      DataSetPass pass(this->DataSet, counts.get(), links);
+      ForEachCell(sequential, numCells, pass);
+      return;
+    }
+    for (const auto& cells : cellArrays)
+    {
+      CellArrayPass pass{ cells.first, cells.second, counts.get(), links };
+      ForEachCell(sequential, cells.first->GetNumberOfCells(), pass);
+    }
+  };
+  traverse(nullptr);
 
-    for (cellId = 0; cellId < numCells; cellId++)
+  auto setCounts = [this, &counts](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
     {
-      this->DataSet->GetCell(cellId, cell);
-      numberOfPoints = cell->GetNumberOfPoints();
-      for (j = 0; j < numberOfPoints; j++)
+      this->Array[ptId].ncells = counts[ptId].load(std::memory_order_relaxed);
+      this->Array[ptId].cells = new vtkIdType[this->Array[ptId].ncells];
+      counts[ptId].store(0, std::memory_order_relaxed);
+    }
+  };
+  ForEachCell(sequential, numPts, setCounts);
+  this->MaxId = numPts - 1;
+
+  // Insert the cells. When done in parallel, sort the lists to produce the
+  // same increasing cell ids as a serial build.
+  traverse(this->Array);
+  if (!sequential)
+  {
+    vtkSMPTools::For(0, numPts, [this](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
       {
-        ptId = cell->PointIds->GetId(j);
-        this->InsertCellReference(ptId, (linkLoc[ptId])++, cellId);
+        std::sort(this->Array[ptId].cells, this->Array[ptId].cells + this->Array[ptId].ncells);
       }
-    }
-    cell->Delete();
-  } // end else
+    });
+  }
   this->BuildTime.Modified();
 }
 
@@ -303,6 +420,11 @@ unsigned long vtkCellLinks::GetActualMemorySize()
 //------------------------------------------------------------------------------
 void vtkCellLinks::DeepCopy(vtkAbstractCellLinks* src)
 {
+  if (auto staticLinks = vtkStaticCellLinks::SafeDownCast(src))
+  {
+    this->CopyStaticLinks(staticLinks);
+    return;
+  }
   this->SetDataSet(src->GetDataSet());
   this->SetSequentialProcessing(src->GetSequentialProcessing());
   vtkCellLinks* clinks = static_cast<vtkCellLinks*>(src);
@@ -317,6 +439,40 @@ void vtkCellLinks::DeepCopy(vtkAbstractCellLinks* src)
     }
   });
   this->MaxId = clinks->MaxId;
+  this->NumberOfPoints = clinks->NumberOfPoints;
+  this->NumberOfCells = clinks->NumberOfCells;
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkCellLinks::CopyStaticLinks(vtkStaticCellLinks* src)
+{
+  vtkDataSet* dataSet = src->GetDataSet();
+  this->SetDataSet(dataSet);
+  this->SetSequentialProcessing(src->GetSequentialProcessing());
+  if (!dataSet)
+  {
+    this->Initialize();
+    return;
+  }
+  // Makes sure that the static links are up to date, this does nothing if they are
+  src->BuildLinks();
+  const vtkIdType numPts = dataSet->GetNumberOfPoints();
+  this->Allocate(numPts, this->Extend);
+  vtkSMPTools::For(0, numPts, [this, src](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType ncells = src->GetNcells(ptId);
+      this->Array[ptId].cells = new vtkIdType[ncells];
+      this->Array[ptId].ncells = ncells;
+      std::copy_n(src->GetCells(ptId), ncells, this->Array[ptId].cells);
+      // The order of the static links depends on how they were built
+      std::sort(this->Array[ptId].cells, this->Array[ptId].cells + ncells);
+    }
+  });
+  this->MaxId = numPts - 1;
+  this->NumberOfPoints = numPts;
+  this->NumberOfCells = dataSet->GetNumberOfCells();
   this->BuildTime.Modified();
 }
 
@@ -17,6 +17,13 @@
  * such as vtkStaticCellLinks or vtkStaticCellLinksTemplate. However these
  * other classes are typically meant for one-time (static) construction.
  *
+ * BuildLinks() counts the uses of each point and then inserts the cells in
+ * two passes over the cells, which are run in parallel with vtkSMPTools unless
+ * SequentialProcessing is enabled. The lists of cells are sorted afterwards,
+ * so that the result does not depend on the number of threads. Links built
+ * with vtkStaticCellLinks can be promoted to editable links without visiting
+ * the cells again with DeepCopy().
+ *
  * @sa
  * vtkCellArray vtkCellTypes vtkStaticCellLinks vtkStaticCellLinksTemplate
  */
@@ -30,6 +37,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDataSet;
 class vtkCellArray;
+class vtkStaticCellLinks;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkCellLinks : public vtkAbstractCellLinks
 {
@@ -152,7 +160,9 @@ public:
 
   /**
    * Standard DeepCopy method.  Since this object contains no reference
-   * to other objects, there is no ShallowCopy.
+   * to other objects, there is no ShallowCopy. The source may also be a
+   * vtkStaticCellLinks, whose links are copied into editable lists after
+   * being brought up to date.
    */
   void DeepCopy(vtkAbstractCellLinks* src) override;
 
@@ -172,6 +182,11 @@ protected:
    */
   void InsertCellReference(vtkIdType ptId, vtkIdType pos, vtkIdType cellId);
 
+  /**
+   * Copy the links of a vtkStaticCellLinks in the editable lists.
+   */
+  void CopyStaticLinks(vtkStaticCellLinks* src);
+
   Link* Array;                // pointer to data
   vtkIdType Size;             // allocated size of data
   vtkIdType MaxId;            // maximum index inserted thus far
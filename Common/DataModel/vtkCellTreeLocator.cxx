@@ -12,6 +12,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
@@ -292,10 +294,22 @@ struct CellPointTraversal
 //------------------------------------------------------------------------------
 // This class builds the CellTree according to the algorithm given in the paper.
 // This class is derived from the avtCellLocatorBIH class in VisIT.
+//
+// The nodes of the top levels are split one after the other, binning and
+// partitioning their cells in parallel. Once nodes hold few enough cells,
+// their subtrees are built concurrently, each in its own node array, and
+// Reduce() stitches them into the final tree. Every operation applied to a
+// node only depends on the cells of that node, so the resulting tree does not
+// depend on the number of threads.
 template <typename T>
 struct CellTreeBuilder
 {
 private:
+  // Nodes holding more cells are binned and partitioned in parallel.
+  static constexpr T ParallelSplitSize = 16384;
+  // Minimum number of cells of the subtrees built concurrently.
+  static constexpr T MinimumSubtreeSize = 4096;
+
   struct Bucket
   {
     double Min;
@@ -321,6 +335,19 @@ private:
         this->Max = max;
       }
     }
+
+    inline void Merge(const Bucket& other)
+    {
+      this->Cnt += other.Cnt;
+      if (other.Min < this->Min)
+      {
+        this->Min = other.Min;
+      }
+      if (other.Max > this->Max)
+      {
+        this->Max = other.Max;
+      }
+    }
   };
 
   struct CellInfo
@@ -383,9 +410,15 @@ private:
   int NumberOfBuckets;
   int NumberOfNodesPerLeaf;
 
+  using NodeArray = std::vector<TCellTreeNode>;
+  using SplitStackType = std::stack<SplitInfo>;
+
   std::vector<CellInfo> CellsInfo;
-  std::vector<CellTreeNode<T>> Nodes;
-  std::stack<SplitInfo> SplitStack;
+  NodeArray Nodes;
+  SplitStackType SplitStack;
+  // Leaves of Nodes whose subtrees are built concurrently, and their nodes.
+  std::vector<SplitInfo> Subtrees;
+  std::vector<NodeArray> SubtreeNodes;
 
   struct BucketsType : public std::array<std::vector<Bucket>, 3>
   {
@@ -439,10 +472,104 @@ private:
   }
 
   // -------------------------------------------------------------------------
-  void Split(T index, double min[3], double max[3], BucketsType& buckets)
+  void FillBuckets(const CellInfo* begin, const CellInfo* end, const double min[3],
+    const double iext[3], BucketsType& buckets)
+  {
+    for (const CellInfo* pc = begin; pc != end; ++pc)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        double cen = (pc->Min[d] + pc->Max[d]) / 2.0;
+        double dblIdx = (cen - min[d]) * iext[d];
+        dblIdx = vtkMath::ClampValue(dblIdx, 0.0, static_cast<double>(this->NumberOfBuckets - 1));
+        size_t ind = static_cast<size_t>(dblIdx);
+
+        buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Each thread bins a part of the cells, the buckets are then merged. Counts
+  // and extremums do not depend on the order of the merge.
+  void FillBucketsInParallel(const CellInfo* begin, const CellInfo* end, const double min[3],
+    const double iext[3], BucketsType& buckets)
+  {
+    const BucketsType exemplar(this->NumberOfBuckets);
+    vtkSMPThreadLocal<BucketsType> localBuckets(exemplar);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(end - begin), [&](vtkIdType first, vtkIdType last) {
+      this->FillBuckets(begin + first, begin + last, min, iext, localBuckets.Local());
+    });
+    for (const auto& local : localBuckets)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        for (int n = 0; n < this->NumberOfBuckets; ++n)
+        {
+          buckets[d][n].Merge(local[d][n]);
+        }
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Stable partition: the cells of every block are counted, then copied to
+  // their final position. The result is the one of std::stable_partition
+  // whatever the number of threads.
+  CellInfo* PartitionInParallel(CellInfo* begin, CellInfo* end, const LeftPredicate& predicate)
   {
-    const T& start = this->Nodes[index].Start();
-    const T& size = this->Nodes[index].Size();
+    const vtkIdType size = static_cast<vtkIdType>(end - begin);
+    const vtkIdType blockSize = 4096;
+    const vtkIdType numberOfBlocks = (size + blockSize - 1) / blockSize;
+    std::vector<vtkIdType> leftOffsets(numberOfBlocks + 1, 0);
+    std::vector<vtkIdType> rightOffsets(numberOfBlocks + 1, 0);
+    vtkSMPTools::For(0, numberOfBlocks, [&](vtkIdType first, vtkIdType last) {
+      LeftPredicate isLeft(predicate);
+      for (vtkIdType block = first; block < last; ++block)
+      {
+        const CellInfo* blockEnd = begin + std::min((block + 1) * blockSize, size);
+        vtkIdType numberOfLeft = 0;
+        for (const CellInfo* pc = begin + block * blockSize; pc != blockEnd; ++pc)
+        {
+          numberOfLeft += isLeft(*pc) ? 1 : 0;
+        }
+        leftOffsets[block + 1] = numberOfLeft;
+        rightOffsets[block + 1] = (blockEnd - begin - block * blockSize) - numberOfLeft;
+      }
+    });
+    for (vtkIdType block = 0; block < numberOfBlocks; ++block)
+    {
+      leftOffsets[block + 1] += leftOffsets[block];
+      rightOffsets[block + 1] += rightOffsets[block];
+    }
+    const vtkIdType numberOfLeft = leftOffsets[numberOfBlocks];
+
+    std::vector<CellInfo> partitioned(static_cast<size_t>(size));
+    vtkSMPTools::For(0, numberOfBlocks, [&](vtkIdType first, vtkIdType last) {
+      LeftPredicate isLeft(predicate);
+      for (vtkIdType block = first; block < last; ++block)
+      {
+        CellInfo* left = partitioned.data() + leftOffsets[block];
+        CellInfo* right = partitioned.data() + numberOfLeft + rightOffsets[block];
+        const CellInfo* blockEnd = begin + std::min((block + 1) * blockSize, size);
+        for (const CellInfo* pc = begin + block * blockSize; pc != blockEnd; ++pc)
+        {
+          *(isLeft(*pc) ? left++ : right++) = *pc;
+        }
+      }
+    });
+    vtkSMPTools::For(0, size, [&](vtkIdType first, vtkIdType last) {
+      std::copy(partitioned.data() + first, partitioned.data() + last, begin + first);
+    });
+    return begin + numberOfLeft;
+  }
+
+  // -------------------------------------------------------------------------
+  void Split(NodeArray& nodes, SplitStackType& stack, T index, double min[3], double max[3],
+    BucketsType& buckets)
+  {
+    const T start = nodes[index].Start();
+    const T size = nodes[index].Size();
 
     if (size < this->NumberOfNodesPerLeaf)
     {
@@ -459,17 +586,13 @@ private:
 
     buckets.Reset();
 
-    for (const CellInfo* pc = begin; pc != end; ++pc)
+    if (size > ParallelSplitSize)
     {
-      for (uint8_t d = 0; d < 3; ++d)
-      {
-        double cen = (pc->Min[d] + pc->Max[d]) / 2.0;
-        double dblIdx = (cen - min[d]) * iext[d];
-        dblIdx = vtkMath::ClampValue(dblIdx, 0.0, static_cast<double>(this->NumberOfBuckets - 1));
-        size_t ind = static_cast<size_t>(dblIdx);
-
-        buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
-      }
+      this->FillBucketsInParallel(begin, end, min, iext, buckets);
+    }
+    else
+    {
+      this->FillBuckets(begin, end, min, iext, buckets);
     }
 
     double cost = VTK_DOUBLE_MAX;
@@ -527,7 +650,9 @@ private:
 
     if (cost != VTK_DOUBLE_MAX)
     {
-      mid = std::partition(begin, end, LeftPredicate(dim, plane));
+      mid = size > ParallelSplitSize
+        ? this->PartitionInParallel(begin, end, LeftPredicate(dim, plane))
+        : std::partition(begin, end, LeftPredicate(dim, plane));
     }
 
     // fallback
@@ -550,11 +675,11 @@ private:
     child[0].MakeLeaf(begin - this->CellsInfo.data(), mid - begin);
     child[1].MakeLeaf(mid - this->CellsInfo.data(), end - mid);
 
-    this->Nodes[index].MakeNode(static_cast<T>(this->Nodes.size()), dim, clip);
-    this->Nodes.insert(this->Nodes.end(), child, child + 2);
+    nodes[index].MakeNode(static_cast<T>(nodes.size()), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
 
-    this->SplitStack.emplace(this->Nodes[index].GetRightChildIndex(), rMin, rMax);
-    this->SplitStack.emplace(this->Nodes[index].GetLeftChildIndex(), lMin, lMax);
+    stack.emplace(nodes[index].GetRightChildIndex(), rMin, rMax);
+    stack.emplace(nodes[index].GetLeftChildIndex(), lMin, lMax);
   }
 
 public:
@@ -569,34 +694,48 @@ public:
     const auto numberOfCells = static_cast<T>(this->DataSet->GetNumberOfCells());
     this->CellsInfo.resize(static_cast<size_t>(numberOfCells));
 
-    double min[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
-    double max[3] = {
-      -VTK_DOUBLE_MAX,
-      -VTK_DOUBLE_MAX,
-      -VTK_DOUBLE_MAX,
-    };
-
+    // Make GetCellBounds() thread safe
     double cellBounds[6], *cellBoundsPtr;
     cellBoundsPtr = cellBounds;
-    for (T i = 0; i < numberOfCells; ++i)
-    {
-      this->CellsInfo[i].Ind = i;
-      this->Locator->GetCellBounds(i, cellBoundsPtr);
+    this->Locator->GetCellBounds(0, cellBoundsPtr);
 
-      for (uint8_t d = 0; d < 3; ++d)
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfCells), [&](vtkIdType begin, vtkIdType end) {
+      double localBounds[6], *localBoundsPtr;
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        this->CellsInfo[i].Min[d] = cellBoundsPtr[2 * d + 0];
-        this->CellsInfo[i].Max[d] = cellBoundsPtr[2 * d + 1];
-
-        if (this->CellsInfo[i].Min[d] < min[d])
-        {
-          min[d] = this->CellsInfo[i].Min[d];
-        }
-        if (this->CellsInfo[i].Max[d] > max[d])
+        localBoundsPtr = localBounds;
+        this->CellsInfo[i].Ind = static_cast<T>(i);
+        this->Locator->GetCellBounds(i, localBoundsPtr);
+        for (uint8_t d = 0; d < 3; ++d)
         {
-          max[d] = this->CellsInfo[i].Max[d];
+          this->CellsInfo[i].Min[d] = localBoundsPtr[2 * d + 0];
+          this->CellsInfo[i].Max[d] = localBoundsPtr[2 * d + 1];
         }
       }
+    });
+
+    const std::array<double, 6> emptyBounds = { { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+      VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX } };
+    vtkSMPThreadLocal<std::array<double, 6>> localBounds(emptyBounds);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfCells), [&](vtkIdType begin, vtkIdType end) {
+      std::array<double, 6>& bounds = localBounds.Local();
+      double lMin[3], lMax[3];
+      this->FindMinMax(this->CellsInfo.data() + begin, this->CellsInfo.data() + end, lMin, lMax);
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        bounds[2 * d] = std::min(bounds[2 * d], lMin[d]);
+        bounds[2 * d + 1] = std::max(bounds[2 * d + 1], lMax[d]);
+      }
+    });
+    double min[3] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+    double max[3] = { -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (const auto& bounds : localBounds)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        min[d] = std::min(min[d], bounds[2 * d]);
+        max[d] = std::max(max[d], bounds[2 * d + 1]);
+      }
     }
 
     this->Tree.DataBBox[0] = min[0];
@@ -621,32 +760,100 @@ public:
 
   void operator()()
   {
+    // Split the top levels, deferring the nodes that are small enough.
+    const vtkIdType numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    const vtkIdType subtreeSize = std::max(
+      static_cast<vtkIdType>(this->CellsInfo.size()) / (8 * numberOfThreads),
+      static_cast<vtkIdType>(MinimumSubtreeSize));
     auto& buckets = this->Buckets;
     while (!this->SplitStack.empty())
     {
       auto splitInfo = std::move(this->SplitStack.top());
       this->SplitStack.pop();
-      this->Split(splitInfo.Index, splitInfo.Min, splitInfo.Max, buckets);
+      if (this->Nodes[splitInfo.Index].Size() <= subtreeSize)
+      {
+        this->Subtrees.push_back(splitInfo);
+        continue;
+      }
+      this->Split(this->Nodes, this->SplitStack, splitInfo.Index, splitInfo.Min, splitInfo.Max,
+        buckets);
     }
+
+    // Build the subtrees concurrently, the root of each one is a copy of the
+    // leaf it replaces.
+    this->SubtreeNodes.resize(this->Subtrees.size());
+    const BucketsType exemplar(this->NumberOfBuckets);
+    vtkSMPThreadLocal<BucketsType> localBuckets(exemplar);
+    const vtkIdType numberOfSubtrees = static_cast<vtkIdType>(this->Subtrees.size());
+    vtkSMPTools::For(0, numberOfSubtrees, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        NodeArray& nodes = this->SubtreeNodes[i];
+        nodes.push_back(this->Nodes[this->Subtrees[i].Index]);
+        SplitStackType stack;
+        stack.emplace(0, this->Subtrees[i].Min, this->Subtrees[i].Max);
+        while (!stack.empty())
+        {
+          auto splitInfo = std::move(stack.top());
+          stack.pop();
+          this->Split(
+            nodes, stack, splitInfo.Index, splitInfo.Min, splitInfo.Max, localBuckets.Local());
+        }
+      }
+    });
   }
 
   void Reduce()
   {
-    this->Tree.Nodes.resize(this->Nodes.size());
-    this->Tree.Nodes[0] = this->Nodes[0];
+    // Nodes are laid out breadth first, following the subtrees from the
+    // leaves they replace.
+    struct NodeReference
+    {
+      const NodeArray* Nodes;
+      T Index;
+    };
+    std::vector<int> subtreeOfNode(this->Nodes.size(), -1);
+    size_t numberOfNodes = this->Nodes.size() - this->Subtrees.size();
+    for (size_t i = 0; i < this->Subtrees.size(); ++i)
+    {
+      subtreeOfNode[this->Subtrees[i].Index] = static_cast<int>(i);
+      numberOfNodes += this->SubtreeNodes[i].size();
+    }
+    auto resolve = [&](const NodeArray* nodes, T index) {
+      NodeReference reference = { nodes, index };
+      if (nodes == &this->Nodes && subtreeOfNode[index] >= 0)
+      {
+        reference.Nodes = &this->SubtreeNodes[subtreeOfNode[index]];
+        reference.Index = 0;
+      }
+      return reference;
+    };
+
+    std::vector<NodeReference> references(numberOfNodes);
+    this->Tree.Nodes.resize(numberOfNodes);
+    references[0] = resolve(&this->Nodes, 0);
+    this->Tree.Nodes[0] = (*references[0].Nodes)[references[0].Index];
 
-    for (auto ni = this->Tree.Nodes.begin(), nn = this->Tree.Nodes.begin() + 1;
-         ni != this->Tree.Nodes.end(); ++ni)
+    size_t next = 1;
+    for (size_t i = 0; i < numberOfNodes; ++i)
     {
-      if (ni->IsLeaf())
+      TCellTreeNode& node = this->Tree.Nodes[i];
+      if (node.IsLeaf())
       {
         continue;
       }
 
-      *(nn++) = this->Nodes[ni->GetLeftChildIndex()];
-      *(nn++) = this->Nodes[ni->GetRightChildIndex()];
-      ni->SetChildren(nn - this->Tree.Nodes.begin() - 2);
+      const T children[2] = { node.GetLeftChildIndex(), node.GetRightChildIndex() };
+      for (const T child : children)
+      {
+        references[next] = resolve(references[i].Nodes, child);
+        this->Tree.Nodes[next] = (*references[next].Nodes)[references[next].Index];
+        ++next;
+      }
+      node.SetChildren(static_cast<T>(next - 2));
     }
+    this->Nodes.clear();
+    this->SubtreeNodes.clear();
 
     const auto numberOfCells = static_cast<size_t>(this->DataSet->GetNumberOfCells());
     this->Tree.Leaves.resize(numberOfCells);
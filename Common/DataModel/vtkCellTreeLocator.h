@@ -13,6 +13,11 @@
  * Some methods in building and traversing the cell tree in this class were derived
  * from avtCellLocatorBIH class in the VisIT Visualization Tool.
  *
+ * The tree is built in parallel using vtkSMPTools: the cells of the top level
+ * nodes are binned and partitioned concurrently, then the subtrees below are
+ * built as independent tasks. The resulting tree does not depend on the
+ * number of threads.
+ *
  * vtkCellTreeLocator utilizes the following parent class parameters:
  * - NumberOfCellsPerNode        (default 8)
  * - CacheCellBounds             (default true)
@@ -165,13 +165,19 @@ namespace
 { // anonymous
 struct ComputeCellBoundsVisitor
 {
-  // vtkCellArray::Visit entry point:
+  // vtkCellArray::Dispatch entry point:
   template <typename CellStateT>
-  void operator()(CellStateT& state, vtkPoints* points, vtkIdType cellId, double bounds[6]) const
+  void operator()(
+    const CellStateT& state, vtkPoints* points, vtkIdType cellId, double bounds[6]) const
   {
     const vtkIdType beginOffset = state.GetBeginOffset(cellId);
+    const auto* connectivity = state.GetConnectivity();
 
-    const auto pointIds = state.GetConnectivity()->GetPointer(beginOffset);
+    vtkIdType pointIds[8];
+    for (vtkIdType i = 0; i < 8; ++i)
+    {
+      pointIds[i] = static_cast<vtkIdType>(connectivity->GetValue(beginOffset + i));
+    }
     vtkBoundingBox::ComputeBounds(points, pointIds, 8, bounds);
   }
 };
@@ -187,7 +193,9 @@ void vtkExplicitStructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6]
     vtkErrorMacro(<< "No data");
     return;
   }
-  this->Cells->Visit(ComputeCellBoundsVisitor{}, this->Points, cellId, bounds);
+  // The const Dispatch() never converts the cell storage, so concurrent calls are safe.
+  const vtkCellArray* cells = this->Cells;
+  cells->Dispatch(ComputeCellBoundsVisitor{}, this->Points, cellId, bounds);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file vtkForEachCellOfType.h
+ * Parallel visitors of the cells of a vtkUnstructuredGrid or a vtkPolyData
+ * that do not instantiate vtkCell objects.
+ *
+ * ```
+ * vtk::ForEachCellOfType<VTK_TETRA>(grid,
+ *   [&](vtkIdType cellId, vtkIdType npts, const vtkIdType* pts, const double* x) { ... });
+ *
+ * vtk::ForEachCellOfTypes(grid, { VTK_TRIANGLE, VTK_QUAD },
+ *   [&](vtkIdType cellId, int cellType, vtkIdType npts, const vtkIdType* pts, const double* x)
+ *   { ... });
+ * ```
+ *
+ * The cells are visited in parallel with vtkSMPTools, so the functor must be
+ * thread-safe. pts are the point ids of the cell and x the coordinates of its
+ * points, stored contiguously (x0, y0, z0, x1, ...). Both spans are only valid
+ * during the call. ForEachCellOfTypes() visits the cells of all the given
+ * types in a single pass over the dataset. The cells of a vtkPolyData are
+ * built with BuildCells() beforehand if needed, and deleted cells are skipped.
+ *
+ * This header is not included by the dataset headers, include it where these
+ * visitors are used.
+ */
+
+#ifndef vtkForEachCellOfType_h
+#define vtkForEachCellOfType_h
+
+#include "vtkAOSDataArrayTemplate.h" // For fast paths on float and double points
+#include "vtkCellArray.h"            // For vtkCellArray
+#include "vtkCellType.h"             // For cell types
+#include "vtkDataArrayRange.h"       // For DataArrayTupleRange
+#include "vtkIdList.h"               // For vtkIdList
+#include "vtkPoints.h"               // For vtkPoints
+#include "vtkPolyData.h"             // For vtkPolyData
+#include "vtkSMPThreadLocal.h"       // For vtkSMPThreadLocal
+#include "vtkSMPThreadLocalObject.h" // For vtkSMPThreadLocalObject
+#include "vtkSMPTools.h"             // For vtkSMPTools
+#include "vtkUnsignedCharArray.h"    // For vtkUnsignedCharArray
+#include "vtkUnstructuredGrid.h"     // For vtkUnstructuredGrid
+
+#include <vector> // For std::vector
+
+namespace vtk
+{
+namespace detail
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+// Cell lookup of a vtkUnstructuredGrid, thread-safe.
+struct UnstructuredGridCellLocator
+{
+  const unsigned char* Types;
+  vtkCellArray* Cells;
+
+  int GetCellType(vtkIdType cellId) const { return this->Types[cellId]; }
+  void GetCellPoints(vtkIdType cellId, vtkIdList* ids, vtkIdType& npts, const vtkIdType*& pts) const
+  {
+    this->Cells->GetCellAtId(cellId, npts, pts, ids);
+  }
+};
+
+// Cell lookup of a vtkPolyData, thread-safe once its cells are built.
+struct PolyDataCellLocator
+{
+  vtkPolyData* PolyData;
+
+  int GetCellType(vtkIdType cellId) const { return this->PolyData->GetCellType(cellId); }
+  void GetCellPoints(vtkIdType cellId, vtkIdList* ids, vtkIdType& npts, const vtkIdType*& pts) const
+  {
+    this->PolyData->GetCellPoints(cellId, npts, pts, ids);
+  }
+};
+
+// Selects the cells of the types given at run time.
+struct CellTypeSelector
+{
+  static constexpr int NumberOfPoints = 0;
+  std::vector<bool> Selected;
+
+  CellTypeSelector(const std::vector<int>& cellTypes)
+    : Selected(VTK_NUMBER_OF_CELL_TYPES, false)
+  {
+    for (int cellType : cellTypes)
+    {
+      if (cellType > VTK_EMPTY_CELL && cellType < VTK_NUMBER_OF_CELL_TYPES)
+      {
+        this->Selected[cellType] = true;
+      }
+    }
+  }
+  bool operator()(int cellType) const { return this->Selected[cellType]; }
+};
+
+// Number of points of the cell types of fixed size, 0 for the other ones.
+template <int CellType>
+struct CellSize
+{
+  static constexpr int value = 0;
+};
+#define vtkForEachCellOfTypeSizeMacro(type, size)                                                  \
+  template <>                                                                                      \
+  struct CellSize<type>                                                                            \
+  {                                                                                                \
+    static constexpr int value = size;                                                             \
+  }
+vtkForEachCellOfTypeSizeMacro(VTK_VERTEX, 1);
+vtkForEachCellOfTypeSizeMacro(VTK_LINE, 2);
+vtkForEachCellOfTypeSizeMacro(VTK_TRIANGLE, 3);
+vtkForEachCellOfTypeSizeMacro(VTK_PIXEL, 4);
+vtkForEachCellOfTypeSizeMacro(VTK_QUAD, 4);
+vtkForEachCellOfTypeSizeMacro(VTK_TETRA, 4);
+vtkForEachCellOfTypeSizeMacro(VTK_VOXEL, 8);
+vtkForEachCellOfTypeSizeMacro(VTK_HEXAHEDRON, 8);
+vtkForEachCellOfTypeSizeMacro(VTK_WEDGE, 6);
+vtkForEachCellOfTypeSizeMacro(VTK_PYRAMID, 5);
+vtkForEachCellOfTypeSizeMacro(VTK_QUADRATIC_EDGE, 3);
+vtkForEachCellOfTypeSizeMacro(VTK_QUADRATIC_TRIANGLE, 6);
+vtkForEachCellOfTypeSizeMacro(VTK_QUADRATIC_QUAD, 8);
+vtkForEachCellOfTypeSizeMacro(VTK_QUADRATIC_TETRA, 10);
+vtkForEachCellOfTypeSizeMacro(VTK_QUADRATIC_HEXAHEDRON, 20);
+#undef vtkForEachCellOfTypeSizeMacro
+
+// Selects the cells of a type known at compile time. The coordinates of the
+// cells of fixed size are gathered in a loop of known length.
+template <int CellType>
+struct SingleCellTypeSelector
+{
+  static constexpr int NumberOfPoints = CellSize<CellType>::value;
+
+  bool operator()(int cellType) const { return cellType == CellType; }
+};
+
+// Copies the coordinates of the points of a cell to x.
+template <typename CoordsT>
+void GatherPoints(const CoordsT& coords, vtkIdType npts, const vtkIdType* pts, double* x)
+{
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    const auto point = coords[pts[i]];
+    x[3 * i] = static_cast<double>(point[0]);
+    x[3 * i + 1] = static_cast<double>(point[1]);
+    x[3 * i + 2] = static_cast<double>(point[2]);
+  }
+}
+
+// Visits in parallel the cells of [0, numCells) whose type is selected, and
+// calls the functor with the coordinates of their points.
+template <typename PointsArrayT, typename LocatorT, typename SelectorT, typename Functor>
+void ForEachCellOfTypesImpl(PointsArrayT* pointsData, vtkIdType numCells, const LocatorT& locator,
+  const SelectorT& selector, Functor& functor)
+{
+  constexpr int fixedSize = SelectorT::NumberOfPoints;
+  const auto coords = vtk::DataArrayTupleRange<3>(pointsData);
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPThreadLocal<std::vector<double>> tlX;
+
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ids = tlIds.Local();
+    std::vector<double>& x = tlX.Local();
+    double fixedX[3 * (fixedSize > 0 ? fixedSize : 1)];
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      const int cellType = locator.GetCellType(cellId);
+      if (cellType == VTK_EMPTY_CELL || !selector(cellType))
+      {
+        continue;
+      }
+      locator.GetCellPoints(cellId, ids, npts, pts);
+      if (fixedSize > 0 && npts == fixedSize)
+      {
+        GatherPoints(coords, fixedSize, pts, fixedX);
+        functor(cellId, cellType, npts, pts, fixedX);
+      }
+      else
+      {
+        x.resize(3 * static_cast<std::size_t>(npts));
+        GatherPoints(coords, npts, pts, x.data());
+        functor(cellId, cellType, npts, pts, x.data());
+      }
+    }
+  });
+}
+
+// Selects a fast path for the common float and double points.
+template <typename LocatorT, typename SelectorT, typename Functor>
+void ForEachCellOfTypes(vtkPoints* points, vtkIdType numCells, const LocatorT& locator,
+  const SelectorT& selector, Functor& functor)
+{
+  vtkDataArray* data = points ? points->GetData() : nullptr;
+  if (!data || numCells <= 0)
+  {
+    return;
+  }
+  if (auto floats = vtkArrayDownCast<vtkAOSDataArrayTemplate<float>>(data))
+  {
+    ForEachCellOfTypesImpl(floats, numCells, locator, selector, functor);
+  }
+  else if (auto doubles = vtkArrayDownCast<vtkAOSDataArrayTemplate<double>>(data))
+  {
+    ForEachCellOfTypesImpl(doubles, numCells, locator, selector, functor);
+  }
+  else
+  {
+    ForEachCellOfTypesImpl(data, numCells, locator, selector, functor);
+  }
+}
+
+template <typename SelectorT, typename Functor>
+void ForEachCellOfTypes(vtkUnstructuredGrid* grid, const SelectorT& selector, Functor& functor)
+{
+  vtkUnsignedCharArray* types = grid ? grid->GetCellTypesArray() : nullptr;
+  if (!types || !grid->GetCells())
+  {
+    return;
+  }
+  const UnstructuredGridCellLocator locator{ types->GetPointer(0), grid->GetCells() };
+  ForEachCellOfTypes(grid->GetPoints(), types->GetNumberOfValues(), locator, selector, functor);
+}
+
+template <typename SelectorT, typename Functor>
+void ForEachCellOfTypes(vtkPolyData* pdata, const SelectorT& selector, Functor& functor)
+{
+  if (!pdata || pdata->GetNumberOfCells() == 0)
+  {
+    return;
+  }
+  if (pdata->NeedToBuildCells())
+  {
+    pdata->BuildCells();
+  }
+  const PolyDataCellLocator locator{ pdata };
+  ForEachCellOfTypes(pdata->GetPoints(), pdata->GetNumberOfCells(), locator, selector, functor);
+}
+
+VTK_ABI_NAMESPACE_END
+} // end namespace detail
+
+VTK_ABI_NAMESPACE_BEGIN
+
+//------------------------------------------------------------------------------
+/**
+ * Call a functor on each cell of grid whose type is in cellTypes, as
+ * functor(cellId, cellType, npts, pts, x).
+ */
+template <typename Functor>
+void ForEachCellOfTypes(
+  vtkUnstructuredGrid* grid, const std::vector<int>& cellTypes, Functor&& functor)
+{
+  detail::ForEachCellOfTypes(grid, detail::CellTypeSelector(cellTypes), functor);
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Call a functor on each cell of pdata whose type is in cellTypes, as
+ * functor(cellId, cellType, npts, pts, x). The cells of pdata are built
+ * first if needed.
+ */
+template <typename Functor>
+void ForEachCellOfTypes(vtkPolyData* pdata, const std::vector<int>& cellTypes, Functor&& functor)
+{
+  detail::ForEachCellOfTypes(pdata, detail::CellTypeSelector(cellTypes), functor);
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Call a functor on each cell of type CellType (e.g. VTK_TETRA) of a
+ * vtkUnstructuredGrid or a vtkPolyData, as functor(cellId, npts, pts, x).
+ * The visitor is specialized for CellType: the type test is a comparison to
+ * a constant and the points of the cell types of fixed size are gathered in
+ * a loop of known length.
+ */
+template <int CellType, typename DataSetT, typename Functor>
+void ForEachCellOfType(DataSetT* dataset, Functor&& functor)
+{
+  auto visitor = [&functor](vtkIdType cellId, int, vtkIdType npts, const vtkIdType* pts,
+                   const double* x) { functor(cellId, npts, pts, x); };
+  detail::ForEachCellOfTypes(dataset, detail::SingleCellTypeSelector<CellType>(), visitor);
+}
+
+VTK_ABI_NAMESPACE_END
+} // end namespace vtk
+
+#endif // vtkForEachCellOfType_h
+// VTK-HeaderTest-Exclude: vtkForEachCellOfType.h
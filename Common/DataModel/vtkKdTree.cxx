@@ -11,6 +11,7 @@
 #include "vtkDataSet.h"
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkGarbageCollector.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -18,11 +19,15 @@
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -32,6 +37,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -637,25 +643,47 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     }
   }
 
-  double* weights = new double[maxCellSize];
-
-  float* cptr = center;
-  double dcenter[3];
-
-  if (set)
-  {
-    for (int j = 0; j < totalCells; j++)
+  // Cell centers are computed concurrently, one data set after the other.
+  vtkIdType offset = 0;
+  auto computeCenters = [&](vtkDataSet* iset) {
+    const vtkIdType nCells = iset->GetNumberOfCells();
+    if (nCells == 0)
     {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
+      return;
+    }
+    // Make GetCell() thread safe
+    vtkNew<vtkGenericCell> firstCell;
+    iset->GetCell(0, firstCell);
+
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    const std::vector<double> weightsExemplar(maxCellSize);
+    vtkSMPThreadLocal<std::vector<double>> tlWeights(weightsExemplar);
+    float* cptr = center + 3 * offset;
+    const vtkIdType progressOffset = offset;
+    vtkSMPTools::For(0, nCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkGenericCell* cell = tlCell.Local();
+      double* weights = tlWeights.Local().data();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      double dcenter[3];
+      for (vtkIdType j = begin; j < end; j++)
       {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
+        iset->GetCell(j, cell);
+        this->ComputeCellCenter(cell, dcenter, weights);
+        cptr[3 * j] = static_cast<float>(dcenter[0]);
+        cptr[3 * j + 1] = static_cast<float>(dcenter[1]);
+        cptr[3 * j + 2] = static_cast<float>(dcenter[2]);
+        if (isFirst && j % 1000 == 0)
+        {
+          this->UpdateSubOperationProgress(static_cast<double>(progressOffset + j) / totalCells);
+        }
       }
-    }
+    });
+    offset += nCells;
+  };
+
+  if (set)
+  {
+    computeCenters(set);
   }
   else
   {
@@ -664,25 +692,10 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
-      int nCells = iset->GetNumberOfCells();
-
-      for (int j = 0; j < nCells; j++)
-      {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
-        {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-        }
-      }
+      computeCenters(iset);
     }
   }
 
-  delete[] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
@@ -912,7 +925,7 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    this->DivideRegionInParallel(kd, ptarray, nullptr, 0);
 
     TIMERDONE("Build tree");
 
@@ -1255,13 +1268,13 @@ int vtkKdTree::DivideTest(int size, int level)
 }
 
 //------------------------------------------------------------------------------
-int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+bool vtkKdTree::DivideNode(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
   if (!ok)
   {
-    return 0;
+    return false;
   }
 
   int maxdim = this->SelectCutDirection(kd);
@@ -1310,9 +1323,15 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 
   this->DoMedianFind(kd, c1, ids, dim1, dim2, dim3);
 
-  if (kd->GetLeft() == nullptr)
+  return kd->GetLeft() != nullptr; // false if unable to divide region further
+}
+
+//------------------------------------------------------------------------------
+int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->DivideNode(kd, c1, ids, level))
   {
-    return 0; // unable to divide region further
+    return 0;
   }
 
   int nleft = kd->GetLeft()->GetNumberOfPoints();
@@ -1327,6 +1346,56 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// The regions of the top levels are divided one after the other, until they
+// are small enough to make a reasonable amount of independent work. The
+// subtrees below are then divided concurrently. Each subtree only reorders
+// its own range of the cell centers and creates its own nodes, so the
+// result does not depend on the number of threads and is the tree built by
+// DivideRegion().
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  struct Region
+  {
+    vtkKdNode* Node;
+    float* C1;
+    int* Ids;
+    int Level;
+  };
+
+  const int numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  const int subtreeSize = std::max(kd->GetNumberOfPoints() / (8 * numberOfThreads), 4096);
+
+  std::vector<Region> subtrees;
+  std::vector<Region> stack(1, Region{ kd, c1, ids, level });
+  while (!stack.empty())
+  {
+    const Region region = stack.back();
+    stack.pop_back();
+    if (region.Node->GetNumberOfPoints() <= subtreeSize)
+    {
+      subtrees.push_back(region);
+      continue;
+    }
+    if (!this->DivideNode(region.Node, region.C1, region.Ids, region.Level))
+    {
+      continue;
+    }
+    const int nleft = region.Node->GetLeft()->GetNumberOfPoints();
+    stack.push_back(Region{ region.Node->GetRight(), region.C1 + nleft * 3,
+      region.Ids ? region.Ids + nleft : nullptr, region.Level + 1 });
+    stack.push_back(Region{ region.Node->GetLeft(), region.C1, region.Ids, region.Level + 1 });
+  }
+
+  const vtkIdType numberOfSubtrees = static_cast<vtkIdType>(subtrees.size());
+  vtkSMPTools::For(0, numberOfSubtrees, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->DivideRegion(subtrees[i].Node, subtrees[i].C1, subtrees[i].Ids, subtrees[i].Level);
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 // Rearrange the point array.  Try dim1 first.  If there's a problem
 // go to dim2, then dim3.
@@ -1873,7 +1942,7 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  this->DivideRegionInParallel(kd, points, ptIds, 0);
 
   this->SetActualLevel();
   this->BuildRegionList();
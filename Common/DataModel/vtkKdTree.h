@@ -34,6 +34,10 @@
  *     tolerance, or you can use FindPoint and FindClosestPoint to
  *     locate points in the original set that the tree was built from.
  *
+ *     The cell centers are computed, and the regions below the top levels
+ *     of the tree are divided, concurrently using vtkSMPTools. The
+ *     decomposition does not depend on the number of threads.
+ *
  * @sa
  *      vtkLocator vtkCellLocator vtkPKdTree
  */
@@ -767,6 +771,8 @@ protected:
   void AddAllPointsInRegion(vtkKdNode* node, vtkIdTypeArray* ids);
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
+  bool DivideNode(vtkKdNode* kd, float* c1, int* ids, int level);
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids, int level);
 
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
@@ -23,6 +23,7 @@
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
@@ -410,7 +411,7 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 
   vtkCellArray* cells = this->GetCellArrayInternal(tag);
   const vtkIdType localCellId = tag.GetCellId();
-  cells->Visit(ComputeCellBoundsVisitor{}, this->Points, localCellId, bounds);
+  cells->Dispatch(ComputeCellBoundsVisitor{}, this->Points, localCellId, bounds);
 }
 
 //------------------------------------------------------------------------------
@@ -957,6 +958,13 @@ void vtkPolyData::SetLinks(vtkAbstractCellLinks* links)
       this->Links = cellLinks;
       this->Modified();
     }
+    else if (auto staticLinks = vtkStaticCellLinks::SafeDownCast(links))
+    {
+      // Promote the static links to editable ones
+      this->Links = vtkSmartPointer<vtkCellLinks>::New();
+      this->Links->DeepCopy(staticLinks);
+      this->Modified();
+    }
     else
     {
       vtkErrorMacro("Only vtkCellLinks are currently supported.");
@@ -372,7 +372,8 @@ public:
   /**
    * Set/Get the links that you created possibly without using BuildLinks.
    *
-   * Note: Only vtkCellLinks are currently supported.
+   * Note: Only vtkCellLinks are currently supported. A vtkStaticCellLinks is
+   * promoted to a vtkCellLinks holding a copy of its links.
    */
   virtual void SetLinks(vtkAbstractCellLinks* links);
   vtkGetSmartPointerMacro(Links, vtkAbstractCellLinks);
@@ -466,11 +466,10 @@ void vtkStaticCellLinksTemplate<TIds>::BuildLinks(vtkPolyData* pd)
   vtkIdType npts, CellId, ptId;
 
   // Visit the four arrays
-  for (CellId = 0, j = 0; j < 4; ++j)
+  for (j = 0; j < 4; ++j)
   {
     // Count number of point uses
-    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j], CellId);
-    CellId += numCells[j];
+    cellArrays[j]->Visit(vtkSCLT_detail::CountPoints{}, this->Offsets, 0, numCells[j]);
   } // for each of the four polydata cell arrays
 
   // Perform prefix sum (inclusive scan)
@@ -992,23 +992,25 @@ struct BucketList : public vtkBucketList
     // Place each point in a bucket
     //
     vtkPointSet* ps = vtkPointSet::SafeDownCast(this->DataSet);
-    if (ps)
+    vtkDataArray* pts = ps ? ps->GetPoints()->GetData() : nullptr;
+    int dataType = pts ? pts->GetDataType() : VTK_VOID;
+    if (pts && pts->HasStandardMemoryLayout() &&
+      (dataType == VTK_FLOAT || dataType == VTK_DOUBLE))
     { // map points array: explicit points representation of float or double
-      int dataType = ps->GetPoints()->GetDataType();
-      void* pts = ps->GetPoints()->GetVoidPointer(0);
       if (dataType == VTK_FLOAT)
       {
-        MapPointsArray<TIds, float> mapper(this, static_cast<float*>(pts));
+        MapPointsArray<TIds, float> mapper(this, static_cast<float*>(pts->GetVoidPointer(0)));
         vtkSMPTools::For(0, this->NumPts, mapper);
       }
-      else if (dataType == VTK_DOUBLE)
+      else
       {
-        MapPointsArray<TIds, double> mapper(this, static_cast<double*>(pts));
+        MapPointsArray<TIds, double> mapper(this, static_cast<double*>(pts->GetVoidPointer(0)));
         vtkSMPTools::For(0, this->NumPts, mapper);
       }
     }
-    else // if (!mapped)
-    {    // map dataset points: non-float points or implicit points representation
+    else
+    { // map dataset points: non-float points or implicit points representation,
+      // decoded point by point so implicit arrays are never densified
       MapDataSet<TIds> mapper(this, this->DataSet);
       vtkSMPTools::For(0, this->NumPts, mapper);
     }
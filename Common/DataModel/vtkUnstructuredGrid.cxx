@@ -1176,7 +1176,7 @@ struct ComputeCellBoundsVisitor
 // constructing a cell.
 void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
-  this->Connectivity->Visit(ComputeCellBoundsVisitor{}, this->Points, cellId, bounds);
+  this->Connectivity->Dispatch(ComputeCellBoundsVisitor{}, this->Points, cellId, bounds);
 }
 
 //------------------------------------------------------------------------------
@@ -1501,6 +1501,22 @@ void vtkUnstructuredGrid::BuildLinks()
     }
     this->Links->SetDataSet(this);
   }
+  else if (this->Editable && !vtkCellLinks::SafeDownCast(this->Links))
+  {
+    // The dataset was made editable after static links were built: promote
+    // them to editable links instead of traversing the cells again.
+    vtkSmartPointer<vtkCellLinks> links = vtkSmartPointer<vtkCellLinks>::New();
+    if (vtkStaticCellLinks::SafeDownCast(this->Links))
+    {
+      this->Links->SetDataSet(this);
+      links->DeepCopy(this->Links);
+    }
+    else
+    {
+      links->SetDataSet(this);
+    }
+    this->Links = links;
+  }
   else if (this->Points->GetMTime() > this->Links->GetMTime())
   {
     this->Links->SetDataSet(this);
@@ -2171,14 +2187,16 @@ bool vtkUnstructuredGrid::IsCellBoundary(
     using CellLinksType = vtkStaticCellLinks;
     using TIsCellBoundary = IsCellBoundaryImpl<CellLinksType>;
     auto links = static_cast<CellLinksType*>(this->Links.Get());
-    return this->Connectivity->Visit(TIsCellBoundary{}, links, cellId, npts, pts, neighborCellId);
+    return this->Connectivity->Dispatch(
+      TIsCellBoundary{}, links, cellId, npts, pts, neighborCellId);
   }
   else
   {
     using CellLinksType = vtkCellLinks;
     using TIsCellBoundary = IsCellBoundaryImpl<CellLinksType>;
     auto links = static_cast<CellLinksType*>(this->Links.Get());
-    return this->Connectivity->Visit(TIsCellBoundary{}, links, cellId, npts, pts, neighborCellId);
+    return this->Connectivity->Dispatch(
+      TIsCellBoundary{}, links, cellId, npts, pts, neighborCellId);
   }
 }
 
@@ -2210,14 +2228,14 @@ void vtkUnstructuredGrid::GetCellNeighbors(
     using CellLinksType = vtkStaticCellLinks;
     using TGetCellNeighbors = GetCellNeighborsImpl<CellLinksType>;
     auto links = static_cast<CellLinksType*>(this->Links.Get());
-    return this->Connectivity->Visit(TGetCellNeighbors{}, links, cellId, npts, pts, cellIds);
+    return this->Connectivity->Dispatch(TGetCellNeighbors{}, links, cellId, npts, pts, cellIds);
   }
   else
   {
     using CellLinksType = vtkCellLinks;
     using TGetCellNeighbors = GetCellNeighborsImpl<CellLinksType>;
     auto links = static_cast<CellLinksType*>(this->Links.Get());
-    return this->Connectivity->Visit(TGetCellNeighbors{}, links, cellId, npts, pts, cellIds);
+    return this->Connectivity->Dispatch(TGetCellNeighbors{}, links, cellId, npts, pts, cellIds);
   }
 }
 
@@ -267,7 +267,9 @@ public:
 
   /**
    * Build topological links from points to lists of cells that use each point.
-   * See vtkAbstractCellLinks for more information.
+   * See vtkAbstractCellLinks for more information. When the grid is made
+   * Editable after static links were built, the static links are promoted to
+   * editable vtkCellLinks.
    */
   void BuildLinks();
 
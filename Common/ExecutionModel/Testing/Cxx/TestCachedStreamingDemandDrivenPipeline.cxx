@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkCachedStreamingDemandDrivenPipeline satisfies requests for
+// previous time steps and pieces from its cache, and respects its limits.
+
+#include "vtkCachedStreamingDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <cstdlib>
+
+namespace
+{
+#define CHECK(cond)                                                                                \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "ERROR: " << #cond << " failed at line " << __LINE__ << std::endl;              \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+// Source with 10 time steps, whose output has 1000 * (time + 1) + piece points.
+class TimeSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeSource* New();
+  vtkTypeMacro(TimeSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  TimeSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[10];
+    for (int i = 0; i < 10; ++i)
+    {
+      timeSteps[i] = i;
+    }
+    double timeRange[2] = { 0.0, 9.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(1000 * (static_cast<vtkIdType>(time) + 1) + piece);
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      points->SetPoint(i, i, time, piece);
+    }
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeSource);
+
+vtkIdType Update(TimeSource* source, double time, int piece = 0, int numberOfPieces = 1)
+{
+  source->UpdateTimeStep(time, piece, numberOfPieces);
+  return source->GetOutput()->GetNumberOfPoints();
+}
+}
+
+int TestCachedStreamingDemandDrivenPipeline(int, char*[])
+{
+  vtkNew<TimeSource> source;
+  vtkNew<vtkCachedStreamingDemandDrivenPipeline> cache;
+  source->SetExecutive(cache);
+  cache->SetCacheSize(3);
+
+  // Least recently used eviction.
+  CHECK(::Update(source, 0) == 1000 && ::Update(source, 1) == 2000 && ::Update(source, 2) == 3000);
+  CHECK(source->NumberOfExecutions == 3 && cache->GetNumberOfCacheMisses() == 3);
+  CHECK(::Update(source, 0) == 1000);
+  CHECK(source->NumberOfExecutions == 3 && cache->GetNumberOfCacheHits() == 1);
+  CHECK(source->GetOutput()->GetPoint(999)[1] == 0.0);
+  CHECK(::Update(source, 3) == 4000); // evicts time 1
+  CHECK(cache->GetNumberOfCacheEvictions() == 1 && cache->GetNumberOfCachedOutputs() == 3);
+  CHECK(::Update(source, 2) == 3000 && source->NumberOfExecutions == 4);
+  CHECK(::Update(source, 1) == 2000 && source->NumberOfExecutions == 5);
+
+  // Pieces are cached separately.
+  cache->SetCacheSize(10);
+  CHECK(::Update(source, 1, 1, 2) == 2001 && source->NumberOfExecutions == 6);
+  CHECK(::Update(source, 1, 0, 2) == 2000 && source->NumberOfExecutions == 7);
+  CHECK(::Update(source, 1, 1, 2) == 2001 && source->NumberOfExecutions == 7);
+  CHECK(::Update(source, 1) == 2000 && source->NumberOfExecutions == 7);
+
+  // Memory limit.
+  const vtkTypeUInt64 size = 1024 * source->GetOutput()->GetActualMemorySize();
+  cache->SetCacheMemoryLimit(size + size / 2);
+  CHECK(cache->GetNumberOfCachedOutputs() == 1 && cache->GetCacheMemorySize() <= size + size / 2);
+  CHECK(::Update(source, 1) == 2000 && source->NumberOfExecutions == 7);
+  cache->SetCacheMemoryLimit(0);
+
+  // Cost aware eviction keeps the limits.
+  cache->SetEvictionPolicyToCostAware();
+  cache->SetCacheSize(2);
+  for (int i = 0; i < 10; ++i)
+  {
+    CHECK(::Update(source, i) == 1000 * (i + 1));
+    CHECK(cache->GetNumberOfCachedOutputs() <= 2);
+  }
+  CHECK(::Update(source, 9) == 10000 && ::Update(source, 8) == 9000);
+
+  // Modifying the pipeline invalidates the cache.
+  const int executions = source->NumberOfExecutions;
+  source->Modified();
+  CHECK(::Update(source, 9) == 10000 && source->NumberOfExecutions == executions + 1);
+  CHECK(::Update(source, 8) == 9000 && source->NumberOfExecutions == executions + 2);
+
+  cache->ResetCacheStatistics();
+  cache->ClearCache();
+  CHECK(cache->GetNumberOfCacheHits() == 0 && cache->GetNumberOfCachedOutputs() == 0);
+  CHECK(::Update(source, 9) == 10000 && cache->GetNumberOfCacheMisses() == 1);
+  cache->Print(std::cout);
+  return EXIT_SUCCESS;
+}
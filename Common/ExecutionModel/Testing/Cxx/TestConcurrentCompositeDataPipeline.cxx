@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Executes a fan-out pipeline, where a contour, a slice, glyphs and a
+// threshold of the same image are appended, with and without
+// vtkConcurrentCompositeDataPipeline, checks that both give the same output
+// and reports the time taken by both.
+
+#include "vtkAppendFilter.h"
+#include "vtkConcurrentCompositeDataPipeline.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkGlyph3D.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMaskPoints.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+struct FanOutPipeline
+{
+  vtkNew<vtkRTAnalyticSource> Source;
+  vtkNew<vtkContourFilter> Contour;
+  vtkNew<vtkCutter> Cutter;
+  vtkNew<vtkPlane> Plane;
+  vtkNew<vtkMaskPoints> Mask;
+  vtkNew<vtkGlyph3D> Glyph;
+  vtkNew<vtkThreshold> Threshold;
+  vtkNew<vtkAppendFilter> Append;
+
+  FanOutPipeline(int extent, vtkExecutive* executive = nullptr)
+  {
+    // The executive must be set before the inputs are connected.
+    if (executive)
+    {
+      this->Append->SetExecutive(executive);
+    }
+    this->Source->SetWholeExtent(-extent, extent, -extent, extent, -extent, extent);
+    this->Contour->SetInputConnection(this->Source->GetOutputPort());
+    this->Contour->SetValue(0, 150.0);
+    this->Contour->SetValue(1, 200.0);
+    this->Plane->SetNormal(1.0, 1.0, 0.0);
+    this->Cutter->SetInputConnection(this->Source->GetOutputPort());
+    this->Cutter->SetCutFunction(this->Plane);
+    this->Mask->SetInputConnection(this->Source->GetOutputPort());
+    this->Mask->SetOnRatio(7);
+    this->Mask->SetMaximumNumberOfPoints(VTK_ID_MAX);
+    this->Glyph->SetInputConnection(this->Mask->GetOutputPort());
+    this->Glyph->SetScaleFactor(0.5);
+    this->Threshold->SetInputConnection(this->Source->GetOutputPort());
+    this->Threshold->SetUpperThreshold(220.0);
+    this->Threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_UPPER);
+    this->Append->AddInputConnection(this->Contour->GetOutputPort());
+    this->Append->AddInputConnection(this->Cutter->GetOutputPort());
+    this->Append->AddInputConnection(this->Glyph->GetOutputPort());
+    this->Append->AddInputConnection(this->Threshold->GetOutputPort());
+  }
+
+  void SetThreadSafe(bool threadSafe)
+  {
+    vtkAlgorithm* algorithms[] = { this->Source, this->Contour, this->Cutter, this->Mask,
+      this->Glyph, this->Threshold };
+    for (vtkAlgorithm* algorithm : algorithms)
+    {
+      algorithm->GetInformation()->Set(vtkConcurrentCompositeDataPipeline::THREAD_SAFE(), 1);
+    }
+    if (!threadSafe)
+    {
+      this->Mask->GetInformation()->Remove(vtkConcurrentCompositeDataPipeline::THREAD_SAFE());
+    }
+  }
+
+  // Average time in seconds of a few updates after modifying the source.
+  double Time(int repeat)
+  {
+    double time = 0.0;
+    for (int i = 0; i < repeat; ++i)
+    {
+      this->Source->SetMaximum(255.0 + i);
+      auto start = std::chrono::steady_clock::now();
+      this->Append->Update();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      time += elapsed.count();
+    }
+    return time / repeat;
+  }
+};
+}
+
+int TestConcurrentCompositeDataPipeline(int, char*[])
+{
+  const int extent = 40;
+  const int repeat = 3;
+
+  ::FanOutPipeline serial(extent);
+  const double serialTime = serial.Time(repeat);
+
+  vtkNew<vtkConcurrentCompositeDataPipeline> executive;
+  ::FanOutPipeline concurrent(extent, executive);
+  concurrent.SetThreadSafe(true);
+  const double concurrentTime = concurrent.Time(repeat);
+
+  std::cout << "Fan-out pipeline with " << vtkSMPTools::GetEstimatedNumberOfThreads()
+            << " threads (" << vtkSMPTools::GetBackend() << "): " << serialTime
+            << " s sequential, " << concurrentTime << " s concurrent, speedup "
+            << serialTime / concurrentTime << std::endl;
+
+  if (executive->GetLastNumberOfConcurrentExecutives() != 4)
+  {
+    vtkLog(ERROR,
+      "Expected 4 concurrent executives, got " << executive->GetLastNumberOfConcurrentExecutives());
+    return EXIT_FAILURE;
+  }
+
+  vtkUnstructuredGrid* expected = serial.Append->GetOutput();
+  vtkUnstructuredGrid* output = concurrent.Append->GetOutput();
+  if (expected->GetNumberOfPoints() == 0 ||
+    output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      "Concurrent output has " << output->GetNumberOfPoints() << " points and "
+                               << output->GetNumberOfCells() << " cells instead of "
+                               << expected->GetNumberOfPoints() << " and "
+                               << expected->GetNumberOfCells());
+    return EXIT_FAILURE;
+  }
+
+  // An algorithm that is not thread safe runs on the calling thread.
+  concurrent.SetThreadSafe(false);
+  concurrent.Source->SetMaximum(255.0 + repeat - 1);
+  concurrent.Source->Modified();
+  concurrent.Append->Update();
+  serial.Source->Modified();
+  serial.Append->Update();
+  if (executive->GetLastNumberOfConcurrentExecutives() != 3 ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    vtkLog(ERROR, "Unexpected output with an algorithm that is not thread safe.");
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is executed when the pipeline is up to date.
+  const vtkMTimeType time = output->GetMTime();
+  concurrent.Append->Update();
+  if (output->GetMTime() != time)
+  {
+    vtkLog(ERROR, "The pipeline was executed although it is up to date.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
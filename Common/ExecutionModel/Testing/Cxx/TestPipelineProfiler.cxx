@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Profiles a small pipeline with vtkPipelineProfiler and checks the recorded
+// requests, SMP tasks and Chrome trace.
+
+#include "vtkElevationFilter.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-30, 30, -30, 30, -30, 30);
+  vtkNew<vtkFlyingEdges3D> contour;
+  contour->SetInputConnection(source->GetOutputPort());
+  contour->SetValue(0, 150.0);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(contour->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  profiler->Start();
+  elevation->Update();
+  profiler->Stop();
+
+  if (profiler->GetTotalTime(contour, "REQUEST_DATA") <= 0.0 ||
+    profiler->GetTotalTime(source, "REQUEST_INFORMATION") <= 0.0 ||
+    profiler->GetTotalTime(elevation, "REQUEST_UPDATE_EXTENT") <= 0.0)
+  {
+    vtkLog(ERROR, "Missing requests.");
+    return EXIT_FAILURE;
+  }
+  if (profiler->GetTotalTime(contour) < profiler->GetTotalTime(contour, "REQUEST_DATA"))
+  {
+    vtkLog(ERROR, "Wrong total time.");
+    return EXIT_FAILURE;
+  }
+  if (profiler->GetOutputMemorySize(contour) == 0 ||
+    profiler->GetOutputMemorySize(contour) != contour->GetOutput()->GetActualMemorySize())
+  {
+    vtkLog(ERROR, "Wrong output memory size: " << profiler->GetOutputMemorySize(contour));
+    return EXIT_FAILURE;
+  }
+  const bool parallel = std::string(vtkSMPTools::GetBackend()) != "Sequential";
+  if (parallel && profiler->GetNumberOfSMPTasks() == 0)
+  {
+    vtkLog(ERROR, "No SMP task recorded with the " << vtkSMPTools::GetBackend() << " backend.");
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  const std::string json = trace.str();
+  if (json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") != 0 ||
+    json.find("\"cat\":\"REQUEST_DATA\"") == std::string::npos ||
+    json.find("vtkFlyingEdges3D") == std::string::npos ||
+    (parallel && json.find("\"cat\":\"SMP\"") == std::string::npos))
+  {
+    vtkLog(ERROR, "Unexpected trace:\n" << json);
+    return EXIT_FAILURE;
+  }
+  profiler->PrintSummary(std::cout);
+
+  // Nothing is recorded once stopped.
+  const vtkIdType numberOfRequests = profiler->GetNumberOfRequests();
+  source->Modified();
+  elevation->Update();
+  if (profiler->IsRecording() || profiler->GetNumberOfRequests() != numberOfRequests)
+  {
+    vtkLog(ERROR, "Requests recorded after Stop().");
+    return EXIT_FAILURE;
+  }
+  profiler->Clear();
+  if (profiler->GetNumberOfRequests() != 0 || profiler->GetNumberOfSMPTasks() != 0)
+  {
+    vtkLog(ERROR, "Events remain after Clear().");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Executes a filter using vtkSMPTools on a multiblock made of one large block
+// and many small ones, and checks that vtkThreadedCompositeDataPipeline
+// executes the large block outside of its parallel loop over the blocks, but
+// keeps blocks of similar sizes in the loop.
+
+#include "vtkDataSetAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+constexpr int NUMBER_OF_SMALL_BLOCKS = 200;
+constexpr int LARGE_BLOCK_DIMENSION = 60;
+
+// Filter passing its input through after visiting its cells with vtkSMPTools.
+class SMPVisitCells : public vtkDataSetAlgorithm
+{
+public:
+  static SMPVisitCells* New();
+  vtkTypeMacro(SMPVisitCells, vtkDataSetAlgorithm);
+
+  std::atomic<int> NumberOfExecutions{ 0 };
+  std::atomic<int> LargeBlockInParallelScope{ -1 };
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+    vtkDataSet* output = vtkDataSet::GetData(outputVector);
+    const vtkIdType numberOfCells = input->GetNumberOfCells();
+    std::atomic<double> sum{ 0.0 };
+    vtkSMPTools::For(0, numberOfCells, [&sum](vtkIdType begin, vtkIdType end) {
+      double local = 0.0;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        local += std::sqrt(static_cast<double>(i));
+      }
+      double expected = sum.load();
+      while (!sum.compare_exchange_weak(expected, expected + local))
+      {
+      }
+    });
+    if (numberOfCells > 1000)
+    {
+      this->LargeBlockInParallelScope = vtkSMPTools::IsParallelScope() ? 1 : 0;
+    }
+    output->ShallowCopy(input);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+};
+vtkStandardNewMacro(SMPVisitCells);
+
+bool CheckOutput(vtkMultiBlockDataSet* input, vtkMultiBlockDataSet* output)
+{
+  if (output->GetNumberOfBlocks() != input->GetNumberOfBlocks())
+  {
+    return false;
+  }
+  for (unsigned int i = 0; i < input->GetNumberOfBlocks(); ++i)
+  {
+    vtkDataSet* block = vtkDataSet::SafeDownCast(output->GetBlock(i));
+    if (!block ||
+      block->GetNumberOfCells() != vtkDataSet::SafeDownCast(input->GetBlock(i))->GetNumberOfCells())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThreadedCompositeDataPipelineLoadBalancing(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(NUMBER_OF_SMALL_BLOCKS + 1);
+  for (int i = 0; i <= NUMBER_OF_SMALL_BLOCKS; ++i)
+  {
+    const int dimension = i == NUMBER_OF_SMALL_BLOCKS / 2 ? LARGE_BLOCK_DIMENSION : 3;
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(dimension, dimension, dimension);
+    input->SetBlock(i, image);
+  }
+
+  vtkNew<SMPVisitCells> filter;
+  vtkNew<vtkThreadedCompositeDataPipeline> executive;
+  filter->SetExecutive(executive);
+  filter->SetInputData(input);
+
+  for (bool loadBalancing : { false, true })
+  {
+    executive->SetLoadBalancing(loadBalancing);
+    filter->NumberOfExecutions = 0;
+    filter->Modified();
+    filter->Update();
+
+    if (filter->NumberOfExecutions != NUMBER_OF_SMALL_BLOCKS + 1 ||
+      !CheckOutput(input, vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0))))
+    {
+      vtkLog(ERROR, "Wrong output with load balancing " << loadBalancing);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The large block is executed alone, so that the filter can use all the threads.
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() > 1 && filter->LargeBlockInParallelScope != 0)
+  {
+    vtkLog(ERROR, "The large block was executed in the parallel loop over the blocks.");
+    return EXIT_FAILURE;
+  }
+
+  // Blocks of the same size are all executed in the parallel loop.
+  vtkNew<vtkMultiBlockDataSet> sameSizeInput;
+  sameSizeInput->SetNumberOfBlocks(2);
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(20, 20, 20);
+    sameSizeInput->SetBlock(i, image);
+  }
+  filter->SetInputData(sameSizeInput);
+  filter->LargeBlockInParallelScope = -1;
+  filter->Update();
+  if (!CheckOutput(
+        sameSizeInput, vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0))))
+  {
+    vtkLog(ERROR, "Wrong output for blocks of the same size.");
+    return EXIT_FAILURE;
+  }
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() > 1 && filter->LargeBlockInParallelScope != 1)
+  {
+    vtkLog(ERROR, "Blocks of the same size were executed outside of the parallel loop.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -296,6 +296,15 @@ public:
    * \ingroup InformationKeys
    */
   static vtkInformationInformationVectorKey* INPUT_REQUIRED_FIELDS();
+  /**
+   * Key set in the information of an input port by algorithms that can
+   * modify the data object of this port in place, e.g. overwrite one of its
+   * arrays instead of allocating a new one. The executive decides for each
+   * execution whether they may do so, see
+   * vtkDemandDrivenPipeline::DATA_MODIFIABLE_IN_PLACE().
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* INPUT_MODIFIABLE_IN_PLACE();
   /**
    * \ingroup InformationKeys
    */
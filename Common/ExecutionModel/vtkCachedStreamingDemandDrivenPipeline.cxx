@@ -7,70 +7,207 @@
 #include "vtkObjectFactory.h"
 
 #include "vtkAlgorithm.h"
-#include "vtkAlgorithmOutput.h"
-#include "vtkImageData.h"
+#include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
 #include "vtkInformationVector.h"
-#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCachedStreamingDemandDrivenPipeline);
 
 //------------------------------------------------------------------------------
-vtkCachedStreamingDemandDrivenPipeline ::vtkCachedStreamingDemandDrivenPipeline()
+namespace
+{
+// A cached output, with the request it was generated for.
+struct CacheEntry
 {
-  this->CacheSize = 0;
-  this->Data = nullptr;
-  this->Times = nullptr;
+  vtkSmartPointer<vtkDataObject> Data;
+  vtkMTimeType UpdateTime = 0;
+
+  bool HasTimeStep = false;
+  double TimeStep = 0.0;
+  int Piece = 0;
+  int NumberOfPieces = 1;
+  int GhostLevels = 0;
+  bool HasExtent = false;
+  int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+
+  vtkTypeUInt64 Size = 0;
+  double Cost = 0.0;
+  vtkIdType LastUse = 0;
+  double Priority = 0.0;
+
+  // Whether this output satisfies the request of the output information.
+  bool Satisfies(vtkInformation* outInfo) const
+  {
+    const int numberOfPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    const int ghostLevels =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    if (this->NumberOfPieces != numberOfPieces ||
+      (numberOfPieces > 1 && this->GhostLevels < ghostLevels) ||
+      (this->NumberOfPieces != 1 && this->Piece != piece))
+    {
+      return false;
+    }
+
+    // Check the structured extent, an empty update extent is always satisfied.
+    if (this->HasExtent && outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+    {
+      int updateExtent[6];
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), updateExtent);
+      if ((updateExtent[0] < this->Extent[0] || updateExtent[1] > this->Extent[1] ||
+            updateExtent[2] < this->Extent[2] || updateExtent[3] > this->Extent[3] ||
+            updateExtent[4] < this->Extent[4] || updateExtent[5] > this->Extent[5]) &&
+        (updateExtent[0] <= updateExtent[1] && updateExtent[2] <= updateExtent[3] &&
+          updateExtent[4] <= updateExtent[5]))
+      {
+        return false;
+      }
+    }
+
+    // The time request only matters if the pipeline provides time.
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()) &&
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+    {
+      return this->HasTimeStep &&
+        this->TimeStep == outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    }
+    return true;
+  }
 
-  this->SetCacheSize(10);
+  bool HasSameRequest(const CacheEntry& other) const
+  {
+    return this->HasTimeStep == other.HasTimeStep &&
+      (!this->HasTimeStep || this->TimeStep == other.TimeStep) && this->Piece == other.Piece &&
+      this->NumberOfPieces == other.NumberOfPieces && this->GhostLevels == other.GhostLevels &&
+      this->HasExtent == other.HasExtent &&
+      (!this->HasExtent || std::equal(this->Extent, this->Extent + 6, other.Extent));
+  }
+};
 }
 
 //------------------------------------------------------------------------------
-vtkCachedStreamingDemandDrivenPipeline ::~vtkCachedStreamingDemandDrivenPipeline()
+class vtkCachedStreamingDemandDrivenPipeline::vtkInternals
+{
+public:
+  // Mark an entry as used, updating its priority for the cost aware policy.
+  void Use(CacheEntry& entry)
+  {
+    entry.LastUse = ++this->UseCounter;
+    entry.Priority =
+      this->Inflation + entry.Cost / static_cast<double>(std::max<vtkTypeUInt64>(entry.Size, 1));
+  }
+
+  vtkTypeUInt64 GetMemorySize() const
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& entry : this->Entries)
+    {
+      size += entry.Size;
+    }
+    return size;
+  }
+
+  std::vector<CacheEntry> Entries;
+  vtkIdType UseCounter = 0;
+  // Priority of the last output evicted by the cost aware policy.
+  double Inflation = 0.0;
+};
+
+//------------------------------------------------------------------------------
+vtkCachedStreamingDemandDrivenPipeline ::vtkCachedStreamingDemandDrivenPipeline()
+  : Internals(new vtkInternals)
 {
-  this->SetCacheSize(0);
+  this->CacheSize = 10;
 }
 
+//------------------------------------------------------------------------------
+vtkCachedStreamingDemandDrivenPipeline ::~vtkCachedStreamingDemandDrivenPipeline() = default;
+
 //------------------------------------------------------------------------------
 void vtkCachedStreamingDemandDrivenPipeline::SetCacheSize(int size)
 {
-  int idx;
-
+  size = std::max(size, 0);
   if (size == this->CacheSize)
   {
     return;
   }
-
+  this->CacheSize = size;
+  this->EvictOutputs();
   this->Modified();
+}
 
-  // free the old data
-  for (idx = 0; idx < this->CacheSize; ++idx)
-  {
-    if (this->Data[idx])
-    {
-      this->Data[idx]->Delete();
-      this->Data[idx] = nullptr;
-    }
-  }
-  delete[] this->Data;
-  this->Data = nullptr;
-  delete[] this->Times;
-  this->Times = nullptr;
-
-  this->CacheSize = size;
-  if (size == 0)
+//------------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::SetCacheMemoryLimit(vtkTypeUInt64 limit)
+{
+  if (limit == this->CacheMemoryLimit)
   {
     return;
   }
+  this->CacheMemoryLimit = limit;
+  this->EvictOutputs();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::ClearCache()
+{
+  this->Internals->Entries.clear();
+  this->Internals->Inflation = 0.0;
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedStreamingDemandDrivenPipeline::GetNumberOfCachedOutputs()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkCachedStreamingDemandDrivenPipeline::GetCacheMemorySize()
+{
+  return this->Internals->GetMemorySize();
+}
 
-  this->Data = new vtkDataObject*[size];
-  this->Times = new vtkMTimeType[size];
+//------------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::ResetCacheStatistics()
+{
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
+  this->NumberOfCacheEvictions = 0;
+}
 
-  for (idx = 0; idx < size; ++idx)
+//------------------------------------------------------------------------------
+void vtkCachedStreamingDemandDrivenPipeline::EvictOutputs()
+{
+  auto& entries = this->Internals->Entries;
+  vtkTypeUInt64 memorySize = this->Internals->GetMemorySize();
+  while (!entries.empty() &&
+    (static_cast<int>(entries.size()) > this->CacheSize ||
+      (this->CacheMemoryLimit > 0 && memorySize > this->CacheMemoryLimit)))
   {
-    this->Data[idx] = nullptr;
-    this->Times[idx] = 0;
+    auto evicted = entries.begin();
+    if (this->EvictionPolicy == COST_AWARE)
+    {
+      evicted = std::min_element(entries.begin(), entries.end(),
+        [](const CacheEntry& a, const CacheEntry& b) { return a.Priority < b.Priority; });
+      this->Internals->Inflation = evicted->Priority;
+    }
+    else
+    {
+      evicted = std::min_element(entries.begin(), entries.end(),
+        [](const CacheEntry& a, const CacheEntry& b) { return a.LastUse < b.LastUse; });
+    }
+    memorySize -= evicted->Size;
+    entries.erase(evicted);
+    ++this->NumberOfCacheEvictions;
   }
 }
 
@@ -79,6 +216,13 @@ void vtkCachedStreamingDemandDrivenPipeline ::PrintSelf(ostream& os, vtkIndent i
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "CacheSize: " << this->CacheSize << "\n";
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "EvictionPolicy: "
+     << (this->EvictionPolicy == COST_AWARE ? "COST_AWARE" : "LEAST_RECENTLY_USED") << "\n";
+  os << indent << "NumberOfCachedOutputs: " << this->Internals->Entries.size() << "\n";
+  os << indent << "NumberOfCacheHits: " << this->NumberOfCacheHits << "\n";
+  os << indent << "NumberOfCacheMisses: " << this->NumberOfCacheMisses << "\n";
+  os << indent << "NumberOfCacheEvictions: " << this->NumberOfCacheEvictions << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -92,6 +236,13 @@ int vtkCachedStreamingDemandDrivenPipeline ::NeedToExecuteData(
     return this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec);
   }
 
+  // Discard the outputs generated before the pipeline was modified.
+  auto& entries = this->Internals->Entries;
+  const vtkMTimeType pmt = this->GetPipelineMTime();
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                  [pmt](const CacheEntry& entry) { return entry.UpdateTime < pmt; }),
+    entries.end());
+
   // Does the superclass want to execute? We must skip our direct superclass
   // because it looks at update extents but does not know about the cache
   // NOLINTNEXTLINE(bugprone-parent-virtual-call)
@@ -106,91 +257,28 @@ int vtkCachedStreamingDemandDrivenPipeline ::NeedToExecuteData(
     return 1;
   }
 
-  // First look through the cached data to see if it is still valid.
-  int i;
-  vtkMTimeType pmt = this->GetPipelineMTime();
-  for (i = 0; i < this->CacheSize; ++i)
+  // Is the current output fine?
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
   {
-    if (this->Data[i] && this->Times[i] < pmt)
-    {
-      this->Data[i]->Delete();
-      this->Data[i] = nullptr;
-      this->Times[i] = 0;
-    }
+    return 0;
   }
 
-  // We need to check the requested update extent.  Get the output
-  // port information and data information.  We do not need to check
-  // existence of values because it has already been verified by
-  // VerifyOutputInformation.
+  // Look for a cached output satisfying the request and pass it to the output.
   vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
-  vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
-  vtkInformation* dataInfo = dataObject->GetInformation();
-  if (dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) == VTK_PIECES_EXTENT)
+  for (auto& entry : entries)
   {
-    int updatePiece = outInfo->Get(UPDATE_PIECE_NUMBER());
-    int updateNumberOfPieces = outInfo->Get(UPDATE_NUMBER_OF_PIECES());
-    int updateGhostLevel = outInfo->Get(UPDATE_NUMBER_OF_GHOST_LEVELS());
-
-    // check to see if any data in the cache fits this request
-    for (i = 0; i < this->CacheSize; ++i)
-    {
-      if (this->Data[i])
-      {
-        dataInfo = this->Data[i]->GetInformation();
-
-        // Check the unstructured extent.  If we do not have the requested
-        // piece, we need to execute.
-        int dataPiece = dataInfo->Get(vtkDataObject::DATA_PIECE_NUMBER());
-        int dataNumberOfPieces = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_PIECES());
-        int dataGhostLevel = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
-        if (dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) == VTK_PIECES_EXTENT &&
-          dataPiece == updatePiece && dataNumberOfPieces == updateNumberOfPieces &&
-          dataGhostLevel == updateGhostLevel)
-        {
-          // we have a matching data we must copy it to our output, but for
-          // now we don't support polydata
-          return 1;
-        }
-      }
-    }
-  }
-  else if (dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) == VTK_3D_EXTENT)
-  {
-    // Check the structured extent.  If the update extent is outside
-    // of the extent and not empty, we need to execute.
-    int dataExtent[6];
-    int updateExtent[6];
-    outInfo->Get(UPDATE_EXTENT(), updateExtent);
-
-    // check to see if any data in the cache fits this request
-    for (i = 0; i < this->CacheSize; ++i)
+    if (entry.Satisfies(outInfo))
     {
-      if (this->Data[i])
-      {
-        dataInfo = this->Data[i]->GetInformation();
-        dataInfo->Get(vtkDataObject::DATA_EXTENT(), dataExtent);
-        if (dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) == VTK_3D_EXTENT &&
-          !(updateExtent[0] < dataExtent[0] || updateExtent[1] > dataExtent[1] ||
-            updateExtent[2] < dataExtent[2] || updateExtent[3] > dataExtent[3] ||
-            updateExtent[4] < dataExtent[4] || updateExtent[5] > dataExtent[5]) &&
-          (updateExtent[0] <= updateExtent[1] && updateExtent[2] <= updateExtent[3] &&
-            updateExtent[4] <= updateExtent[5]))
-        {
-          // we have a match
-          // Pass this data to output.
-          vtkImageData* id = vtkImageData::SafeDownCast(dataObject);
-          vtkImageData* id2 = vtkImageData::SafeDownCast(this->Data[i]);
-          if (id && id2)
-          {
-            id->SetExtent(dataExtent);
-            id->GetPointData()->PassData(id2->GetPointData());
-            // not sure if we need this
-            dataObject->DataHasBeenGenerated();
-            return 0;
-          }
-        }
-      }
+      vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      dataObject->ShallowCopy(entry.Data);
+      vtkInformation* dataInfo = dataObject->GetInformation();
+      dataInfo->Set(vtkDataObject::DATA_PIECE_NUMBER(), entry.Piece);
+      dataInfo->Set(vtkDataObject::DATA_NUMBER_OF_PIECES(), entry.NumberOfPieces);
+      dataInfo->Set(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(), entry.GhostLevels);
+      dataObject->DataHasBeenGenerated();
+      this->Internals->Use(entry);
+      ++this->NumberOfCacheHits;
+      return 0;
     }
   }
 
@@ -202,63 +290,54 @@ int vtkCachedStreamingDemandDrivenPipeline ::NeedToExecuteData(
 int vtkCachedStreamingDemandDrivenPipeline ::ExecuteData(
   vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
 {
-  // only works for one in one out algorithms
+  // only works for one output algorithms
   if (request->Get(FROM_OUTPUT_PORT()) != 0)
   {
     vtkErrorMacro("vtkCachedStreamingDemandDrivenPipeline can only be used for algorithms with one "
-                  "output and one input");
+                  "output");
     return 0;
   }
 
   // first do the usual thing
+  const double startTime = vtkTimerLog::GetUniversalTime();
   int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
-
-  // then save the newly generated data
-  vtkMTimeType bestTime = VTK_INT_MAX;
-  int bestIdx = 0;
-
-  // Save the image in cache.
-  // Find a spot to put the data.
-  for (int i = 0; i < this->CacheSize; ++i)
-  {
-    if (this->Data[i] == nullptr)
-    {
-      bestIdx = i;
-      break;
-    }
-    if (this->Times[i] < bestTime)
-    {
-      bestIdx = i;
-      bestTime = this->Times[i];
-    }
-  }
+  ++this->NumberOfCacheMisses;
 
   vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
   vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
-  if (this->Data[bestIdx] == nullptr)
+  if (!result || !dataObject || this->CacheSize == 0)
   {
-    this->Data[bestIdx] = dataObject->NewInstance();
+    return result;
   }
-  this->Data[bestIdx]->ReleaseData();
 
-  vtkImageData* id = vtkImageData::SafeDownCast(dataObject);
-  if (id)
-  {
-    vtkInformation* inInfo = inInfoVec[0]->GetInformationObject(0);
-    vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
-    id->SetExtent(input->GetExtent());
-    id->GetPointData()->PassData(input->GetPointData());
-    id->DataHasBeenGenerated();
-  }
-
-  vtkImageData* id2 = vtkImageData::SafeDownCast(this->Data[bestIdx]);
-  if (id && id2)
+  // then save the newly generated data
+  CacheEntry entry;
+  entry.Cost = vtkTimerLog::GetUniversalTime() - startTime;
+  entry.Data.TakeReference(dataObject->NewInstance());
+  entry.Data->ShallowCopy(dataObject);
+  entry.UpdateTime = dataObject->GetUpdateTime();
+  entry.HasTimeStep = outInfo->Has(UPDATE_TIME_STEP()) != 0;
+  entry.TimeStep = entry.HasTimeStep ? outInfo->Get(UPDATE_TIME_STEP()) : 0.0;
+  vtkInformation* dataInfo = dataObject->GetInformation();
+  entry.Piece = dataInfo->Get(vtkDataObject::DATA_PIECE_NUMBER());
+  entry.NumberOfPieces = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_PIECES());
+  entry.GhostLevels = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
+  entry.HasExtent = dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) == VTK_3D_EXTENT &&
+    dataInfo->Has(vtkDataObject::DATA_EXTENT());
+  if (entry.HasExtent)
   {
-    id2->SetExtent(id->GetExtent());
-    id2->GetPointData()->SetScalars(id->GetPointData()->GetScalars());
+    dataInfo->Get(vtkDataObject::DATA_EXTENT(), entry.Extent);
   }
-
-  this->Times[bestIdx] = dataObject->GetUpdateTime();
+  entry.Size = static_cast<vtkTypeUInt64>(dataObject->GetActualMemorySize()) * 1024;
+  this->Internals->Use(entry);
+
+  // Replace the output of a previous execution for the same request.
+  auto& entries = this->Internals->Entries;
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                  [&entry](const CacheEntry& other) { return entry.HasSameRequest(other); }),
+    entries.end());
+  entries.push_back(std::move(entry));
+  this->EvictOutputs();
 
   return result;
 }
@@ -2,8 +2,31 @@
 // SPDX-License-Identifier: BSD-3-Clause
 /**
  * @class   vtkCachedStreamingDemandDrivenPipeline
+ * @brief   Executive keeping the outputs of previous updates
  *
- * vtkCachedStreamingDemandDrivenPipeline
+ * vtkCachedStreamingDemandDrivenPipeline keeps the outputs generated by its
+ * algorithm for previous requests, so that a request for the same time step,
+ * piece, number of ghost levels and update extent is satisfied without
+ * executing the algorithm again, e.g. when scrubbing back and forth through
+ * the time steps of an expensive filter. A cached output is used if its time
+ * step is the requested one, if it is the requested piece with at least the
+ * requested number of ghost levels, and, for structured data, if its extent
+ * contains the requested extent. Cached outputs are discarded as soon as the
+ * algorithm or the pipeline upstream of it is modified.
+ *
+ * The cache holds at most CacheSize outputs and, if CacheMemoryLimit is not 0,
+ * at most CacheMemoryLimit bytes. When one of these limits is exceeded,
+ * outputs are evicted according to the EvictionPolicy: the least recently
+ * used output, or the output with the least execution time per byte, aged
+ * with the GreedyDual-Size algorithm, so that an expensive output is kept
+ * longer than a cheap one of the same size.
+ *
+ * The cache only supports algorithms with one output port. The outputs are
+ * shallow copies: algorithms must create new arrays at each execution, which
+ * is what most VTK filters do.
+ *
+ * @sa
+ * vtkImageCacheFilter vtkStreamingDemandDrivenPipeline
  */
 
 #ifndef vtkCachedStreamingDemandDrivenPipeline_h
@@ -12,6 +35,8 @@
 #include "vtkCommonExecutionModelModule.h" // For export macro
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <memory> // For std::unique_ptr
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkInformationIntegerKey;
 class vtkInformationIntegerVectorKey;
@@ -26,13 +51,64 @@ public:
 
   ///@{
   /**
-   * This is the maximum number of images that can be retained in memory.
+   * This is the maximum number of outputs that can be retained in memory.
    * it defaults to 10.
    */
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize, int);
   ///@}
 
+  ///@{
+  /**
+   * Maximum memory in bytes used by the cached outputs, as reported by
+   * vtkDataObject::GetActualMemorySize(). 0, the default, means no limit.
+   */
+  void SetCacheMemoryLimit(vtkTypeUInt64 limit);
+  vtkGetMacro(CacheMemoryLimit, vtkTypeUInt64);
+  ///@}
+
+  enum EvictionPolicies
+  {
+    LEAST_RECENTLY_USED = 0,
+    COST_AWARE = 1
+  };
+
+  ///@{
+  /**
+   * Set/Get the policy used to choose the outputs evicted from the cache.
+   * Default is LEAST_RECENTLY_USED.
+   */
+  vtkSetClampMacro(EvictionPolicy, int, LEAST_RECENTLY_USED, COST_AWARE);
+  vtkGetMacro(EvictionPolicy, int);
+  void SetEvictionPolicyToLeastRecentlyUsed() { this->SetEvictionPolicy(LEAST_RECENTLY_USED); }
+  void SetEvictionPolicyToCostAware() { this->SetEvictionPolicy(COST_AWARE); }
+  ///@}
+
+  /**
+   * Remove all the outputs from the cache.
+   */
+  void ClearCache();
+
+  ///@{
+  /**
+   * Get the number of outputs in the cache and the memory in bytes they use.
+   */
+  int GetNumberOfCachedOutputs();
+  vtkTypeUInt64 GetCacheMemorySize();
+  ///@}
+
+  ///@{
+  /**
+   * Statistics of the cache: number of requests satisfied from the cache,
+   * number of executions of the algorithm, and number of outputs evicted to
+   * respect the cache limits.
+   */
+  vtkGetMacro(NumberOfCacheHits, vtkIdType);
+  vtkGetMacro(NumberOfCacheMisses, vtkIdType);
+  vtkGetMacro(NumberOfCacheEvictions, vtkIdType);
+  void ResetCacheStatistics();
+  ///@}
+
 protected:
   vtkCachedStreamingDemandDrivenPipeline();
   ~vtkCachedStreamingDemandDrivenPipeline() override;
@@ -42,14 +118,23 @@ protected:
   int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec) override;
 
+  // Evict outputs until the cache respects its limits.
+  void EvictOutputs();
+
   int CacheSize;
+  vtkTypeUInt64 CacheMemoryLimit = 0;
+  int EvictionPolicy = LEAST_RECENTLY_USED;
 
-  vtkDataObject** Data;
-  vtkMTimeType* Times;
+  vtkIdType NumberOfCacheHits = 0;
+  vtkIdType NumberOfCacheMisses = 0;
+  vtkIdType NumberOfCacheEvictions = 0;
 
 private:
   vtkCachedStreamingDemandDrivenPipeline(const vtkCachedStreamingDemandDrivenPipeline&) = delete;
   void operator=(const vtkCachedStreamingDemandDrivenPipeline&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 VTK_ABI_NAMESPACE_END
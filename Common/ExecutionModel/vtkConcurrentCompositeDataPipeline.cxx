@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkConcurrentCompositeDataPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkConcurrentCompositeDataPipeline);
+
+vtkInformationKeyMacro(vtkConcurrentCompositeDataPipeline, THREAD_SAFE, Integer);
+
+//------------------------------------------------------------------------------
+namespace
+{
+// An executive upstream of the algorithm, with the output ports requested by
+// its consumers.
+struct UpstreamNode
+{
+  vtkExecutive* Executive;
+  std::vector<int> Ports;
+  int Level = 0;
+  bool ThreadSafe = false;
+};
+
+class UpstreamGraph
+{
+public:
+  // Collect the executives upstream of the given one, and compute their
+  // levels. Returns false if data release is enabled on one of them.
+  bool Build(vtkExecutive* executive)
+  {
+    if (vtkDataObject::GetGlobalReleaseDataFlag())
+    {
+      return false;
+    }
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+      {
+        int level;
+        if (!this->Visit(executive->GetInputInformation(i, j), level))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  std::vector<UpstreamNode> Nodes;
+  int NumberOfLevels = 0;
+
+private:
+  // Visit the producer of an input and its own inputs. The level of the
+  // producer is returned, -1 if there is none.
+  bool Visit(vtkInformation* inInfo, int& level)
+  {
+    level = -1;
+    vtkExecutive* executive;
+    int port;
+    vtkExecutive::PRODUCER()->Get(inInfo, executive, port);
+    if (!executive)
+    {
+      return true;
+    }
+    if (inInfo->Get(vtkDemandDrivenPipeline::RELEASE_DATA()))
+    {
+      return false;
+    }
+
+    auto found = this->Indices.find(executive);
+    if (found != this->Indices.end())
+    {
+      UpstreamNode& node = this->Nodes[found->second];
+      if (std::find(node.Ports.begin(), node.Ports.end(), port) == node.Ports.end())
+      {
+        node.Ports.push_back(port);
+      }
+      level = node.Level;
+      return true;
+    }
+
+    int nodeLevel = 0;
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+      {
+        int inputLevel;
+        if (!this->Visit(executive->GetInputInformation(i, j), inputLevel))
+        {
+          return false;
+        }
+        nodeLevel = std::max(nodeLevel, inputLevel + 1);
+      }
+    }
+
+    UpstreamNode node;
+    node.Executive = executive;
+    node.Ports.push_back(port);
+    node.Level = nodeLevel;
+    vtkAlgorithm* algorithm = executive->GetAlgorithm();
+    node.ThreadSafe = algorithm && algorithm->GetInformation()->Get(
+                                    vtkConcurrentCompositeDataPipeline::THREAD_SAFE()) != 0;
+    this->Indices[executive] = this->Nodes.size();
+    this->Nodes.push_back(node);
+    this->NumberOfLevels = std::max(this->NumberOfLevels, nodeLevel + 1);
+    level = nodeLevel;
+    return true;
+  }
+
+  std::map<vtkExecutive*, std::size_t> Indices;
+};
+
+// Send the request to the executive for each requested port, without
+// forwarding it upstream.
+int ExecuteNode(const UpstreamNode& node, vtkInformation* request)
+{
+  vtkExecutive* executive = node.Executive;
+  vtkInformationVector** inInfoVec = executive->GetInputInformation();
+  executive->SetSharedInputInformation(inInfoVec);
+  int result = 1;
+  for (int port : node.Ports)
+  {
+    request->Set(vtkExecutive::FROM_OUTPUT_PORT(), port);
+    if (!executive->ProcessRequest(request, inInfoVec, executive->GetOutputInformation()))
+    {
+      result = 0;
+    }
+  }
+  executive->SetSharedInputInformation(nullptr);
+  return result;
+}
+
+// Compute the caches that vtkDataSet and vtkDataArray fill on first access.
+void ComputeCaches(vtkDataSet* dataSet)
+{
+  if (dataSet->GetNumberOfCells() > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    dataSet->GetCell(0, cell);
+  }
+  dataSet->ComputeBounds();
+  double range[2];
+  dataSet->GetScalarRange(range);
+  vtkDataSetAttributes* attributes[2] = { dataSet->GetPointData(), dataSet->GetCellData() };
+  for (vtkDataSetAttributes* data : attributes)
+  {
+    for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = data->GetArray(i);
+      if (!array)
+      {
+        continue;
+      }
+      const int numComps = array->GetNumberOfComponents();
+      for (int comp = numComps > 1 ? -1 : 0; comp < numComps; ++comp)
+      {
+        array->GetRange(range, comp);
+      }
+    }
+  }
+}
+
+void ComputeCaches(vtkDataObject* dataObject)
+{
+  if (auto dataSet = vtkDataSet::SafeDownCast(dataObject))
+  {
+    ComputeCaches(dataSet);
+  }
+  else if (auto composite = vtkCompositeDataSet::SafeDownCast(dataObject))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      if (auto leaf = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+      {
+        ComputeCaches(leaf);
+      }
+    }
+  }
+}
+
+// Compute the caches of the inputs read by several of the given executives.
+void ComputeSharedInputCaches(const std::vector<const UpstreamNode*>& nodes)
+{
+  std::map<vtkDataObject*, int> readers;
+  for (const UpstreamNode* node : nodes)
+  {
+    vtkExecutive* executive = node->Executive;
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+      {
+        vtkInformation* inInfo = executive->GetInputInformation(i, j);
+        if (vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT()))
+        {
+          if (++readers[input] == 2)
+          {
+            ComputeCaches(input);
+          }
+        }
+      }
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkConcurrentCompositeDataPipeline::vtkConcurrentCompositeDataPipeline() = default;
+
+//------------------------------------------------------------------------------
+vtkConcurrentCompositeDataPipeline::~vtkConcurrentCompositeDataPipeline() = default;
+
+//------------------------------------------------------------------------------
+int vtkConcurrentCompositeDataPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (!request->Has(REQUEST_DATA()) || this->SharedInputInformation)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  ::UpstreamGraph graph;
+  if (!graph.Build(this))
+  {
+    vtkDebugMacro("Data release is enabled, executing upstream branches sequentially.");
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  std::vector<std::vector<const ::UpstreamNode*>> levels(graph.NumberOfLevels);
+  for (const ::UpstreamNode& node : graph.Nodes)
+  {
+    levels[node.Level].push_back(&node);
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+  const int port = request->Get(FROM_OUTPUT_PORT());
+
+  int result = 1;
+  this->LastNumberOfConcurrentExecutives = 0;
+  for (const auto& level : levels)
+  {
+    // Algorithms that are not thread safe run first, on this thread.
+    std::vector<const ::UpstreamNode*> concurrentNodes;
+    for (const ::UpstreamNode* node : level)
+    {
+      if (node->ThreadSafe && level.size() > 1)
+      {
+        concurrentNodes.push_back(node);
+      }
+      else if (!::ExecuteNode(*node, request))
+      {
+        result = 0;
+      }
+    }
+    if (concurrentNodes.empty())
+    {
+      continue;
+    }
+
+    ::ComputeSharedInputCaches(concurrentNodes);
+    const vtkIdType numberOfNodes = static_cast<vtkIdType>(concurrentNodes.size());
+    this->LastNumberOfConcurrentExecutives =
+      std::max(this->LastNumberOfConcurrentExecutives, static_cast<int>(numberOfNodes));
+    std::atomic<int> levelResult(1);
+    vtkSMPTools::For(0, numberOfNodes, 1, [&](vtkIdType begin, vtkIdType end) {
+      // Executives modify the request, each one gets its own copy. The
+      // request key is not an entry of the information, it is copied apart.
+      vtkNew<vtkInformation> nodeRequest;
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        nodeRequest->Copy(request);
+        nodeRequest->SetRequest(request->GetRequest());
+        if (!::ExecuteNode(*concurrentNodes[i], nodeRequest))
+        {
+          levelResult = 0;
+        }
+      }
+    });
+    if (!levelResult)
+    {
+      result = 0;
+    }
+  }
+  request->Set(FROM_OUTPUT_PORT(), port);
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+void vtkConcurrentCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "LastNumberOfConcurrentExecutives: " << this->LastNumberOfConcurrentExecutives
+     << endl;
+}
+VTK_ABI_NAMESPACE_END
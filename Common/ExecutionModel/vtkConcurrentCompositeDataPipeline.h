@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConcurrentCompositeDataPipeline
+ * @brief   Executive executing independent upstream branches concurrently
+ *
+ * vtkStreamingDemandDrivenPipeline executes the pipeline upstream of an
+ * algorithm depth-first, on the calling thread. When an algorithm has several
+ * inputs computed from the same source, e.g. when appending the outputs of a
+ * contour, a slice, a glyph and a clip filter of the same dataset, these
+ * branches run one after another although they only share read-only data.
+ *
+ * When it forwards REQUEST_DATA upstream, vtkConcurrentCompositeDataPipeline
+ * instead collects all the executives upstream of its algorithm and sorts them
+ * by level, the level of an executive being one more than the highest level
+ * of its inputs. Levels are executed one after another, and the executives of
+ * a level, which do not depend on each other, are executed concurrently with
+ * vtkSMPTools::For. Upstream executives are executed without forwarding the
+ * request further upstream, since their inputs belong to previous levels.
+ *
+ * Concurrent execution is opt-in for each algorithm: only algorithms whose
+ * information (vtkAlgorithm::GetInformation()) has THREAD_SAFE() set to 1 are
+ * executed concurrently, the others are executed on the calling thread before
+ * the concurrent ones of their level. A thread-safe algorithm must not modify
+ * its inputs nor any state shared with other algorithms, including its
+ * observers. Before a level is executed, the caches of the data objects read
+ * by several of its thread-safe algorithms (cell structures, bounds and array
+ * ranges) are computed, so that reading them concurrently does not write them.
+ * Other structures built on demand by some filters, such as the links of
+ * vtkPolyData or vtkUnstructuredGrid, must be built beforehand.
+ *
+ * Algorithms running concurrently use vtkSMPTools from within a parallel
+ * scope: their own parallel loops run sequentially unless nested parallelism
+ * is enabled, see vtkSMPTools::SetNestedParallelism().
+ *
+ * Only the algorithm using this executive schedules its upstream pipeline, so
+ * it is typically set on the algorithm joining the branches, e.g. an append
+ * filter or a writer with several inputs. The whole pipeline is executed
+ * sequentially when data release is enabled, either globally or for one of
+ * the upstream outputs, since releasing data read by concurrent algorithms is
+ * not safe. Upstream executives that need their data up to date while their
+ * consumer does not are executed anyway.
+ *
+ * @sa
+ * vtkCompositeDataPipeline vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkConcurrentCompositeDataPipeline_h
+#define vtkConcurrentCompositeDataPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkInformation;
+class vtkInformationIntegerKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkConcurrentCompositeDataPipeline
+  : public vtkCompositeDataPipeline
+{
+public:
+  static vtkConcurrentCompositeDataPipeline* New();
+  vtkTypeMacro(vtkConcurrentCompositeDataPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Key set to 1 in the information of an algorithm to declare that it can
+   * execute concurrently with other algorithms.
+   */
+  static vtkInformationIntegerKey* THREAD_SAFE();
+
+  /**
+   * Get the highest number of executives executed concurrently during the
+   * last REQUEST_DATA pass.
+   */
+  vtkGetMacro(LastNumberOfConcurrentExecutives, int);
+
+protected:
+  vtkConcurrentCompositeDataPipeline();
+  ~vtkConcurrentCompositeDataPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+  using Superclass::ForwardUpstream;
+
+  int LastNumberOfConcurrentExecutives = 0;
+
+private:
+  vtkConcurrentCompositeDataPipeline(const vtkConcurrentCompositeDataPipeline&) = delete;
+  void operator=(const vtkConcurrentCompositeDataPipeline&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -6,6 +6,7 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
@@ -28,6 +29,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDemandDrivenPipeline);
 
+vtkInformationKeyMacro(vtkDemandDrivenPipeline, DATA_MODIFIABLE_IN_PLACE, Integer);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, DATA_NOT_GENERATED, Integer);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, RELEASE_DATA, Integer);
 vtkInformationKeyMacro(vtkDemandDrivenPipeline, REQUEST_DATA, Request);
@@ -504,6 +506,19 @@ void vtkDemandDrivenPipeline::ExecuteDataStart(
     }
   }
 
+  // Tell the algorithm which inputs it may modify in place.
+  for (i = 0; i < this->Algorithm->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < inInfo[i]->GetNumberOfInformationObjects(); ++j)
+    {
+      vtkInformation* info = inInfo[i]->GetInformationObject(j);
+      if (this->InputIsModifiableInPlace(i, info))
+      {
+        info->Set(DATA_MODIFIABLE_IN_PLACE(), 1);
+      }
+    }
+  }
+
   // Tell observers the algorithm is about to execute.
   this->Algorithm->InvokeEvent(vtkCommand::StartEvent, nullptr);
 
@@ -563,6 +578,7 @@ void vtkDemandDrivenPipeline::ExecuteDataEnd(
     for (j = 0; j < inInfoVec[i]->GetNumberOfInformationObjects(); ++j)
     {
       vtkInformation* inInfo = inInfoVec[i]->GetInformationObject(j);
+      inInfo->Remove(DATA_MODIFIABLE_IN_PLACE());
       vtkDataObject* dataObject = inInfo->Get(vtkDataObject::DATA_OBJECT());
       if (dataObject && (vtkDataObject::GetGlobalReleaseDataFlag() || inInfo->Get(RELEASE_DATA())))
       {
@@ -962,6 +978,48 @@ int vtkDemandDrivenPipeline::ArrayIsValid(vtkAbstractArray* array, vtkInformatio
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkDemandDrivenPipeline::InputIsModifiableInPlace(int port, vtkInformation* inInfo)
+{
+  vtkInformation* portInfo = this->Algorithm->GetInputPortInformation(port);
+  if (!portInfo || !portInfo->Get(vtkAlgorithm::INPUT_MODIFIABLE_IN_PLACE()))
+  {
+    return 0;
+  }
+
+  // The producer must not need its output after this execution.
+  if (!vtkDataObject::GetGlobalReleaseDataFlag() && !inInfo->Get(RELEASE_DATA()))
+  {
+    return 0;
+  }
+
+  // This algorithm must be the only consumer of the output.
+  if (vtkExecutive::CONSUMERS()->Length(inInfo) != 1)
+  {
+    return 0;
+  }
+
+  // Only the output information of the producer may reference the data.
+  vtkDataObject* dataObject = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  return dataObject && dataObject->GetReferenceCount() == 1 &&
+    !vtkCompositeDataSet::SafeDownCast(dataObject);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDemandDrivenPipeline::IsArrayModifiableInPlace(
+  vtkInformation* inInfo, vtkAbstractArray* array)
+{
+  // The data object is referenced by the pipeline only, so an array
+  // referenced once is referenced by its attributes only. Arrays without a
+  // plain buffer (implicit, lazy, quantized or scaled arrays...) would
+  // silently drop or alter the values written to them. The memory of the
+  // array must not be shared either: a shallow copy of another array or a
+  // buffer wrapping caller memory would overwrite data we do not own.
+  return inInfo && array && inInfo->Get(DATA_MODIFIABLE_IN_PLACE()) &&
+    array->GetReferenceCount() == 1 && array->HasStandardMemoryLayout() &&
+    array->IsMemoryExclusivelyOwned();
+}
+
 //------------------------------------------------------------------------------
 int vtkDemandDrivenPipeline::InputIsOptional(int port)
 {
@@ -145,6 +145,30 @@ public:
    */
   static vtkInformationIntegerKey* DATA_NOT_GENERATED();
 
+  /**
+   * Key set by the executive in the information of an input connection
+   * during REQUEST_DATA, when the algorithm may modify the input data object
+   * in place. This requires that the input port has
+   * vtkAlgorithm::INPUT_MODIFIABLE_IN_PLACE(), that the producer releases
+   * its output after use (RELEASE_DATA() or the global release data flag),
+   * that the algorithm is the only consumer of this output, and that nothing
+   * but the pipeline references the data object. Composite data objects are
+   * never modifiable in place, as their blocks may be shared.
+   * @ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* DATA_MODIFIABLE_IN_PLACE();
+
+  /**
+   * Return true if the algorithm may overwrite @a array, a point or cell
+   * data array of the data object of the input connection @a inInfo, in
+   * place: DATA_MODIFIABLE_IN_PLACE() must be set, the array must not be
+   * shared with any other data object, it must have a standard memory
+   * layout, which implicit arrays do not, and it must exclusively own its
+   * memory (see vtkAbstractArray::IsMemoryExclusivelyOwned()). Call it before
+   * passing the array to the output, e.g. before ShallowCopy().
+   */
+  static bool IsArrayModifiableInPlace(vtkInformation* inInfo, vtkAbstractArray* array);
+
   /**
    * Create (New) and return a data object of the given type.
    * This is here for backwards compatibility. Use
@@ -190,6 +214,10 @@ protected:
   int InputIsOptional(int port);
   int InputIsRepeatable(int port);
 
+  // Decide whether the algorithm may modify the data object of an input
+  // connection in place. See DATA_MODIFIABLE_IN_PLACE().
+  virtual int InputIsModifiableInPlace(int port, vtkInformation* inInfo);
+
   // Decide whether the output data need to be generated.
   virtual int NeedToExecuteData(
     int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
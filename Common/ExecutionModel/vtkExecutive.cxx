@@ -14,6 +14,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <sstream>
@@ -718,10 +719,16 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
-  // Invoke the request on the algorithm.
+  // Invoke the request on the algorithm, recording it if profiling.
+  vtkPipelineProfiler* profiler = vtkPipelineProfiler::GetActiveProfiler();
+  const double startTime = profiler ? vtkPipelineProfiler::GetTime() : 0.0;
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if (profiler)
+  {
+    profiler->RecordRequest(this->Algorithm, request, outInfo, startTime);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
@@ -0,0 +1,500 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//------------------------------------------------------------------------------
+namespace
+{
+std::atomic<vtkPipelineProfiler*> ActiveProfiler(nullptr);
+
+// Number of threads inside RecordSMPTask. A thread increments it before
+// loading ActiveProfiler, so once ActiveProfiler is changed and the count
+// drops to zero, no thread uses the previous profiler anymore.
+std::atomic<int> NumberOfRecorders(0);
+
+void WaitForRecorders()
+{
+  while (NumberOfRecorders.load() > 0)
+  {
+    std::this_thread::yield();
+  }
+}
+
+struct RequestEvent
+{
+  vtkAlgorithm* Algorithm;
+  std::string Name;
+  std::string Request;
+  double Start;
+  double End;
+  int Thread;
+  unsigned long Memory;
+};
+
+struct TaskEvent
+{
+  vtkIdType First;
+  vtkIdType Last;
+  double Start;
+  double End;
+  int Thread;
+};
+
+// Task recorded by a thread, before its index is known.
+struct ThreadTaskEvent
+{
+  vtkIdType First;
+  vtkIdType Last;
+  double Start;
+  double End;
+  std::thread::id ThreadId;
+};
+
+// Name of the key identifying the pass of the request, e.g. REQUEST_DATA.
+std::string GetRequestName(vtkInformation* request)
+{
+  vtkInformationRequestKey* key = request->GetRequest();
+  return key ? key->GetName() : "UNKNOWN_REQUEST";
+}
+
+void WriteJSONString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+         << std::dec << std::setfill(' ');
+    }
+    else
+    {
+      os << c;
+    }
+  }
+  os << '"';
+}
+}
+
+//------------------------------------------------------------------------------
+class vtkPipelineProfiler::vtkInternals
+{
+public:
+  // Index of the given thread, the mutex must be locked.
+  int GetThread(std::thread::id threadId)
+  {
+    auto inserted = this->Threads.insert(std::make_pair(threadId, this->NumberOfThreads));
+    if (inserted.second)
+    {
+      ++this->NumberOfThreads;
+    }
+    return inserted.first->second;
+  }
+
+  // Merges the tasks recorded by each thread into Tasks, the mutex must be
+  // locked. As for the Reduce() of a vtkSMPTools functor, no task must be
+  // running meanwhile.
+  void Reduce()
+  {
+    for (auto& buffer : this->ThreadTasks)
+    {
+      for (const auto& task : buffer)
+      {
+        this->Tasks.push_back(
+          TaskEvent{ task.First, task.Last, task.Start, task.End, this->GetThread(task.ThreadId) });
+      }
+      buffer.clear();
+    }
+  }
+
+  // Time of the first event, origin of the trace.
+  double GetStartTime() const
+  {
+    double start = VTK_DOUBLE_MAX;
+    for (const auto& event : this->Requests)
+    {
+      start = std::min(start, event.Start);
+    }
+    for (const auto& task : this->Tasks)
+    {
+      start = std::min(start, task.Start);
+    }
+    return start;
+  }
+
+  // Total time of the SMP tasks started during the given interval.
+  double GetSMPTime(double start, double end, std::size_t& numberOfTasks) const
+  {
+    double time = 0.0;
+    for (const auto& task : this->Tasks)
+    {
+      if (task.Start >= start && task.Start <= end)
+      {
+        time += task.End - task.Start;
+        ++numberOfTasks;
+      }
+    }
+    return time;
+  }
+
+  std::mutex Mutex;
+  std::vector<RequestEvent> Requests;
+  std::vector<TaskEvent> Tasks;
+  vtkSMPThreadLocal<std::vector<ThreadTaskEvent>> ThreadTasks;
+  std::map<std::thread::id, int> Threads;
+  int NumberOfThreads = 0;
+};
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  this->Stop();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Start()
+{
+  if (ActiveProfiler.exchange(this) != this)
+  {
+    ::WaitForRecorders();
+  }
+  vtk::detail::smp::SetSMPTaskObserver(&vtkPipelineProfiler::RecordSMPTask);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Stop()
+{
+  vtkPipelineProfiler* self = this;
+  if (ActiveProfiler.compare_exchange_strong(self, nullptr))
+  {
+    vtk::detail::smp::SetSMPTaskObserver(nullptr);
+    ::WaitForRecorders();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::IsRecording()
+{
+  return ActiveProfiler == this;
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler* vtkPipelineProfiler::GetActiveProfiler()
+{
+  return ActiveProfiler.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineProfiler::GetTime()
+{
+  return vtk::detail::smp::GetSMPTaskTime();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Requests.clear();
+  this->Internals->Tasks.clear();
+  for (auto& buffer : this->Internals->ThreadTasks)
+  {
+    buffer.clear();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::RecordRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+  vtkInformationVector* outInfo, double startTime)
+{
+  RequestEvent event;
+  event.End = vtkPipelineProfiler::GetTime();
+  event.Start = startTime;
+  event.Algorithm = algorithm;
+  event.Name = algorithm->GetObjectDescription();
+  event.Request = ::GetRequestName(request);
+  event.Memory = 0;
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    for (int i = 0; i < outInfo->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkDataObject* output = outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+      if (output)
+      {
+        event.Memory += output->GetActualMemorySize();
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  event.Thread = this->Internals->GetThread(std::this_thread::get_id());
+  this->Internals->Requests.push_back(std::move(event));
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::RecordSMPTask(vtkIdType first, vtkIdType last, double start, double end)
+{
+  // The profiler cannot be destroyed while NumberOfRecorders is not zero, see
+  // WaitForRecorders().
+  ++NumberOfRecorders;
+  vtkPipelineProfiler* self = ActiveProfiler.load();
+  if (self && self->RecordSMPTasks)
+  {
+    // Tasks are recorded in a buffer local to the calling thread, without
+    // locking, and merged when the profiler is queried.
+    self->Internals->ThreadTasks.Local().push_back(
+      ThreadTaskEvent{ first, last, start, end, std::this_thread::get_id() });
+  }
+  --NumberOfRecorders;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfRequests()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkIdType>(this->Internals->Requests.size());
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfSMPTasks()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Reduce();
+  return static_cast<vtkIdType>(this->Internals->Tasks.size());
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineProfiler::GetTotalTime(vtkAlgorithm* algorithm, const char* request)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  double time = 0.0;
+  for (const auto& event : this->Internals->Requests)
+  {
+    if (event.Algorithm == algorithm && (!request || event.Request == request))
+    {
+      time += event.End - event.Start;
+    }
+  }
+  return time;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkPipelineProfiler::GetOutputMemorySize(vtkAlgorithm* algorithm)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  const auto& requests = this->Internals->Requests;
+  for (auto event = requests.rbegin(); event != requests.rend(); ++event)
+  {
+    if (event->Algorithm == algorithm && event->Request == "REQUEST_DATA")
+    {
+      return event->Memory;
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfThreads()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Reduce();
+  return this->Internals->NumberOfThreads;
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineProfiler::GetThreadSMPTime(int thread)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Reduce();
+  double time = 0.0;
+  for (const auto& task : this->Internals->Tasks)
+  {
+    if (task.Thread == thread)
+    {
+      time += task.End - task.Start;
+    }
+  }
+  return time;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Reduce();
+  const double origin = this->Internals->GetStartTime();
+
+  // Times are in microseconds.
+  std::ostringstream trace;
+  trace << std::fixed << std::setprecision(3);
+  trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto beginEvent = [&](const std::string& name, const char* phase, int thread) {
+    trace << (first ? "\n" : ",\n") << "{\"name\":";
+    first = false;
+    ::WriteJSONString(trace, name);
+    trace << ",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << thread;
+  };
+
+  for (int thread = 0; thread < this->Internals->NumberOfThreads; ++thread)
+  {
+    beginEvent("thread_name", "M", thread);
+    trace << ",\"args\":{\"name\":\"Thread " << thread << "\"}}";
+  }
+  for (const auto& event : this->Internals->Requests)
+  {
+    beginEvent(event.Name, "X", event.Thread);
+    trace << ",\"cat\":";
+    ::WriteJSONString(trace, event.Request);
+    trace << ",\"ts\":" << (event.Start - origin) * 1e6
+          << ",\"dur\":" << (event.End - event.Start) * 1e6;
+    if (event.Request == "REQUEST_DATA")
+    {
+      trace << ",\"args\":{\"output_memory_kib\":" << event.Memory << "}";
+    }
+    trace << "}";
+  }
+  for (const auto& task : this->Internals->Tasks)
+  {
+    beginEvent("vtkSMPTools task", "X", task.Thread);
+    trace << ",\"cat\":\"SMP\",\"ts\":" << (task.Start - origin) * 1e6
+          << ",\"dur\":" << (task.End - task.Start) * 1e6 << ",\"args\":{\"first\":" << task.First
+          << ",\"last\":" << task.Last << "}}";
+  }
+  trace << "\n]}\n";
+  os << trace.str();
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteChromeTrace(const std::string& fileName)
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    vtkErrorMacro("Cannot open " << fileName << " for writing.");
+    return false;
+  }
+  this->WriteChromeTrace(file);
+  return file.good();
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Reduce();
+
+  struct AlgorithmSummary
+  {
+    std::string Name;
+    vtkIdType NumberOfRequests = 0;
+    std::vector<std::pair<std::string, double>> RequestTimes;
+    double SMPTime = 0.0;
+    std::size_t NumberOfTasks = 0;
+    unsigned long Memory = 0;
+  };
+  std::vector<AlgorithmSummary> summaries;
+  std::map<vtkAlgorithm*, std::size_t> indices;
+  double end = 0.0;
+  for (const auto& event : this->Internals->Requests)
+  {
+    auto inserted = indices.insert(std::make_pair(event.Algorithm, summaries.size()));
+    if (inserted.second)
+    {
+      summaries.emplace_back();
+    }
+    AlgorithmSummary& summary = summaries[inserted.first->second];
+    summary.Name = event.Name;
+    ++summary.NumberOfRequests;
+    auto time = std::find_if(summary.RequestTimes.begin(), summary.RequestTimes.end(),
+      [&](const std::pair<std::string, double>& t) { return t.first == event.Request; });
+    if (time == summary.RequestTimes.end())
+    {
+      summary.RequestTimes.emplace_back(event.Request, 0.0);
+      time = summary.RequestTimes.end() - 1;
+    }
+    time->second += event.End - event.Start;
+    if (event.Request == "REQUEST_DATA")
+    {
+      summary.SMPTime +=
+        this->Internals->GetSMPTime(event.Start, event.End, summary.NumberOfTasks);
+      summary.Memory = event.Memory;
+    }
+    end = std::max(end, event.End);
+  }
+
+  for (const auto& summary : summaries)
+  {
+    os << summary.Name << ": " << summary.NumberOfRequests << " requests\n";
+    for (const auto& time : summary.RequestTimes)
+    {
+      os << "  " << time.first << ": " << time.second << " s\n";
+    }
+    if (summary.NumberOfTasks > 0)
+    {
+      os << "  SMP tasks: " << summary.SMPTime << " s in " << summary.NumberOfTasks
+         << " tasks\n";
+    }
+    os << "  Output memory: " << summary.Memory << " KiB\n";
+  }
+
+  std::vector<double> threadTimes(this->Internals->NumberOfThreads, 0.0);
+  for (const auto& task : this->Internals->Tasks)
+  {
+    threadTimes[task.Thread] += task.End - task.Start;
+    end = std::max(end, task.End);
+  }
+  const double duration = end - this->Internals->GetStartTime();
+  if (!this->Internals->Tasks.empty() && duration > 0.0)
+  {
+    for (int thread = 0; thread < this->Internals->NumberOfThreads; ++thread)
+    {
+      os << "Thread " << thread << ": " << threadTimes[thread] << " s in SMP tasks, "
+         << 100.0 * threadTimes[thread] / duration << "% of " << duration << " s\n";
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "RecordSMPTasks: " << this->RecordSMPTasks << endl;
+  os << indent << "Recording: " << this->IsRecording() << endl;
+  os << indent << "NumberOfRequests: " << this->GetNumberOfRequests() << endl;
+  os << indent << "NumberOfSMPTasks: " << this->GetNumberOfSMPTasks() << endl;
+}
+VTK_ABI_NAMESPACE_END
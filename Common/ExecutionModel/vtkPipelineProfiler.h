@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPipelineProfiler
+ * @brief   Record the requests processed by all the algorithms of the pipeline
+ *
+ * vtkExecutionTimer times the execution of one algorithm. vtkPipelineProfiler
+ * instead records every request processed by any algorithm while it is
+ * started: REQUEST_DATA_OBJECT, REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT,
+ * REQUEST_DATA and the other passes of the pipeline, with the thread that
+ * processed them and, for REQUEST_DATA, the memory used by the outputs of the
+ * algorithm. The executives notify the active profiler from
+ * vtkExecutive::CallAlgorithm(), so that the times recorded for an algorithm
+ * do not include the execution of its inputs.
+ *
+ * When RecordSMPTasks is on, the tasks executed by the threads of the
+ * STDThread, TBB and OpenMP vtkSMPTools backends are recorded as well, which
+ * shows how much of the time of an algorithm is spent in parallel code and how
+ * busy the threads are. Each thread records its tasks in its own buffer,
+ * without locking, and the buffers are merged when the profiler is queried,
+ * which must therefore not happen while vtkSMPTools tasks are running.
+ *
+ * The recorded events can be written in the Chrome trace event format, which
+ * is loaded by the Perfetto UI (https://ui.perfetto.dev) and chrome://tracing,
+ * or summarized per algorithm with PrintSummary().
+ *
+ * @code{.cpp}
+ * vtkNew<vtkPipelineProfiler> profiler;
+ * profiler->Start();
+ * writer->Write();
+ * profiler->Stop();
+ * profiler->WriteChromeTrace("pipeline.json");
+ * @endcode
+ *
+ * Only one profiler records at a time. It must be stopped before it is
+ * deleted, which the destructor does, and must not be deleted while the
+ * pipeline executes.
+ *
+ * @sa
+ * vtkExecutionTimer vtkTimerLog vtkSMPTools
+ */
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <memory> // For std::unique_ptr
+#include <string> // For std::string
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Start and stop recording. Starting a profiler stops the one that was
+   * recording, if any. Events recorded previously are kept, see Clear().
+   * Stop() returns once no thread records tasks in this profiler anymore.
+   */
+  void Start();
+  void Stop();
+  bool IsRecording();
+  ///@}
+
+  /**
+   * Get the profiler that is recording, nullptr if none is.
+   */
+  static vtkPipelineProfiler* GetActiveProfiler();
+
+  ///@{
+  /**
+   * Set/Get whether the tasks executed by the vtkSMPTools backends are
+   * recorded. Default is on.
+   */
+  vtkSetMacro(RecordSMPTasks, bool);
+  vtkGetMacro(RecordSMPTasks, bool);
+  vtkBooleanMacro(RecordSMPTasks, bool);
+  ///@}
+
+  /**
+   * Remove all the recorded events.
+   */
+  void Clear();
+
+  ///@{
+  /**
+   * Get the number of recorded requests and SMP tasks.
+   */
+  vtkIdType GetNumberOfRequests();
+  vtkIdType GetNumberOfSMPTasks();
+  ///@}
+
+  /**
+   * Get the total time in seconds spent by the algorithm to process the
+   * given request, e.g. "REQUEST_DATA", or all the requests if nullptr.
+   */
+  double GetTotalTime(vtkAlgorithm* algorithm, const char* request = nullptr);
+
+  /**
+   * Get the memory in kibibytes used by the outputs of the algorithm after
+   * its last recorded REQUEST_DATA.
+   */
+  unsigned long GetOutputMemorySize(vtkAlgorithm* algorithm);
+
+  /**
+   * Get the number of threads that processed requests or SMP tasks.
+   */
+  int GetNumberOfThreads();
+
+  /**
+   * Get the time in seconds spent by a thread executing SMP tasks. Thread 0
+   * is the first thread that processed a request.
+   */
+  double GetThreadSMPTime(int thread);
+
+  ///@{
+  /**
+   * Write the recorded events in the Chrome trace event format. Requests are
+   * complete events named after the algorithm, whose category is the request,
+   * and SMP tasks are complete events of the "SMP" category.
+   */
+  void WriteChromeTrace(ostream& os);
+  bool WriteChromeTrace(const std::string& fileName);
+  ///@}
+
+  /**
+   * Print, for each algorithm, the number of requests it processed, the time
+   * spent in each kind of request and in the SMP tasks executed during its
+   * REQUEST_DATA, and the memory used by its outputs. The time spent by each
+   * thread in SMP tasks is printed as well.
+   */
+  void PrintSummary(ostream& os);
+
+  /**
+   * Record a request processed by an algorithm, from the given start time.
+   * Called by the executives.
+   */
+  void RecordRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+    vtkInformationVector* outInfo, double startTime);
+
+  /**
+   * Current time in seconds, used to time the events.
+   */
+  static double GetTime();
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler() override;
+
+  bool RecordSMPTasks = true;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&) = delete;
+  void operator=(const vtkPipelineProfiler&) = delete;
+
+  static void RecordSMPTask(vtkIdType first, vtkIdType last, double start, double end);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
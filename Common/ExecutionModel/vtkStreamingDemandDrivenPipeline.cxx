@@ -372,6 +372,13 @@ vtkTypeBool vtkStreamingDemandDrivenPipeline::Update(int port)
 //------------------------------------------------------------------------------
 vtkTypeBool vtkStreamingDemandDrivenPipeline::Update(int port, vtkInformationVector* requests)
 {
+  // If neither the pipeline nor the requests changed since the last update,
+  // skip the request passes, which would all be short circuited.
+  if (!requests && this->OutputsAreUpToDate(port))
+  {
+    return 1;
+  }
+
   if (!this->UpdateInformation())
   {
     return 0;
@@ -406,6 +413,10 @@ vtkTypeBool vtkStreamingDemandDrivenPipeline::Update(int port, vtkInformationVec
         retval = retval && this->UpdateData(port);
       }
     } while (this->ContinueExecuting);
+    if (retval)
+    {
+      this->LastUpdateTime.Modified();
+    }
     return retval;
   }
   else
@@ -414,6 +425,38 @@ vtkTypeBool vtkStreamingDemandDrivenPipeline::Update(int port, vtkInformationVec
   }
 }
 
+//------------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline::OutputsAreUpToDate(int port)
+{
+  const vtkMTimeType lastUpdateTime = this->LastUpdateTime.GetMTime();
+  const int numPorts = this->Algorithm ? this->Algorithm->GetNumberOfOutputPorts() : 0;
+  if (lastUpdateTime == 0 || port < -1 || port >= numPorts || this->ContinueExecuting)
+  {
+    return 0;
+  }
+
+  // Check the cheap conditions first: the requests on the outputs, and the
+  // outputs themselves, must not have been modified since the last update.
+  vtkInformationVector* outInfoVec = this->GetOutputInformation();
+  for (int i = (port < 0 ? 0 : port); i < (port < 0 ? numPorts : port + 1); ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* dataObject = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (outInfo->GetMTime() > lastUpdateTime || outInfo->Get(vtkAlgorithm::ABORTED()) ||
+      !dataObject || dataObject->GetMTime() > lastUpdateTime || dataObject->GetDataReleased())
+    {
+      return 0;
+    }
+  }
+
+  // Then nothing upstream must have been modified.
+  if (!this->UpdatePipelineMTime())
+  {
+    return 0;
+  }
+  return this->PipelineMTime < lastUpdateTime;
+}
+
 //------------------------------------------------------------------------------
 vtkTypeBool vtkStreamingDemandDrivenPipeline::UpdateWholeExtent()
 {
@@ -305,6 +305,12 @@ protected:
   // did the most recent PUE do anything ?
   int LastPropogateUpdateExtentShortCircuited;
 
+  // Are the outputs requested from Update() still those of the last update?
+  int OutputsAreUpToDate(int port);
+
+  // Time at which the last successful Update() completed.
+  vtkTimeStamp LastUpdateTime;
+
 private:
   vtkStreamingDemandDrivenPipeline(const vtkStreamingDemandDrivenPipeline&) = delete;
   void operator=(const vtkStreamingDemandDrivenPipeline&) = delete;
@@ -20,6 +20,7 @@
 #include "vtkImageData.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 
@@ -28,7 +29,12 @@
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
 #include <vector>
 
 //------------------------------------------------------------------------------
@@ -56,6 +62,69 @@ void DeleteAll(vtkInformationVector** dst, int n)
   }
   delete[] dst;
 }
+
+// Distribute the blocks according to their number of cells. The blocks that
+// dominate the work, holding at least half of the cells, are returned in
+// largeBlocks, unless all the blocks would be: blocks of similar sizes are
+// better executed in parallel with each other. The other blocks are
+// distributed in batches of similar cost, largest blocks first, each one in
+// the least loaded batch. There are several batches per thread, so that
+// threads that finish early take more work. order lists the blocks of each
+// batch, batch b being order[batchOffsets[b]] to order[batchOffsets[b + 1] - 1].
+void ScheduleBlocks(const std::vector<vtkDataObject*>& blocks, int numberOfThreads,
+  std::vector<vtkIdType>& largeBlocks, std::vector<vtkIdType>& order,
+  std::vector<vtkIdType>& batchOffsets)
+{
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkIdType> costs(numberOfBlocks);
+  vtkIdType totalCost = 0;
+  for (vtkIdType i = 0; i < numberOfBlocks; ++i)
+  {
+    costs[i] = std::max<vtkIdType>(blocks[i]->GetNumberOfElements(vtkDataObject::CELL), 1);
+    totalCost += costs[i];
+  }
+  std::vector<vtkIdType> sorted(numberOfBlocks);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::stable_sort(sorted.begin(), sorted.end(),
+    [&costs](vtkIdType a, vtkIdType b) { return costs[a] > costs[b]; });
+
+  auto firstSmall = sorted.begin();
+  while (firstSmall != sorted.end() && 2 * costs[*firstSmall] >= totalCost)
+  {
+    ++firstSmall;
+  }
+  if (firstSmall == sorted.end())
+  {
+    firstSmall = sorted.begin();
+  }
+  largeBlocks.assign(sorted.begin(), firstSmall);
+
+  const vtkIdType numberOfBatches =
+    std::min<vtkIdType>(sorted.end() - firstSmall, 4 * numberOfThreads);
+  std::vector<std::vector<vtkIdType>> batches(numberOfBatches);
+  using BatchLoad = std::pair<vtkIdType, vtkIdType>; // cost, batch
+  std::priority_queue<BatchLoad, std::vector<BatchLoad>, std::greater<BatchLoad>> loads;
+  for (vtkIdType b = 0; b < numberOfBatches; ++b)
+  {
+    loads.emplace(0, b);
+  }
+  for (auto it = firstSmall; it != sorted.end(); ++it)
+  {
+    BatchLoad load = loads.top();
+    loads.pop();
+    batches[load.second].push_back(*it);
+    load.first += costs[*it];
+    loads.push(load);
+  }
+
+  order.clear();
+  batchOffsets.assign(1, 0);
+  for (const auto& batch : batches)
+  {
+    order.insert(order.end(), batch.begin(), batch.end());
+    batchOffsets.push_back(static_cast<vtkIdType>(order.size()));
+  }
+}
 };
 
 //------------------------------------------------------------------------------
@@ -103,7 +172,8 @@ class ProcessBlock
 public:
   ProcessBlock(vtkThreadedCompositeDataPipeline* exec, vtkInformationVector** inInfoVec,
     vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
-    const std::vector<vtkDataObject*>& inObjs, std::vector<vtkDataObject*>& outObjs)
+    const std::vector<vtkDataObject*>& inObjs, std::vector<vtkDataObject*>& outObjs,
+    const std::vector<vtkIdType>& order, const std::vector<vtkIdType>& batchOffsets)
     : Exec(exec)
     , InInfoVec(inInfoVec)
     , OutInfoVec(outInfoVec)
@@ -111,6 +181,8 @@ public:
     , Connection(connection)
     , Request(request)
     , InObjs(inObjs)
+    , Order(order)
+    , BatchOffsets(batchOffsets)
   {
     int numInputPorts = this->Exec->GetNumberOfInputPorts();
     this->OutObjs = outObjs.data();
@@ -158,20 +230,40 @@ public:
 
     vtkInformation* inInfo = inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
 
-    for (vtkIdType i = begin; i < end; ++i)
+    for (vtkIdType batch = begin; batch < end; ++batch)
     {
-      std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
-        &inInfoVec[0], outInfoVec, inInfo, request, this->InObjs[i]);
-      for (int j = 0; j < outInfoVec->GetNumberOfInformationObjects(); ++j)
+      for (vtkIdType k = this->BatchOffsets[batch]; k < this->BatchOffsets[batch + 1]; ++k)
       {
-        this->OutObjs[i * outInfoVec->GetNumberOfInformationObjects() + j] = outObjList[j];
+        this->Execute(this->Order[k], inInfoVec, outInfoVec, inInfo, request);
       }
     }
   }
 
   void Reduce() {}
 
+  // Execute block i on the calling thread, outside of any vtkSMPTools::For.
+  void ExecuteAlone(vtkIdType i)
+  {
+    vtkNew<ProcessBlockData> data;
+    data->Construct(this->InfoPrototype->In, this->InfoPrototype->InSize, this->InfoPrototype->Out);
+    vtkNew<vtkInformation> request;
+    request->Copy(this->Request, 1);
+    vtkInformation* inInfo = data->In[this->CompositePort]->GetInformationObject(this->Connection);
+    this->Execute(i, data->In, data->Out, inInfo, request);
+  }
+
 protected:
+  void Execute(vtkIdType i, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec,
+    vtkInformation* inInfo, vtkInformation* request)
+  {
+    std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
+      &inInfoVec[0], outInfoVec, inInfo, request, this->InObjs[i]);
+    for (int j = 0; j < outInfoVec->GetNumberOfInformationObjects(); ++j)
+    {
+      this->OutObjs[i * outInfoVec->GetNumberOfInformationObjects() + j] = outObjList[j];
+    }
+  }
+
   vtkThreadedCompositeDataPipeline* Exec;
   vtkInformationVector** InInfoVec;
   vtkInformationVector* OutInfoVec;
@@ -181,6 +273,8 @@ protected:
   vtkInformation* Request;
   const std::vector<vtkDataObject*>& InObjs;
   vtkDataObject** OutObjs;
+  const std::vector<vtkIdType>& Order;
+  const std::vector<vtkIdType>& BatchOffsets;
 
   vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
   vtkSMPThreadLocal<vtkInformationVector*> OutInfoVecs;
@@ -197,6 +291,7 @@ vtkThreadedCompositeDataPipeline::~vtkThreadedCompositeDataPipeline() = default;
 void vtkThreadedCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LoadBalancing: " << (this->LoadBalancing ? "On" : "Off") << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -228,14 +323,49 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
   std::vector<vtkDataObject*> outObjs;
   outObjs.resize(indices.size() * outInfoVec->GetNumberOfInformationObjects(), nullptr);
 
+  // schedule the blocks: without load balancing, each block is a batch and
+  // the batches are statically split among the threads.
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(inObjs.size());
+  const int numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  const bool balance = this->LoadBalancing && numberOfThreads > 1 && numberOfBlocks > 1;
+  std::vector<vtkIdType> largeBlocks;
+  std::vector<vtkIdType> order;
+  std::vector<vtkIdType> batchOffsets;
+  if (balance)
+  {
+    ::ScheduleBlocks(inObjs, numberOfThreads, largeBlocks, order, batchOffsets);
+  }
+  else
+  {
+    order.resize(numberOfBlocks);
+    std::iota(order.begin(), order.end(), 0);
+    batchOffsets.resize(numberOfBlocks + 1);
+    std::iota(batchOffsets.begin(), batchOffsets.end(), 0);
+  }
+  const vtkIdType numberOfBatches = static_cast<vtkIdType>(batchOffsets.size()) - 1;
+
   // create the parallel task processBlock
-  ProcessBlock processBlock(
-    this, inInfoVec, outInfoVec, compositePort, connection, request, inObjs, outObjs);
+  ProcessBlock processBlock(this, inInfoVec, outInfoVec, compositePort, connection, request,
+    inObjs, outObjs, order, batchOffsets);
 
   vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
   vtkNew<vtkSMPProgressObserver> po;
   this->Algorithm->SetProgressObserver(po);
-  vtkSMPTools::For(0, static_cast<vtkIdType>(inObjs.size()), processBlock);
+  // large blocks are executed one at a time, so that the algorithm can use
+  // vtkSMPTools itself, then the batches of small blocks are executed in
+  // parallel, one task per batch.
+  for (vtkIdType block : largeBlocks)
+  {
+    processBlock.ExecuteAlone(block);
+  }
+  if (balance)
+  {
+    vtkSMPTools::For(0, numberOfBatches, 1, processBlock);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numberOfBatches, processBlock);
+  }
   this->Algorithm->SetProgressObserver(origPo);
 
   int i = 0;
@@ -264,8 +394,14 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
-  // Invoke the request on the algorithm.
+  // Invoke the request on the algorithm, recording it if profiling.
+  vtkPipelineProfiler* profiler = vtkPipelineProfiler::GetActiveProfiler();
+  const double startTime = profiler ? vtkPipelineProfiler::GetTime() : 0.0;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  if (profiler)
+  {
+    profiler->RecordRequest(this->Algorithm, request, outInfo, startTime);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
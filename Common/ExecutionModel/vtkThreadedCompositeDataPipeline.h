@@ -11,6 +11,13 @@
  * algorithm implement all pipeline passes in a re-entrant way. It should
  * store/retrieve all state changes using input and output information
  * objects, which are unique to each thread.
+ *
+ * When LoadBalancing is on, the default, the blocks are scheduled according
+ * to their number of cells. A block that dominates the work, holding at least
+ * half of the cells of all the blocks, is executed alone, outside of the
+ * parallel loop over the blocks, so that an algorithm that uses vtkSMPTools
+ * internally can use all the threads for it. The other blocks are grouped in
+ * batches of similar cost, which are executed in parallel.
  */
 
 #ifndef vtkThreadedCompositeDataPipeline_h
@@ -38,6 +45,17 @@ public:
   int CallAlgorithm(vtkInformation* request, int direction, vtkInformationVector** inInfo,
     vtkInformationVector* outInfo) override;
 
+  ///@{
+  /**
+   * Enable/disable the scheduling of the blocks according to their number of
+   * cells. When off, the blocks are statically split among the threads.
+   * Default is on.
+   */
+  vtkSetMacro(LoadBalancing, bool);
+  vtkGetMacro(LoadBalancing, bool);
+  vtkBooleanMacro(LoadBalancing, bool);
+  ///@}
+
 protected:
   vtkThreadedCompositeDataPipeline();
   ~vtkThreadedCompositeDataPipeline() override;
@@ -45,6 +63,8 @@ protected:
     vtkInformationVector* outInfoVec, int compositePort, int connection, vtkInformation* request,
     std::vector<vtkSmartPointer<vtkCompositeDataSet>>& compositeOutput) override;
 
+  bool LoadBalancing = true;
+
 private:
   vtkThreadedCompositeDataPipeline(const vtkThreadedCompositeDataPipeline&) = delete;
   void operator=(const vtkThreadedCompositeDataPipeline&) = delete;
@@ -11,6 +11,55 @@ vtkStandardNewMacro(vtkFunctionParser);
 
 static double vtkParserVectorErrorResult[3] = { VTK_PARSER_ERROR_RESULT, VTK_PARSER_ERROR_RESULT,
   VTK_PARSER_ERROR_RESULT };
+
+namespace
+{
+// Apply op to each value of a block.
+template <typename Op>
+void vtkUnaryBlock(double* a, vtkIdType n, Op op)
+{
+  for (vtkIdType t = 0; t < n; ++t)
+  {
+    a[t] = op(a[t]);
+  }
+}
+
+// Apply op to each pair of values of two blocks, storing the result in the first one.
+template <typename Op>
+void vtkBinaryBlock(double* a, const double* b, vtkIdType n, Op op)
+{
+  for (vtkIdType t = 0; t < n; ++t)
+  {
+    a[t] = op(a[t], b[t]);
+  }
+}
+
+// Apply op to the values of a block for which valid is true. The others are
+// replaced, or flagged as failed in which case false is returned.
+template <typename Valid, typename Op>
+bool vtkCheckedUnaryBlock(
+  double* a, vtkIdType n, Valid valid, Op op, bool replace, double replacement, double* failed)
+{
+  bool success = true;
+  for (vtkIdType t = 0; t < n; ++t)
+  {
+    if (valid(a[t]))
+    {
+      a[t] = op(a[t]);
+    }
+    else if (replace)
+    {
+      a[t] = replacement;
+    }
+    else
+    {
+      failed[t] = 1.0;
+      success = false;
+    }
+  }
+  return success;
+}
+}
 //------------------------------------------------------------------------------
 vtkFunctionParser::vtkFunctionParser()
 {
@@ -875,6 +924,437 @@ double* vtkFunctionParser::GetVectorResult()
   return this->Stack;
 }
 
+//------------------------------------------------------------------------------
+bool vtkFunctionParser::EvaluateBlock(vtkIdType numberOfTuples,
+  const double* const* scalarVariables, const double* const* vectorVariables, double* result,
+  std::vector<double>& workspace, const char** errorMessage)
+{
+  if (errorMessage)
+  {
+    *errorMessage = nullptr;
+  }
+  if (this->FunctionMTime.GetMTime() > this->ParseMTime.GetMTime() || numberOfTuples < 0)
+  {
+    return false;
+  }
+
+  // The stack holds a block of values per entry. It is followed by a flag per
+  // tuple telling whether its evaluation failed.
+  const vtkIdType n = numberOfTuples;
+  workspace.resize(static_cast<size_t>((this->StackSize + 1) * n));
+  double* stack = workspace.data();
+  double* failed = stack + this->StackSize * n;
+  std::fill(failed, failed + n, 0.0);
+  auto block = [stack, n](int position) { return stack + position * n; };
+
+  const bool replace = this->ReplaceInvalidValues != 0;
+  const double replacement = this->ReplacementValue;
+  const char* error = nullptr;
+
+  const int numberOfScalarVariables = this->GetNumberOfScalarVariables();
+  int numImmediatesProcessed = 0;
+  int stackPosition = -1;
+  for (int i = 0; i < this->ByteCodeSize; i++)
+  {
+    const int p = stackPosition;
+    switch (this->ByteCode[i])
+    {
+      case VTK_PARSER_IMMEDIATE:
+        std::fill(block(p + 1), block(p + 2), this->Immediates[numImmediatesProcessed++]);
+        stackPosition++;
+        break;
+      case VTK_PARSER_UNARY_MINUS:
+        vtkUnaryBlock(block(p), n, [](double a) { return -a; });
+        break;
+      case VTK_PARSER_UNARY_PLUS:
+      case VTK_PARSER_VECTOR_UNARY_PLUS:
+        break;
+      case VTK_PARSER_ADD:
+        vtkBinaryBlock(block(p - 1), block(p), n, [](double a, double b) { return a + b; });
+        stackPosition--;
+        break;
+      case VTK_PARSER_SUBTRACT:
+        vtkBinaryBlock(block(p - 1), block(p), n, [](double a, double b) { return a - b; });
+        stackPosition--;
+        break;
+      case VTK_PARSER_MULTIPLY:
+        vtkBinaryBlock(block(p - 1), block(p), n, [](double a, double b) { return a * b; });
+        stackPosition--;
+        break;
+      case VTK_PARSER_DIVIDE:
+      {
+        double* a = block(p - 1);
+        const double* b = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          if (b[t] != 0)
+          {
+            a[t] /= b[t];
+          }
+          else if (replace)
+          {
+            a[t] = replacement;
+          }
+          else
+          {
+            failed[t] = 1.0;
+            error = "Trying to divide by zero";
+          }
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_POWER:
+        vtkBinaryBlock(block(p - 1), block(p), n, [](double a, double b) { return pow(a, b); });
+        stackPosition--;
+        break;
+      case VTK_PARSER_ABSOLUTE_VALUE:
+        vtkUnaryBlock(block(p), n, [](double a) { return fabs(a); });
+        break;
+      case VTK_PARSER_EXPONENT:
+        vtkUnaryBlock(block(p), n, [](double a) { return exp(a); });
+        break;
+      case VTK_PARSER_CEILING:
+        vtkUnaryBlock(block(p), n, [](double a) { return ceil(a); });
+        break;
+      case VTK_PARSER_FLOOR:
+        vtkUnaryBlock(block(p), n, [](double a) { return floor(a); });
+        break;
+      case VTK_PARSER_LOGARITHM:
+        if (!vtkCheckedUnaryBlock(block(p), n, [](double a) { return a > 0; },
+              [](double a) { return log(a); }, replace, replacement, failed))
+        {
+          error = "Trying to take a log of a non-positive value";
+        }
+        break;
+      case VTK_PARSER_LOGARITHME:
+        if (!vtkCheckedUnaryBlock(block(p), n, [](double a) { return a > 0; },
+              [](double a) { return log(a); }, replace, replacement, failed))
+        {
+          error = "Trying to take a natural logarithm of a non-positive value";
+        }
+        break;
+      case VTK_PARSER_LOGARITHM10:
+        if (!vtkCheckedUnaryBlock(block(p), n, [](double a) { return a > 0; },
+              [](double a) { return log10(a); }, replace, replacement, failed))
+        {
+          error = "Trying to take a log10 of a non-positive value";
+        }
+        break;
+      case VTK_PARSER_SQUARE_ROOT:
+        if (!vtkCheckedUnaryBlock(block(p), n, [](double a) { return a >= 0; },
+              [](double a) { return sqrt(a); }, replace, replacement, failed))
+        {
+          error = "Trying to take a square root of a negative value";
+        }
+        break;
+      case VTK_PARSER_SINE:
+        vtkUnaryBlock(block(p), n, [](double a) { return sin(a); });
+        break;
+      case VTK_PARSER_COSINE:
+        vtkUnaryBlock(block(p), n, [](double a) { return cos(a); });
+        break;
+      case VTK_PARSER_TANGENT:
+        vtkUnaryBlock(block(p), n, [](double a) { return tan(a); });
+        break;
+      case VTK_PARSER_ARCSINE:
+        if (!vtkCheckedUnaryBlock(block(p), n, [](double a) { return !(a < -1 || a > 1); },
+              [](double a) { return asin(a); }, replace, replacement, failed))
+        {
+          error = "Trying to take asin of a value < -1 or > 1";
+        }
+        break;
+      case VTK_PARSER_ARCCOSINE:
+        if (!vtkCheckedUnaryBlock(block(p), n, [](double a) { return !(a < -1 || a > 1); },
+              [](double a) { return acos(a); }, replace, replacement, failed))
+        {
+          error = "Trying to take acos of a value < -1 or > 1";
+        }
+        break;
+      case VTK_PARSER_ARCTANGENT:
+        vtkUnaryBlock(block(p), n, [](double a) { return atan(a); });
+        break;
+      case VTK_PARSER_HYPERBOLIC_SINE:
+        vtkUnaryBlock(block(p), n, [](double a) { return sinh(a); });
+        break;
+      case VTK_PARSER_HYPERBOLIC_COSINE:
+        vtkUnaryBlock(block(p), n, [](double a) { return cosh(a); });
+        break;
+      case VTK_PARSER_HYPERBOLIC_TANGENT:
+        vtkUnaryBlock(block(p), n, [](double a) { return tanh(a); });
+        break;
+      case VTK_PARSER_MIN:
+        vtkBinaryBlock(block(p - 1), block(p), n, [](double a, double b) { return b < a ? b : a; });
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAX:
+        vtkBinaryBlock(block(p - 1), block(p), n, [](double a, double b) { return b > a ? b : a; });
+        stackPosition--;
+        break;
+      case VTK_PARSER_CROSS:
+      {
+        double* ux = block(p - 5);
+        double* uy = block(p - 4);
+        double* uz = block(p - 3);
+        const double* vx = block(p - 2);
+        const double* vy = block(p - 1);
+        const double* vz = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const double x = uy[t] * vz[t] - uz[t] * vy[t];
+          const double y = uz[t] * vx[t] - ux[t] * vz[t];
+          const double z = ux[t] * vy[t] - uy[t] * vx[t];
+          ux[t] = x;
+          uy[t] = y;
+          uz[t] = z;
+        }
+        stackPosition -= 3;
+        break;
+      }
+      case VTK_PARSER_SIGN:
+        vtkUnaryBlock(block(p), n, [](double a) { return a < 0 ? -1.0 : (a == 0 ? 0.0 : 1.0); });
+        break;
+      case VTK_PARSER_VECTOR_UNARY_MINUS:
+        vtkUnaryBlock(block(p - 2), n, [](double a) { return -a; });
+        vtkUnaryBlock(block(p - 1), n, [](double a) { return -a; });
+        vtkUnaryBlock(block(p), n, [](double a) { return -a; });
+        break;
+      case VTK_PARSER_DOT_PRODUCT:
+      {
+        double* ux = block(p - 5);
+        const double* uy = block(p - 4);
+        const double* uz = block(p - 3);
+        const double* vx = block(p - 2);
+        const double* vy = block(p - 1);
+        const double* vz = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          ux[t] = ux[t] * vx[t] + uy[t] * vy[t] + uz[t] * vz[t];
+        }
+        stackPosition -= 5;
+        break;
+      }
+      case VTK_PARSER_VECTOR_ADD:
+        for (int c = 0; c < 3; ++c)
+        {
+          vtkBinaryBlock(block(p - 5 + c), block(p - 2 + c), n,
+            [](double a, double b) { return a + b; });
+        }
+        stackPosition -= 3;
+        break;
+      case VTK_PARSER_VECTOR_SUBTRACT:
+        for (int c = 0; c < 3; ++c)
+        {
+          vtkBinaryBlock(block(p - 5 + c), block(p - 2 + c), n,
+            [](double a, double b) { return a - b; });
+        }
+        stackPosition -= 3;
+        break;
+      case VTK_PARSER_SCALAR_TIMES_VECTOR:
+      {
+        // The vector is moved down over the scalar.
+        double* s = block(p - 3);
+        double* x = block(p - 2);
+        double* y = block(p - 1);
+        const double* z = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const double scalar = s[t];
+          s[t] = scalar * x[t];
+          x[t] = scalar * y[t];
+          y[t] = scalar * z[t];
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_VECTOR_TIMES_SCALAR:
+      {
+        const double* s = block(p);
+        for (int c = 1; c <= 3; ++c)
+        {
+          double* a = block(p - c);
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            a[t] *= s[t];
+          }
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_VECTOR_OVER_SCALAR:
+      {
+        const double* s = block(p);
+        for (int c = 1; c <= 3; ++c)
+        {
+          double* a = block(p - c);
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            a[t] = s[t] != 0.0 ? a[t] / s[t] : a[t];
+          }
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_MAGNITUDE:
+      {
+        double* x = block(p - 2);
+        const double* y = block(p - 1);
+        const double* z = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          x[t] = sqrt(x[t] * x[t] + y[t] * y[t] + z[t] * z[t]);
+        }
+        stackPosition -= 2;
+        break;
+      }
+      case VTK_PARSER_NORMALIZE:
+      {
+        double* x = block(p - 2);
+        double* y = block(p - 1);
+        double* z = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          const double magnitude = sqrt(x[t] * x[t] + y[t] * y[t] + z[t] * z[t]);
+          if (magnitude != 0)
+          {
+            x[t] /= magnitude;
+            y[t] /= magnitude;
+            z[t] /= magnitude;
+          }
+        }
+        break;
+      }
+      case VTK_PARSER_IHAT:
+      case VTK_PARSER_JHAT:
+      case VTK_PARSER_KHAT:
+      {
+        const int axis = static_cast<int>(this->ByteCode[i] - VTK_PARSER_IHAT);
+        for (int c = 0; c < 3; ++c)
+        {
+          std::fill(block(p + 1 + c), block(p + 2 + c), c == axis ? 1.0 : 0.0);
+        }
+        stackPosition += 3;
+        break;
+      }
+      case VTK_PARSER_LESS_THAN:
+        vtkBinaryBlock(block(p - 1), block(p), n,
+          [](double a, double b) { return static_cast<double>(a < b); });
+        stackPosition--;
+        break;
+      case VTK_PARSER_GREATER_THAN:
+        vtkBinaryBlock(block(p - 1), block(p), n,
+          [](double a, double b) { return static_cast<double>(a > b); });
+        stackPosition--;
+        break;
+      case VTK_PARSER_EQUAL_TO:
+        vtkBinaryBlock(block(p - 1), block(p), n,
+          [](double a, double b) { return static_cast<double>(a == b); });
+        stackPosition--;
+        break;
+      case VTK_PARSER_AND:
+        vtkBinaryBlock(block(p - 1), block(p), n,
+          [](double a, double b) { return static_cast<double>(a && b); });
+        stackPosition--;
+        break;
+      case VTK_PARSER_OR:
+        vtkBinaryBlock(block(p - 1), block(p), n,
+          [](double a, double b) { return static_cast<double>(a || b); });
+        stackPosition--;
+        break;
+      case VTK_PARSER_IF:
+      {
+        // if(bool,valtrue,valfalse): the result replaces valfalse.
+        double* valFalse = block(p - 2);
+        const double* valTrue = block(p - 1);
+        const double* boolArg = block(p);
+        for (vtkIdType t = 0; t < n; ++t)
+        {
+          valFalse[t] = boolArg[t] != 0.0 ? valTrue[t] : valFalse[t];
+        }
+        stackPosition -= 2;
+        break;
+      }
+      case VTK_PARSER_VECTOR_IF:
+      {
+        const double* boolArg = block(p);
+        for (int c = 0; c < 3; ++c)
+        {
+          double* valFalse = block(p - 6 + c);
+          const double* valTrue = block(p - 3 + c);
+          for (vtkIdType t = 0; t < n; ++t)
+          {
+            valFalse[t] = boolArg[t] != 0.0 ? valTrue[t] : valFalse[t];
+          }
+        }
+        stackPosition -= 4;
+        break;
+      }
+      default:
+      {
+        const int variable = static_cast<int>(this->ByteCode[i] - VTK_PARSER_BEGIN_VARIABLES);
+        if (variable < numberOfScalarVariables)
+        {
+          if (!scalarVariables || !scalarVariables[variable])
+          {
+            return false;
+          }
+          std::copy(scalarVariables[variable], scalarVariables[variable] + n, block(p + 1));
+          stackPosition++;
+        }
+        else
+        {
+          const int vectorNum = variable - numberOfScalarVariables;
+          if (!vectorVariables || !vectorVariables[vectorNum])
+          {
+            return false;
+          }
+          // The x, y and z blocks of the stack are contiguous.
+          std::copy(vectorVariables[vectorNum], vectorVariables[vectorNum] + 3 * n, block(p + 1));
+          stackPosition += 3;
+        }
+      }
+    }
+  }
+
+  int numberOfComponents;
+  if (stackPosition == 0)
+  {
+    numberOfComponents = 1;
+  }
+  else if (stackPosition == 2)
+  {
+    numberOfComponents = 3;
+  }
+  else
+  {
+    return false;
+  }
+  std::copy(stack, stack + numberOfComponents * n, result);
+
+  if (error)
+  {
+    if (errorMessage)
+    {
+      *errorMessage = error;
+    }
+    else
+    {
+      vtkErrorMacro(<< error);
+    }
+    for (vtkIdType t = 0; t < n; ++t)
+    {
+      if (failed[t] != 0.0)
+      {
+        for (int c = 0; c < numberOfComponents; ++c)
+        {
+          result[c * n + t] = VTK_PARSER_ERROR_RESULT;
+        }
+      }
+    }
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 const char* vtkFunctionParser::GetScalarVariableName(int i)
 {
@@ -170,6 +170,33 @@ public:
   }
   ///@}
 
+  /**
+   * Evaluate the function for a block of numberOfTuples sets of variable
+   * values at once. The byte code is interpreted once per block instead of
+   * once per tuple, and each of its instructions is applied to the whole block
+   * in a loop the compiler can vectorize.
+   *
+   * scalarVariables[i] points to the numberOfTuples values of the i-th scalar
+   * variable, and vectorVariables[i] to the numberOfTuples x values, then the
+   * numberOfTuples y values, then the numberOfTuples z values of the i-th
+   * vector variable. Variables the function does not need may be nullptr.
+   * result receives the numberOfTuples values of a scalar result, or the
+   * x, y and z values of a vector result laid out the same way. workspace is
+   * resized as needed and can be reused from one block to the next.
+   *
+   * The function must have been parsed beforehand, for instance with
+   * IsScalarResult(). This method then does not modify the parser, so that
+   * several threads can evaluate blocks with the same parser, each with its
+   * own workspace. Tuples whose evaluation fails are set to
+   * VTK_PARSER_ERROR_RESULT. If error is not nullptr, it receives the message
+   * of a failure, or nullptr if there is none, instead of the failure being
+   * reported with vtkErrorMacro, which is not safe from several threads.
+   * Returns false if the function is not parsed or a needed variable is missing.
+   */
+  bool EvaluateBlock(vtkIdType numberOfTuples, const double* const* scalarVariables,
+    const double* const* vectorVariables, double* result, std::vector<double>& workspace,
+    const char** error = nullptr);
+
   ///@{
   /**
    * Set the value of a scalar variable.  If a variable with this name
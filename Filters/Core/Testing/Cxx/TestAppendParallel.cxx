@@ -0,0 +1,456 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkAppendFilter and vtkAppendPolyData, which copy their inputs
+// concurrently, append the points, cells and attributes of each input at the
+// right location, with and without merging points.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A slab of hexahedra of a nx x ny x (numberOfPieces * nz) grid. Consecutive
+// slabs share the points of their common boundary.
+vtkSmartPointer<vtkUnstructuredGrid> CreateSlab(int piece, int nx, int ny, int nz)
+{
+  auto slab = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetName("GlobalIds");
+  vtkNew<vtkIntArray> pieces;
+  pieces->SetName("piece");
+  vtkNew<vtkStringArray> names;
+  names->SetName("name");
+  for (int k = 0; k <= nz; ++k)
+  {
+    for (int j = 0; j <= ny; ++j)
+    {
+      for (int i = 0; i <= nx; ++i)
+      {
+        const int z = piece * nz + k;
+        points->InsertNextPoint(i, j, z);
+        globalIds->InsertNextValue(i + (nx + 1) * (j + (ny + 1) * z));
+        pieces->InsertNextValue(piece);
+        names->InsertNextValue(std::to_string(piece));
+      }
+    }
+  }
+  slab->SetPoints(points);
+  slab->GetPointData()->SetGlobalIds(globalIds);
+  slab->GetPointData()->AddArray(pieces);
+  slab->GetPointData()->AddArray(names);
+
+  vtkNew<vtkDoubleArray> cellIds;
+  cellIds->SetName("cellId");
+  slab->AllocateExact(nx * ny * nz, 8);
+  for (int k = 0; k < nz; ++k)
+  {
+    for (int j = 0; j < ny; ++j)
+    {
+      for (int i = 0; i < nx; ++i)
+      {
+        auto id = [=](int di, int dj, int dk) -> vtkIdType {
+          return (i + di) + (nx + 1) * ((j + dj) + (ny + 1) * (k + dk));
+        };
+        const vtkIdType hex[8] = { id(0, 0, 0), id(1, 0, 0), id(1, 1, 0), id(0, 1, 0), id(0, 0, 1),
+          id(1, 0, 1), id(1, 1, 1), id(0, 1, 1) };
+        slab->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        cellIds->InsertNextValue(i + nx * (j + ny * (piece * nz + k)));
+      }
+    }
+  }
+  slab->GetCellData()->AddArray(cellIds);
+  return slab;
+}
+
+// A grid with a tetrahedron and a cube described as a polyhedron.
+vtkSmartPointer<vtkUnstructuredGrid> CreatePolyhedra(double shift)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+  {
+    points->InsertNextPoint(shift, 0, k);
+    points->InsertNextPoint(shift + 1, 0, k);
+    points->InsertNextPoint(shift + 1, 1, k);
+    points->InsertNextPoint(shift, 1, k);
+  }
+  points->InsertNextPoint(shift, 0, 3);
+  grid->SetPoints(points);
+  const vtkIdType tetra[4] = { 4, 5, 7, 8 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  const vtkIdType faces[] = { 4, 0, 3, 2, 1, 4, 4, 5, 6, 7, 4, 0, 1, 5, 4, 4, 1, 2, 6, 5, 4, 2, 3,
+    7, 6, 4, 3, 0, 4, 7 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 6, faces);
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  return grid;
+}
+
+// Polygonal data with cells of every kind. Its cell ids are grouped by kind
+// (verts, lines, polys then strips) only if the cells are set by kind.
+vtkSmartPointer<vtkPolyData> CreatePolyData(int shift, bool setByKind)
+{
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  vtkNew<vtkStringArray> names;
+  names->SetName("name");
+  for (int i = 0; i < 6; ++i)
+  {
+    points->InsertNextPoint(shift + i, i % 2, 0);
+    names->InsertNextValue(std::to_string(shift + i));
+  }
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(names);
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  const vtkIdType line[2] = { 3, 4 };
+  const vtkIdType strip[4] = { 2, 3, 4, 5 };
+  const vtkIdType vertex[1] = { 5 };
+  if (setByKind)
+  {
+    vtkNew<vtkCellArray> verts, lines, polys, strips;
+    verts->InsertNextCell(1, vertex);
+    lines->InsertNextCell(2, line);
+    polys->InsertNextCell(3, triangle);
+    polys->InsertNextCell(4, strip);
+    strips->InsertNextCell(4, strip);
+    polyData->SetVerts(verts);
+    polyData->SetLines(lines);
+    polyData->SetPolys(polys);
+    polyData->SetStrips(strips);
+  }
+  else
+  {
+    polyData->AllocateEstimate(10, 4);
+    polyData->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+    polyData->InsertNextCell(VTK_LINE, 2, line);
+    polyData->InsertNextCell(VTK_TRIANGLE_STRIP, 4, strip);
+    polyData->InsertNextCell(VTK_VERTEX, 1, vertex);
+    polyData->InsertNextCell(VTK_POLYGON, 4, strip);
+  }
+  vtkNew<vtkDoubleArray> cellIds;
+  cellIds->SetName("cellId");
+  for (vtkIdType i = 0; i < polyData->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(shift + i);
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+  return polyData;
+}
+
+// Compare the types and point coordinates of two cells, as well as the face
+// coordinates of polyhedra.
+bool SameCell(vtkDataSet* output, vtkIdType outputId, vtkDataSet* input, vtkIdType inputId)
+{
+  vtkNew<vtkIdList> outputIds;
+  vtkNew<vtkIdList> inputIds;
+  output->GetCellPoints(outputId, outputIds);
+  input->GetCellPoints(inputId, inputIds);
+  if (output->GetCellType(outputId) != input->GetCellType(inputId) ||
+    outputIds->GetNumberOfIds() != inputIds->GetNumberOfIds())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < inputIds->GetNumberOfIds(); ++i)
+  {
+    double p[3], q[3];
+    output->GetPoint(outputIds->GetId(i), p);
+    input->GetPoint(inputIds->GetId(i), q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      return false;
+    }
+  }
+  if (input->GetCellType(inputId) == VTK_POLYHEDRON)
+  {
+    vtkIdType outputFaces, inputFaces;
+    const vtkIdType *outputStream, *inputStream;
+    vtkUnstructuredGrid::SafeDownCast(output)->GetFaceStream(outputId, outputFaces, outputStream);
+    vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(inputId, inputFaces, inputStream);
+    if (outputFaces != inputFaces)
+    {
+      return false;
+    }
+    for (vtkIdType face = 0; face < inputFaces; ++face)
+    {
+      const vtkIdType npts = *inputStream++;
+      if (*outputStream++ != npts)
+      {
+        return false;
+      }
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        double p[3], q[3];
+        output->GetPoint(*outputStream++, p);
+        input->GetPoint(*inputStream++, q);
+        if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Check that the cells of the inputs are appended in order, along with their
+// cell data.
+bool CheckCells(vtkDataSet* output, const std::vector<vtkDataSet*>& inputs)
+{
+  vtkIdType outputId = 0;
+  vtkDataArray* outputCellIds = output->GetCellData()->GetArray("cellId");
+  for (vtkDataSet* input : inputs)
+  {
+    vtkDataArray* inputCellIds = input->GetCellData()->GetArray("cellId");
+    for (vtkIdType inputId = 0; inputId < input->GetNumberOfCells(); ++inputId, ++outputId)
+    {
+      if (!::SameCell(output, outputId, input, inputId) ||
+        (outputCellIds &&
+          outputCellIds->GetTuple1(outputId) != inputCellIds->GetTuple1(inputId)))
+      {
+        vtkLog(ERROR, "Wrong output cell " << outputId);
+        return false;
+      }
+    }
+  }
+  if (outputId != output->GetNumberOfCells())
+  {
+    vtkLog(ERROR, "Wrong number of cells " << output->GetNumberOfCells());
+    return false;
+  }
+  return true;
+}
+
+bool TestAppendFilterSlabs(bool mergePoints, bool globalIds)
+{
+  constexpr int numberOfPieces = 5;
+  constexpr int nx = 4, ny = 3, nz = 2;
+  vtkNew<vtkAppendFilter> append;
+  append->SetMergePoints(mergePoints);
+  std::vector<vtkSmartPointer<vtkUnstructuredGrid>> slabs;
+  std::vector<vtkDataSet*> inputs;
+  for (int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    slabs.push_back(::CreateSlab(piece, nx, ny, nz));
+    if (!globalIds)
+    {
+      slabs.back()->GetPointData()->SetGlobalIds(nullptr);
+    }
+    inputs.push_back(slabs.back());
+    append->AddInputData(slabs.back());
+  }
+  // empty inputs are skipped
+  vtkNew<vtkUnstructuredGrid> empty;
+  append->AddInputData(empty);
+  append->Update();
+  vtkUnstructuredGrid* output = append->GetOutput();
+
+  const vtkIdType expectedPoints = mergePoints
+    ? (nx + 1) * (ny + 1) * (numberOfPieces * nz + 1)
+    : numberOfPieces * (nx + 1) * (ny + 1) * (nz + 1);
+  if (output->GetNumberOfPoints() != expectedPoints)
+  {
+    vtkLog(ERROR, "Wrong number of points " << output->GetNumberOfPoints());
+    return false;
+  }
+  if (!::CheckCells(output, inputs))
+  {
+    return false;
+  }
+
+  // Merged points are numbered in the order of their first occurrence, and
+  // their data come from their last occurrence.
+  vtkDataArray* pieces = output->GetPointData()->GetArray("piece");
+  vtkStringArray* names =
+    vtkStringArray::SafeDownCast(output->GetPointData()->GetAbstractArray("name"));
+  if (!pieces || !names || (output->GetPointData()->GetGlobalIds() != nullptr) != globalIds)
+  {
+    vtkLog(ERROR, "Missing point data");
+    return false;
+  }
+  const vtkIdType pointsPerPlane = (nx + 1) * (ny + 1);
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3];
+    output->GetPoint(ptId, p);
+    int piece = static_cast<int>(ptId / (pointsPerPlane * (nz + 1)));
+    vtkIdType expectedZ = piece * nz + (ptId / pointsPerPlane) % (nz + 1);
+    if (mergePoints)
+    {
+      expectedZ = ptId / pointsPerPlane;
+      piece = static_cast<int>(std::min<vtkIdType>(expectedZ / nz, numberOfPieces - 1));
+    }
+    if (p[2] != expectedZ || p[0] != ptId % (nx + 1) ||
+      pieces->GetTuple1(ptId) != piece || names->GetValue(ptId) != std::to_string(piece))
+    {
+      vtkLog(ERROR, "Wrong output point " << ptId);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestAppendFilterMixed()
+{
+  auto polyhedra0 = ::CreatePolyhedra(0);
+  auto polyhedra1 = ::CreatePolyhedra(5);
+  auto polyData = ::CreatePolyData(10, false);
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(3, 2, 2);
+  image->SetOrigin(20, 0, 0);
+  std::vector<vtkDataSet*> inputs{ polyhedra0, polyData, image, polyhedra1 };
+  vtkNew<vtkAppendFilter> append;
+  for (vtkDataSet* input : inputs)
+  {
+    append->AddInputData(input);
+  }
+  append->Update();
+  vtkUnstructuredGrid* output = append->GetOutput();
+  return ::CheckCells(output, inputs) && output->GetPointData()->GetNumberOfArrays() == 0;
+}
+
+bool TestAppendPolyDataTypes()
+{
+  std::vector<vtkSmartPointer<vtkPolyData>> polyDatas{ ::CreatePolyData(0, true),
+    ::CreatePolyData(10, true), vtkSmartPointer<vtkPolyData>::New(), ::CreatePolyData(20, true) };
+  vtkNew<vtkAppendPolyData> append;
+  for (const auto& polyData : polyDatas)
+  {
+    append->AddInputData(polyData);
+  }
+  append->Update();
+  vtkPolyData* output = append->GetOutput();
+
+  // The output cells are grouped by kind: verts, then lines, polys and strips.
+  auto kind = [](int cellType) {
+    switch (cellType)
+    {
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+        return 0;
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+        return 1;
+      case VTK_TRIANGLE_STRIP:
+        return 3;
+      default:
+        return 2;
+    }
+  };
+  vtkIdType outputId = 0;
+  vtkDataArray* outputCellIds = output->GetCellData()->GetArray("cellId");
+  for (int cellKind = 0; cellKind < 4; ++cellKind)
+  {
+    for (const auto& input : polyDatas)
+    {
+      for (vtkIdType inputId = 0; inputId < input->GetNumberOfCells(); ++inputId)
+      {
+        if (kind(input->GetCellType(inputId)) != cellKind)
+        {
+          continue;
+        }
+        if (!::SameCell(output, outputId, input, inputId) ||
+          outputCellIds->GetTuple1(outputId) !=
+            input->GetCellData()->GetArray("cellId")->GetTuple1(inputId))
+        {
+          vtkLog(ERROR, "Wrong output cell " << outputId);
+          return false;
+        }
+        ++outputId;
+      }
+    }
+  }
+  vtkStringArray* names =
+    vtkStringArray::SafeDownCast(output->GetPointData()->GetAbstractArray("name"));
+  if (outputId != output->GetNumberOfCells() || output->GetNumberOfPoints() != 18 || !names ||
+    names->GetValue(7) != "11")
+  {
+    vtkLog(ERROR, "Wrong appended polydata");
+    return false;
+  }
+  return true;
+}
+
+// Bit arrays of many small pieces, whose tuples share bytes of the output.
+bool TestAppendBitArrays()
+{
+  constexpr int numberOfPieces = 64;
+  constexpr vtkIdType piecePoints = 3;
+  vtkNew<vtkAppendFilter> append;
+  for (int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    vtkNew<vtkUnstructuredGrid> grid;
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkBitArray> pointBits;
+    pointBits->SetName("bits");
+    vtkNew<vtkBitArray> cellBits;
+    cellBits->SetName("bits");
+    grid->AllocateExact(piecePoints, 1);
+    for (vtkIdType i = 0; i < piecePoints; ++i)
+    {
+      points->InsertNextPoint(piece, static_cast<double>(i), 0.0);
+      pointBits->InsertNextValue((piece + i) % 2);
+      cellBits->InsertNextValue((piece * i) % 2);
+      grid->InsertNextCell(VTK_VERTEX, 1, &i);
+    }
+    grid->SetPoints(points);
+    grid->GetPointData()->AddArray(pointBits);
+    grid->GetCellData()->AddArray(cellBits);
+    append->AddInputData(grid);
+  }
+  append->Update();
+  vtkUnstructuredGrid* output = append->GetOutput();
+  vtkBitArray* pointBits = vtkBitArray::SafeDownCast(output->GetPointData()->GetArray("bits"));
+  vtkBitArray* cellBits = vtkBitArray::SafeDownCast(output->GetCellData()->GetArray("bits"));
+  if (!pointBits || !cellBits || pointBits->GetNumberOfValues() != numberOfPieces * piecePoints ||
+    cellBits->GetNumberOfValues() != numberOfPieces * piecePoints)
+  {
+    vtkLog(ERROR, "Wrong appended bit arrays");
+    return false;
+  }
+  for (int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    for (vtkIdType i = 0; i < piecePoints; ++i)
+    {
+      const vtkIdType id = piece * piecePoints + i;
+      if (pointBits->GetValue(id) != (piece + i) % 2 || cellBits->GetValue(id) != (piece * i) % 2)
+      {
+        vtkLog(ERROR, "Wrong appended bit at " << id);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestAppendParallel(int, char*[])
+{
+  if (!::TestAppendFilterSlabs(false, false) || !::TestAppendFilterSlabs(true, false) ||
+    !::TestAppendFilterSlabs(true, true) || !::TestAppendFilterMixed() ||
+    !::TestAppendPolyDataTypes() || !::TestAppendBitArrays())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that the vectorized parser of vtkArrayCalculator computes the same
+// results as vtkFunctionParser, that evaluation errors are reported once, and
+// measures the number of tuples per second of each parser.
+
+#include "vtkArrayCalculator.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Count the error events of an object.
+class ErrorCounter : public vtkCommand
+{
+public:
+  static ErrorCounter* New() { return new ErrorCounter; }
+  void Execute(vtkObject*, unsigned long, void*) override { ++this->NumberOfErrors; }
+  int NumberOfErrors = 0;
+};
+
+// Add the arrays used by the functions to attributes.
+void AddArrays(vtkDataSetAttributes* attributes, vtkIdType numberOfTuples)
+{
+  vtkNew<vtkDoubleArray> a;
+  a->SetName("a");
+  a->SetNumberOfTuples(numberOfTuples);
+  vtkNew<vtkFloatArray> b;
+  b->SetName("b");
+  b->SetNumberOfTuples(numberOfTuples);
+  vtkNew<vtkIntArray> c;
+  c->SetName("c");
+  c->SetNumberOfComponents(2);
+  c->SetNumberOfTuples(numberOfTuples);
+  vtkNew<vtkFloatArray> v;
+  v->SetName("v");
+  v->SetNumberOfComponents(3);
+  v->SetNumberOfTuples(numberOfTuples);
+  for (vtkIdType i = 0; i < numberOfTuples; ++i)
+  {
+    a->SetValue(i, std::sin(0.01 * i) * 2.0);
+    b->SetValue(i, static_cast<float>(i % 7) - 3.0f);
+    c->SetTypedComponent(i, 0, static_cast<int>(i % 5));
+    c->SetTypedComponent(i, 1, static_cast<int>(i % 3) - 1);
+    v->SetTypedComponent(i, 0, static_cast<float>(std::cos(0.02 * i)));
+    v->SetTypedComponent(i, 1, static_cast<float>(i % 11) * 0.1f);
+    v->SetTypedComponent(i, 2, -0.5f);
+  }
+  attributes->AddArray(a);
+  attributes->AddArray(b);
+  attributes->AddArray(c);
+  attributes->AddArray(v);
+}
+
+vtkSmartPointer<vtkDataArray> Compute(vtkDataObject* input, int attributeType,
+  vtkArrayCalculator::FunctionParserTypes parserType, const char* function)
+{
+  vtkNew<vtkArrayCalculator> calculator;
+  calculator->SetInputData(input);
+  calculator->SetFunctionParserType(parserType);
+  calculator->SetAttributeType(attributeType);
+  calculator->AddScalarArrayName("a");
+  calculator->AddScalarArrayName("b");
+  calculator->AddScalarVariable("c1", "c", 1);
+  calculator->AddVectorArrayName("v");
+  calculator->AddVectorVariable("w", "v", 2, 1, 0);
+  if (attributeType == vtkDataObject::POINT)
+  {
+    calculator->AddCoordinateScalarVariable("y", 1);
+    calculator->AddCoordinateVectorVariable("p");
+  }
+  calculator->SetReplaceInvalidValues(true);
+  calculator->SetReplacementValue(-7.0);
+  calculator->SetFunction(function);
+  calculator->SetResultArrayName("result");
+  calculator->Update();
+  return vtkDataSet::SafeDownCast(calculator->GetOutput())
+    ->GetAttributes(attributeType)
+    ->GetArray("result");
+}
+
+bool CheckFunctions(vtkDataSet* input, int attributeType)
+{
+  const char* functions[] = { "a + b * 2 - a / 3", "-a + +b", "a ^ 2 + abs(b)",
+    "exp(a) + ceil(b) + floor(a)", "ln(b) + log10(b) + sqrt(b)", "sin(a) * cos(b) + tan(a)",
+    "asin(a) + acos(b / 4) + atan(a)", "sinh(a) + cosh(b) - tanh(a)", "min(a, b) + max(a, b)",
+    "sign(b) + sign(a)", "a / b", "c1 * 2", "v.w + mag(v)", "cross(v, w) + b * v - v / b",
+    "norm(v) * a", "-v + iHat - jHat * 2 + kHat * a", "if(a < b, a, b) + if(a > b | a = b, 1, 0)",
+    "if(b > 0 & a < 0, v, w)", "1", "iHat" };
+  const char* pointFunctions[] = { "y + a", "p + v", "mag(p - y * jHat)" };
+
+  std::vector<const char*> allFunctions(std::begin(functions), std::end(functions));
+  if (attributeType == vtkDataObject::POINT)
+  {
+    allFunctions.insert(allFunctions.end(), std::begin(pointFunctions), std::end(pointFunctions));
+  }
+  for (const char* function : allFunctions)
+  {
+    auto expected = ::Compute(input, attributeType, vtkArrayCalculator::FunctionParser, function);
+    auto actual =
+      ::Compute(input, attributeType, vtkArrayCalculator::VectorizedFunctionParser, function);
+    if (!expected || !actual ||
+      expected->GetNumberOfComponents() != actual->GetNumberOfComponents() ||
+      expected->GetNumberOfTuples() != actual->GetNumberOfTuples())
+    {
+      vtkLog(ERROR, "Wrong result array for " << function);
+      return false;
+    }
+    for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+    {
+      const int nc = expected->GetNumberOfComponents();
+      const double e = expected->GetComponent(i / nc, i % nc);
+      const double r = actual->GetComponent(i / nc, i % nc);
+      if (!vtkMathUtilities::FuzzyCompare(e, r, 1e-12 * std::max(1.0, std::abs(e))))
+      {
+        vtkLog(ERROR, "Wrong value " << r << " instead of " << e << " for " << function);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestArrayCalculatorVectorized(int, char*[])
+{
+  // Point set, whose coordinates come from a points array, with a number of
+  // points which is not a multiple of the block size.
+  constexpr vtkIdType numberOfPoints = 1000;
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->SetPoint(i, 0.001 * i, std::sin(0.1 * i), 0.5);
+  }
+  polyData->SetPoints(points);
+  ::AddArrays(polyData->GetPointData(), numberOfPoints);
+  if (!::CheckFunctions(polyData, vtkDataObject::POINT))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Image, whose coordinates are computed, and cell data.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 30, 3);
+  image->SetSpacing(0.1, 0.2, 0.3);
+  ::AddArrays(image->GetPointData(), image->GetNumberOfPoints());
+  ::AddArrays(image->GetCellData(), image->GetNumberOfCells());
+  if (!::CheckFunctions(image, vtkDataObject::POINT) ||
+    !::CheckFunctions(image, vtkDataObject::CELL))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Tuples per second of each parser.
+  vtkNew<vtkImageData> large;
+  large->SetDimensions(128, 128, 64);
+  ::AddArrays(large->GetPointData(), large->GetNumberOfPoints());
+  const char* function = "sqrt(a * a + b * b) * sin(c1) + mag(v) + v.w";
+  const char* names[] = { "vtkFunctionParser", "vtkExprTkFunctionParser",
+    "VectorizedFunctionParser" };
+  for (int i = 0; i < vtkArrayCalculator::NumberOfFunctionParserTypes; ++i)
+  {
+    const std::string parserFunction = i == vtkArrayCalculator::ExprTkFunctionParser
+      ? "sqrt(a * a + b * b) * sin(c1) + mag(v) + dot(v, w)"
+      : function;
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    ::Compute(large, vtkDataObject::POINT, static_cast<vtkArrayCalculator::FunctionParserTypes>(i),
+      parserFunction.c_str());
+    timer->StopTimer();
+    std::cout << names[i] << ": "
+              << large->GetNumberOfPoints() / std::max(timer->GetElapsedTime(), 1e-9)
+              << " tuples/s" << std::endl;
+  }
+
+  // Failed evaluations are reported once, whatever the number of threads.
+  vtkNew<vtkArrayCalculator> calculator;
+  vtkNew<ErrorCounter> errors;
+  calculator->AddObserver(vtkCommand::ErrorEvent, errors);
+  calculator->SetInputData(large);
+  calculator->SetFunctionParserType(vtkArrayCalculator::VectorizedFunctionParser);
+  calculator->AddScalarArrayName("b");
+  calculator->SetFunction("sqrt(-b)");
+  calculator->SetResultArrayName("result");
+  calculator->Update();
+  if (errors->NumberOfErrors != 1)
+  {
+    vtkLog(ERROR, "Expected one error instead of " << errors->NumberOfErrors);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,346 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkContourGrid and vtkCutter, which contour the cells of
+// unstructured grids concurrently when merging points with vtkMergePoints,
+// give the same output as their serial path on a grid mixing linear,
+// quadratic and polyhedral cells, whatever the number of threads.
+
+#include "vtkCellData.h"
+#include "vtkCellTypes.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphere.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace
+{
+// A grid of n x n x n cubes, each made of a hexahedron, two wedges, six
+// pyramids, a polyhedron or a quadratic hexahedron, with quads and lines on
+// its z = 0 boundary.
+vtkSmartPointer<vtkUnstructuredGrid> CreateMixedGrid(int n)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  auto id = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+  std::map<std::pair<vtkIdType, vtkIdType>, vtkIdType> midPoints;
+  auto midPoint = [&](vtkIdType a, vtkIdType b) {
+    const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+    auto it = midPoints.find(key);
+    if (it == midPoints.end())
+    {
+      double p[3], q[3];
+      points->GetPoint(a, p);
+      points->GetPoint(b, q);
+      const vtkIdType mid =
+        points->InsertNextPoint(0.5 * (p[0] + q[0]), 0.5 * (p[1] + q[1]), 0.5 * (p[2] + q[2]));
+      it = midPoints.emplace(key, mid).first;
+    }
+    return it->second;
+  };
+
+  const int faces[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 1, 2, 6, 5 },
+    { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+  const int edges[12][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 }, { 4, 5 }, { 5, 6 }, { 6, 7 },
+    { 7, 4 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+  grid->AllocateEstimate(6 * n * n * n, 8);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType c[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        switch ((i + 2 * j + 3 * k) % 5)
+        {
+          case 0:
+            grid->InsertNextCell(VTK_HEXAHEDRON, 8, c);
+            break;
+          case 1:
+          {
+            const vtkIdType wedge0[6] = { c[0], c[1], c[2], c[4], c[5], c[6] };
+            const vtkIdType wedge1[6] = { c[0], c[2], c[3], c[4], c[6], c[7] };
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge0);
+            grid->InsertNextCell(VTK_WEDGE, 6, wedge1);
+            break;
+          }
+          case 2:
+          {
+            const vtkIdType center = points->InsertNextPoint(i + 0.5, j + 0.5, k + 0.5);
+            for (const auto& face : faces)
+            {
+              const vtkIdType pyramid[5] = { c[face[0]], c[face[1]], c[face[2]], c[face[3]],
+                center };
+              grid->InsertNextCell(VTK_PYRAMID, 5, pyramid);
+            }
+            break;
+          }
+          case 3:
+          {
+            vtkIdType faceStream[30];
+            vtkIdType* f = faceStream;
+            for (const auto& face : faces)
+            {
+              *f++ = 4;
+              for (int v : face)
+              {
+                *f++ = c[v];
+              }
+            }
+            grid->InsertNextCell(VTK_POLYHEDRON, 6, faceStream);
+            break;
+          }
+          default:
+          {
+            vtkIdType quadraticHex[20];
+            std::copy(c, c + 8, quadraticHex);
+            for (int e = 0; e < 12; ++e)
+            {
+              quadraticHex[8 + e] = midPoint(c[edges[e][0]], c[edges[e][1]]);
+            }
+            grid->InsertNextCell(VTK_QUADRATIC_HEXAHEDRON, 20, quadraticHex);
+            break;
+          }
+        }
+      }
+    }
+  }
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const vtkIdType quad[4] = { id(i, j, 0), id(i + 1, j, 0), id(i + 1, j + 1, 0),
+        id(i, j + 1, 0) };
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      grid->InsertNextCell(VTK_LINE, 2, quad);
+    }
+  }
+  grid->SetPoints(points);
+
+  vtkNew<vtkDoubleArray> distances;
+  distances->SetName("distance");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3];
+    points->GetPoint(ptId, p);
+    distances->InsertNextValue(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]));
+    vectors->InsertNextTuple3(p[1], -p[0], p[2]);
+    ids->InsertNextValue(static_cast<int>(ptId));
+  }
+  grid->GetPointData()->SetScalars(distances);
+  grid->GetPointData()->AddArray(vectors);
+  grid->GetPointData()->AddArray(ids);
+  vtkNew<vtkDoubleArray> cellIds;
+  cellIds->SetName("cellIds");
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* arrayA = a->GetArray(i);
+    vtkDataArray* arrayB = arrayA->GetName() ? b->GetArray(arrayA->GetName()) : b->GetScalars();
+    if (!arrayB || arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples() ||
+      arrayA->GetNumberOfComponents() != arrayB->GetNumberOfComponents())
+    {
+      return false;
+    }
+    for (vtkIdType v = 0; v < arrayA->GetNumberOfValues(); ++v)
+    {
+      const int nc = arrayA->GetNumberOfComponents();
+      if (arrayA->GetComponent(v / nc, v % nc) != arrayB->GetComponent(v / nc, v % nc))
+      {
+        return false;
+      }
+    }
+  }
+  return (a->GetScalars() != nullptr) == (b->GetScalars() != nullptr);
+}
+
+// Check that two outputs are identical, including the ordering of their points
+// and cells. The cells generated by polyhedra, or built from the triangles of
+// 3D cells when not generating triangles, depend on the ids given by the
+// locator to their points, which differ between the threaded and serial paths.
+// Unless exact is true, they are only compared by the points they use for each
+// input cell.
+bool SameOutputs(vtkPolyData* a, vtkPolyData* b, vtkUnstructuredGrid* input, const char* what,
+  bool exact, bool generateTriangles)
+{
+  bool same = a->GetNumberOfPoints() == b->GetNumberOfPoints() &&
+    a->GetNumberOfVerts() == b->GetNumberOfVerts() &&
+    a->GetNumberOfLines() == b->GetNumberOfLines() &&
+    a->GetNumberOfPolys() == b->GetNumberOfPolys() && a->GetNumberOfCells() > 0 &&
+    ::SameAttributes(a->GetPointData(), b->GetPointData()) &&
+    ::SameAttributes(a->GetCellData(), b->GetCellData());
+  for (vtkIdType ptId = 0; same && ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3], q[3];
+    a->GetPoint(ptId, p);
+    b->GetPoint(ptId, q);
+    same = p[0] == q[0] && p[1] == q[1] && p[2] == q[2];
+  }
+  vtkDataArray* sourceIds = a->GetCellData()->GetArray("cellIds");
+  std::map<vtkIdType, std::set<vtkIdType>> pointsA, pointsB;
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType cellId = 0; same && cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, idsA);
+    b->GetCellPoints(cellId, idsB);
+    same = a->GetCellType(cellId) == b->GetCellType(cellId) &&
+      idsA->GetNumberOfIds() == idsB->GetNumberOfIds();
+    const vtkIdType sourceId = static_cast<vtkIdType>(sourceIds->GetTuple1(cellId));
+    const int sourceType = input->GetCellType(sourceId);
+    if (!exact &&
+      (sourceType == VTK_POLYHEDRON ||
+        (vtkCellTypes::GetDimension(sourceType) == 3 && !generateTriangles)))
+    {
+      pointsA[sourceId].insert(idsA->begin(), idsA->end());
+      pointsB[sourceId].insert(idsB->begin(), idsB->end());
+    }
+    else
+    {
+      same = same && std::equal(idsA->begin(), idsA->end(), idsB->begin());
+    }
+  }
+  same = same && pointsA == pointsB;
+  if (!same)
+  {
+    vtkLog(ERROR, "Threaded and serial outputs differ for " << what);
+  }
+  return same;
+}
+
+// Run the filter with numberOfThreads threads.
+template <typename FilterT>
+void Update(FilterT* filter, int numberOfThreads)
+{
+  vtkSMPTools::LocalScope(vtkSMPTools::Config(numberOfThreads), [&]() {
+    filter->Modified();
+    filter->Update();
+  });
+}
+
+// Run the filter with its default locator, which takes the threaded path,
+// with four and two threads, then with one thread and with a vtkPointLocator
+// merging coincident points, which both take the serial path.
+template <typename FilterT>
+bool TestFilter(FilterT* filter, vtkUnstructuredGrid* input, const char* what)
+{
+  const bool generateTriangles = filter->GetGenerateTriangles() != 0;
+  ::Update(filter, 4);
+  vtkNew<vtkPolyData> threaded;
+  threaded->DeepCopy(filter->GetOutput());
+
+  ::Update(filter, 2);
+  if (!::SameOutputs(threaded, filter->GetOutput(), input, what, true, generateTriangles))
+  {
+    vtkLog(ERROR, "Output depends on the number of threads");
+    return false;
+  }
+
+  ::Update(filter, 1);
+  if (!::SameOutputs(threaded, filter->GetOutput(), input, what, false, generateTriangles))
+  {
+    return false;
+  }
+
+  vtkIncrementalPointLocator* locator = filter->GetLocator();
+  locator->Register(nullptr);
+  vtkNew<vtkPointLocator> serialLocator;
+  serialLocator->SetTolerance(0.0);
+  filter->SetLocator(serialLocator);
+  filter->Update();
+  const bool same =
+    ::SameOutputs(threaded, filter->GetOutput(), input, what, false, generateTriangles);
+  filter->SetLocator(locator);
+  locator->UnRegister(nullptr);
+  return same;
+}
+}
+
+int TestContourGridThreaded(int, char*[])
+{
+  auto grid = ::CreateMixedGrid(7);
+
+  vtkNew<vtkContourGrid> contour;
+  contour->SetInputData(grid);
+  contour->SetValue(0, 4.2);
+  contour->SetValue(1, 8.7);
+  for (int generateTriangles = 0; generateTriangles < 2; ++generateTriangles)
+  {
+    for (int computeScalars = 0; computeScalars < 2; ++computeScalars)
+    {
+      contour->SetGenerateTriangles(generateTriangles);
+      contour->SetComputeScalars(computeScalars);
+      if (!::TestFilter(contour.Get(), grid, "vtkContourGrid"))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(3.5, 3.5, 0);
+  sphere->SetRadius(2.2);
+  vtkNew<vtkCutter> cutter;
+  cutter->SetInputData(grid);
+  cutter->SetCutFunction(sphere);
+  cutter->SetValue(0, 0.0);
+  cutter->SetValue(1, 4.0);
+  cutter->GenerateCutScalarsOn();
+  for (int generateTriangles = 0; generateTriangles < 2; ++generateTriangles)
+  {
+    cutter->SetGenerateTriangles(generateTriangles);
+    if (!::TestFilter(cutter.Get(), grid, "vtkCutter"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that attribute filters overwrite the arrays of their input instead of
+// allocating new ones when the pipeline allows it, and only then.
+
+#include "vtkArrayCalculator.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSphereSource.h"
+#include "vtkVectorNorm.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Filter adding a constant implicit array "r" to its input.
+class AddConstantArray : public vtkPolyDataAlgorithm
+{
+public:
+  static AddConstantArray* New();
+  vtkTypeMacro(AddConstantArray, vtkPolyDataAlgorithm);
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(vtkPolyData::GetData(inputVector[0]));
+    vtkNew<vtkConstantArray<double>> constant;
+    constant->ConstructBackend(5.0);
+    constant->SetName("r");
+    constant->SetNumberOfComponents(1);
+    constant->SetNumberOfTuples(output->GetNumberOfPoints());
+    output->GetPointData()->AddArray(constant);
+    return 1;
+  }
+};
+vtkStandardNewMacro(AddConstantArray);
+
+// Filter adding an array "r" to its input that shares the memory of Source,
+// either by shallow copy or by wrapping its pointer.
+class AddSharedArray : public vtkPolyDataAlgorithm
+{
+public:
+  static AddSharedArray* New();
+  vtkTypeMacro(AddSharedArray, vtkPolyDataAlgorithm);
+
+  vtkFloatArray* Source = nullptr;
+  bool Wrap = false;
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(vtkPolyData::GetData(inputVector[0]));
+    vtkNew<vtkFloatArray> shared;
+    if (this->Wrap)
+    {
+      shared->SetArray(this->Source->GetPointer(0), this->Source->GetNumberOfValues(), 1);
+    }
+    else
+    {
+      shared->ShallowCopy(this->Source);
+    }
+    shared->SetName("r");
+    output->GetPointData()->AddArray(shared);
+    return 1;
+  }
+};
+vtkStandardNewMacro(AddSharedArray);
+
+vtkDataArray* GetArray(vtkAlgorithm* algorithm, const char* name)
+{
+  algorithm->Update();
+  return vtkDataSet::SafeDownCast(algorithm->GetOutputDataObject(0))
+    ->GetPointData()
+    ->GetArray(name);
+}
+
+bool CheckValues(vtkDataArray* array, vtkDataArray* reference, double scale, double shift)
+{
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+  {
+    if (!vtkMathUtilities::FuzzyCompare(
+          array->GetTuple1(i), scale * reference->GetTuple1(i) + shift, 1e-6))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestInPlaceAttributeFilters(int, char*[])
+{
+  vtkNew<vtkSphereSource> source;
+  source->SetThetaResolution(16);
+  source->SetPhiResolution(16);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+
+  vtkNew<vtkArrayCalculator> calculator1;
+  calculator1->SetInputConnection(elevation->GetOutputPort());
+  calculator1->AddScalarArrayName("Elevation");
+  calculator1->SetFunction("2 * Elevation");
+  calculator1->SetResultArrayName("r");
+
+  vtkNew<vtkArrayCalculator> calculator2;
+  calculator2->SetInputConnection(calculator1->GetOutputPort());
+  calculator2->AddScalarArrayName("r");
+  calculator2->SetFunction("r + 1");
+  calculator2->SetResultArrayName("r");
+
+  // The output of calculator1 is kept: calculator2 allocates its result.
+  vtkDataArray* elevationArray = ::GetArray(elevation, "Elevation");
+  vtkDataArray* array1 = ::GetArray(calculator1, "r");
+  vtkDataArray* array2 = ::GetArray(calculator2, "r");
+  if (array1 == array2 || !::CheckValues(array1, elevationArray, 2.0, 0.0) ||
+    !::CheckValues(array2, elevationArray, 2.0, 1.0))
+  {
+    vtkLog(ERROR, "Input array modified while its data is kept.");
+    return EXIT_FAILURE;
+  }
+
+  // The output of calculator1 is released: calculator2 overwrites it.
+  calculator1->ReleaseDataFlagOn();
+  calculator2->Modified();
+  array1 = ::GetArray(calculator1, "r");
+  array2 = ::GetArray(calculator2, "r");
+  if (array1 != array2 || !::CheckValues(array2, elevationArray, 2.0, 1.0))
+  {
+    vtkLog(ERROR, "Array calculator did not execute in place.");
+    return EXIT_FAILURE;
+  }
+
+  // An implicit array cannot be written to, it is never overwritten.
+  vtkNew<AddConstantArray> constant;
+  constant->SetInputConnection(source->GetOutputPort());
+  constant->ReleaseDataFlagOn();
+  vtkNew<vtkArrayCalculator> calculator3;
+  calculator3->SetInputConnection(constant->GetOutputPort());
+  calculator3->AddScalarArrayName("r");
+  calculator3->SetFunction("r + 1");
+  calculator3->SetResultArrayName("r");
+  vtkDataArray* constantArray = ::GetArray(constant, "r");
+  vtkDataArray* array3 = ::GetArray(calculator3, "r");
+  if (array3 == constantArray || !array3->HasStandardMemoryLayout() ||
+    array3->GetTuple1(0) != 6.0)
+  {
+    vtkLog(ERROR, "Implicit array overwritten in place.");
+    return EXIT_FAILURE;
+  }
+
+  // Arrays sharing memory they do not own are never overwritten.
+  vtkNew<vtkFloatArray> sharedSource;
+  sharedSource->SetNumberOfTuples(source->GetOutput()->GetNumberOfPoints());
+  sharedSource->FillValue(2.0f);
+  for (bool wrap : { false, true })
+  {
+    vtkNew<AddSharedArray> shared;
+    shared->SetInputConnection(source->GetOutputPort());
+    shared->Source = sharedSource;
+    shared->Wrap = wrap;
+    shared->ReleaseDataFlagOn();
+    vtkNew<vtkArrayCalculator> calculator4;
+    calculator4->SetInputConnection(shared->GetOutputPort());
+    calculator4->AddScalarArrayName("r");
+    calculator4->SetFunction("r + 1");
+    calculator4->SetResultArrayName("r");
+    calculator4->SetResultArrayType(VTK_FLOAT);
+    vtkDataArray* sharedArray = ::GetArray(shared, "r");
+    vtkDataArray* array4 = ::GetArray(calculator4, "r");
+    if (array4 == sharedArray || array4->GetTuple1(0) != 3.0 || sharedSource->GetValue(0) != 2.0f)
+    {
+      vtkLog(ERROR, "Array sharing its memory overwritten in place (wrap: " << wrap << ").");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A second elevation overwrites the first one.
+  vtkNew<vtkElevationFilter> elevation1;
+  elevation1->SetInputConnection(source->GetOutputPort());
+  elevation1->ReleaseDataFlagOn();
+  vtkNew<vtkElevationFilter> elevation2;
+  elevation2->SetInputConnection(elevation1->GetOutputPort());
+  elevation2->SetScalarRange(1.0, 3.0);
+  elevationArray = ::GetArray(elevation1, "Elevation");
+  vtkNew<vtkFloatArray> reference;
+  reference->DeepCopy(elevationArray);
+  if (::GetArray(elevation2, "Elevation") != elevationArray ||
+    !::CheckValues(elevationArray, reference, 2.0, 1.0))
+  {
+    vtkLog(ERROR, "Elevation filter did not execute in place.");
+    return EXIT_FAILURE;
+  }
+
+  // The norm of the vectors overwrites the active scalars, once no other data
+  // object shares them.
+  vtkNew<vtkArrayCalculator> scalars;
+  scalars->SetInputConnection(source->GetOutputPort());
+  scalars->SetFunction("1");
+  scalars->SetResultArrayName("s");
+  scalars->SetResultArrayType(VTK_FLOAT);
+  scalars->ReleaseDataFlagOn();
+
+  vtkNew<vtkArrayCalculator> vectors;
+  vectors->SetInputConnection(scalars->GetOutputPort());
+  vectors->AddVectorArrayName("Normals");
+  vectors->SetFunction("3 * Normals");
+  vectors->SetResultArrayName("v");
+  vectors->ReleaseDataFlagOn();
+
+  vtkNew<vtkVectorNorm> norm;
+  norm->SetInputConnection(vectors->GetOutputPort());
+
+  vtkDataArray* scalarsArray = ::GetArray(scalars, "s");
+  ::GetArray(vectors, "v");
+  norm->Update();
+  vtkDataArray* normArray = norm->GetOutput()->GetPointData()->GetScalars();
+  if (normArray != scalarsArray || normArray->GetName() ||
+    !::CheckValues(normArray, scalarsArray, 0.0, 3.0))
+  {
+    vtkLog(ERROR, "Vector norm did not execute in place.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
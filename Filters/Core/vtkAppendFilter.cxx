@@ -2,27 +2,58 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkAppendFilter.h"
 
+#include "vtkAppendInternal.h"
 #include "vtkBoundingBox.h"
-#include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataSetCollection.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
-#include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
-#include <string>
-#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendFilter);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Allocate the arrays of the output attributes of the given type common to all
+// the inputs, with their final number of tuples, and match them with the
+// arrays of the inputs.
+void AllocateAttributes(int attributesType, const std::vector<vtkDataSet*>& dataSets,
+  vtkDataSetAttributes* output, vtkIdType numberOfTuples, AppendAttributes& attributes)
+{
+  vtkDataSetAttributes::FieldList fieldList;
+  for (vtkDataSet* dataSet : dataSets)
+  {
+    fieldList.IntersectFieldList(dataSet->GetAttributes(attributesType));
+  }
+  output->CopyAllocate(fieldList, numberOfTuples);
+  AppendAttributes::SetNumberOfTuples(output, numberOfTuples);
+  for (std::size_t i = 0; i < dataSets.size(); ++i)
+  {
+    attributes.AddInput(
+      fieldList, static_cast<int>(i), dataSets[i]->GetAttributes(attributesType), output);
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 vtkAppendFilter::vtkAppendFilter()
 {
@@ -145,9 +176,6 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // Now we can allocate memory
-  output->Allocate(totalNumCells);
-
   vtkSmartPointer<vtkPoints> newPts = vtkSmartPointer<vtkPoints>::New();
 
   // set precision for the points in the output
@@ -214,156 +242,272 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  // If we aren't merging points, we need to allocate the points here.
-  if (!reallyMergePoints)
-  {
-    newPts->SetNumberOfPoints(totalNumPts);
-  }
-
-  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
-  ptIds->Allocate(VTK_CELL_SIZE);
-  vtkSmartPointer<vtkIdList> newPtIds = vtkSmartPointer<vtkIdList>::New();
-  newPtIds->Allocate(VTK_CELL_SIZE);
-
-  vtkIdType twentieth = (totalNumPts + totalNumCells) / 20 + 1;
-
-  // For optionally merging duplicate points
-  vtkIdType* globalIndices = new vtkIdType[totalNumPts];
-
-  vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter;
-  if (reallyMergePoints)
+  // Compute where the points and cells of each input go in the output, and
+  // gather the connectivity of the inputs, so that they can all be copied
+  // concurrently. The point ids of the cells are first offset as if the points
+  // were not merged.
+  std::vector<vtkDataSet*> dataSets;
+  std::vector<vtkDataArray*> inPoints;
+  std::vector<vtkIdType> ptOffsets;
+  AppendSegments pointSegments;
+  AppendSegments cellSegments;
+  std::vector<vtkCellArray*> inCells;
+  std::vector<vtkIdType> cellPtOffsets;
+  std::vector<vtkSmartPointer<vtkCellArray>> extractedCells;
+  std::vector<vtkIdType> facesOffsets;
+  vtkIdType totalNumFaceIds = 0;
+  bool useGlobalIds = globalIdsArray != nullptr;
+  inputs->InitTraversal(iter);
+  while ((dataSet = inputs->GetNextDataSet(iter)))
   {
-    vtkBoundingBox outputBB;
-    inputs->InitTraversal(iter);
-    while ((dataSet = inputs->GetNextDataSet(iter)))
+    const int input = static_cast<int>(dataSets.size());
+    const vtkIdType dataSetNumPts = dataSet->GetNumberOfPoints();
+    const vtkIdType dataSetNumCells = dataSet->GetNumberOfCells();
+    dataSets.push_back(dataSet);
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(dataSet);
+    inPoints.push_back(ps && ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr);
+    ptOffsets.push_back(pointSegments.GetSize());
+    pointSegments.Add(input, 0, dataSetNumPts);
+    cellSegments.Add(input, 0, dataSetNumCells);
+    facesOffsets.push_back(totalNumFaceIds);
+    useGlobalIds = useGlobalIds &&
+      vtkIdTypeArray::SafeDownCast(dataSet->GetPointData()->GetGlobalIds()) != nullptr;
+    if (dataSetNumCells == 0)
     {
-      // Union of bounding boxes
-      double localBox[6];
-      dataSet->GetBounds(localBox);
-      outputBB.AddBounds(localBox);
+      continue;
     }
 
-    double outputBounds[6];
-    outputBB.GetBounds(outputBounds);
-
-    ptInserter = vtkSmartPointer<vtkIncrementalOctreePointLocator>::New();
-    if (this->ToleranceIsAbsolute)
+    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    if (ug)
     {
-      ptInserter->SetTolerance(this->Tolerance);
+      inCells.push_back(ug->GetCells());
+      cellPtOffsets.push_back(ptOffsets.back());
+      if (ug->GetFaces())
+      {
+        totalNumFaceIds += ug->GetFaces()->GetNumberOfValues();
+      }
     }
     else
     {
-      ptInserter->SetTolerance(this->Tolerance * outputBB.GetDiagonalLength());
+      // the connectivity of other datasets, including polydata whose cell ids
+      // may interleave verts, lines, polys and strips, is extracted first
+      vtkNew<vtkIdList> ptIds;
+      vtkNew<vtkCellArray> cells;
+      cells->AllocateEstimate(dataSetNumCells, dataSet->GetMaxCellSize());
+      for (vtkIdType cellId = 0; cellId < dataSetNumCells; ++cellId)
+      {
+        dataSet->GetCellPoints(cellId, ptIds);
+        cells->InsertNextCell(ptIds);
+      }
+      extractedCells.emplace_back(cells);
+      inCells.push_back(cells);
+      cellPtOffsets.push_back(ptOffsets.back());
+    }
+    // cell types are then requested concurrently, polydata must have built
+    // their cells beforehand since GetCellType() builds them on demand
+    vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataSet);
+    if (polyData && polyData->NeedToBuildCells())
+    {
+      polyData->BuildCells();
     }
-
-    ptInserter->InitPointInsertion(newPts, outputBounds);
+  }
+  if (this->CheckAbort())
+  {
+    return 1;
   }
 
-  // append the blocks / pieces in terms of the geometry and topology
-  std::unordered_map<vtkIdType, vtkIdType> addedPointsMap;
-  vtkIdType count = 0;
-  vtkIdType ptOffset = 0;
-  float decimal = 0.0;
-  inputs->InitTraversal(iter);
-  bool abort = false;
-  double p[3];
-  while (!abort && (dataSet = inputs->GetNextDataSet(iter)))
+  // Copy the points of the inputs, then merge them if needed.
+  vtkSmartPointer<vtkPoints> allPts = newPts;
+  if (reallyMergePoints)
   {
-    vtkIdType dataSetNumPts = dataSet->GetNumberOfPoints();
-    vtkIdType dataSetNumCells = dataSet->GetNumberOfCells();
-    vtkIdTypeArray* dataSetGlobalIdsArray = globalIdsArray
-      ? vtkIdTypeArray::SafeDownCast(dataSet->GetPointData()->GetGlobalIds())
-      : nullptr;
-
-    // copy points
-    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort; ++ptId)
-    {
-      if (reallyMergePoints)
-      {
-        if (dataSetGlobalIdsArray)
+    allPts = vtkSmartPointer<vtkPoints>::New();
+    allPts->SetDataType(newPts->GetDataType());
+  }
+  allPts->SetNumberOfPoints(totalNumPts);
+  vtkDataArray* allPtsData = allPts->GetData();
+  vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+    pointSegments.ForEach(begin, end,
+      [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfPoints) {
+        if (inPoints[input])
         {
-          vtkIdType globalId = dataSetGlobalIdsArray->GetValue(ptId);
-          auto it = addedPointsMap.find(globalId);
-          if (it == addedPointsMap.end())
-          {
-            globalIndices[ptId + ptOffset] = newPts->GetNumberOfPoints();
-            dataSet->GetPoint(ptId, p);
-            vtkIdType newPtId = newPts->InsertNextPoint(p);
-            addedPointsMap.emplace(globalId, newPtId);
-          }
-          else
-          {
-            globalIndices[ptId + ptOffset] = it->second;
-          }
+          CopyTuplesWorker::Execute(
+            inPoints[input], inputStart, allPtsData, outputStart, numberOfPoints);
+          return;
         }
-        else
+        double p[3];
+        for (vtkIdType ptId = 0; ptId < numberOfPoints; ++ptId)
         {
-          vtkIdType globalPtId = 0;
-          dataSet->GetPoint(ptId, p);
-          ptInserter->InsertUniquePoint(p, globalPtId);
-          globalIndices[ptId + ptOffset] = globalPtId;
-          // The point inserter puts the point into newPts, so we don't have to do that here.
+          dataSets[input]->GetPoint(inputStart + ptId, p);
+          allPtsData->SetTuple(outputStart + ptId, p);
         }
-      }
-      else
+      });
+  });
+  this->UpdateProgress(0.2);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // For merged points, pointMap maps the points of the inputs, numbered as
+  // if they were not merged, to the output points, and the output points are
+  // copied from the first point merged to them. Point data are copied from
+  // the last one, as earlier inputs are overwritten by later ones.
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> firstPoints;
+  std::vector<vtkIdType> lastPoints;
+  if (reallyMergePoints)
+  {
+    pointMap.resize(totalNumPts);
+    if (useGlobalIds)
+    {
+      // Points sharing the same global id are merged to the one with the
+      // lowest id, which comes first once sorted.
+      std::vector<std::pair<vtkIdType, vtkIdType>> globalIds(totalNumPts);
+      vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+        pointSegments.ForEach(begin, end,
+          [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfPoints) {
+            vtkIdTypeArray* ids =
+              vtkIdTypeArray::SafeDownCast(dataSets[input]->GetPointData()->GetGlobalIds());
+            for (vtkIdType ptId = 0; ptId < numberOfPoints; ++ptId)
+            {
+              globalIds[outputStart + ptId] =
+                std::make_pair(ids->GetValue(inputStart + ptId), outputStart + ptId);
+            }
+          });
+      });
+      vtkSMPTools::Sort(globalIds.begin(), globalIds.end());
+      vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          auto first = std::lower_bound(globalIds.begin(), globalIds.begin() + i,
+            globalIds[i].first,
+            [](const std::pair<vtkIdType, vtkIdType>& id, vtkIdType globalId) {
+              return id.first < globalId;
+            });
+          pointMap[globalIds[i].second] = first->second;
+        }
+      });
+    }
+    else
+    {
+      vtkNew<vtkPolyData> cloud;
+      cloud->SetPoints(allPts);
+      vtkNew<vtkStaticPointLocator> locator;
+      locator->SetDataSet(cloud);
+      locator->SetTraversalOrderToBinOrder();
+      locator->BuildLocator();
+      double tolerance = this->Tolerance;
+      if (!this->ToleranceIsAbsolute)
       {
-        globalIndices[ptId + ptOffset] = ptId + ptOffset;
-        dataSet->GetPoint(ptId, p);
-        newPts->SetPoint(ptId + ptOffset, p);
+        double bounds[6];
+        allPts->GetBounds(bounds);
+        tolerance *= vtkBoundingBox(bounds).GetDiagonalLength();
       }
+      locator->MergePoints(tolerance, pointMap.data());
+    }
 
-      // Update progress
-      count++;
-      if (!(count % twentieth))
+    // Number the output points in the order of the first point merged to
+    // them.
+    std::vector<vtkIdType> outputIds(totalNumPts, -1);
+    for (vtkIdType ptId = 0; ptId < totalNumPts; ++ptId)
+    {
+      vtkIdType& outputId = outputIds[pointMap[ptId]];
+      if (outputId < 0)
       {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->CheckAbort();
+        outputId = static_cast<vtkIdType>(firstPoints.size());
+        firstPoints.push_back(ptId);
+        lastPoints.push_back(ptId);
       }
+      pointMap[ptId] = outputId;
+      lastPoints[outputId] = ptId;
     }
 
-    // copy cell
-    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
-    for (vtkIdType cellId = 0; cellId < dataSetNumCells && !abort; ++cellId)
-    {
-      newPtIds->Reset();
-      if (ug && dataSet->GetCellType(cellId) == VTK_POLYHEDRON)
+    const vtkIdType numNewPts = static_cast<vtkIdType>(firstPoints.size());
+    newPts->SetNumberOfPoints(numNewPts);
+    vtkDataArray* newPtsData = newPts->GetData();
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-        vtkIdType nfaces;
-        const vtkIdType* facePtIds;
-        ug->GetFaceStream(cellId, nfaces, facePtIds);
-        for (vtkIdType id = 0; id < nfaces; ++id)
+        newPtsData->SetTuple(ptId, firstPoints[ptId], allPtsData);
+      }
+    });
+  }
+  this->UpdateProgress(0.4);
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+
+  // Copy the cells, with their point ids offset and merged.
+  const vtkIdType* ptMap = reallyMergePoints ? pointMap.data() : nullptr;
+  vtkNew<vtkCellArray> newCells;
+  if (!::AppendCellArrays(inCells, cellPtOffsets, newCells, ptMap))
+  {
+    vtkErrorMacro(<< "Memory allocation failed in append filter");
+    return 0;
+  }
+  vtkNew<vtkUnsignedCharArray> newTypes;
+  newTypes->SetNumberOfValues(totalNumCells);
+  vtkNew<vtkIdTypeArray> newFaceLocations;
+  vtkNew<vtkIdTypeArray> newFaces;
+  if (totalNumFaceIds > 0)
+  {
+    newFaceLocations->SetNumberOfValues(totalNumCells);
+    newFaces->SetNumberOfValues(totalNumFaceIds);
+  }
+  vtkSMPTools::For(0, totalNumCells, [&](vtkIdType begin, vtkIdType end) {
+    cellSegments.ForEach(begin, end,
+      [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfCells) {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSets[input]);
+        if (ug)
+        {
+          const unsigned char* types = ug->GetCellTypesArray()->GetPointer(inputStart);
+          std::copy(types, types + numberOfCells, newTypes->GetPointer(outputStart));
+        }
+        else
         {
-          vtkIdType nPoints = facePtIds[0];
-          newPtIds->InsertNextId(nPoints);
-          for (vtkIdType j = 1; j <= nPoints; ++j)
+          for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
           {
-            newPtIds->InsertNextId(globalIndices[facePtIds[j] + ptOffset]);
+            newTypes->SetValue(
+              outputStart + cellId, dataSets[input]->GetCellType(inputStart + cellId));
           }
-          facePtIds += nPoints + 1;
         }
-        output->InsertNextCell(VTK_POLYHEDRON, nfaces, newPtIds->GetPointer(0));
-      }
-      else
-      {
-        dataSet->GetCellPoints(cellId, ptIds);
-        for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+        if (totalNumFaceIds == 0)
         {
-          newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          return;
         }
-        output->InsertNextCell(dataSet->GetCellType(cellId), newPtIds);
-      }
-
-      // Update progress
-      count++;
-      if (!(count % twentieth))
-      {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->CheckAbort();
-      }
-    }
-    ptOffset += dataSetNumPts;
+        vtkIdTypeArray* faceLocations = ug ? ug->GetFaceLocations() : nullptr;
+        for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+        {
+          const vtkIdType location =
+            faceLocations ? faceLocations->GetValue(inputStart + cellId) : -1;
+          if (location < 0)
+          {
+            newFaceLocations->SetValue(outputStart + cellId, -1);
+            continue;
+          }
+          // copy the face stream of the polyhedron, offsetting its point ids
+          const vtkIdType newLocation = location + facesOffsets[input];
+          newFaceLocations->SetValue(outputStart + cellId, newLocation);
+          const vtkIdType* faceStream = ug->GetFaces()->GetPointer(location);
+          vtkIdType* newFaceStream = newFaces->GetPointer(newLocation);
+          const vtkIdType nfaces = *newFaceStream++ = *faceStream++;
+          for (vtkIdType face = 0; face < nfaces; ++face)
+          {
+            const vtkIdType npts = *newFaceStream++ = *faceStream++;
+            for (vtkIdType i = 0; i < npts; ++i)
+            {
+              const vtkIdType id = ptOffsets[input] + *faceStream++;
+              *newFaceStream++ = ptMap ? ptMap[id] : id;
+            }
+          }
+        }
+      });
+  });
+  this->UpdateProgress(0.6);
+  if (this->CheckAbort())
+  {
+    return 1;
   }
 
   // this filter can copy global ids except for global point ids when merging
@@ -378,18 +522,61 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
-  this->UpdateProgress(0.75);
-  this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
+  AppendAttributes pointData;
+  const vtkIdType numNewPts = newPts->GetNumberOfPoints();
+  ::AllocateAttributes(
+    vtkDataObject::POINT, dataSets, output->GetPointData(), numNewPts, pointData);
+  if (reallyMergePoints)
+  {
+    auto copyMergedPoint = [&](vtkIdType ptId, bool dataArrays) {
+      const vtkIdType id = lastPoints[ptId];
+      const std::size_t segment = pointSegments.Find(id);
+      const int input = pointSegments.Inputs[segment];
+      const vtkIdType inputId = id - pointSegments.OutputStarts[segment];
+      if (dataArrays)
+      {
+        pointData.CopyDataArraysTuple(input, inputId, ptId);
+      }
+      else
+      {
+        pointData.CopyOtherArraysTuple(input, inputId, ptId);
+      }
+    };
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        copyMergedPoint(ptId, true);
+      }
+    });
+    for (vtkIdType ptId = 0; pointData.HasOtherArrays() && ptId < numNewPts; ++ptId)
+    {
+      copyMergedPoint(ptId, false);
+    }
+  }
+  else
+  {
+    pointData.Copy(pointSegments);
+  }
+  this->UpdateProgress(0.8);
+
+  AppendAttributes cellData;
+  ::AllocateAttributes(
+    vtkDataObject::CELL, dataSets, output->GetCellData(), totalNumCells, cellData);
+  cellData.Copy(cellSegments);
   this->UpdateProgress(1.0);
 
   // Update ourselves and release memory
   output->SetPoints(newPts);
+  if (totalNumFaceIds > 0)
+  {
+    output->SetCells(newTypes, newCells, newFaceLocations, newFaces);
+  }
+  else
+  {
+    output->SetCells(newTypes, newCells);
+  }
   output->Squeeze();
 
-  delete[] globalIndices;
-
   return 1;
 }
 
@@ -419,59 +606,6 @@ vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector**
   return collection;
 }
 
-//------------------------------------------------------------------------------
-void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** inputVector,
-  vtkIdType* globalIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements)
-{
-  // Check if attributesType is supported
-  if (attributesType != vtkDataObject::POINT && attributesType != vtkDataObject::CELL)
-  {
-    vtkErrorMacro(<< "Unhandled attributes type " << attributesType << ", must be either "
-                  << "vtkDataObject::POINT or vtkDataObject::CELL");
-    return;
-  }
-
-  vtkDataSetAttributes::FieldList fieldList;
-  auto inputs = vtkSmartPointer<vtkDataSetCollection>::Take(this->GetNonEmptyInputs(inputVector));
-  vtkCollectionSimpleIterator iter;
-  vtkDataSet* dataSet = nullptr;
-  for (dataSet = nullptr, inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
-  {
-    if (auto inputData = dataSet->GetAttributes(attributesType))
-    {
-      fieldList.IntersectFieldList(inputData);
-    }
-  }
-
-  vtkDataSetAttributes* outputData = output->GetAttributes(attributesType);
-  outputData->CopyAllocate(fieldList, totalNumberOfElements);
-
-  // copy arrays.
-  int inputIndex;
-  vtkIdType offset = 0;
-  for (inputIndex = 0, dataSet = nullptr, inputs->InitTraversal(iter);
-       (dataSet = inputs->GetNextDataSet(iter));)
-  {
-    if (auto inputData = dataSet->GetAttributes(attributesType))
-    {
-      const auto numberOfInputTuples = inputData->GetNumberOfTuples();
-      if (globalIds != nullptr)
-      {
-        for (vtkIdType id = 0; id < numberOfInputTuples; ++id)
-        {
-          fieldList.CopyData(inputIndex, inputData, id, outputData, globalIds[offset + id]);
-        }
-      }
-      else
-      {
-        fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
-      }
-      offset += numberOfInputTuples;
-      ++inputIndex;
-    }
-  }
-}
-
 //------------------------------------------------------------------------------
 int vtkAppendFilter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
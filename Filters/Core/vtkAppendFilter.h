@@ -17,6 +17,12 @@
  * "GlobalPointIds"), then two points are merged if they share the same point global id,
  * without checking for coincident point.
  *
+ * The points, cells and attributes of the inputs are copied concurrently
+ * using vtkSMPTools, after the location of each input in the output is
+ * computed. When points are merged, this is done afterwards, in parallel,
+ * with a vtkStaticPointLocator or by sorting the point global ids. Merged points
+ * are numbered in the order of their first occurrence in the inputs.
+ *
  * @sa
  * vtkAppendPolyData
  */
@@ -62,8 +68,8 @@ public:
    * Get/Set the tolerance to use to find coincident points when `MergePoints`
    * is `true`. Default is 0.0.
    *
-   * This is simply passed on to the internal vtkLocator used to merge points.
-   * @sa `vtkLocator::SetTolerance`.
+   * This is simply passed on to the internal vtkStaticPointLocator used to merge points.
+   * @sa `vtkStaticPointLocator::MergePoints`.
    */
   vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
   vtkGetMacro(Tolerance, double);
@@ -132,9 +138,6 @@ private:
   // Get all input data sets that have points, cells, or both.
   // Caller must delete the returned vtkDataSetCollection.
   vtkDataSetCollection* GetNonEmptyInputs(vtkInformationVector** inputVector);
-
-  void AppendArrays(int attributesType, vtkInformationVector** inputVector, vtkIdType* globalIds,
-    vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkAppendInternal
+ * @brief   threaded copy of the inputs of the append filters
+ *
+ * vtkAppendInternal provides the machinery shared by vtkAppendFilter and
+ * vtkAppendPolyData to copy their inputs concurrently. The offsets of the
+ * points, cells and connectivity ids of each input in the output are computed
+ * first and stored in AppendSegments. The output arrays are then allocated to
+ * their final size, and ranges of output elements are filled in parallel
+ * with vtkSMPTools. A range may span several inputs, so that many small
+ * inputs or a few large ones are processed equally well.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkAppendFilter vtkAppendPolyData
+ */
+
+#ifndef vtkAppendInternal_h
+#define vtkAppendInternal_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Consecutive ranges of elements of an output (points, cells, connectivity
+// ids, ...) each copied from a range of elements of one input. Segment s
+// fills the output elements [OutputStarts[s], OutputStarts[s + 1]) from the
+// elements of input Inputs[s] starting at InputStarts[s].
+struct AppendSegments
+{
+  std::vector<vtkIdType> OutputStarts{ 0 };
+  std::vector<vtkIdType> InputStarts;
+  std::vector<int> Inputs;
+
+  // Append numberOfElements elements of the input to the output. Empty
+  // ranges are skipped so that the output starts are strictly increasing.
+  void Add(int input, vtkIdType inputStart, vtkIdType numberOfElements)
+  {
+    if (numberOfElements > 0)
+    {
+      this->Inputs.push_back(input);
+      this->InputStarts.push_back(inputStart);
+      this->OutputStarts.push_back(this->OutputStarts.back() + numberOfElements);
+    }
+  }
+
+  // Total number of output elements.
+  vtkIdType GetSize() const { return this->OutputStarts.back(); }
+
+  // Return the segment holding the output element outputId.
+  std::size_t Find(vtkIdType outputId) const
+  {
+    return std::upper_bound(this->OutputStarts.begin(), this->OutputStarts.end(), outputId) -
+      this->OutputStarts.begin() - 1;
+  }
+
+  // Invoke op(input, inputStart, outputStart, numberOfElements) for the
+  // parts of the segments overlapping the output elements [begin, end).
+  template <typename OpT>
+  void ForEach(vtkIdType begin, vtkIdType end, OpT&& op) const
+  {
+    for (std::size_t s = (begin < end ? this->Find(begin) : 0); begin < end; ++s)
+    {
+      const vtkIdType segmentEnd = std::min(end, this->OutputStarts[s + 1]);
+      op(this->Inputs[s], this->InputStarts[s] + begin - this->OutputStarts[s], begin,
+        segmentEnd - begin);
+      begin = segmentEnd;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy a range of tuples between arrays with the same number of components.
+// Only the given output tuples are written, so that disjoint ranges of the
+// same output can be filled concurrently.
+struct CopyTuplesWorker
+{
+  template <typename SrcArrayT, typename DstArrayT>
+  void operator()(SrcArrayT* src, DstArrayT* dst, vtkIdType srcStart, vtkIdType dstStart,
+    vtkIdType numberOfTuples)
+  {
+    using DstValueT = vtk::GetAPIType<DstArrayT>;
+    const vtkIdType numComps = src->GetNumberOfComponents();
+    const auto in =
+      vtk::DataArrayValueRange(src, srcStart * numComps, (srcStart + numberOfTuples) * numComps);
+    auto out =
+      vtk::DataArrayValueRange(dst, dstStart * numComps, (dstStart + numberOfTuples) * numComps);
+    auto outIter = out.begin();
+    for (const auto value : in)
+    {
+      *outIter++ = static_cast<DstValueT>(value);
+    }
+  }
+
+  static void Execute(vtkDataArray* src, vtkIdType srcStart, vtkDataArray* dst,
+    vtkIdType dstStart, vtkIdType numberOfTuples)
+  {
+    using RealDispatch =
+      vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+    CopyTuplesWorker worker;
+    if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(
+          src, dst, worker, srcStart, dstStart, numberOfTuples) &&
+      !RealDispatch::Execute(src, dst, worker, srcStart, dstStart, numberOfTuples))
+    {
+      // Use vtkDataArray API when fast-path dispatch fails.
+      worker(src, dst, srcStart, dstStart, numberOfTuples);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Copy a range of point ids (connectivity) or of offsets between the storage
+// arrays of cell arrays, adding shift to the values. When map is not null,
+// the shifted values are then mapped through it.
+struct CopyIdsWorker
+{
+  template <typename SrcArrayT, typename DstArrayT>
+  void operator()(SrcArrayT* src, DstArrayT* dst, vtkIdType srcStart, vtkIdType dstStart,
+    vtkIdType numberOfIds, vtkIdType shift, const vtkIdType* map)
+  {
+    using SrcValueT = vtk::GetAPIType<SrcArrayT>;
+    using DstValueT = vtk::GetAPIType<DstArrayT>;
+    const auto in = vtk::DataArrayValueRange<1>(src, srcStart, srcStart + numberOfIds);
+    auto out = vtk::DataArrayValueRange<1>(dst, dstStart, dstStart + numberOfIds);
+    if (map)
+    {
+      std::transform(in.cbegin(), in.cend(), out.begin(), [shift, map](SrcValueT id) -> DstValueT {
+        return static_cast<DstValueT>(map[static_cast<vtkIdType>(id) + shift]);
+      });
+    }
+    else
+    {
+      std::transform(in.cbegin(), in.cend(), out.begin(), [shift](SrcValueT id) -> DstValueT {
+        return static_cast<DstValueT>(static_cast<vtkIdType>(id) + shift);
+      });
+    }
+  }
+
+  static void Execute(vtkDataArray* src, vtkIdType srcStart, vtkDataArray* dst,
+    vtkIdType dstStart, vtkIdType numberOfIds, vtkIdType shift, const vtkIdType* map = nullptr)
+  {
+    using Dispatcher = vtkArrayDispatch::Dispatch2ByArray<vtkCellArray::StorageArrayList,
+      vtkCellArray::StorageArrayList>;
+    CopyIdsWorker worker;
+    if (!Dispatcher::Execute(src, dst, worker, srcStart, dstStart, numberOfIds, shift, map))
+    {
+      worker(src, dst, srcStart, dstStart, numberOfIds, shift, map);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Append cell arrays into the empty cell array dst. The point ids of cells[i]
+// are shifted by pointOffsets[i], then mapped through pointMap if it is not
+// null. Return false if dst cannot be allocated.
+inline bool AppendCellArrays(const std::vector<vtkCellArray*>& cells,
+  const std::vector<vtkIdType>& pointOffsets, vtkCellArray* dst,
+  const vtkIdType* pointMap = nullptr)
+{
+  AppendSegments cellSegments;
+  AppendSegments connectivitySegments;
+  std::vector<vtkIdType> connectivityStarts;
+  for (std::size_t i = 0; i < cells.size(); ++i)
+  {
+    connectivityStarts.push_back(connectivitySegments.GetSize());
+    cellSegments.Add(static_cast<int>(i), 0, cells[i]->GetNumberOfCells());
+    connectivitySegments.Add(static_cast<int>(i), 0, cells[i]->GetNumberOfConnectivityIds());
+  }
+  if (!dst->ResizeExact(cellSegments.GetSize(), connectivitySegments.GetSize()))
+  {
+    return false;
+  }
+  vtkDataArray* dstOffsets = dst->GetOffsetsArray();
+  vtkDataArray* dstConnectivity = dst->GetConnectivityArray();
+
+  // Offsets are shifted by the start of the connectivity of each cell array.
+  vtkSMPTools::For(0, cellSegments.GetSize(), [&](vtkIdType begin, vtkIdType end) {
+    cellSegments.ForEach(begin, end,
+      [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfCells) {
+        CopyIdsWorker::Execute(cells[input]->GetOffsetsArray(), inputStart, dstOffsets,
+          outputStart, numberOfCells, connectivityStarts[input]);
+      });
+  });
+  dstOffsets->SetComponent(cellSegments.GetSize(), 0, connectivitySegments.GetSize());
+
+  vtkSMPTools::For(0, connectivitySegments.GetSize(), [&](vtkIdType begin, vtkIdType end) {
+    connectivitySegments.ForEach(begin, end,
+      [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfIds) {
+        CopyIdsWorker::Execute(cells[input]->GetConnectivityArray(), inputStart,
+          dstConnectivity, outputStart, numberOfIds, pointOffsets[input], pointMap);
+      });
+  });
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The arrays of the attributes of each input of an append matched with the
+// arrays of the output attributes by a vtkDataSetAttributes::FieldList.
+// The output arrays must have their final number of tuples (see
+// SetNumberOfTuples) so that disjoint ranges of tuples can be copied
+// concurrently. Only arrays deriving from vtkDataArray are copied
+// concurrently, other arrays (strings, variants) are copied serially, as well
+// as bit arrays whose segments may share a byte.
+class AppendAttributes
+{
+public:
+  // Add the arrays of the next input, whose index in the field list is
+  // listIndex.
+  void AddInput(const vtkDataSetAttributes::FieldList& list, int listIndex,
+    vtkDataSetAttributes* input, vtkDataSetAttributes* output)
+  {
+    this->Inputs.emplace_back();
+    Input& arrays = this->Inputs.back();
+    list.TransformData(listIndex, input, output,
+      [&arrays](vtkAbstractArray* in, vtkAbstractArray* out) {
+        vtkDataArray* inData = vtkDataArray::FastDownCast(in);
+        vtkDataArray* outData = vtkDataArray::FastDownCast(out);
+        if (inData && outData && outData->GetDataType() != VTK_BIT)
+        {
+          arrays.DataArrays.emplace_back(inData, outData);
+        }
+        else
+        {
+          arrays.OtherArrays.emplace_back(in, out);
+        }
+      });
+  }
+
+  // Give all the arrays of output numberOfTuples tuples.
+  static void SetNumberOfTuples(vtkDataSetAttributes* output, vtkIdType numberOfTuples)
+  {
+    for (int i = 0; i < output->GetNumberOfArrays(); ++i)
+    {
+      output->GetAbstractArray(i)->SetNumberOfTuples(numberOfTuples);
+    }
+  }
+
+  // Copy the tuples of the inputs to the output as described by segments,
+  // whose inputs are in the order of AddInput.
+  void Copy(const AppendSegments& segments) const
+  {
+    vtkSMPTools::For(0, segments.GetSize(), [&](vtkIdType begin, vtkIdType end) {
+      segments.ForEach(begin, end,
+        [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfTuples) {
+          for (const auto& pair : this->Inputs[input].DataArrays)
+          {
+            CopyTuplesWorker::Execute(
+              pair.first, inputStart, pair.second, outputStart, numberOfTuples);
+          }
+        });
+    });
+    if (this->HasOtherArrays())
+    {
+      segments.ForEach(0, segments.GetSize(),
+        [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfTuples) {
+          for (const auto& pair : this->Inputs[input].OtherArrays)
+          {
+            pair.second->InsertTuples(outputStart, numberOfTuples, inputStart, pair.first);
+          }
+        });
+    }
+  }
+
+  // Copy one tuple of the data arrays of an input. Thread safe for distinct
+  // outputIds.
+  void CopyDataArraysTuple(int input, vtkIdType inputId, vtkIdType outputId) const
+  {
+    for (const auto& pair : this->Inputs[input].DataArrays)
+    {
+      pair.second->SetTuple(outputId, inputId, pair.first);
+    }
+  }
+
+  // Copy one tuple of the other arrays of an input. Not thread safe.
+  void CopyOtherArraysTuple(int input, vtkIdType inputId, vtkIdType outputId) const
+  {
+    for (const auto& pair : this->Inputs[input].OtherArrays)
+    {
+      pair.second->SetTuple(outputId, inputId, pair.first);
+    }
+  }
+
+  bool HasOtherArrays() const
+  {
+    return std::any_of(this->Inputs.begin(), this->Inputs.end(),
+      [](const Input& input) { return !input.OtherArrays.empty(); });
+  }
+
+private:
+  struct Input
+  {
+    std::vector<std::pair<vtkDataArray*, vtkDataArray*>> DataArrays;
+    std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*>> OtherArrays;
+  };
+  std::vector<Input> Inputs;
+};
+
+} // anonymous namespace
+
+#endif // vtkAppendInternal_h
+// VTK-HeaderTest-Exclude: vtkAppendInternal.h
@@ -1,8 +1,12 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
+// Hide VTK_DEPRECATED_IN_9_4_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkAppendPolyData.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendInternal.h"
 #include "vtkArrayDispatch.h"
 #include "vtkAssume.h"
 #include "vtkCellArray.h"
@@ -14,11 +18,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendPolyData);
@@ -113,13 +119,8 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 {
   int idx;
   vtkPolyData* ds;
-  vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkCellArray *inVerts, *newVerts;
-  vtkCellArray *inLines, *newLines;
-  vtkCellArray *inPolys, *newPolys;
-  vtkIdType sizePolys, numPolys;
-  vtkCellArray *inStrips, *newStrips;
+  vtkCellArray *newVerts, *newLines, *newPolys, *newStrips;
   vtkIdType numPts, numCells;
   vtkPointData* inPD = nullptr;
   vtkCellData* inCD = nullptr;
@@ -131,14 +132,10 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   // loop over all data sets, checking to see what point data is available.
   numPts = 0;
   numCells = 0;
-  sizePolys = numPolys = 0;
 
   int countPD = 0;
   int countCD = 0;
 
-  vtkIdType numVerts = 0, numLines = 0, numStrips = 0;
-  vtkIdType sizeLines = 0, sizeStrips = 0, sizeVerts = 0;
-
   // These Field lists are very picky.  Count the number of non empty inputs
   // so we can initialize them properly.
   for (idx = 0; idx < numInputs; ++idx)
@@ -187,32 +184,7 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
       // Although we cannot have cells without points ... let's not nest.
       if (ds->GetNumberOfCells() > 0)
       {
-        if (ds->GetVerts())
-        {
-          sizeVerts += ds->GetVerts()->GetNumberOfConnectivityIds();
-        }
-        if (ds->GetLines())
-        {
-          sizeLines += ds->GetLines()->GetNumberOfConnectivityIds();
-        }
-        // keep track of the size of the poly cell array
-        if (ds->GetPolys())
-        {
-          sizePolys += ds->GetPolys()->GetNumberOfConnectivityIds();
-        }
-        if (ds->GetStrips())
-        {
-          sizeStrips += ds->GetStrips()->GetNumberOfConnectivityIds();
-        }
-
         numCells += ds->GetNumberOfCells();
-        // Count the cells of each type.
-        // This is used to ensure that cell data is copied at the correct
-        // locations in the output.
-        numVerts += ds->GetNumberOfVerts();
-        numLines += ds->GetNumberOfLines();
-        numPolys += ds->GetNumberOfPolys();
-        numStrips += ds->GetNumberOfStrips();
 
         inCD = ds->GetCellData();
         if (countCD == 0)
@@ -277,123 +249,113 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
   newPts->SetNumberOfPoints(numPts);
 
   newVerts = vtkCellArray::New();
-  bool allocated = newVerts->AllocateExact(numVerts, sizeVerts);
-
-  if (sizeVerts > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
   newLines = vtkCellArray::New();
-  allocated = newLines->AllocateExact(numLines, sizeLines);
-
-  if (sizeLines > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
   newPolys = vtkCellArray::New();
-  allocated = newPolys->AllocateExact(numPolys, sizePolys);
-
-  if (sizePolys > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
-
   newStrips = vtkCellArray::New();
-  allocated = newStrips->AllocateExact(numStrips, sizeStrips);
-
-  if (sizeStrips > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
-  }
 
   // Since points are cells are not merged,
   // this filter can easily pass all field arrays, including global ids.
   outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
   outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
-  // Allocate the point and cell data
+  // Allocate the point and cell data, with their final number of tuples so
+  // that the inputs can be copied concurrently.
   outputPD->CopyAllocate(ptList, numPts);
   outputCD->CopyAllocate(cellList, numCells);
-
-  // loop over all input sets
-  vtkIdType ptOffset = 0;
-  vtkIdType vertOffset = 0;
-  vtkIdType linesOffset = numVerts;
-  vtkIdType polysOffset = numVerts + numLines;
-  vtkIdType stripsOffset = numVerts + numLines + numPolys;
+  AppendAttributes::SetNumberOfTuples(outputPD, numPts);
+  AppendAttributes::SetNumberOfTuples(outputCD, numCells);
+
+  // Compute where the points and attributes of each input go in the output.
+  AppendSegments pointSegments;
+  AppendAttributes pointData;
+  AppendAttributes cellData;
+  std::vector<vtkDataArray*> inPoints;
+  std::vector<vtkIdType> ptOffsets(numInputs, 0);
+  std::vector<int> cellDataIndices(numInputs, -1);
   countPD = countCD = 0;
-  int checkAbortInterval = std::min(numInputs / 10 + 1, 1000);
   for (idx = 0; idx < numInputs; ++idx)
   {
-    if (idx % checkAbortInterval == 0 && this->CheckAbort())
+    ds = inputs[idx];
+    if (ds == nullptr)
+    {
+      continue;
+    }
+    ptOffsets[idx] = pointSegments.GetSize();
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      pointSegments.Add(countPD, 0, ds->GetNumberOfPoints());
+      inPoints.push_back(ds->GetPoints()->GetData());
+      pointData.AddInput(ptList, countPD, ds->GetPointData(), outputPD);
+      ++countPD;
+    }
+    if (ds->GetNumberOfCells() > 0)
+    {
+      cellData.AddInput(cellList, countCD, ds->GetCellData(), outputCD);
+      cellDataIndices[idx] = countCD;
+      ++countCD;
+    }
+  }
+
+  // Append the cells, grouped by type in the output: all the verts, then all
+  // the lines, polys and strips, and so is their data.
+  AppendSegments cellSegments;
+  vtkCellArray* newCells[] = { newVerts, newLines, newPolys, newStrips };
+  for (int type = 0; type < 4; ++type)
+  {
+    if (this->CheckAbort())
     {
       break;
     }
-    this->UpdateProgress(0.2 + 0.8 * idx / numInputs);
-    ds = inputs[idx];
-    // this check is not necessary, but I'll put it in anyway
-    if (ds != nullptr)
+    std::vector<vtkCellArray*> inCells;
+    std::vector<vtkIdType> cellPtOffsets;
+    for (idx = 0; idx < numInputs; ++idx)
     {
-      numPts = ds->GetNumberOfPoints();
-      numCells = ds->GetNumberOfCells();
-      if (numPts <= 0 && numCells <= 0)
+      ds = inputs[idx];
+      if (ds == nullptr || cellDataIndices[idx] < 0)
       {
-        continue; // no input, just skip
+        continue;
       }
-
-      inPD = ds->GetPointData();
-      inCD = ds->GetCellData();
-
-      inPts = ds->GetPoints();
-      inVerts = ds->GetVerts();
-      inLines = ds->GetLines();
-      inPolys = ds->GetPolys();
-      inStrips = ds->GetStrips();
-
-      if (ds->GetNumberOfPoints() > 0)
+      // These are the cellIDs at which each of the cell types start.
+      vtkCellArray* cells[] = { ds->GetVerts(), ds->GetLines(), ds->GetPolys(), ds->GetStrips() };
+      vtkIdType cellsIndex = 0;
+      for (int previous = 0; previous < type; ++previous)
       {
-        // copy points directly
-        this->AppendData(newPts->GetData(), inPts->GetData(), ptOffset);
-        outputPD->CopyData(ptList, inPD, countPD, ptOffset, numPts, 0);
-        ++countPD;
+        cellsIndex += cells[previous] ? cells[previous]->GetNumberOfCells() : 0;
       }
-
-      if (ds->GetNumberOfCells() > 0)
+      if (cells[type] && cells[type]->GetNumberOfCells() > 0)
       {
-        // These are the cellIDs at which each of the cell types start.
-        vtkIdType vertsIndex = 0;
-        vtkIdType linesIndex = ds->GetNumberOfVerts();
-        vtkIdType polysIndex = linesIndex + ds->GetNumberOfLines();
-        vtkIdType stripsIndex = polysIndex + ds->GetNumberOfPolys();
-
-        // copy the cells
-        this->AppendCells(newVerts, inVerts, ptOffset);
-        this->AppendCells(newLines, inLines, ptOffset);
-        this->AppendCells(newPolys, inPolys, ptOffset);
-        this->AppendCells(newStrips, inStrips, ptOffset);
-
-        // copy cell data
-        outputCD->CopyData(cellList, inCD, countCD, vertOffset, ds->GetNumberOfVerts(), vertsIndex);
-        vertOffset += ds->GetNumberOfVerts();
-        outputCD->CopyData(
-          cellList, inCD, countCD, linesOffset, ds->GetNumberOfLines(), linesIndex);
-        linesOffset += ds->GetNumberOfLines();
-        outputCD->CopyData(
-          cellList, inCD, countCD, polysOffset, ds->GetNumberOfPolys(), polysIndex);
-        polysOffset += ds->GetNumberOfPolys();
-        outputCD->CopyData(
-          cellList, inCD, countCD, stripsOffset, ds->GetNumberOfStrips(), stripsIndex);
-        stripsOffset += ds->GetNumberOfStrips();
-        ++countCD;
+        cellSegments.Add(cellDataIndices[idx], cellsIndex, cells[type]->GetNumberOfCells());
+        inCells.push_back(cells[type]);
+        cellPtOffsets.push_back(ptOffsets[idx]);
       }
-      ptOffset += numPts;
     }
+    if (!::AppendCellArrays(inCells, cellPtOffsets, newCells[type]))
+    {
+      vtkErrorMacro(<< "Memory allocation failed in append filter");
+      newPts->Delete();
+      newVerts->Delete();
+      newLines->Delete();
+      newPolys->Delete();
+      newStrips->Delete();
+      return 0;
+    }
+    this->UpdateProgress(0.2 + 0.15 * (type + 1));
+  }
+
+  // copy points directly, then the point and cell data
+  if (!this->CheckAbort())
+  {
+    vtkDataArray* outPoints = newPts->GetData();
+    vtkSMPTools::For(0, pointSegments.GetSize(), [&](vtkIdType begin, vtkIdType end) {
+      pointSegments.ForEach(begin, end,
+        [&](int input, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfPoints) {
+          CopyTuplesWorker::Execute(
+            inPoints[input], inputStart, outPoints, outputStart, numberOfPoints);
+        });
+    });
+    pointData.Copy(pointSegments);
+    this->UpdateProgress(0.9);
+    cellData.Copy(cellSegments);
   }
 
   // Update ourselves and release memory
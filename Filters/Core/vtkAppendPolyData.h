@@ -12,6 +12,10 @@
  * attributes available.  (For example, if one dataset has point scalars but
  * another does not, point scalars will not be appended.)
  *
+ * The points, cells and attributes of the inputs are copied concurrently
+ * using vtkSMPTools, after the location of each input in the output is
+ * computed.
+ *
  * @warning
  * The related filter vtkRemovePolyData enables the subtraction, or removal
  * of the cells of a vtkPolyData. Hence vtkRemovePolyData functions like the
@@ -24,6 +28,7 @@
 #ifndef vtkAppendPolyData_h
 #define vtkAppendPolyData_h
 
+#include "vtkDeprecation.h"      // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
@@ -126,9 +131,11 @@ protected:
   int FillInputPortInformation(int, vtkInformation*) override;
 
   // An efficient templated way to append data.
+  VTK_DEPRECATED_IN_9_4_0("No longer used, inputs are appended concurrently in RequestData")
   void AppendData(vtkDataArray* dest, vtkDataArray* src, vtkIdType offset);
 
   // An efficient way to append cells.
+  VTK_DEPRECATED_IN_9_4_0("No longer used, use vtkCellArray::Append instead")
   void AppendCells(vtkCellArray* dst, vtkCellArray* src, vtkIdType offset);
 
 private:
@@ -6,7 +6,9 @@
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkDoubleArray.h"
 #include "vtkExprTkFunctionParser.h"
 #include "vtkFieldData.h"
@@ -83,6 +85,7 @@ int vtkArrayCalculator::FillInputPortInformation(int vtkNotUsed(port), vtkInform
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkTable");
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkCompositeDataSet");
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkHyperTreeGrid");
+  info->Set(vtkAlgorithm::INPUT_MODIFIABLE_IN_PLACE(), 1);
   return 1;
 }
 
@@ -429,9 +432,294 @@ struct vtkArrayCalculatorWorker
   }
 };
 
+//------------------------------------------------------------------------------
+// Number of tuples evaluated at once by vtkArrayCalculatorBlockFunctor.
+constexpr vtkIdType vtkArrayCalculatorBlockSize = 256;
+
+//------------------------------------------------------------------------------
+// Copy a component of the tuples [begin, begin + n) of an array into values.
+struct vtkArrayCalculatorGatherComponent
+{
+  template <typename TArray>
+  void operator()(TArray* array, vtkIdType begin, vtkIdType n, int component, double* values) const
+  {
+    for (const auto tuple : vtk::DataArrayTupleRange(array, begin, begin + n))
+    {
+      *values++ = static_cast<double>(tuple[component]);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Evaluate the function of a parsed vtkFunctionParser block by block: the
+// variables of a block of tuples are gathered into contiguous buffers, the
+// whole block is evaluated at once and the results are scattered into the
+// result array.
+template <typename TResultArray>
+class vtkArrayCalculatorBlockFunctor
+{
+  // Variable of the parser with the array and components its values come from.
+  struct Variable
+  {
+    int Index;
+    vtkDataArray* Array;
+    int Components[3];
+  };
+
+  vtkFunctionParser* FunctionParser;
+  vtkDataSet* DsInput;
+  vtkGraph* GraphInput;
+  vtkDataArray* Points;
+  std::vector<Variable> ScalarVariables;
+  std::vector<Variable> VectorVariables;
+  bool NeedPointCoordinates;
+  int NumberOfComponents;
+  TResultArray* ResultArray;
+
+  // thread local
+  vtkSMPThreadLocal<std::vector<double>> Values;
+  vtkSMPThreadLocal<std::vector<double>> Workspace;
+  vtkSMPThreadLocal<const char*> ThreadError;
+
+public:
+  // Message of an evaluation failure, set by Reduce().
+  const char* Error;
+
+  vtkArrayCalculatorBlockFunctor(vtkFunctionParser* functionParser, vtkDataSet* dsInput,
+    vtkGraph* graphInput, int attributeType, const std::vector<vtkDataArray*>& scalarArrays,
+    const std::vector<int>& scalarArrayIndices, const std::vector<int>& selectedScalarComponents,
+    const std::vector<vtkDataArray*>& vectorArrays, const std::vector<int>& vectorArrayIndices,
+    const std::vector<vtkTuple<int, 3>>& selectedVectorComponents,
+    const std::vector<std::string>& coordinateScalarVariableNames,
+    const std::vector<int>& selectedCoordinateScalarComponents,
+    const std::vector<std::string>& coordinateVectorVariableNames,
+    const std::vector<vtkTuple<int, 3>>& selectedCoordinateVectorComponents,
+    int numberOfComponents, TResultArray* resultArray)
+    : FunctionParser(functionParser)
+    , DsInput(dsInput)
+    , GraphInput(graphInput)
+    , Points(nullptr)
+    , NeedPointCoordinates(false)
+    , NumberOfComponents(numberOfComponents)
+    , ResultArray(resultArray)
+    , ThreadError(nullptr)
+    , Error(nullptr)
+  {
+    for (size_t i = 0; i < scalarArrays.size(); ++i)
+    {
+      if (scalarArrays[i])
+      {
+        this->ScalarVariables.push_back(
+          { scalarArrayIndices[i], scalarArrays[i], { selectedScalarComponents[i], 0, 0 } });
+      }
+    }
+    for (size_t i = 0; i < vectorArrays.size(); ++i)
+    {
+      if (vectorArrays[i])
+      {
+        const vtkTuple<int, 3>& c = selectedVectorComponents[i];
+        this->VectorVariables.push_back(
+          { vectorArrayIndices[i], vectorArrays[i], { c[0], c[1], c[2] } });
+      }
+    }
+
+    if (attributeType != vtkDataObject::POINT && attributeType != vtkDataObject::VERTEX)
+    {
+      return;
+    }
+    // Coordinates are read from the points array when there is one.
+    vtkPointSet* psInput = vtkPointSet::SafeDownCast(dsInput);
+    if (psInput && psInput->GetPoints())
+    {
+      this->Points = psInput->GetPoints()->GetData();
+    }
+    else if (graphInput && graphInput->GetPoints())
+    {
+      this->Points = graphInput->GetPoints()->GetData();
+    }
+    for (size_t i = 0; i < coordinateScalarVariableNames.size(); ++i)
+    {
+      const int index = functionParser->GetScalarVariableIndex(coordinateScalarVariableNames[i]);
+      if (index >= 0 && functionParser->GetScalarVariableNeeded(index))
+      {
+        this->ScalarVariables.push_back(
+          { index, nullptr, { selectedCoordinateScalarComponents[i], 0, 0 } });
+        this->NeedPointCoordinates = !this->Points;
+      }
+    }
+    for (size_t i = 0; i < coordinateVectorVariableNames.size(); ++i)
+    {
+      const int index = functionParser->GetVectorVariableIndex(coordinateVectorVariableNames[i]);
+      if (index >= 0 && functionParser->GetVectorVariableNeeded(index))
+      {
+        const vtkTuple<int, 3>& c = selectedCoordinateVectorComponents[i];
+        this->VectorVariables.push_back({ index, nullptr, { c[0], c[1], c[2] } });
+        this->NeedPointCoordinates = !this->Points;
+      }
+    }
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int numberOfScalarVariables = this->FunctionParser->GetNumberOfScalarVariables();
+    const int numberOfVectorVariables = this->FunctionParser->GetNumberOfVectorVariables();
+    std::vector<double>& values = this->Values.Local();
+    std::vector<double>& workspace = this->Workspace.Local();
+    const char*& threadError = this->ThreadError.Local();
+    std::vector<const double*> scalarValues(numberOfScalarVariables, nullptr);
+    std::vector<const double*> vectorValues(numberOfVectorVariables, nullptr);
+
+    // One block per scalar variable, three per vector variable, three for the
+    // coordinates and three for the result.
+    const size_t numberOfBlocks =
+      this->ScalarVariables.size() + 3 * this->VectorVariables.size() + 6;
+    values.resize(numberOfBlocks * vtkArrayCalculatorBlockSize);
+    double* points = values.data();
+    double* result = points + 3 * vtkArrayCalculatorBlockSize;
+    double* variableValues = result + 3 * vtkArrayCalculatorBlockSize;
+
+    for (vtkIdType first = begin; first < end; first += vtkArrayCalculatorBlockSize)
+    {
+      const vtkIdType n = std::min(vtkArrayCalculatorBlockSize, end - first);
+      if (this->NeedPointCoordinates)
+      {
+        this->GatherPoints(first, n, points);
+      }
+      double* next = variableValues;
+      for (const Variable& variable : this->ScalarVariables)
+      {
+        this->Gather(variable.Array, first, n, variable.Components[0], points, next);
+        scalarValues[variable.Index] = next;
+        next += n;
+      }
+      for (const Variable& variable : this->VectorVariables)
+      {
+        vectorValues[variable.Index] = next;
+        for (int c = 0; c < 3; ++c)
+        {
+          this->Gather(variable.Array, first, n, variable.Components[c], points, next);
+          next += n;
+        }
+      }
+
+      const char* error = nullptr;
+      if (!this->FunctionParser->EvaluateBlock(
+            n, scalarValues.data(), vectorValues.data(), result, workspace, &error))
+      {
+        std::fill(result, result + this->NumberOfComponents * n, VTK_PARSER_ERROR_RESULT);
+      }
+      if (error && !threadError)
+      {
+        threadError = error;
+      }
+
+      auto resultRange = vtk::DataArrayTupleRange(this->ResultArray, first, first + n);
+      vtkIdType t = 0;
+      for (auto tuple : resultRange)
+      {
+        for (int c = 0; c < this->NumberOfComponents; ++c)
+        {
+          tuple[c] = result[c * n + t];
+        }
+        ++t;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    // Errors cannot be reported from the threads, keep one for the caller.
+    for (const char* error : this->ThreadError)
+    {
+      if (error)
+      {
+        this->Error = error;
+        break;
+      }
+    }
+  }
+
+private:
+  // Copy a component of an array, or of the coordinates when array is nullptr.
+  void Gather(vtkDataArray* array, vtkIdType first, vtkIdType n, int component,
+    const double* points, double* values) const
+  {
+    if (!array && !this->Points)
+    {
+      for (vtkIdType t = 0; t < n; ++t)
+      {
+        values[t] = points[3 * t + component];
+      }
+      return;
+    }
+    array = array ? array : this->Points;
+    vtkArrayCalculatorGatherComponent gather;
+    if (!vtkArrayDispatch::Dispatch::Execute(array, gather, first, n, component, values))
+    {
+      gather(array, first, n, component, values);
+    }
+  }
+
+  // Copy the coordinates of points without a points array.
+  void GatherPoints(vtkIdType first, vtkIdType n, double* points) const
+  {
+    for (vtkIdType t = 0; t < n; ++t)
+    {
+      if (this->DsInput)
+      {
+        this->DsInput->GetPoint(first + t, points + 3 * t);
+      }
+      else if (this->GraphInput)
+      {
+        this->GraphInput->GetPoint(first + t, points + 3 * t);
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+struct vtkArrayCalculatorBlockWorker
+{
+  // Message of an evaluation failure, to be reported by the caller.
+  const char* Error = nullptr;
+
+  template <typename TResultArray>
+  void operator()(TResultArray* resultArray, vtkFunctionParser* functionParser,
+    vtkDataSet* dsInput, vtkGraph* graphInput, int attributeType,
+    const std::vector<vtkDataArray*>& scalarArrays, const std::vector<int>& scalarArrayIndices,
+    const std::vector<int>& selectedScalarComponents,
+    const std::vector<vtkDataArray*>& vectorArrays, const std::vector<int>& vectorArrayIndices,
+    const std::vector<vtkTuple<int, 3>>& selectedVectorComponents,
+    const std::vector<std::string>& coordinateScalarVariableNames,
+    const std::vector<int>& selectedCoordinateScalarComponents,
+    const std::vector<std::string>& coordinateVectorVariableNames,
+    const std::vector<vtkTuple<int, 3>>& selectedCoordinateVectorComponents,
+    int numberOfComponents, vtkIdType numTuples)
+  {
+    vtkArrayCalculatorBlockFunctor<TResultArray> functor(functionParser, dsInput, graphInput,
+      attributeType, scalarArrays, scalarArrayIndices, selectedScalarComponents, vectorArrays,
+      vectorArrayIndices, selectedVectorComponents, coordinateScalarVariableNames,
+      selectedCoordinateScalarComponents, coordinateVectorVariableNames,
+      selectedCoordinateVectorComponents, numberOfComponents, resultArray);
+
+    vtkIdType grain = 0;
+    if (resultArray->GetDataType() == VTK_BIT)
+    {
+      // The grain size needs to be defined to prevent false sharing
+      // when writing to a vtkBitArray.
+      grain = sizeof(vtkIdType) * 64;
+    }
+    vtkSMPTools::For(0, numTuples, grain, functor);
+    this->Error = functor.Error;
+  }
+};
+
 //------------------------------------------------------------------------------
 template <typename TFunctionParser>
-int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* output)
+int vtkArrayCalculator::ProcessDataObject(
+  vtkDataObject* input, vtkDataObject* output, vtkInformation* inInfo)
 {
   vtkDataSet* dsInput = vtkDataSet::SafeDownCast(input);
   vtkGraph* graphInput = vtkGraph::SafeDownCast(input);
@@ -627,23 +915,46 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
   }
   else
   {
-    resultArray.TakeReference(
-      vtkArrayDownCast<vtkDataArray>(vtkAbstractArray::CreateArray(this->ResultArrayType)));
+    // When allowed, overwrite the input array replaced by the result instead
+    // of allocating a new one.
+    vtkDataArray* replacedArray = inFD->GetArray(this->ResultArrayName);
+    if (replacedArray && replacedArray->HasStandardMemoryLayout() &&
+      replacedArray->GetDataType() == this->ResultArrayType &&
+      replacedArray->GetNumberOfComponents() == (resultType == SCALAR_RESULT ? 1 : 3) &&
+      replacedArray->GetNumberOfTuples() == numTuples &&
+      vtkDemandDrivenPipeline::IsArrayModifiableInPlace(inInfo, replacedArray))
+    {
+      resultArray = replacedArray;
+    }
+    else
+    {
+      resultArray.TakeReference(
+        vtkArrayDownCast<vtkDataArray>(vtkAbstractArray::CreateArray(this->ResultArrayType)));
+    }
   }
 
+  // The first tuple is computed again below. It must not be set beforehand
+  // when the result overwrites an input array, which may be a variable.
+  const bool inPlace = inFD->GetArray(this->ResultArrayName) == resultArray.Get();
   if (resultType == SCALAR_RESULT)
   {
     resultArray->SetNumberOfComponents(1);
     resultArray->SetNumberOfTuples(numTuples);
     double scalarResult = functionParser->GetScalarResult();
-    resultArray->SetTuple(0, &scalarResult);
+    if (!inPlace)
+    {
+      resultArray->SetTuple(0, &scalarResult);
+    }
   }
   else
   {
-    resultArray->Allocate(numTuples * 3);
-    resultArray->SetNumberOfComponents(3);
-    resultArray->SetNumberOfTuples(numTuples);
-    resultArray->SetTuple(0, functionParser->GetVectorResult());
+    if (!inPlace)
+    {
+      resultArray->Allocate(numTuples * 3);
+      resultArray->SetNumberOfComponents(3);
+      resultArray->SetNumberOfTuples(numTuples);
+      resultArray->SetTuple(0, functionParser->GetVectorResult());
+    }
   }
 
   // Save array pointers to avoid looking them up for each tuple.
@@ -694,23 +1005,50 @@ int vtkArrayCalculator::ProcessDataObject(vtkDataObject* input, vtkDataObject* o
     }
   }
 
-  vtkArrayCalculatorWorker<TFunctionParser> arrayCalculatorWorker;
-  if (!vtkArrayDispatch::Dispatch::Execute(resultArray.Get(), arrayCalculatorWorker, dsInput,
-        graphInput, inFD, attributeType, this->Function, this->ReplaceInvalidValues,
-        this->ReplacementValue, this->IgnoreMissingArrays, this->ScalarArrayNames,
-        this->VectorArrayNames, this->ScalarVariableNames, this->VectorVariableNames,
-        this->SelectedScalarComponents, this->SelectedVectorComponents,
-        this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
-        this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
-        scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples))
+  if (this->FunctionParserType == VectorizedFunctionParser)
   {
-    arrayCalculatorWorker(resultArray.Get(), dsInput, graphInput, inFD, attributeType,
-      this->Function, this->ReplaceInvalidValues, this->ReplacementValue, this->IgnoreMissingArrays,
-      this->ScalarArrayNames, this->VectorArrayNames, this->ScalarVariableNames,
-      this->VectorVariableNames, this->SelectedScalarComponents, this->SelectedVectorComponents,
-      this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
-      this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
-      scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples);
+    vtkArrayCalculatorBlockWorker blockWorker;
+    vtkFunctionParser* blockParser = vtkFunctionParser::SafeDownCast(functionParser);
+    const int numberOfComponents = resultType == SCALAR_RESULT ? 1 : 3;
+    if (!vtkArrayDispatch::Dispatch::Execute(resultArray.Get(), blockWorker, blockParser, dsInput,
+          graphInput, attributeType, scalarArrays, scalarArrayIndices,
+          this->SelectedScalarComponents, vectorArrays, vectorArrayIndices,
+          this->SelectedVectorComponents, this->CoordinateScalarVariableNames,
+          this->SelectedCoordinateScalarComponents, this->CoordinateVectorVariableNames,
+          this->SelectedCoordinateVectorComponents, numberOfComponents, numTuples))
+    {
+      blockWorker(resultArray.Get(), blockParser, dsInput, graphInput, attributeType, scalarArrays,
+        scalarArrayIndices, this->SelectedScalarComponents, vectorArrays, vectorArrayIndices,
+        this->SelectedVectorComponents, this->CoordinateScalarVariableNames,
+        this->SelectedCoordinateScalarComponents, this->CoordinateVectorVariableNames,
+        this->SelectedCoordinateVectorComponents, numberOfComponents, numTuples);
+    }
+    if (blockWorker.Error)
+    {
+      vtkErrorMacro(<< blockWorker.Error);
+    }
+  }
+  else
+  {
+    vtkArrayCalculatorWorker<TFunctionParser> arrayCalculatorWorker;
+    if (!vtkArrayDispatch::Dispatch::Execute(resultArray.Get(), arrayCalculatorWorker, dsInput,
+          graphInput, inFD, attributeType, this->Function, this->ReplaceInvalidValues,
+          this->ReplacementValue, this->IgnoreMissingArrays, this->ScalarArrayNames,
+          this->VectorArrayNames, this->ScalarVariableNames, this->VectorVariableNames,
+          this->SelectedScalarComponents, this->SelectedVectorComponents,
+          this->CoordinateScalarVariableNames, this->CoordinateVectorVariableNames,
+          this->SelectedCoordinateScalarComponents, this->SelectedCoordinateVectorComponents,
+          scalarArrays, vectorArrays, scalarArrayIndices, vectorArrayIndices, numTuples))
+    {
+      arrayCalculatorWorker(resultArray.Get(), dsInput, graphInput, inFD, attributeType,
+        this->Function, this->ReplaceInvalidValues, this->ReplacementValue,
+        this->IgnoreMissingArrays, this->ScalarArrayNames, this->VectorArrayNames,
+        this->ScalarVariableNames, this->VectorVariableNames, this->SelectedScalarComponents,
+        this->SelectedVectorComponents, this->CoordinateScalarVariableNames,
+        this->CoordinateVectorVariableNames, this->SelectedCoordinateScalarComponents,
+        this->SelectedCoordinateVectorComponents, scalarArrays, vectorArrays, scalarArrayIndices,
+        vectorArrayIndices, numTuples);
+    }
   }
 
   output->ShallowCopy(input);
@@ -815,7 +1153,8 @@ int vtkArrayCalculator::RequestData(vtkInformation* vtkNotUsed(request),
       outputCD->SetDataSet(cdIter, outputDataObject);
       outputDataObject->FastDelete();
 
-      if (this->FunctionParserType == FunctionParser)
+      if (this->FunctionParserType == FunctionParser ||
+        this->FunctionParserType == VectorizedFunctionParser)
       {
         success *= this->ProcessDataObject<vtkFunctionParser>(inputDataObject, outputDataObject);
       }
@@ -835,13 +1174,14 @@ int vtkArrayCalculator::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Not a composite data set.
-  if (this->FunctionParserType == FunctionParser)
+  if (this->FunctionParserType == FunctionParser ||
+    this->FunctionParserType == VectorizedFunctionParser)
   {
-    return this->ProcessDataObject<vtkFunctionParser>(input, output);
+    return this->ProcessDataObject<vtkFunctionParser>(input, output, inInfo);
   }
   else if (this->FunctionParserType == ExprTkFunctionParser)
   {
-    return this->ProcessDataObject<vtkExprTkFunctionParser>(input, output);
+    return this->ProcessDataObject<vtkExprTkFunctionParser>(input, output, inInfo);
   }
   else
   {
@@ -21,7 +21,7 @@
  * *
  * /
  * ^
- * . (only by vtkFunctionParser)
+ * . (only by vtkFunctionParser and VectorizedFunctionParser)
  * build unit vectors: iHat, jHat, kHat (ie (1,0,0), (0,1,0), (0,0,1))
  * abs
  * acos
@@ -53,7 +53,7 @@
  *
  * @sa
  * For more detailed documentation of the supported functionality see:
- * 1) vtkFunctionParser
+ * 1) vtkFunctionParser, also used by VectorizedFunctionParser
  * 2) vtkExprTkFunctionParser (default)
  */
 
@@ -280,15 +280,22 @@ public:
    */
   enum FunctionParserTypes
   {
-    FunctionParser,       // vtkFunctionParser
-    ExprTkFunctionParser, // vtkExprTkFunctionParser
+    FunctionParser,           // vtkFunctionParser
+    ExprTkFunctionParser,     // vtkExprTkFunctionParser
+    VectorizedFunctionParser, // vtkFunctionParser evaluating blocks of tuples
     NumberOfFunctionParserTypes
   };
 
   ///@{
   /**
    * Set/Get the FunctionParser type that will be used.
-   * vtkFunctionParser = 0, vtkExprTkFunctionParser = 1. Default is 1.
+   * vtkFunctionParser = 0, vtkExprTkFunctionParser = 1,
+   * VectorizedFunctionParser = 2. Default is 1.
+   *
+   * VectorizedFunctionParser understands the syntax of vtkFunctionParser. The
+   * function is parsed once, then evaluated with
+   * vtkFunctionParser::EvaluateBlock() on blocks of tuples, so that the cost
+   * of interpreting it is shared by the tuples of a block.
    */
   vtkSetEnumMacro(FunctionParserType, FunctionParserTypes);
   void SetFunctionParserTypeToFunctionParser()
@@ -301,6 +308,11 @@ public:
     this->FunctionParserType = FunctionParserTypes::ExprTkFunctionParser;
     this->Modified();
   }
+  void SetFunctionParserTypeToVectorizedFunctionParser()
+  {
+    this->FunctionParserType = FunctionParserTypes::VectorizedFunctionParser;
+    this->Modified();
+  }
   vtkGetEnumMacro(FunctionParserType, FunctionParserTypes);
   ///@}
 
@@ -362,9 +374,11 @@ private:
   vtkArrayCalculator(const vtkArrayCalculator&) = delete;
   void operator=(const vtkArrayCalculator&) = delete;
 
-  // Do the bulk of the work
+  // Do the bulk of the work. inInfo is the information of the input
+  // connection when the input is the data object of the pipeline.
   template <typename TFunctionParser>
-  int ProcessDataObject(vtkDataObject* input, vtkDataObject* output);
+  int ProcessDataObject(
+    vtkDataObject* input, vtkDataObject* output, vtkInformation* inInfo = nullptr);
 };
 
 VTK_ABI_NAMESPACE_END
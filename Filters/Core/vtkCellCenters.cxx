@@ -9,6 +9,7 @@
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
+#include "vtkForEachCellOfType.h"
 #include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -22,6 +23,7 @@
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <atomic>
 
@@ -31,6 +33,79 @@ vtkStandardNewMacro(vtkCellCenters);
 namespace
 {
 
+//------------------------------------------------------------------------------
+// Linear cells whose parametric center is the average of their points.
+bool IsAveragedCellType(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_VERTEX:
+    case VTK_LINE:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_TETRA:
+    case VTK_VOXEL:
+    case VTK_HEXAHEDRON:
+    case VTK_WEDGE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Computes the centers of the linear cells of a dataset as the average of
+// their points, in a single pass and without instantiating cells. Returns the
+// number of cells processed.
+template <typename DataSetT>
+vtkIdType AverageCellCenters(DataSetT* dataset, double* centers)
+{
+  vtkSMPThreadLocal<vtkIdType> visited(0);
+  vtk::ForEachCellOfTypes(dataset,
+    { VTK_VERTEX, VTK_LINE, VTK_TRIANGLE, VTK_QUAD, VTK_PIXEL, VTK_TETRA, VTK_VOXEL,
+      VTK_HEXAHEDRON, VTK_WEDGE },
+    [centers, &visited](vtkIdType cellId, int, vtkIdType npts, const vtkIdType*, const double* x) {
+      double center[3] = { 0.0, 0.0, 0.0 };
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        center[0] += x[3 * i];
+        center[1] += x[3 * i + 1];
+        center[2] += x[3 * i + 2];
+      }
+      const double scale = 1.0 / npts;
+      centers[3 * cellId] = center[0] * scale;
+      centers[3 * cellId + 1] = center[1] * scale;
+      centers[3 * cellId + 2] = center[2] * scale;
+      ++visited.Local();
+    });
+
+  vtkIdType numVisited = 0;
+  for (vtkIdType count : visited)
+  {
+    numVisited += count;
+  }
+  return numVisited;
+}
+
+//------------------------------------------------------------------------------
+// Fast path for the linear cells of polydata and unstructured grids, returns
+// the number of cells processed.
+vtkIdType AverageCellCenters(vtkDataSet* dataset, vtkDoubleArray* cellCenters)
+{
+  double* centers = cellCenters->GetPointer(0);
+  if (auto pdata = vtkPolyData::SafeDownCast(dataset))
+  {
+    return AverageCellCenters(pdata, centers);
+  }
+  if (auto ugrid = vtkUnstructuredGrid::SafeDownCast(dataset))
+  {
+    return AverageCellCenters(ugrid, centers);
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
 class CellCenterFunctor
 {
   vtkSMPThreadLocalObject<vtkGenericCell> TLCell;
@@ -38,12 +113,14 @@ class CellCenterFunctor
   vtkDataSet* DataSet;
   vtkDoubleArray* CellCenters;
   vtkIdType MaxCellSize;
+  bool SkipAveragedCells;
 
 public:
-  CellCenterFunctor(vtkDataSet* ds, vtkDoubleArray* cellCenters)
+  CellCenterFunctor(vtkDataSet* ds, vtkDoubleArray* cellCenters, bool skipAveragedCells)
     : DataSet(ds)
     , CellCenters(cellCenters)
     , MaxCellSize(ds->GetMaxCellSize())
+    , SkipAveragedCells(skipAveragedCells)
   {
   }
 
@@ -64,6 +141,10 @@ public:
     auto cell = this->TLCell.Local();
     for (vtkIdType cellId = begin; cellId < end; ++cellId)
     {
+      if (this->SkipAveragedCells && ::IsAveragedCellType(this->DataSet->GetCellType(cellId)))
+      {
+        continue;
+      }
       this->DataSet->GetCell(cellId, cell);
       double x[3] = { 0.0 };
       if (cell->GetCellType() != VTK_EMPTY_CELL)
@@ -156,7 +237,14 @@ struct GhostCellsToGhostPointsConverter
 //------------------------------------------------------------------------------
 void vtkCellCenters::ComputeCellCenters(vtkDataSet* dataset, vtkDoubleArray* centers)
 {
-  CellCenterFunctor functor(dataset, centers);
+  // The centers of linear cells of polydata and unstructured grids are the
+  // average of their points, computed without instantiating the cells.
+  const vtkIdType numAveraged = ::AverageCellCenters(dataset, centers);
+  if (numAveraged == dataset->GetNumberOfCells())
+  {
+    return;
+  }
+  CellCenterFunctor functor(dataset, centers, numAveraged > 0);
 
   // Call this once one the main thread before calling on multiple threads.
   // According to the documentation for vtkDataSet::GetCell(vtkIdType, vtkGenericCell*),
@@ -6,6 +6,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkContourGridInternal.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
 #include "vtkCutter.h"
@@ -23,9 +24,11 @@
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
+#include "vtkSMPTools.h"
 #include "vtkSimpleScalarTree.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
@@ -361,6 +364,47 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
   output->Squeeze();
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Threaded version of vtkContourGridExecute for vtkUnstructuredGrid inputs
+// when points are merged with a vtkMergePoints and no scalar tree is used.
+// The output is the same.
+bool vtkContourGridThreadedExecute(vtkContourGrid* self, vtkUnstructuredGrid* input,
+  vtkPolyData* output, vtkDataArray* inScalars, vtkIdType numContours, double* values,
+  vtkTypeBool computeScalars, bool generateTriangles)
+{
+  // As in vtkContourGridExecute, the scalars to contour are made the active
+  // scalars of a shallow copy of the input point data.
+  vtkNew<vtkPointData> inPd;
+  inPd->ShallowCopy(input->GetPointData());
+  vtkAbstractArray* oldScalars = inPd->GetScalars();
+  inPd->SetScalars(inScalars);
+  if (oldScalars)
+  {
+    inPd->AddArray(oldScalars);
+  }
+
+  ThreadedContour contour(input, inScalars, inPd, input->GetCellData(), values, numContours);
+  contour.GenerateTriangles = generateTriangles;
+  contour.CopyScalars = computeScalars != 0;
+  contour.Filter = self;
+  if (self->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    contour.PointsType = input->GetPoints()->GetDataType();
+  }
+  else if (self->GetOutputPointsPrecision() == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    contour.PointsType = VTK_FLOAT;
+  }
+  else if (self->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    contour.PointsType = VTK_DOUBLE;
+  }
+  return contour.Execute(output);
+}
+}
+
 //------------------------------------------------------------------------------
 // Contouring filter for unstructured grids.
 //
@@ -410,8 +454,29 @@ int vtkContourGrid::RequestData(vtkInformation* vtkNotUsed(request),
     scalarTree->SetScalars(inScalars);
   }
 
-  vtkContourGridExecute(this, input, output, inScalars, numContours, values, computeScalars,
-    useScalarTree, scalarTree, this->GenerateTriangles != 0);
+  // Unstructured grids give thread safe access to their cells, which are then
+  // contoured concurrently when several threads are available, unless the
+  // locator merges points differently than vtkMergePoints.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!useScalarTree && grid && this->Locator->IsA("vtkMergePoints") &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
+  {
+    if (!vtkContourGridThreadedExecute(this, grid, output, inScalars, numContours, values,
+          computeScalars, this->GenerateTriangles != 0))
+    {
+      if (!this->GetAbortOutput())
+      {
+        vtkErrorMacro("Memory allocation failed in contour filter");
+      }
+      output->Initialize();
+      return 1;
+    }
+  }
+  else
+  {
+    vtkContourGridExecute(this, input, output, inScalars, numContours, values, computeScalars,
+      useScalarTree, scalarTree, this->GenerateTriangles != 0);
+  }
 
   if (this->ComputeNormals)
   {
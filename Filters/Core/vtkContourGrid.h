@@ -22,6 +22,16 @@
  * contours are being extracted. If you want to use a scalar tree,
  * invoke the method UseScalarTreeOn().
  *
+ * When no scalar tree is used, the locator is a vtkMergePoints (the
+ * default) and vtkSMPTools estimates that more than one thread is available,
+ * the cells are contoured concurrently with vtkSMPTools, in fixed batches
+ * whose points are merged afterwards. The output of this path is the same
+ * for any number of threads greater than one. It has the same points and
+ * cells as the serial path, which runs with a single thread or another
+ * locator, except that polygons produced by polyhedra (or by 3D cells when
+ * GenerateTriangles is off) may start at another point or be triangulated
+ * differently.
+ *
  * @warning
  * If the input vtkUnstructuredGrid contains 3D linear cells, the class
  * vtkContour3DLinearGrid is much faster and may be preferred in certain
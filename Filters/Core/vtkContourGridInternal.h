@@ -0,0 +1,493 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkContourGridInternal
+ * @brief   threaded contouring of the cells of an unstructured grid
+ *
+ * vtkContourGridInternal provides the threaded path shared by vtkContourGrid
+ * and vtkCutter to contour unstructured grids made of any kind of cells
+ * (wedges, pyramids, polyhedra, quadratic and higher order cells...). The
+ * cells are split in batches of fixed size that are contoured concurrently
+ * with vtkSMPTools, each batch merging its own points with a vtkMergePoints.
+ * The outputs of the batches are then appended in the order of the batches
+ * using the machinery of vtkAppendInternal.h, and the points generated by
+ * several batches are merged with vtkStaticPointLocator.
+ *
+ * Since the batches do not depend on the number of threads and merged points
+ * are numbered in the order of their first occurrence, the output is the same
+ * as the one of the serial contouring of the cells with a vtkMergePoints
+ * locator: same points, cells, attributes and ordering, whatever the number of
+ * threads.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkContourGrid vtkCutter vtkContourHelper
+ */
+
+#ifndef vtkContourGridInternal_h
+#define vtkContourGridInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkAppendInternal.h"
+#include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkContourHelper.h"
+#include "vtkCutter.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Contour the cells of an unstructured grid concurrently. The output is the
+// one of the serial contouring of the cells by increasing dimension with a
+// vtkMergePoints locator and a vtkContourHelper.
+class ThreadedContour
+{
+public:
+  // Number of cells contoured together, independent of the number of threads
+  // for the output to be deterministic.
+  static constexpr vtkIdType BatchSize = 1000;
+
+  ThreadedContour(vtkUnstructuredGrid* input, vtkDataArray* scalars, vtkPointData* inPd,
+    vtkCellData* inCd, const double* values, vtkIdType numberOfValues)
+    : Input(input)
+    , Scalars(scalars)
+    , InPd(inPd)
+    , InCd(inCd)
+    , Values(values)
+    , NumberOfValues(numberOfValues)
+  {
+  }
+
+  bool GenerateTriangles = true;
+  bool CopyScalars = true;
+  int PointsType = VTK_FLOAT;
+  vtkAlgorithm* Filter = nullptr;
+
+  // Contour the input into output. Return false if the output cannot be
+  // allocated or if the filter was aborted.
+  bool Execute(vtkPolyData* output)
+  {
+    const vtkIdType numberOfBatches = (this->Input->GetNumberOfCells() - 1) / BatchSize + 1;
+    unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+
+    // The cells are processed by increasing dimension, as the contours of
+    // lines, polygons and volumes give verts, lines and polys, which are
+    // ordered that way in the output. 0d cells generate nothing.
+    std::vector<Batch> batches;
+    for (int dimension = 1; dimension <= 3; ++dimension)
+    {
+      std::vector<Batch> dimensionBatches(numberOfBatches);
+      ContourBatches worker(this, dimension, cellTypeDimensions, dimensionBatches);
+      vtkSMPTools::For(0, numberOfBatches, worker);
+      if (this->Filter && this->Filter->GetAbortOutput())
+      {
+        return false;
+      }
+      for (Batch& batch : dimensionBatches)
+      {
+        if (batch.Points)
+        {
+          batches.emplace_back(std::move(batch));
+        }
+      }
+      if (this->Filter)
+      {
+        this->Filter->UpdateProgress(0.25 * dimension);
+      }
+    }
+    return this->Append(batches, output);
+  }
+
+private:
+  // The output of the contouring of a batch of cells. Cells holds the verts,
+  // lines and polys.
+  struct Batch
+  {
+    vtkSmartPointer<vtkPoints> Points;
+    vtkSmartPointer<vtkCellArray> Cells[3];
+    vtkSmartPointer<vtkPointData> PointData;
+    vtkSmartPointer<vtkCellData> CellData;
+  };
+
+  struct ContourBatches
+  {
+    ThreadedContour* Self;
+    int Dimension;
+    const unsigned char* CellTypeDimensions;
+    std::vector<Batch>& Batches;
+
+    struct LocalData
+    {
+      vtkSmartPointer<vtkGenericCell> Cell;
+      vtkSmartPointer<vtkIdList> PointIds;
+      vtkSmartPointer<vtkDoubleArray> CellScalars;
+      std::vector<vtkIdType> CellIds;
+      int UnknownCellType = -1;
+    };
+    vtkSMPThreadLocal<LocalData> Local;
+
+    ContourBatches(ThreadedContour* self, int dimension, const unsigned char* cellTypeDimensions,
+      std::vector<Batch>& batches)
+      : Self(self)
+      , Dimension(dimension)
+      , CellTypeDimensions(cellTypeDimensions)
+      , Batches(batches)
+    {
+    }
+
+    void Initialize()
+    {
+      LocalData& local = this->Local.Local();
+      local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+      local.PointIds = vtkSmartPointer<vtkIdList>::New();
+      local.CellScalars = vtkSmartPointer<vtkDoubleArray>::New();
+      local.CellScalars->SetNumberOfComponents(this->Self->Scalars->GetNumberOfComponents());
+    }
+
+    void operator()(vtkIdType batchId, vtkIdType endBatchId)
+    {
+      ThreadedContour* self = this->Self;
+      vtkUnstructuredGrid* input = self->Input;
+      LocalData& local = this->Local.Local();
+      const bool isFirst = vtkSMPTools::GetSingleThread();
+      for (; batchId < endBatchId; ++batchId)
+      {
+        if (self->Filter)
+        {
+          if (isFirst)
+          {
+            self->Filter->CheckAbort();
+          }
+          if (self->Filter->GetAbortOutput())
+          {
+            break;
+          }
+        }
+
+        // Find the cells of the batch crossed by a contour value, and their
+        // bounds.
+        const vtkIdType beginCellId = batchId * BatchSize;
+        const vtkIdType endCellId = std::min(beginCellId + BatchSize, input->GetNumberOfCells());
+        vtkBoundingBox bbox;
+        local.CellIds.clear();
+        for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+        {
+          const int cellType = input->GetCellType(cellId);
+          if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+          { // Protect against new cell types added, reported by Reduce().
+            local.UnknownCellType = cellType;
+            continue;
+          }
+          if (this->CellTypeDimensions[cellType] != this->Dimension)
+          {
+            continue;
+          }
+          input->GetCellPoints(cellId, local.PointIds);
+          if (!self->IsCrossed(local.PointIds, local.CellScalars))
+          {
+            continue;
+          }
+          local.CellIds.push_back(cellId);
+          for (vtkIdType i = 0; i < local.PointIds->GetNumberOfIds(); ++i)
+          {
+            double x[3];
+            input->GetPoint(local.PointIds->GetId(i), x);
+            bbox.AddPoint(x);
+          }
+        }
+        if (local.CellIds.empty())
+        {
+          continue;
+        }
+
+        Batch& batch = this->Batches[batchId];
+        const vtkIdType estimatedSize =
+          static_cast<vtkIdType>(local.CellIds.size()) * self->NumberOfValues;
+        batch.Points = vtkSmartPointer<vtkPoints>::New();
+        batch.Points->SetDataType(self->PointsType);
+        batch.Points->Allocate(estimatedSize);
+        for (auto& cells : batch.Cells)
+        {
+          cells = vtkSmartPointer<vtkCellArray>::New();
+        }
+        batch.PointData = vtkSmartPointer<vtkPointData>::New();
+        if (!self->CopyScalars)
+        {
+          batch.PointData->CopyScalarsOff();
+        }
+        batch.PointData->InterpolateAllocate(self->InPd, estimatedSize);
+        batch.CellData = vtkSmartPointer<vtkCellData>::New();
+        batch.CellData->CopyAllocate(self->InCd, estimatedSize);
+        double bounds[6];
+        bbox.GetBounds(bounds);
+        vtkNew<vtkMergePoints> locator;
+        locator->InitPointInsertion(batch.Points, bounds, estimatedSize);
+        vtkContourHelper helper(locator, batch.Cells[0], batch.Cells[1], batch.Cells[2],
+          self->InPd, self->InCd, batch.PointData, batch.CellData,
+          static_cast<int>(estimatedSize), self->GenerateTriangles);
+
+        for (vtkIdType cellId : local.CellIds)
+        {
+          input->GetCell(cellId, local.Cell);
+          input->SetCellOrderAndRationalWeights(cellId, local.Cell);
+          double range[2];
+          self->GetRange(local.Cell->GetPointIds(), local.CellScalars, range);
+          for (vtkIdType i = 0; i < self->NumberOfValues; ++i)
+          {
+            if (self->Values[i] >= range[0] && self->Values[i] <= range[1])
+            {
+              helper.Contour(local.Cell, self->Values[i], local.CellScalars, cellId);
+            }
+          }
+        }
+      }
+    }
+
+    void Reduce()
+    {
+      // Every dimension visits all the cells, warn once from the calling
+      // thread.
+      if (this->Dimension != 1)
+      {
+        return;
+      }
+      for (const LocalData& local : this->Local)
+      {
+        if (local.UnknownCellType >= 0)
+        {
+          vtkGenericWarningMacro("Unknown cell type " << local.UnknownCellType);
+          return;
+        }
+      }
+    }
+  };
+
+  // Gather the scalars of the points of a cell in cellScalars and compute
+  // their range over all components.
+  void GetRange(vtkIdList* pointIds, vtkDoubleArray* cellScalars, double range[2]) const
+  {
+    cellScalars->SetNumberOfTuples(pointIds->GetNumberOfIds());
+    this->Scalars->GetTuples(pointIds, cellScalars);
+    range[0] = std::numeric_limits<double>::max();
+    range[1] = std::numeric_limits<double>::lowest();
+    const double* values = cellScalars->GetPointer(0);
+    for (vtkIdType i = 0; i < cellScalars->GetNumberOfValues(); ++i)
+    {
+      range[0] = std::min(range[0], values[i]);
+      range[1] = std::max(range[1], values[i]);
+    }
+  }
+
+  bool IsCrossed(vtkIdList* pointIds, vtkDoubleArray* cellScalars) const
+  {
+    double range[2];
+    this->GetRange(pointIds, cellScalars, range);
+    return std::any_of(this->Values, this->Values + this->NumberOfValues,
+      [&range](double value) { return value >= range[0] && value <= range[1]; });
+  }
+
+  // Append the outputs of the batches, merging the points they share.
+  bool Append(std::vector<Batch>& batches, vtkPolyData* output) const
+  {
+    vtkPointData* outPd = output->GetPointData();
+    vtkCellData* outCd = output->GetCellData();
+    vtkNew<vtkPoints> newPts;
+    newPts->SetDataType(this->PointsType);
+    output->SetPoints(newPts);
+    if (batches.empty())
+    {
+      if (!this->CopyScalars)
+      {
+        outPd->CopyScalarsOff();
+      }
+      outPd->InterpolateAllocate(this->InPd, 0);
+      outCd->CopyAllocate(this->InCd, 0);
+      return true;
+    }
+
+    // Concatenate the points of the batches.
+    AppendSegments pointSegments;
+    std::vector<vtkIdType> pointOffsets;
+    for (std::size_t i = 0; i < batches.size(); ++i)
+    {
+      pointOffsets.push_back(pointSegments.GetSize());
+      pointSegments.Add(static_cast<int>(i), 0, batches[i].Points->GetNumberOfPoints());
+    }
+    const vtkIdType totalNumPts = pointSegments.GetSize();
+    vtkNew<vtkPoints> allPts;
+    allPts->SetDataType(this->PointsType);
+    allPts->SetNumberOfPoints(totalNumPts);
+    vtkDataArray* allPtsData = allPts->GetData();
+    vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+      pointSegments.ForEach(begin, end,
+        [&](int batch, vtkIdType inputStart, vtkIdType outputStart, vtkIdType numberOfPoints) {
+          CopyTuplesWorker::Execute(batches[batch].Points->GetData(), inputStart, allPtsData,
+            outputStart, numberOfPoints);
+        });
+    });
+    for (Batch& batch : batches)
+    {
+      batch.Points = nullptr;
+    }
+
+    // Merge the coincident points, like vtkMergePoints does, and number them
+    // in the order of their first occurrence.
+    std::vector<vtkIdType> pointMap(totalNumPts);
+    vtkNew<vtkPolyData> cloud;
+    cloud->SetPoints(allPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(cloud);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, pointMap.data());
+    std::vector<vtkIdType> outputIds(totalNumPts, -1);
+    std::vector<vtkIdType> firstPoints;
+    for (vtkIdType ptId = 0; ptId < totalNumPts; ++ptId)
+    {
+      vtkIdType& outputId = outputIds[pointMap[ptId]];
+      if (outputId < 0)
+      {
+        outputId = static_cast<vtkIdType>(firstPoints.size());
+        firstPoints.push_back(ptId);
+      }
+      pointMap[ptId] = outputId;
+    }
+    const vtkIdType numNewPts = static_cast<vtkIdType>(firstPoints.size());
+    newPts->SetNumberOfPoints(numNewPts);
+    vtkDataArray* newPtsData = newPts->GetData();
+
+    vtkDataSetAttributes::FieldList pointList(static_cast<int>(batches.size()));
+    for (const Batch& batch : batches)
+    {
+      pointList.IntersectFieldList(batch.PointData);
+    }
+    outPd->CopyAllocate(pointList, numNewPts);
+    AppendAttributes::SetNumberOfTuples(outPd, numNewPts);
+    AppendAttributes pointData;
+    for (std::size_t i = 0; i < batches.size(); ++i)
+    {
+      pointData.AddInput(pointList, static_cast<int>(i), batches[i].PointData, outPd);
+    }
+    auto copyPoint = [&](vtkIdType ptId, bool dataArrays) {
+      const vtkIdType id = firstPoints[ptId];
+      const std::size_t segment = pointSegments.Find(id);
+      const vtkIdType batchId = id - pointSegments.OutputStarts[segment];
+      if (dataArrays)
+      {
+        newPtsData->SetTuple(ptId, id, allPtsData);
+        pointData.CopyDataArraysTuple(pointSegments.Inputs[segment], batchId, ptId);
+      }
+      else
+      {
+        pointData.CopyOtherArraysTuple(pointSegments.Inputs[segment], batchId, ptId);
+      }
+    };
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        copyPoint(ptId, true);
+      }
+    });
+    for (vtkIdType ptId = 0; pointData.HasOtherArrays() && ptId < numNewPts; ++ptId)
+    {
+      copyPoint(ptId, false);
+    }
+
+    // Append the verts, lines and polys of the batches. The cell data of a
+    // batch is ordered the same way.
+    AppendSegments cellSegments;
+    for (int kind = 0; kind < 3; ++kind)
+    {
+      std::vector<vtkCellArray*> cells;
+      std::vector<vtkIdType> cellPointOffsets;
+      for (std::size_t i = 0; i < batches.size(); ++i)
+      {
+        vtkIdType batchStart = 0;
+        for (int previousKind = 0; previousKind < kind; ++previousKind)
+        {
+          batchStart += batches[i].Cells[previousKind]->GetNumberOfCells();
+        }
+        const vtkIdType numberOfCells = batches[i].Cells[kind]->GetNumberOfCells();
+        if (numberOfCells > 0)
+        {
+          cells.push_back(batches[i].Cells[kind]);
+          cellPointOffsets.push_back(pointOffsets[i]);
+          cellSegments.Add(static_cast<int>(i), batchStart, numberOfCells);
+        }
+      }
+      if (cells.empty())
+      {
+        continue;
+      }
+      vtkNew<vtkCellArray> newCells;
+      if (!AppendCellArrays(cells, cellPointOffsets, newCells, pointMap.data()))
+      {
+        return false;
+      }
+      if (kind == 0)
+      {
+        output->SetVerts(newCells);
+      }
+      else if (kind == 1)
+      {
+        output->SetLines(newCells);
+      }
+      else
+      {
+        output->SetPolys(newCells);
+      }
+    }
+
+    vtkDataSetAttributes::FieldList cellList(static_cast<int>(batches.size()));
+    for (const Batch& batch : batches)
+    {
+      cellList.IntersectFieldList(batch.CellData);
+    }
+    outCd->CopyAllocate(cellList, cellSegments.GetSize());
+    AppendAttributes::SetNumberOfTuples(outCd, cellSegments.GetSize());
+    AppendAttributes cellData;
+    for (std::size_t i = 0; i < batches.size(); ++i)
+    {
+      cellData.AddInput(cellList, static_cast<int>(i), batches[i].CellData, outCd);
+    }
+    cellData.Copy(cellSegments);
+    return true;
+  }
+
+  vtkUnstructuredGrid* Input;
+  vtkDataArray* Scalars;
+  vtkPointData* InPd;
+  vtkCellData* InCd;
+  const double* Values;
+  vtkIdType NumberOfValues;
+};
+
+} // anonymous namespace
+
+#endif // vtkContourGridInternal_h
+// VTK-HeaderTest-Exclude: vtkContourGridInternal.h
@@ -7,6 +7,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkContourGridInternal.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
 #include "vtkDataSet.h"
@@ -29,11 +30,13 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkSynchronizedTemplates3D.h"
 #include "vtkSynchronizedTemplatesCutter3D.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
@@ -774,13 +777,6 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   {
     newPoints->SetDataType(VTK_DOUBLE);
   }
-  newPoints->Allocate(estimatedSize, estimatedSize / 2);
-  newVerts = vtkCellArray::New();
-  newVerts->AllocateEstimate(estimatedSize, 1);
-  newLines = vtkCellArray::New();
-  newLines->AllocateEstimate(estimatedSize, 2);
-  newPolys = vtkCellArray::New();
-  newPolys->AllocateEstimate(estimatedSize, 4);
   cutScalars = vtkDoubleArray::New();
   cutScalars->SetNumberOfTuples(numPts);
 
@@ -795,24 +791,61 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   {
     inPD = input->GetPointData();
   }
-  outPD = output->GetPointData();
-  outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
-  outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
+
+  // Loop over all points evaluating scalar function at each point
+  if (inputPointSet)
+  {
+    vtkDataArray* dataArrayInput = inputPointSet->GetPoints()->GetData();
+    this->CutFunction->FunctionValue(dataArrayInput, cutScalars);
+  }
 
   // locator used to merge potentially duplicate points
   if (this->Locator == nullptr)
   {
     this->CreateDefaultLocator();
   }
-  this->Locator->InitPointInsertion(newPoints, input->GetBounds());
 
-  // Loop over all points evaluating scalar function at each point
-  if (inputPointSet)
+  // The cells of unstructured grids, which give thread safe access to them, are
+  // cut concurrently when sorting by value and several threads are available,
+  // unless the locator merges points differently than vtkMergePoints. The
+  // output is the same as below.
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (this->SortBy == VTK_SORT_BY_VALUE && grid && this->Locator->IsA("vtkMergePoints") &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
   {
-    vtkDataArray* dataArrayInput = inputPointSet->GetPoints()->GetData();
-    this->CutFunction->FunctionValue(dataArrayInput, cutScalars);
+    ThreadedContour contour(grid, cutScalars, inPD, inCD, contourValues, numContours);
+    contour.GenerateTriangles = this->GenerateTriangles != 0;
+    contour.PointsType = newPoints->GetDataType();
+    contour.Filter = this;
+    if (!contour.Execute(output))
+    {
+      if (!this->GetAbortOutput())
+      {
+        vtkErrorMacro("Memory allocation failed in cutter");
+      }
+      output->Initialize();
+    }
+    newPoints->Delete();
+    cutScalars->Delete();
+    if (this->GenerateCutScalars)
+    {
+      inPD->Delete();
+    }
+    return;
   }
 
+  newPoints->Allocate(estimatedSize, estimatedSize / 2);
+  newVerts = vtkCellArray::New();
+  newVerts->AllocateEstimate(estimatedSize, 1);
+  newLines = vtkCellArray::New();
+  newLines->AllocateEstimate(estimatedSize, 2);
+  newPolys = vtkCellArray::New();
+  newPolys->AllocateEstimate(estimatedSize, 4);
+  outPD = output->GetPointData();
+  outPD->InterpolateAllocate(inPD, estimatedSize, estimatedSize / 2);
+  outCD->CopyAllocate(inCD, estimatedSize, estimatedSize / 2);
+  this->Locator->InitPointInsertion(newPoints, input->GetBounds());
+
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
   vtkNew<vtkGenericCell> cell;
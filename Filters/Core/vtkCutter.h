@@ -30,6 +30,12 @@
  * it's specialized for planes and it's faster because it's multithreaded, and in some
  * cases also algorithmically faster.
  *
+ * For other vtkUnstructuredGrid inputs sorted by value, with a vtkMergePoints
+ * locator (the default) and more than one thread, the cells are cut
+ * concurrently in the same way as in vtkContourGrid, with the same
+ * differences to the serial path. Sorting by cell, using another locator or
+ * a single thread keeps the serial path.
+ *
  * @sa
  * vtkImplicitFunction vtkClipPolyData vtkPlaneCutter
  */
@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -144,6 +145,17 @@ void vtkElevationFilter::PrintSelf(ostream& os, vtkIndent indent)
      << ")\n";
 }
 
+//------------------------------------------------------------------------------
+int vtkElevationFilter::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  info->Set(vtkAlgorithm::INPUT_MODIFIABLE_IN_PLACE(), 1);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkElevationFilter::RequestData(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -160,9 +172,23 @@ int vtkElevationFilter::RequestData(
     return 1;
   }
 
-  // Allocate space for the elevation scalar data.
-  vtkSmartPointer<vtkFloatArray> newScalars = vtkSmartPointer<vtkFloatArray>::New();
-  newScalars->SetNumberOfTuples(numPts);
+  // Allocate space for the elevation scalar data, or overwrite the elevation
+  // of the input when allowed.
+  vtkSmartPointer<vtkFloatArray> newScalars;
+  vtkFloatArray* inputScalars =
+    vtkFloatArray::FastDownCast(input->GetPointData()->GetArray("Elevation"));
+  if (inputScalars && inputScalars->GetNumberOfComponents() == 1 &&
+    inputScalars->GetNumberOfTuples() == numPts &&
+    vtkDemandDrivenPipeline::IsArrayModifiableInPlace(
+      inputVector[0]->GetInformationObject(0), inputScalars))
+  {
+    newScalars = inputScalars;
+  }
+  else
+  {
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numPts);
+  }
 
   // Set up 1D parametric system and make sure it is valid.
   double diffVector[3] = { this->HighPoint[0] - this->LowPoint[0],
@@ -67,6 +67,7 @@ protected:
   vtkElevationFilter();
   ~vtkElevationFilter() override;
 
+  int FillInputPortInformation(int port, vtkInformation* info) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   double LowPoint[3];
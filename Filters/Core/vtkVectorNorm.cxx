@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -112,6 +113,30 @@ struct vtkVectorNormDispatch // Interface between VTK and templated functions.
     }
   }
 };
+
+// Return a new reference to the scalars of the input attributes when the norm
+// can overwrite them, nullptr otherwise. The scalars are renamed only once the
+// norm is computed.
+vtkFloatArray* ReplaceableScalars(
+  vtkInformation* inInfo, vtkDataSetAttributes* attributes, vtkIdType numVectors)
+{
+  vtkFloatArray* scalars = vtkFloatArray::FastDownCast(attributes->GetScalars());
+  if (!scalars || scalars->GetNumberOfComponents() != 1 ||
+    scalars->GetNumberOfTuples() != numVectors ||
+    !vtkDemandDrivenPipeline::IsArrayModifiableInPlace(inInfo, scalars))
+  {
+    return nullptr;
+  }
+  for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
+  {
+    if (i != vtkDataSetAttributes::SCALARS && attributes->GetAbstractAttribute(i) == scalars)
+    {
+      return nullptr;
+    }
+  }
+  scalars->Register(nullptr);
+  return scalars;
+}
 }
 
 //=================================Begin class proper=========================
@@ -123,6 +148,17 @@ vtkVectorNorm::vtkVectorNorm()
   this->AttributeMode = VTK_ATTRIBUTE_MODE_DEFAULT;
 }
 
+//------------------------------------------------------------------------------
+int vtkVectorNorm::FillInputPortInformation(int port, vtkInformation* info)
+{
+  if (!this->Superclass::FillInputPortInformation(port, info))
+  {
+    return 0;
+  }
+  info->Set(vtkAlgorithm::INPUT_MODIFIABLE_IN_PLACE(), 1);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkVectorNorm::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -174,8 +210,13 @@ int vtkVectorNorm::RequestData(vtkInformation* vtkNotUsed(request),
   if (computePtScalars)
   {
     numVectors = ptVectors->GetNumberOfTuples();
-    newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfTuples(numVectors);
+    newScalars = ::ReplaceableScalars(inInfo, pd, numVectors);
+    const bool inPlace = newScalars != nullptr;
+    if (!inPlace)
+    {
+      newScalars = vtkFloatArray::New();
+      newScalars->SetNumberOfTuples(numVectors);
+    }
 
     if (!vtkArrayDispatch::Dispatch::Execute(
           ptVectors, normDispatch, normalize, numVectors, newScalars->GetPointer(0), this))
@@ -183,6 +224,11 @@ int vtkVectorNorm::RequestData(vtkInformation* vtkNotUsed(request),
       normDispatch(ptVectors, normalize, numVectors, newScalars->GetPointer(0), this);
     }
 
+    if (inPlace)
+    {
+      // The norm is unnamed, like a newly allocated array.
+      newScalars->SetName(nullptr);
+    }
     int idx = outPD->AddArray(newScalars);
     outPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
     newScalars->Delete();
@@ -195,8 +241,13 @@ int vtkVectorNorm::RequestData(vtkInformation* vtkNotUsed(request),
   if (computeCellScalars)
   {
     numVectors = cellVectors->GetNumberOfTuples();
-    newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfTuples(numVectors);
+    newScalars = ::ReplaceableScalars(inInfo, cd, numVectors);
+    const bool inPlace = newScalars != nullptr;
+    if (!inPlace)
+    {
+      newScalars = vtkFloatArray::New();
+      newScalars->SetNumberOfTuples(numVectors);
+    }
 
     if (!vtkArrayDispatch::Dispatch::Execute(
           cellVectors, normDispatch, normalize, numVectors, newScalars->GetPointer(0), this))
@@ -204,6 +255,11 @@ int vtkVectorNorm::RequestData(vtkInformation* vtkNotUsed(request),
       normDispatch(cellVectors, normalize, numVectors, newScalars->GetPointer(0), this);
     }
 
+    if (inPlace)
+    {
+      // The norm is unnamed, like a newly allocated array.
+      newScalars->SetName(nullptr);
+    }
     int idx = outCD->AddArray(newScalars);
     outCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
     newScalars->Delete();
@@ -73,6 +73,7 @@ protected:
   vtkVectorNorm();
   ~vtkVectorNorm() override = default;
 
+  int FillInputPortInformation(int port, vtkInformation* info) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   vtkTypeBool Normalize; // normalize 0<=n<=1 if true.
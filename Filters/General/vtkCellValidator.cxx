@@ -73,6 +73,7 @@
 #include <cmath>
 #include <map>
 #include <sstream>
+#include <unordered_map>
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -9,6 +9,7 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkForEachCellOfType.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
@@ -19,14 +20,68 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
+#include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_verdict.h"
+
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCellSizeFilter);
 
+namespace
+{
+// Fast path for the triangles, quads and tetrahedra of polydata and
+// unstructured grids, computed in parallel in a single pass directly from the
+// coordinates of their points, with the same verdict functions as
+// vtkMeshQuality.
+template <typename DataSetT>
+void ComputeLinearCellSizes(DataSetT* dataset, vtkDoubleArray* areas, vtkDoubleArray* volumes)
+{
+  std::vector<int> cellTypes;
+  if (areas)
+  {
+    cellTypes.push_back(VTK_TRIANGLE);
+    cellTypes.push_back(VTK_QUAD);
+  }
+  if (volumes)
+  {
+    cellTypes.push_back(VTK_TETRA);
+  }
+  if (cellTypes.empty())
+  {
+    return;
+  }
+  double* areaValues = areas ? areas->GetPointer(0) : nullptr;
+  double* volumeValues = volumes ? volumes->GetPointer(0) : nullptr;
+  vtk::ForEachCellOfTypes(dataset, cellTypes,
+    [areaValues, volumeValues](
+      vtkIdType cellId, int cellType, vtkIdType npts, const vtkIdType*, const double* x) {
+      const int n = static_cast<int>(npts);
+      const auto coordinates = reinterpret_cast<const double(*)[3]>(x);
+      switch (cellType)
+      {
+        case VTK_TRIANGLE:
+          areaValues[cellId] = verdict::tri_area(n, coordinates);
+          break;
+        case VTK_QUAD:
+          areaValues[cellId] = verdict::quad_area(n, coordinates);
+          break;
+        case VTK_TETRA:
+          volumeValues[cellId] = verdict::tet_volume(n, coordinates);
+          break;
+        default:
+          break;
+      }
+    });
+}
+} // end anonymous namespace
+
 //------------------------------------------------------------------------------
 vtkCellSizeFilter::vtkCellSizeFilter()
   : ComputeVertexCount(true)
@@ -102,6 +157,22 @@ void vtkCellSizeFilter::ExecuteBlock(vtkDataSet* input, vtkDataSet* output, doub
   vtkNew<vtkGenericCell> cell;
   vtkPointSet* inputPS = vtkPointSet::SafeDownCast(input);
 
+  // The sizes of triangles, quads and tetrahedra are computed beforehand, in
+  // parallel and without instantiating cells, when the input allows it.
+  bool precomputed = true;
+  if (auto pdata = vtkPolyData::SafeDownCast(input))
+  {
+    ::ComputeLinearCellSizes(pdata, arrays[2], arrays[3]);
+  }
+  else if (auto ugrid = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    ::ComputeLinearCellSizes(ugrid, arrays[2], arrays[3]);
+  }
+  else
+  {
+    precomputed = false;
+  }
+
   vtkUnsignedCharArray* ghostArray = nullptr;
   if (sum)
   {
@@ -161,8 +232,15 @@ void vtkCellSizeFilter::ExecuteBlock(vtkDataSet* input, vtkDataSet* output, doub
       {
         if (this->ComputeArea)
         {
-          input->GetCell(cellId, cell);
-          value = vtkMeshQuality::TriangleArea(cell);
+          if (precomputed)
+          {
+            value = arrays[2]->GetValue(cellId);
+          }
+          else
+          {
+            input->GetCell(cellId, cell);
+            value = vtkMeshQuality::TriangleArea(cell);
+          }
           cellDimension = 2;
         }
         else
@@ -221,8 +299,15 @@ void vtkCellSizeFilter::ExecuteBlock(vtkDataSet* input, vtkDataSet* output, doub
       {
         if (this->ComputeArea)
         {
-          input->GetCell(cellId, cell);
-          value = vtkMeshQuality::QuadArea(cell);
+          if (precomputed)
+          {
+            value = arrays[2]->GetValue(cellId);
+          }
+          else
+          {
+            input->GetCell(cellId, cell);
+            value = vtkMeshQuality::QuadArea(cell);
+          }
           cellDimension = 2;
         }
         else
@@ -251,8 +336,15 @@ void vtkCellSizeFilter::ExecuteBlock(vtkDataSet* input, vtkDataSet* output, doub
       {
         if (this->ComputeVolume)
         {
-          input->GetCell(cellId, cell);
-          value = vtkMeshQuality::TetVolume(cell);
+          if (precomputed)
+          {
+            value = arrays[3]->GetValue(cellId);
+          }
+          else
+          {
+            input->GetCell(cellId, cell);
+            value = vtkMeshQuality::TetVolume(cell);
+          }
           cellDimension = 3;
         }
         else
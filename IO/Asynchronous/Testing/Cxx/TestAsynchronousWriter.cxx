@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAsynchronousWriter.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+
+namespace
+{
+constexpr int NumberOfSteps = 6;
+constexpr vtkIdType NumberOfPoints = 10000;
+
+std::string StepFileName(const std::string& dir, int step)
+{
+  return dir + "/TestAsynchronousWriter_" + std::to_string(step) + ".vtp";
+}
+}
+
+int TestAsynchronousWriter(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir(tempDir);
+  delete[] tempDir;
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->SetPoint(i, static_cast<double>(i), 0.0, 0.0);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(values);
+
+  vtkNew<vtkXMLPolyDataWriter> xmlWriter;
+  xmlWriter->SetDataModeToAppended();
+
+  std::atomic<int> numberOfCompletedWrites(0);
+  vtkNew<vtkAsynchronousWriter> writer;
+  writer->SetWriter(xmlWriter);
+  writer->SetSnapshotModeToDeepCopy();
+  writer->SetMaximumNumberOfPendingWrites(2);
+  writer->SetCompletionCallback(
+    [&numberOfCompletedWrites](const std::string&, bool success) {
+      if (success)
+      {
+        ++numberOfCompletedWrites;
+      }
+    });
+  writer->SetInputData(polyData);
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    // The input is modified in place right after queuing it, the deep copy
+    // snapshot must protect the pending writes.
+    values->FillValue(static_cast<double>(step));
+    values->Modified();
+    writer->SetFileName(::StepFileName(dir, step).c_str());
+    if (!writer->Write())
+    {
+      std::cerr << "Failed to queue step " << step << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (writer->GetNumberOfPendingWrites() > 2)
+    {
+      std::cerr << "Too many pending writes: " << writer->GetNumberOfPendingWrites() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  writer->Flush();
+
+  if (writer->GetNumberOfPendingWrites() != 0 || writer->GetNumberOfFailedWrites() != 0 ||
+    numberOfCompletedWrites != NumberOfSteps)
+  {
+    std::cerr << "Unexpected write status: " << writer->GetNumberOfPendingWrites() << " pending, "
+              << writer->GetNumberOfFailedWrites() << " failed, " << numberOfCompletedWrites
+              << " completed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->SetFileName(::StepFileName(dir, step).c_str());
+    reader->Update();
+    vtkPolyData* output = reader->GetOutput();
+    vtkDataArray* array = output->GetPointData()->GetArray("values");
+    if (output->GetNumberOfPoints() != NumberOfPoints || !array)
+    {
+      std::cerr << "Wrong data read back for step " << step << std::endl;
+      return EXIT_FAILURE;
+    }
+    double range[2];
+    array->GetRange(range);
+    if (range[0] != step || range[1] != step)
+    {
+      std::cerr << "Wrong values for step " << step << ": [" << range[0] << ", " << range[1]
+                << "]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,277 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAsynchronousWriter.h"
+
+#include "vtkDataObject.h"
+#include "vtkDataWriter.h"
+#include "vtkErrorCode.h"
+#include "vtkImageWriter.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkXMLWriterBase.h"
+
+#include <condition_variable>
+#include <mutex>
+
+VTK_ABI_NAMESPACE_BEGIN
+//****************************************************************************
+class vtkAsynchronousWriter::vtkInternals
+{
+public:
+  using TaskQueueType =
+    vtkThreadedTaskQueue<void, vtkSmartPointer<vtkDataObject>, std::string, vtkTypeInt64>;
+
+  std::unique_ptr<TaskQueueType> Queue;
+
+  std::mutex PendingMutex;
+  std::condition_variable PendingCV;
+  int NumberOfPendingWrites = 0;
+  vtkTypeInt64 PendingMemory = 0;
+  vtkTypeInt64 NumberOfFailedWrites = 0;
+
+  std::mutex CallbackMutex;
+  CompletionCallbackType CompletionCallback;
+
+  // Block the calling thread until a snapshot of the given size may be queued
+  // without exceeding the limits, then account for it.
+  void Reserve(vtkTypeInt64 size, int maxWrites, vtkTypeInt64 maxMemory)
+  {
+    std::unique_lock<std::mutex> lock(this->PendingMutex);
+    this->PendingCV.wait(lock, [&] {
+      if (this->NumberOfPendingWrites == 0)
+      {
+        return true;
+      }
+      if (maxWrites > 0 && this->NumberOfPendingWrites >= maxWrites)
+      {
+        return false;
+      }
+      return maxMemory <= 0 || this->PendingMemory + size <= maxMemory;
+    });
+    ++this->NumberOfPendingWrites;
+    this->PendingMemory += size;
+  }
+
+  void Release(vtkTypeInt64 size, bool success)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->PendingMutex);
+      --this->NumberOfPendingWrites;
+      this->PendingMemory -= size;
+      if (!success)
+      {
+        ++this->NumberOfFailedWrites;
+      }
+    }
+    this->PendingCV.notify_all();
+  }
+
+  void WaitForPendingWrites()
+  {
+    std::unique_lock<std::mutex> lock(this->PendingMutex);
+    this->PendingCV.wait(lock, [this] { return this->NumberOfPendingWrites == 0; });
+  }
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+void ForwardFileName(vtkAlgorithm* writer, const std::string& fileName)
+{
+  if (auto* xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    xmlWriter->SetFileName(fileName.c_str());
+  }
+  else if (auto* legacyWriter = vtkDataWriter::SafeDownCast(writer))
+  {
+    legacyWriter->SetFileName(fileName.c_str());
+  }
+  else if (auto* imageWriter = vtkImageWriter::SafeDownCast(writer))
+  {
+    imageWriter->SetFileName(fileName.c_str());
+  }
+  else
+  {
+    vtkLogF(WARNING, "Cannot forward file name '%s' to writer of type %s.", fileName.c_str(),
+      writer->GetClassName());
+  }
+}
+
+//----------------------------------------------------------------------------
+bool WriteSnapshot(vtkAlgorithm* writer, vtkDataObject* data, const std::string& fileName)
+{
+  if (!fileName.empty())
+  {
+    ::ForwardFileName(writer, fileName);
+  }
+  writer->SetInputDataObject(0, data);
+
+  bool success;
+  if (auto* vWriter = vtkWriter::SafeDownCast(writer))
+  {
+    success = vWriter->Write() != 0;
+  }
+  else if (auto* xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    success = xmlWriter->Write() != 0 && xmlWriter->GetErrorCode() == vtkErrorCode::NoError;
+  }
+  else
+  {
+    writer->Modified();
+    writer->UpdateWholeExtent();
+    success = writer->GetErrorCode() == vtkErrorCode::NoError;
+  }
+
+  // Do not keep the snapshot alive once it has been written.
+  writer->SetInputDataObject(0, nullptr);
+  return success;
+}
+}
+
+vtkStandardNewMacro(vtkAsynchronousWriter);
+
+//------------------------------------------------------------------------------
+vtkAsynchronousWriter::vtkAsynchronousWriter()
+  : Internals(new vtkInternals())
+{
+}
+
+//------------------------------------------------------------------------------
+vtkAsynchronousWriter::~vtkAsynchronousWriter()
+{
+  this->Flush();
+  this->Internals->Queue.reset();
+  this->SetWriter(nullptr);
+  this->SetFileName(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::SetWriter(vtkAlgorithm* writer)
+{
+  if (this->Writer == writer)
+  {
+    return;
+  }
+  // The I/O thread holds on to the writer it was started with, stop it so
+  // that the next write starts a new one using the new writer.
+  this->Flush();
+  this->Internals->Queue.reset();
+  vtkSetObjectBodyMacro(Writer, vtkAlgorithm, writer);
+}
+
+//------------------------------------------------------------------------------
+int vtkAsynchronousWriter::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::WriteData()
+{
+  vtkDataObject* input = this->GetInput();
+  if (input == nullptr)
+  {
+    vtkErrorMacro(<< "Write: Please specify an input!");
+    return;
+  }
+  if (this->Writer == nullptr)
+  {
+    vtkErrorMacro(<< "Write: Please specify a writer!");
+    return;
+  }
+
+  vtkSmartPointer<vtkDataObject> snapshot;
+  snapshot.TakeReference(input->NewInstance());
+  if (this->SnapshotMode == DEEP_COPY)
+  {
+    snapshot->DeepCopy(input);
+  }
+  else
+  {
+    snapshot->ShallowCopy(input);
+  }
+  vtkTypeInt64 size = static_cast<vtkTypeInt64>(snapshot->GetActualMemorySize());
+
+  if (!this->Internals->Queue)
+  {
+    vtkAlgorithm* writer = this->Writer;
+    vtkInternals* internals = this->Internals.get();
+    // Writes are serialized on a single worker: a writer instance cannot be
+    // executed concurrently.
+    this->Internals->Queue.reset(new vtkInternals::TaskQueueType(
+      [writer, internals](
+        vtkSmartPointer<vtkDataObject> data, std::string fileName, vtkTypeInt64 dataSize) {
+        vtkLogF(TRACE, "writing: %s", fileName.c_str());
+        bool success = ::WriteSnapshot(writer, data, fileName);
+        data = nullptr;
+        {
+          std::lock_guard<std::mutex> lock(internals->CallbackMutex);
+          if (internals->CompletionCallback)
+          {
+            internals->CompletionCallback(fileName, success);
+          }
+        }
+        internals->Release(dataSize, success);
+      },
+      /*strict_ordering=*/true,
+      /*buffer_size=*/-1,
+      /*max_concurrent_tasks=*/1));
+  }
+
+  this->Internals->Reserve(size, this->MaximumNumberOfPendingWrites, this->MaximumPendingMemory);
+  this->Internals->Queue->Push(
+    std::move(snapshot), std::string(this->FileName ? this->FileName : ""), std::move(size));
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::Flush()
+{
+  this->Internals->WaitForPendingWrites();
+}
+
+//------------------------------------------------------------------------------
+int vtkAsynchronousWriter::GetNumberOfPendingWrites()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+  return this->Internals->NumberOfPendingWrites;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkAsynchronousWriter::GetNumberOfFailedWrites()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->PendingMutex);
+  return this->Internals->NumberOfFailedWrites;
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::SetCompletionCallback(CompletionCallbackType callback)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->CallbackMutex);
+  this->Internals->CompletionCallback = std::move(callback);
+}
+
+//------------------------------------------------------------------------------
+void vtkAsynchronousWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Writer: ";
+  if (this->Writer)
+  {
+    os << endl;
+    this->Writer->PrintSelf(os, indent.GetNextIndent());
+  }
+  else
+  {
+    os << "(none)" << endl;
+  }
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "SnapshotMode: " << (this->SnapshotMode == DEEP_COPY ? "DeepCopy" : "ShallowCopy")
+     << endl;
+  os << indent << "MaximumNumberOfPendingWrites: " << this->MaximumNumberOfPendingWrites << endl;
+  os << indent << "MaximumPendingMemory: " << this->MaximumPendingMemory << endl;
+}
+VTK_ABI_NAMESPACE_END
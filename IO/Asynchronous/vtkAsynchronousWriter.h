@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class    vtkAsynchronousWriter
+ * @brief    write data objects on a background thread using any writer
+ *
+ * vtkAsynchronousWriter generalizes vtkThreadedImageWriter to any data type
+ * and any writer. The wrapped writer (any vtkWriter or vtkXMLWriterBase
+ * subclass, or more generally any sink algorithm) is configured as usual and
+ * set with SetWriter(). Every call to Write() then takes a snapshot of the
+ * input, queues it and returns immediately; the snapshot is written by the
+ * wrapped writer on a background I/O thread managed by a vtkThreadedTaskQueue.
+ *
+ * Writes are executed in submission order. Since a writer instance is not
+ * reentrant, all writes issued through one vtkAsynchronousWriter are
+ * serialized on its I/O thread; use several vtkAsynchronousWriter instances,
+ * each with its own writer, to write several outputs concurrently.
+ *
+ * The snapshot is a shallow copy of the input by default, which protects the
+ * queued data against the pipeline replacing its output, but not against
+ * in-place modifications of the input arrays. Use SetSnapshotMode() with
+ * DEEP_COPY when the caller reuses its buffers, e.g. in in-situ adaptors.
+ *
+ * To bound the memory held by pending writes, MaximumNumberOfPendingWrites
+ * and MaximumPendingMemory can be set. When queuing a new snapshot would
+ * exceed either limit, Write() blocks until enough pending writes complete.
+ * A single snapshot larger than the memory limit is always accepted once
+ * the queue is empty.
+ *
+ * The wrapped writer must not be modified or executed by the caller while
+ * writes are pending. Call Flush() to wait for all pending writes.
+ *
+ * @sa
+ * vtkThreadedImageWriter vtkThreadedTaskQueue
+ */
+
+#ifndef vtkAsynchronousWriter_h
+#define vtkAsynchronousWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkWriter.h"
+
+#include <functional> // For std::function
+#include <memory>     // For std::unique_ptr
+#include <string>     // For std::string
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOASYNCHRONOUS_EXPORT vtkAsynchronousWriter : public vtkWriter
+{
+public:
+  static vtkAsynchronousWriter* New();
+  vtkTypeMacro(vtkAsynchronousWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/Get the writer used to write the queued snapshots. Changing the
+   * writer waits for all pending writes to complete first.
+   */
+  void SetWriter(vtkAlgorithm* writer);
+  vtkGetObjectMacro(Writer, vtkAlgorithm);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the name of the file the next snapshot is written to. The name
+   * is captured when Write() is called and forwarded to the wrapped writer
+   * when it is a vtkXMLWriterBase, vtkDataWriter or vtkImageWriter. When
+   * not set, the file name configured on the wrapped writer is used.
+   */
+  vtkSetFilePathMacro(FileName);
+  vtkGetFilePathMacro(FileName);
+  ///@}
+
+  enum SnapshotModes
+  {
+    SHALLOW_COPY = 0,
+    DEEP_COPY = 1
+  };
+
+  ///@{
+  /**
+   * Set/Get how the input is copied before being queued. Default is
+   * SHALLOW_COPY.
+   */
+  vtkSetClampMacro(SnapshotMode, int, SHALLOW_COPY, DEEP_COPY);
+  vtkGetMacro(SnapshotMode, int);
+  void SetSnapshotModeToShallowCopy() { this->SetSnapshotMode(SHALLOW_COPY); }
+  void SetSnapshotModeToDeepCopy() { this->SetSnapshotMode(DEEP_COPY); }
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of writes that may be pending at any time.
+   * A value of 0 or less means no limit. Default is 0.
+   */
+  vtkSetMacro(MaximumNumberOfPendingWrites, int);
+  vtkGetMacro(MaximumNumberOfPendingWrites, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum amount of memory, in kibibytes as reported by
+   * vtkDataObject::GetActualMemorySize(), that may be held by pending
+   * snapshots. A value of 0 or less means no limit. Default is 0.
+   */
+  vtkSetMacro(MaximumPendingMemory, vtkTypeInt64);
+  vtkGetMacro(MaximumPendingMemory, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Block until all pending writes are completed.
+   */
+  void Flush();
+
+  /**
+   * Return the number of writes queued or in progress.
+   */
+  int GetNumberOfPendingWrites();
+
+  /**
+   * Return the number of completed writes that reported an error since this
+   * object was created.
+   */
+  vtkTypeInt64 GetNumberOfFailedWrites();
+
+  // We do not use InvokeEvent here because this callback is called from the
+  // I/O thread, which could conflict with events invoked by other threads.
+  // The callback receives the file name given when the write was queued (may
+  // be empty) and whether the write succeeded. It should return quickly.
+  using CompletionCallbackType = std::function<void(const std::string& fileName, bool success)>;
+  void SetCompletionCallback(CompletionCallbackType callback);
+
+protected:
+  vtkAsynchronousWriter();
+  ~vtkAsynchronousWriter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  void WriteData() override;
+
+  vtkAlgorithm* Writer = nullptr;
+  char* FileName = nullptr;
+  int SnapshotMode = SHALLOW_COPY;
+  int MaximumNumberOfPendingWrites = 0;
+  vtkTypeInt64 MaximumPendingMemory = 0;
+
+private:
+  vtkAsynchronousWriter(const vtkAsynchronousWriter&) = delete;
+  void operator=(const vtkAsynchronousWriter&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
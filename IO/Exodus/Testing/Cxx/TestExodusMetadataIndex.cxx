@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that the metadata index of vtkExodusIIReader round-trips a file with
+// node and element maps, and that the reader scans the file again when the
+// index is truncated.
+#include "vtkExodusIIReader.h"
+#include "vtkNew.h"
+#include "vtkTestUtilities.h"
+#include "vtk_exodusII.h"
+
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int ObjectTypes[] = { vtkExodusIIReader::ELEM_BLOCK, vtkExodusIIReader::NODE_MAP,
+  vtkExodusIIReader::ELEM_MAP };
+
+// Write a single hexahedron with two node maps, one element map and one
+// element variable at one time step.
+bool WriteExodusFile(const std::string& fileName)
+{
+  int cpuWordSize = sizeof(double);
+  int ioWordSize = sizeof(double);
+  int exoid = ex_create(fileName.c_str(), EX_CLOBBER, &cpuWordSize, &ioWordSize);
+  if (exoid < 0)
+  {
+    return false;
+  }
+
+  ex_init_params params;
+  std::memset(&params, 0, sizeof(params));
+  std::strcpy(params.title, "maps");
+  params.num_dim = 3;
+  params.num_nodes = 8;
+  params.num_elem = 1;
+  params.num_elem_blk = 1;
+  params.num_node_maps = 2;
+  params.num_elem_maps = 1;
+
+  const double x[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
+  const double y[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
+  const double z[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+  const int connectivity[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  const int nodeMap1[8] = { 11, 12, 13, 14, 15, 16, 17, 18 };
+  const int nodeMap2[8] = { 18, 17, 16, 15, 14, 13, 12, 11 };
+  const int elementMap[1] = { 100 };
+  const double time = 1.0;
+  const double pressure = 2.0;
+
+  bool ok = ex_put_init_ext(exoid, &params) >= 0 && ex_put_coord(exoid, x, y, z) >= 0 &&
+    ex_put_block(exoid, EX_ELEM_BLOCK, 10, "HEX8", 1, 8, 0, 0, 0) >= 0 &&
+    ex_put_conn(exoid, EX_ELEM_BLOCK, 10, connectivity, nullptr, nullptr) >= 0 &&
+    ex_put_num_map(exoid, EX_NODE_MAP, 20, nodeMap1) >= 0 &&
+    ex_put_num_map(exoid, EX_NODE_MAP, 21, nodeMap2) >= 0 &&
+    ex_put_num_map(exoid, EX_ELEM_MAP, 30, elementMap) >= 0 &&
+    ex_put_name(exoid, EX_NODE_MAP, 20, "ascending") >= 0 &&
+    ex_put_name(exoid, EX_NODE_MAP, 21, "descending") >= 0 &&
+    ex_put_name(exoid, EX_ELEM_MAP, 30, "elements") >= 0 &&
+    ex_put_variable_param(exoid, EX_ELEM_BLOCK, 1) >= 0 &&
+    ex_put_variable_name(exoid, EX_ELEM_BLOCK, 1, "pressure") >= 0 &&
+    ex_put_time(exoid, 1, &time) >= 0 &&
+    ex_put_var(exoid, 1, EX_ELEM_BLOCK, 1, 10, 1, &pressure) >= 0;
+  return ex_close(exoid) >= 0 && ok;
+}
+
+void SetUpReader(vtkExodusIIReader* reader, const std::string& fileName, const std::string& index)
+{
+  reader->SetFileName(fileName.c_str());
+  if (!index.empty())
+  {
+    reader->SetMetadataIndexFileName(index.c_str());
+  }
+  reader->UpdateInformation();
+}
+
+bool SameMetadata(vtkExodusIIReader* a, vtkExodusIIReader* b)
+{
+  for (int type : ObjectTypes)
+  {
+    if (a->GetNumberOfObjects(type) != b->GetNumberOfObjects(type))
+    {
+      return false;
+    }
+    for (int obj = 0; obj < a->GetNumberOfObjects(type); ++obj)
+    {
+      if (a->GetObjectId(type, obj) != b->GetObjectId(type, obj) ||
+        std::string(a->GetObjectName(type, obj)) != b->GetObjectName(type, obj))
+      {
+        return false;
+      }
+    }
+  }
+  const int type = vtkExodusIIReader::ELEM_BLOCK;
+  if (a->GetNumberOfObjectArrays(type) != b->GetNumberOfObjectArrays(type))
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfObjectArrays(type); ++i)
+  {
+    if (std::string(a->GetObjectArrayName(type, i)) != b->GetObjectArrayName(type, i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::string> ReadLines(const std::string& fileName)
+{
+  std::vector<std::string> lines;
+  vtksys::ifstream is(fileName.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  while (std::getline(is, line))
+  {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+bool WriteLines(const std::string& fileName, const std::vector<std::string>& lines)
+{
+  vtksys::ofstream os(fileName.c_str(), std::ios::out | std::ios::binary);
+  for (const auto& line : lines)
+  {
+    os << line << '\n';
+  }
+  return static_cast<bool>(os);
+}
+}
+
+int TestExodusMetadataIndex(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestExodusMetadataIndex";
+  delete[] tempDir;
+  const std::string fileName = prefix + ".exo";
+  const std::string indexFileName = prefix + ".vtkexodusindex";
+  vtksys::SystemTools::RemoveFile(indexFileName);
+  if (!::WriteExodusFile(fileName))
+  {
+    cout << "Could not write " << fileName << ".\n";
+    return 1;
+  }
+
+  vtkNew<vtkExodusIIReader> reference;
+  ::SetUpReader(reference, fileName, std::string());
+  if (reference->GetNumberOfObjects(vtkExodusIIReader::NODE_MAP) != 2 ||
+    reference->GetNumberOfObjects(vtkExodusIIReader::ELEM_MAP) != 1 ||
+    reference->GetNumberOfObjectArrays(vtkExodusIIReader::ELEM_BLOCK) != 1)
+  {
+    cout << "Unexpected metadata in the test file.\n";
+    return 1;
+  }
+
+  // The first reader scans the file and writes the index, the second one
+  // reads the metadata back from it.
+  vtkNew<vtkExodusIIReader> writer;
+  ::SetUpReader(writer, fileName, indexFileName);
+  vtkNew<vtkExodusIIReader> indexed;
+  ::SetUpReader(indexed, fileName, indexFileName);
+  if (!::SameMetadata(reference, writer) || !::SameMetadata(reference, indexed))
+  {
+    cout << "Metadata read using the index differs from the one read from the file.\n";
+    return 1;
+  }
+
+  // The element map comes after the node maps in the index: change its id
+  // there, a reader parsing the whole index reports it.
+  std::vector<std::string> lines = ::ReadLines(indexFileName);
+  auto mapIt = std::find(lines.begin(), lines.end(), "1 30");
+  if (lines.empty() || lines[0] != "vtkExodusIIMetadataIndex 2" || mapIt == lines.end())
+  {
+    cout << "Metadata index does not hold the expected header and element map id.\n";
+    return 1;
+  }
+  *mapIt = "1 31";
+  if (!::WriteLines(indexFileName, lines))
+  {
+    cout << "Could not rewrite the metadata index.\n";
+    return 1;
+  }
+  vtkNew<vtkExodusIIReader> modified;
+  ::SetUpReader(modified, fileName, indexFileName);
+  if (modified->GetNumberOfObjects(vtkExodusIIReader::ELEM_MAP) != 1 ||
+    modified->GetObjectId(vtkExodusIIReader::ELEM_MAP, 0) != 31 ||
+    modified->GetNumberOfObjects(vtkExodusIIReader::NODE_MAP) != 2)
+  {
+    cout << "Reader did not take the element map id from the metadata index.\n";
+    return 1;
+  }
+
+  // A truncated index is invalid: the reader scans the file instead, and
+  // replaces the index.
+  for (size_t size : { lines.size() - 1, lines.size() / 2, size_t(3) })
+  {
+    lines.resize(size);
+    if (!::WriteLines(indexFileName, lines))
+    {
+      cout << "Could not truncate the metadata index.\n";
+      return 1;
+    }
+    vtkNew<vtkExodusIIReader> truncated;
+    ::SetUpReader(truncated, fileName, indexFileName);
+    if (!::SameMetadata(reference, truncated))
+    {
+      cout << "Reader did not scan the file when the index has " << size << " lines.\n";
+      return 1;
+    }
+    lines = ::ReadLines(indexFileName);
+    if (std::find(lines.begin(), lines.end(), "1 30") == lines.end())
+    {
+      cout << "Truncated metadata index was not replaced.\n";
+      return 1;
+    }
+  }
+
+  vtkNew<vtkExodusIIReader> reread;
+  ::SetUpReader(reread, fileName, indexFileName);
+  reread->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reread->Update();
+  if (!::SameMetadata(reference, reread))
+  {
+    cout << "Metadata read using the replaced index differs from the file.\n";
+    return 1;
+  }
+
+  vtksys::SystemTools::RemoveFile(indexFileName);
+  vtksys::SystemTools::RemoveFile(fileName);
+  return 0;
+}
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that reading result arrays with several threads, and reading the
+// metadata from a metadata index file, produce the same output as a plain
+// serial read, and that the metadata index holds the ids of the blocks.
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSet.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTesting.h"
+
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool SameArrays(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* aa = a->GetArray(i);
+    vtkDataArray* ba = aa ? b->GetArray(aa->GetName()) : nullptr;
+    if (!aa)
+    {
+      continue;
+    }
+    if (!ba || aa->GetNumberOfTuples() != ba->GetNumberOfTuples() ||
+      aa->GetNumberOfComponents() != ba->GetNumberOfComponents())
+    {
+      return false;
+    }
+    for (vtkIdType t = 0; t < aa->GetNumberOfTuples(); ++t)
+    {
+      for (int c = 0; c < aa->GetNumberOfComponents(); ++c)
+      {
+        if (aa->GetComponent(t, c) != ba->GetComponent(t, c))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkExodusIIReader* a, vtkExodusIIReader* b)
+{
+  auto amb = vtkMultiBlockDataSet::SafeDownCast(a->GetOutputDataObject(0));
+  auto bmb = vtkMultiBlockDataSet::SafeDownCast(b->GetOutputDataObject(0));
+  vtkNew<vtkDataObjectTreeIterator> ait;
+  vtkNew<vtkDataObjectTreeIterator> bit;
+  ait->SetDataSet(amb);
+  bit->SetDataSet(bmb);
+  for (ait->InitTraversal(), bit->InitTraversal(); !ait->IsDoneWithTraversal();
+       ait->GoToNextItem(), bit->GoToNextItem())
+  {
+    if (bit->IsDoneWithTraversal())
+    {
+      return false;
+    }
+    auto ads = vtkDataSet::SafeDownCast(ait->GetCurrentDataObject());
+    auto bds = vtkDataSet::SafeDownCast(bit->GetCurrentDataObject());
+    if (!ads || !bds || ads->GetNumberOfPoints() != bds->GetNumberOfPoints() ||
+      ads->GetNumberOfCells() != bds->GetNumberOfCells() ||
+      !::SameArrays(ads->GetPointData(), bds->GetPointData()) ||
+      !::SameArrays(ads->GetCellData(), bds->GetCellData()))
+    {
+      return false;
+    }
+  }
+  return bit->IsDoneWithTraversal();
+}
+
+// The metadata index stores a list of values as their count followed by the
+// values, on one line.
+std::string IndexLine(vtkExodusIIReader* reader, int objectType)
+{
+  std::ostringstream line;
+  const int numObjects = reader->GetNumberOfObjects(objectType);
+  line << numObjects;
+  for (int obj = 0; obj < numObjects; ++obj)
+  {
+    line << ' ' << reader->GetObjectId(objectType, obj);
+  }
+  return line.str();
+}
+
+std::vector<std::string> ReadLines(const std::string& fileName)
+{
+  std::vector<std::string> lines;
+  vtksys::ifstream is(fileName.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  while (std::getline(is, line))
+  {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+bool WriteLines(const std::string& fileName, const std::vector<std::string>& lines)
+{
+  vtksys::ofstream os(fileName.c_str(), std::ios::out | std::ios::binary);
+  for (const auto& line : lines)
+  {
+    os << line << '\n';
+  }
+  return static_cast<bool>(os);
+}
+
+void SetUpReader(vtkExodusIIReader* reader, const char* fileName, int numberOfThreads,
+  const std::string& indexFileName)
+{
+  reader->SetFileName(fileName);
+  reader->SetNumberOfThreads(numberOfThreads);
+  if (!indexFileName.empty())
+  {
+    reader->SetMetadataIndexFileName(indexFileName.c_str());
+  }
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::GLOBAL, 1);
+  reader->SetTimeStep(10);
+  reader->Update();
+}
+}
+
+int TestExodusThreadedRead(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/can.ex2");
+  if (!fname)
+  {
+    cout << "Could not obtain filename for test data.\n";
+    return 1;
+  }
+
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string indexFileName =
+    std::string(testing->GetTempDirectory()) + "/TestExodusThreadedRead.vtkexodusindex";
+  vtksys::SystemTools::RemoveFile(indexFileName);
+
+  vtkNew<vtkExodusIIReader> serialReader;
+  ::SetUpReader(serialReader, fname, 1, std::string());
+
+  // The first threaded reader scans the file and writes the index.
+  vtkNew<vtkExodusIIReader> threadedReader;
+  ::SetUpReader(threadedReader, fname, 4, indexFileName);
+  if (!vtksys::SystemTools::FileExists(indexFileName, true))
+  {
+    cout << "Metadata index was not written.\n";
+    delete[] fname;
+    return 1;
+  }
+
+  // The second one reads the metadata from the index.
+  vtkNew<vtkExodusIIReader> indexedReader;
+  ::SetUpReader(indexedReader, fname, 4, indexFileName);
+  const std::string fileName = fname;
+  delete[] fname;
+
+  if (!::SameOutput(serialReader, threadedReader))
+  {
+    cout << "Output read with several threads differs from the serial one.\n";
+    return 1;
+  }
+  if (!::SameOutput(serialReader, indexedReader) ||
+    serialReader->GetNumberOfObjects(vtkExodusIIReader::ELEM_BLOCK) !=
+      indexedReader->GetNumberOfObjects(vtkExodusIIReader::ELEM_BLOCK) ||
+    serialReader->GetNumberOfPointResultArrays() != indexedReader->GetNumberOfPointResultArrays())
+  {
+    cout << "Output read using the metadata index differs from the serial one.\n";
+    return 1;
+  }
+
+  // Check what the index holds: its header names the indexed file, and the
+  // element block ids are stored as one line.
+  std::vector<std::string> lines = ::ReadLines(indexFileName);
+  const std::string idsLine = ::IndexLine(serialReader, vtkExodusIIReader::ELEM_BLOCK);
+  auto idsIt = std::find(lines.begin(), lines.end(), idsLine);
+  if (lines.size() < 2 || lines[0] != "vtkExodusIIMetadataIndex 2" ||
+    lines[1] != std::to_string(fileName.size()) + " " + fileName || idsIt == lines.end())
+  {
+    cout << "Metadata index does not hold the expected header and element block ids.\n";
+    return 1;
+  }
+
+  // Shift the element block ids stored in the index: a reader using the
+  // index reports them, while one scanning the file would not.
+  const int numBlocks = serialReader->GetNumberOfObjects(vtkExodusIIReader::ELEM_BLOCK);
+  std::ostringstream shiftedIds;
+  shiftedIds << numBlocks;
+  for (int obj = 0; obj < numBlocks; ++obj)
+  {
+    shiftedIds << ' ' << serialReader->GetObjectId(vtkExodusIIReader::ELEM_BLOCK, obj) + 100;
+  }
+  *idsIt = shiftedIds.str();
+  if (!::WriteLines(indexFileName, lines))
+  {
+    cout << "Could not rewrite the metadata index.\n";
+    return 1;
+  }
+  vtkNew<vtkExodusIIReader> shiftedReader;
+  shiftedReader->SetFileName(fileName.c_str());
+  shiftedReader->SetMetadataIndexFileName(indexFileName.c_str());
+  shiftedReader->UpdateInformation();
+  if (shiftedReader->GetNumberOfObjects(vtkExodusIIReader::ELEM_BLOCK) != numBlocks)
+  {
+    cout << "Reader using the modified index reports a wrong number of blocks.\n";
+    return 1;
+  }
+  for (int obj = 0; obj < numBlocks; ++obj)
+  {
+    if (shiftedReader->GetObjectId(vtkExodusIIReader::ELEM_BLOCK, obj) !=
+      serialReader->GetObjectId(vtkExodusIIReader::ELEM_BLOCK, obj) + 100)
+    {
+      cout << "Reader did not take the element block ids from the metadata index.\n";
+      return 1;
+    }
+  }
+  vtksys::SystemTools::RemoveFile(indexFileName);
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include "vtkLogger.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkMutableDirectedGraph.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -36,12 +37,15 @@
 #include "vtkVariantArray.h"
 #include "vtkXMLParser.h"
 
+#include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtksys/RegularExpression.hxx"
@@ -1576,6 +1580,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
   }
   else
   {
+    std::lock_guard<std::mutex> cacheLock(this->CacheMutex);
     arr = this->Cache->Find(key);
   }
 
@@ -1586,7 +1591,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
   }
 
   int exoid = this->Exoid;
-  int maxNameLength = this->Parent->GetMaxNameLength();
+  int maxNameLength;
+  {
+    std::lock_guard<std::mutex> handleLock(this->HandleMutex);
+    maxNameLength = this->Parent->GetMaxNameLength();
+  }
 
   // If array is nullptr, try reading it from file.
   if (key.ObjectType == vtkExodusIIReader::GLOBAL)
@@ -1627,6 +1636,10 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
     {
       arr->FillComponent(2, 0.);
     }
+    // Result arrays may be read by several threads (see PrefetchResultArrays()),
+    // but the reads are serialized: only the interleaving of the components of
+    // vector and tensor variables below runs concurrently.
+    std::unique_lock<std::mutex> handleLock(this->HandleMutex);
     if (ncomps == 1)
     {
       if (ex_get_var(exoid, key.Time + 1, static_cast<ex_entity_type>(key.ObjectType),
@@ -1657,6 +1670,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
           return nullptr;
         }
       }
+      handleLock.unlock();
       int t;
       std::vector<double> tmpTuple;
       tmpTuple.resize(ncomps);
@@ -1872,6 +1886,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
       arr->SetNumberOfComponents(ainfop->Components);
     }
     arr->SetNumberOfTuples(oinfop->Size);
+    std::unique_lock<std::mutex> handleLock(this->HandleMutex);
     if (ainfop->Components == 1)
     {
       if (ex_get_var(exoid, key.Time + 1, static_cast<ex_entity_type>(key.ObjectType),
@@ -1907,6 +1922,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
           arr = nullptr;
         }
       }
+      handleLock.unlock();
       // Carefully use arr->GetNumberOfComponents() when sizing
       // output as we may have promoted 2-D arrays to 3-D.
       int t = arr->GetNumberOfComponents();
@@ -2885,6 +2901,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
   // GetCacheOrRead(), you better start running!
   if (arr)
   {
+    std::lock_guard<std::mutex> cacheLock(this->CacheMutex);
     this->Cache->Insert(key, arr);
     arr->FastDelete();
   }
@@ -3710,6 +3727,9 @@ void vtkExodusIIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "IgnoreFileTime: " << this->GetIgnoreFileTime() << "\n";
   os << indent << "SILUpdateStamp: " << this->SILUpdateStamp << "\n";
   os << indent << "UseLegacyBlockNames: " << this->UseLegacyBlockNames << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "MetadataIndexFileName: "
+     << (this->MetadataIndexFileName ? this->MetadataIndexFileName : "(none)") << "\n";
   if (this->Metadata)
   {
     os << indent << "Metadata:\n";
@@ -3999,24 +4019,477 @@ void vtkExodusIIReaderPrivate::BuildSIL()
   }
 }
 
+namespace
+{
+// Storage for an array of names filled by the Exodus API.
+class vtkExodusIINameBuffer
+{
+public:
+  vtkExodusIINameBuffer(size_t count, int maxNameLength)
+    : Storage(count, std::vector<char>(maxNameLength + 1, '\0'))
+  {
+    for (auto& name : this->Storage)
+    {
+      this->Pointers.push_back(name.data());
+    }
+  }
+
+  char** Get() { return this->Pointers.empty() ? nullptr : this->Pointers.data(); }
+
+  std::vector<std::string> ToStrings() const
+  {
+    std::vector<std::string> names;
+    names.reserve(this->Storage.size());
+    for (const auto& name : this->Storage)
+    {
+      names.emplace_back(name.data());
+    }
+    return names;
+  }
+
+private:
+  std::vector<std::vector<char>> Storage;
+  std::vector<char*> Pointers;
+};
+
+// Non-const copies of names for the APIs taking char**.
+class vtkExodusIINamePointers
+{
+public:
+  vtkExodusIINamePointers(const std::vector<std::string>& names)
+    : Names(names)
+  {
+    for (auto& name : this->Names)
+    {
+      this->Pointers.push_back(&name[0]);
+    }
+  }
+
+  char** Get() { return this->Pointers.empty() ? nullptr : this->Pointers.data(); }
+
+private:
+  std::vector<std::string> Names;
+  std::vector<char*> Pointers;
+};
+
+// Read the parameters of a block or set, whatever the integer size used by
+// the bulk API of the file.
+template <typename IntType>
+struct vtkExodusIIBlockParameters
+{
+  IntType Values[5] = { 0, 0, 0, 0, 0 };
+
+  std::vector<vtkTypeInt64> ToVector(int count) const
+  {
+    return std::vector<vtkTypeInt64>(this->Values, this->Values + count);
+  }
+};
+
+int vtkExodusIIGetBlockParameters(int exoid, ex_entity_type type, vtkIdType id, char* typeName,
+  std::vector<vtkTypeInt64>& parameters)
+{
+  int status;
+  if (ex_int64_status(exoid) & EX_BULK_INT64_API)
+  {
+    vtkExodusIIBlockParameters<int64_t> p;
+    status = ex_get_block(exoid, type, id, typeName, &p.Values[0], &p.Values[1], &p.Values[2],
+      &p.Values[3], &p.Values[4]);
+    parameters = p.ToVector(5);
+  }
+  else
+  {
+    vtkExodusIIBlockParameters<int> p;
+    status = ex_get_block(exoid, type, id, typeName, &p.Values[0], &p.Values[1], &p.Values[2],
+      &p.Values[3], &p.Values[4]);
+    parameters = p.ToVector(5);
+  }
+  return status;
+}
+
+int vtkExodusIIGetSetParameters(
+  int exoid, ex_entity_type type, vtkIdType id, std::vector<vtkTypeInt64>& parameters)
+{
+  int status;
+  if (ex_int64_status(exoid) & EX_BULK_INT64_API)
+  {
+    vtkExodusIIBlockParameters<int64_t> p;
+    status = ex_get_set_param(exoid, type, id, &p.Values[0], &p.Values[1]);
+    parameters = p.ToVector(2);
+  }
+  else
+  {
+    vtkExodusIIBlockParameters<int> p;
+    status = ex_get_set_param(exoid, type, id, &p.Values[0], &p.Values[1]);
+    parameters = p.ToVector(2);
+  }
+  return status;
+}
+
+// Helpers for the metadata index, a text file made of counts, values and
+// length-prefixed strings.
+const char vtkExodusIIMetadataIndexMagic[] = "vtkExodusIIMetadataIndex";
+const int vtkExodusIIMetadataIndexVersion = 2;
+// Guards against allocating huge buffers when reading a corrupted index.
+const size_t vtkExodusIIMetadataIndexMaxSize = 1 << 28;
+
+void WriteIndexString(ostream& os, const std::string& str)
+{
+  os << str.size() << ' ' << str << '\n';
+}
+
+bool ReadIndexString(istream& is, std::string& str)
+{
+  size_t length;
+  if (!(is >> length) || length > vtkExodusIIMetadataIndexMaxSize || is.get() != ' ')
+  {
+    return false;
+  }
+  str.resize(length);
+  return length == 0 || static_cast<bool>(is.read(&str[0], length));
+}
+
+void WriteIndexStrings(ostream& os, const std::vector<std::string>& strings)
+{
+  os << strings.size() << '\n';
+  for (const auto& str : strings)
+  {
+    WriteIndexString(os, str);
+  }
+}
+
+bool ReadIndexStrings(istream& is, std::vector<std::string>& strings)
+{
+  size_t count;
+  if (!(is >> count) || count > vtkExodusIIMetadataIndexMaxSize)
+  {
+    return false;
+  }
+  strings.resize(count);
+  for (auto& str : strings)
+  {
+    if (!ReadIndexString(is, str))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void WriteIndexValues(ostream& os, const std::vector<T>& values)
+{
+  os << values.size();
+  for (const auto& value : values)
+  {
+    os << ' ' << value;
+  }
+  os << '\n';
+}
+
+template <typename T>
+bool ReadIndexValues(istream& is, std::vector<T>& values)
+{
+  size_t count;
+  if (!(is >> count) || count > vtkExodusIIMetadataIndexMaxSize)
+  {
+    return false;
+  }
+  values.resize(count);
+  for (auto& value : values)
+  {
+    if (!(is >> value))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// What the index is only valid for: the Exodus file and its model parameters.
+std::vector<vtkTypeInt64> GetIndexKey(const ex_init_params& params, vtkIdType numTimeSteps,
+  int maxNameLength, const std::string& fileName)
+{
+  return { static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(fileName)),
+    static_cast<vtkTypeInt64>(vtksys::SystemTools::ModifiedTime(fileName)), maxNameLength,
+    numTimeSteps, params.num_dim, params.num_nodes, params.num_edge, params.num_edge_blk,
+    params.num_face, params.num_face_blk, params.num_elem, params.num_elem_blk,
+    params.num_node_sets, params.num_edge_sets, params.num_face_sets, params.num_side_sets,
+    params.num_elem_sets, params.num_node_maps, params.num_edge_maps, params.num_face_maps,
+    params.num_elem_maps };
+}
+}
+
+//------------------------------------------------------------------------------
+int vtkExodusIIReaderPrivate::ScanMetadata(MetadataIndexType& index)
+{
+  int exoid = this->Exoid;
+  int maxNameLength = this->Parent->GetMaxNameLength();
+  int num_timesteps = static_cast<int>(this->Times.size());
+  int num_vars;
+
+  // Start afresh, index may hold what a failed read of the index file left.
+  index = MetadataIndexType();
+  index.ObjectTypes.resize(num_obj_types);
+  for (int i = 0; i < num_obj_types; ++i)
+  {
+    if (OBJTYPE_IS_NODAL(i))
+    {
+      continue;
+    }
+
+    ObjectTypeMetadataType& meta = index.ObjectTypes[i];
+    vtkIdType nids;
+    VTK_EXO_FUNC(ex_inquire(exoid, obj_sizes[i], &nids, nullptr, nullptr),
+      "Object ID list size could not be determined.");
+    if (nids == 0)
+    {
+      continue;
+    }
+
+    meta.Ids.resize(nids);
+    vtkExodusIINameBuffer obj_names(nids, maxNameLength);
+    VTK_EXO_FUNC(ex_get_ids(exoid, static_cast<ex_entity_type>(obj_types[i]), meta.Ids.data()),
+      "Could not read object ids for i=" << i << " and otyp=" << obj_types[i] << ".");
+    VTK_EXO_FUNC(ex_get_names(exoid, static_cast<ex_entity_type>(obj_types[i]), obj_names.Get()),
+      "Could not read object names.");
+    meta.Names = obj_names.ToStrings();
+
+    if ((OBJTYPE_IS_BLOCK(i)) || (OBJTYPE_IS_SET(i)))
+    {
+      VTK_EXO_FUNC(
+        ex_get_var_param(exoid, obj_typestr[i], &num_vars), "Could not read number of variables.");
+
+      if (num_vars && num_timesteps > 0)
+      {
+        meta.TruthTable.resize(num_vars * nids);
+        VTK_EXO_FUNC(
+          ex_get_var_tab(exoid, obj_typestr[i], nids, num_vars, meta.TruthTable.data()),
+          "Could not read truth table.");
+
+        vtkExodusIINameBuffer var_names(num_vars, maxNameLength);
+        VTK_EXO_FUNC(ex_get_var_names(exoid, obj_typestr[i], num_vars, var_names.Get()),
+          "Could not read variable names.");
+        this->RemoveBeginningAndTrailingSpaces(num_vars, var_names.Get(), maxNameLength);
+        meta.VariableNames = var_names.ToStrings();
+      }
+    }
+
+    if (OBJTYPE_IS_BLOCK(i))
+    {
+      meta.Parameters.resize(nids);
+      meta.AttributeNames.resize(nids);
+      vtkExodusIINameBuffer obj_typenames(nids, maxNameLength);
+      for (vtkIdType obj = 0; obj < nids; ++obj)
+      {
+        VTK_EXO_FUNC(
+          vtkExodusIIGetBlockParameters(exoid, static_cast<ex_entity_type>(obj_types[i]),
+            meta.Ids[obj], obj_typenames.Get()[obj], meta.Parameters[obj]),
+          "Could not read block params.");
+        int numAttributes = static_cast<int>(meta.Parameters[obj][4]);
+        if (numAttributes)
+        {
+          vtkExodusIINameBuffer attr_names(numAttributes, maxNameLength);
+          VTK_EXO_FUNC(ex_get_attr_names(exoid, static_cast<ex_entity_type>(obj_types[i]),
+                         meta.Ids[obj], attr_names.Get()),
+            "Could not read attributes names.");
+          meta.AttributeNames[obj] = attr_names.ToStrings();
+        }
+      }
+      meta.TypeNames = obj_typenames.ToStrings();
+    }
+    else if (OBJTYPE_IS_SET(i))
+    {
+      meta.Parameters.resize(nids);
+      for (vtkIdType obj = 0; obj < nids; ++obj)
+      {
+        VTK_EXO_FUNC(vtkExodusIIGetSetParameters(exoid, static_cast<ex_entity_type>(obj_types[i]),
+                       meta.Ids[obj], meta.Parameters[obj]),
+          "Could not read set parameters.");
+      }
+    }
+  }
+
+  // Now read information for nodal arrays
+  VTK_EXO_FUNC(
+    ex_get_var_param(exoid, "n", &num_vars), "Unable to read number of nodal variables.");
+  if (num_vars > 0)
+  {
+    vtkExodusIINameBuffer var_names(num_vars, maxNameLength);
+    VTK_EXO_FUNC(ex_get_var_names(exoid, "n", num_vars, var_names.Get()),
+      "Could not read nodal variable names.");
+    this->RemoveBeginningAndTrailingSpaces(num_vars, var_names.Get(), maxNameLength);
+    index.NodalVariableNames = var_names.ToStrings();
+  }
+
+  // Now read information for global variables
+  VTK_EXO_FUNC(
+    ex_get_var_param(exoid, "g", &num_vars), "Unable to read number of global variables.");
+  if (num_vars > 0)
+  {
+    vtkExodusIINameBuffer var_names(num_vars, maxNameLength);
+    VTK_EXO_FUNC(ex_get_var_names(exoid, "g", num_vars, var_names.Get()),
+      "Could not read global variable names.");
+    this->RemoveBeginningAndTrailingSpaces(num_vars, var_names.Get(), maxNameLength);
+    index.GlobalVariableNames = var_names.ToStrings();
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkExodusIIReaderPrivate::ReadMetadataIndex(
+  const char* indexFileName, MetadataIndexType& index)
+{
+  vtksys::ifstream is(indexFileName, std::ios::in | std::ios::binary);
+  if (!is)
+  {
+    return false;
+  }
+
+  const std::string fileName = this->Parent->GetFileName();
+  std::string magic, indexedFileName;
+  int version;
+  std::vector<vtkTypeInt64> key;
+  if (!(is >> magic >> version) || magic != vtkExodusIIMetadataIndexMagic ||
+    version != vtkExodusIIMetadataIndexVersion || !ReadIndexString(is, indexedFileName) ||
+    indexedFileName != fileName || !ReadIndexValues(is, key) ||
+    key !=
+      GetIndexKey(this->ModelParameters, static_cast<vtkIdType>(this->Times.size()),
+        this->Parent->GetMaxNameLength(), fileName))
+  {
+    vtkDebugMacro("Metadata index " << indexFileName << " is out of date.");
+    return false;
+  }
+
+  index.ObjectTypes.clear();
+  index.ObjectTypes.resize(num_obj_types);
+  for (auto& meta : index.ObjectTypes)
+  {
+    if (!ReadIndexValues(is, meta.Ids) || !ReadIndexStrings(is, meta.Names) ||
+      !ReadIndexStrings(is, meta.TypeNames) || !ReadIndexStrings(is, meta.VariableNames) ||
+      !ReadIndexValues(is, meta.TruthTable))
+    {
+      return false;
+    }
+    size_t numParameterLists;
+    if (!(is >> numParameterLists) || numParameterLists > meta.Ids.size())
+    {
+      return false;
+    }
+    meta.Parameters.resize(numParameterLists);
+    for (auto& parameters : meta.Parameters)
+    {
+      if (!ReadIndexValues(is, parameters))
+      {
+        return false;
+      }
+    }
+    size_t numAttributeLists;
+    if (!(is >> numAttributeLists) || numAttributeLists > meta.Ids.size())
+    {
+      return false;
+    }
+    meta.AttributeNames.resize(numAttributeLists);
+    for (auto& names : meta.AttributeNames)
+    {
+      if (!ReadIndexStrings(is, names))
+      {
+        return false;
+      }
+    }
+  }
+  if (!ReadIndexStrings(is, index.NodalVariableNames) ||
+    !ReadIndexStrings(is, index.GlobalVariableNames))
+  {
+    return false;
+  }
+
+  // Check that every list has the size ScanMetadata() gives it, so that a
+  // corrupted index cannot make RequestInformation() index out of bounds.
+  // Only blocks have type and attribute names, blocks and sets have
+  // parameters and variables, and maps have neither.
+  char extra;
+  if (is >> extra)
+  {
+    return false;
+  }
+  for (int i = 0; i < num_obj_types; ++i)
+  {
+    const ObjectTypeMetadataType& meta = index.ObjectTypes[i];
+    const bool isBlock = OBJTYPE_IS_BLOCK(i);
+    const bool isSet = OBJTYPE_IS_SET(i);
+    const size_t nids = OBJTYPE_IS_NODAL(i) ? 0 : meta.Ids.size();
+    const size_t numParameters = isBlock ? 5 : (isSet ? 2 : 0);
+    if (meta.Ids.size() != nids || meta.Names.size() != nids ||
+      meta.TypeNames.size() != (isBlock ? nids : 0) ||
+      meta.AttributeNames.size() != (isBlock ? nids : 0) ||
+      meta.Parameters.size() != (isBlock || isSet ? nids : 0) ||
+      (!isBlock && !isSet && !meta.VariableNames.empty()) ||
+      meta.TruthTable.size() != meta.VariableNames.size() * nids)
+    {
+      return false;
+    }
+    for (size_t obj = 0; obj < meta.Parameters.size(); ++obj)
+    {
+      if (meta.Parameters[obj].size() != numParameters ||
+        (isBlock &&
+          meta.AttributeNames[obj].size() != static_cast<size_t>(meta.Parameters[obj][4])))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkExodusIIReaderPrivate::WriteMetadataIndex(
+  const char* indexFileName, const MetadataIndexType& index)
+{
+  vtksys::ofstream os(indexFileName, std::ios::out | std::ios::binary);
+  if (!os)
+  {
+    return false;
+  }
+
+  const std::string fileName = this->Parent->GetFileName();
+  os << vtkExodusIIMetadataIndexMagic << ' ' << vtkExodusIIMetadataIndexVersion << '\n';
+  WriteIndexString(os, fileName);
+  WriteIndexValues(os,
+    GetIndexKey(this->ModelParameters, static_cast<vtkIdType>(this->Times.size()),
+      this->Parent->GetMaxNameLength(), fileName));
+  for (const auto& meta : index.ObjectTypes)
+  {
+    WriteIndexValues(os, meta.Ids);
+    WriteIndexStrings(os, meta.Names);
+    WriteIndexStrings(os, meta.TypeNames);
+    WriteIndexStrings(os, meta.VariableNames);
+    WriteIndexValues(os, meta.TruthTable);
+    os << meta.Parameters.size() << '\n';
+    for (const auto& parameters : meta.Parameters)
+    {
+      WriteIndexValues(os, parameters);
+    }
+    os << meta.AttributeNames.size() << '\n';
+    for (const auto& names : meta.AttributeNames)
+    {
+      WriteIndexStrings(os, names);
+    }
+  }
+  WriteIndexStrings(os, index.NodalVariableNames);
+  WriteIndexStrings(os, index.GlobalVariableNames);
+  return static_cast<bool>(os);
+}
+
 //------------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::RequestInformation()
 {
   int exoid = this->Exoid;
-  // int itmp[5];
-  vtkIdType* ids;
-  vtkIdType nids;
   int obj;
-  int i, j;
   int num_timesteps;
-  char** obj_names;
-  char** obj_typenames = nullptr;
-  char** var_names = nullptr;
-  int have_var_names;
   int num_vars = 0; /* number of variables per object */
   char tmpName[256];
   tmpName[255] = '\0';
-  int maxNameLength = this->Parent->GetMaxNameLength();
 
   this->InformationTimeStamp
     .Modified(); // Update MTime so that it will be newer than parent's FileNameMTime
@@ -4026,73 +4499,41 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 
   VTK_EXO_FUNC(this->UpdateTimeInformation(), "");
 
-  // VTK_EXO_FUNC( ex_inquire( exoid, EX_INQ_TIME,       itmp, 0, 0 ), "Inquire for EX_INQ_TIME
-  // failed" ); num_timesteps = itmp[0];
-
   num_timesteps = static_cast<int>(this->Times.size());
-  /*
-    this->Times.clear();
-    if ( num_timesteps > 0 )
-      {
-      this->Times.resize( num_timesteps );
-      VTK_EXO_FUNC( ex_get_all_times( this->Exoid, this->Times.data() ), "Could not retrieve time
-    values." );
-      }
-  */
-  for (i = 0; i < num_obj_types; ++i)
+
+  // Object ids, names, parameters and variable names come from the metadata
+  // index when it is up to date, otherwise from a scan of the whole file.
+  MetadataIndexType index;
+  const char* indexFileName = this->Parent->GetMetadataIndexFileName();
+  if (!indexFileName || !this->ReadMetadataIndex(indexFileName, index))
+  {
+    if (this->ScanMetadata(index))
+    {
+      return 1;
+    }
+    if (indexFileName && !this->WriteMetadataIndex(indexFileName, index))
+    {
+      vtkWarningMacro("Could not write the metadata index " << indexFileName << ".");
+    }
+  }
+
+  for (int i = 0; i < num_obj_types; ++i)
   {
     if (OBJTYPE_IS_NODAL(i))
     {
       continue;
     }
 
+    const ObjectTypeMetadataType& meta = index.ObjectTypes[i];
     vtkIdType blockEntryFileOffset = 1;
     vtkIdType setEntryFileOffset = 1;
 
     std::map<int, int> sortedObjects;
 
-    int* truth_tab = nullptr;
-    have_var_names = 0;
-
-    VTK_EXO_FUNC(ex_inquire(exoid, obj_sizes[i], &nids, nullptr, nullptr),
-      "Object ID list size could not be determined.");
-
-    if (nids)
-    {
-      ids = (vtkIdType*)malloc(nids * sizeof(vtkIdType));
-      obj_names = (char**)malloc(nids * sizeof(char*));
-      for (obj = 0; obj < nids; ++obj)
-      {
-        obj_names[obj] = (char*)malloc((maxNameLength + 1) * sizeof(char));
-      }
-      if (OBJTYPE_IS_BLOCK(i))
-      {
-        obj_typenames = (char**)malloc(nids * sizeof(char*));
-        for (obj = 0; obj < nids; ++obj)
-        {
-          obj_typenames[obj] = (char*)malloc((maxNameLength + 1) * sizeof(char));
-          obj_typenames[obj][0] = '\0';
-        }
-      }
-    }
-    else
-    {
-      ids = nullptr;
-      obj_names = nullptr;
-      obj_typenames = nullptr;
-    }
-
+    vtkIdType nids = static_cast<vtkIdType>(meta.Ids.size());
     if (nids == 0 && !OBJTYPE_IS_MAP(i))
       continue;
 
-    if (nids)
-    {
-      VTK_EXO_FUNC(ex_get_ids(exoid, static_cast<ex_entity_type>(obj_types[i]), ids),
-        "Could not read object ids for i=" << i << " and otyp=" << obj_types[i] << ".");
-      VTK_EXO_FUNC(ex_get_names(exoid, static_cast<ex_entity_type>(obj_types[i]), obj_names),
-        "Could not read object names.");
-    }
-
     BlockInfoType binfo;
     SetInfoType sinfo;
     MapInfoType minfo;
@@ -4113,58 +4554,32 @@ int vtkExodusIIReaderPrivate::RequestInformation()
       this->MapInfo[obj_types[i]].reserve(nids);
     }
 
-    if ((OBJTYPE_IS_BLOCK(i)) || (OBJTYPE_IS_SET(i)))
-    {
-      VTK_EXO_FUNC(
-        ex_get_var_param(exoid, obj_typestr[i], &num_vars), "Could not read number of variables.");
-
-      if (num_vars && num_timesteps > 0)
-      {
-        truth_tab = (int*)malloc(num_vars * nids * sizeof(int));
-        VTK_EXO_FUNC(ex_get_var_tab(exoid, obj_typestr[i], nids, num_vars, truth_tab),
-          "Could not read truth table.");
-
-        var_names = (char**)malloc(num_vars * sizeof(char*));
-        for (j = 0; j < num_vars; ++j)
-          var_names[j] = (char*)malloc((maxNameLength + 1) * sizeof(char));
-
-        VTK_EXO_FUNC(ex_get_var_names(exoid, obj_typestr[i], num_vars, var_names),
-          "Could not read variable names.");
-        this->RemoveBeginningAndTrailingSpaces(num_vars, var_names, maxNameLength);
-        have_var_names = 1;
-      }
-    }
-
-    if (!have_var_names)
-      var_names = nullptr;
+    num_vars = static_cast<int>(meta.VariableNames.size());
 
     for (obj = 0; obj < nids; ++obj)
     {
+      vtkIdType id = meta.Ids[obj];
 
       if (OBJTYPE_IS_BLOCK(i))
       {
-
-        binfo.Name = obj_names[obj];
-        binfo.Id = ids[obj];
+        const std::vector<vtkTypeInt64>& params = meta.Parameters[obj];
+        binfo.Name = meta.Names[obj];
+        binfo.Id = id;
         binfo.CachedConnectivity = nullptr;
         binfo.NextSqueezePoint = 0;
+        binfo.Size = static_cast<int>(params[0]);
+        binfo.BdsPerEntry[0] = params[1];
+        binfo.BdsPerEntry[1] = params[2];
+        binfo.BdsPerEntry[2] = params[3];
+        binfo.AttributesPerEntry = static_cast<vtkIdType>(params[4]);
+        binfo.TypeName = meta.TypeNames[obj];
         if (obj_types[i] == vtkExodusIIReader::ELEM_BLOCK)
         {
-          VTK_EXO_FUNC(ex_get_block(exoid, static_cast<ex_entity_type>(obj_types[i]), ids[obj],
-                         obj_typenames[obj], &binfo.Size, &binfo.BdsPerEntry[0],
-                         &binfo.BdsPerEntry[1], &binfo.BdsPerEntry[2], &binfo.AttributesPerEntry),
-            "Could not read block params.");
           binfo.Status = 1; // load element blocks by default
-          binfo.TypeName = obj_typenames[obj];
         }
         else
         {
-          VTK_EXO_FUNC(ex_get_block(exoid, static_cast<ex_entity_type>(obj_types[i]), ids[obj],
-                         obj_typenames[obj], &binfo.Size, &binfo.BdsPerEntry[0],
-                         &binfo.BdsPerEntry[1], &binfo.BdsPerEntry[2], &binfo.AttributesPerEntry),
-            "Could not read block params.");
           binfo.Status = 0; // don't load edge/face blocks by default
-          binfo.TypeName = obj_typenames[obj];
           binfo.BdsPerEntry[1] = binfo.BdsPerEntry[2] = 0;
         }
         this->GetInitialObjectStatus(obj_types[i], &binfo);
@@ -4181,14 +4596,14 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 #else
               "Unnamed block ID: %d Type: %s",
 #endif
-              ids[obj], binfo.TypeName.length() ? binfo.TypeName.c_str() : "nullptr");
+              id, binfo.TypeName.length() ? binfo.TypeName.c_str() : "nullptr");
           }
           else
           {
 #ifdef VTK_USE_64BIT_IDS
-            snprintf(tmpName, sizeof(tmpName), "Unnamed block ID: %lld", ids[obj]);
+            snprintf(tmpName, sizeof(tmpName), "Unnamed block ID: %lld", id);
 #else
-            snprintf(tmpName, sizeof(tmpName), "Unnamed block ID: %d", ids[obj]);
+            snprintf(tmpName, sizeof(tmpName), "Unnamed block ID: %d", id);
 #endif
           }
           binfo.Name = tmpName;
@@ -4196,26 +4611,10 @@ int vtkExodusIIReaderPrivate::RequestInformation()
         binfo.OriginalName = binfo.Name;
         this->DetermineVtkCellType(binfo);
 
-        if (binfo.AttributesPerEntry)
+        for (const auto& attributeName : meta.AttributeNames[obj])
         {
-          char** attr_names;
-          attr_names = (char**)malloc(binfo.AttributesPerEntry * sizeof(char*));
-          for (j = 0; j < binfo.AttributesPerEntry; ++j)
-            attr_names[j] = (char*)malloc((maxNameLength + 1) * sizeof(char));
-
-          VTK_EXO_FUNC(ex_get_attr_names(
-                         exoid, static_cast<ex_entity_type>(obj_types[i]), ids[obj], attr_names),
-            "Could not read attributes names.");
-
-          for (j = 0; j < binfo.AttributesPerEntry; ++j)
-          {
-            binfo.AttributeNames.emplace_back(attr_names[j]);
-            binfo.AttributeStatus.push_back(0); // don't load attributes by default
-          }
-
-          for (j = 0; j < binfo.AttributesPerEntry; ++j)
-            free(attr_names[j]);
-          free(attr_names);
+          binfo.AttributeNames.emplace_back(attributeName);
+          binfo.AttributeStatus.push_back(0); // don't load attributes by default
         }
 
         // Check to see if there is metadata that defines what part, material,
@@ -4225,75 +4624,6 @@ int vtkExodusIIReaderPrivate::RequestInformation()
         {
           // Update the block name using the XML.
           binfo.Name = this->Parser->GetBlockName(binfo.Id);
-
-          // int blockIdx = static_cast<int>( this->BlockInfo[obj_types[i]].size() );
-          //// Add this block to our parts, materials, and assemblies collections
-          // unsigned int k;
-          // int found = 0;
-
-          //// Look to see if this part has already been created
-          // for (k=0;k<this->PartInfo.size();k++)
-          //  {
-          //  if (this->PartInfo[k].Name==partName)
-          //    {
-          //    //binfo.PartId = k;
-          //    this->PartInfo[k].BlockIndices.push_back(blockIdx);
-          //    found=1;
-          //    }
-          //  }
-
-          // if (!found)
-          //  {
-          //  PartInfoType pinfo;
-          //  pinfo.Name = partName;
-          //  pinfo.Id = static_cast<int>( this->PartInfo.size() );
-          //  //binfo.PartId = k;
-          //  pinfo.BlockIndices.push_back(blockIdx);
-          //  this->PartInfo.push_back(pinfo);
-          //  }
-          //
-          // found=0;
-          // for (k=0;k<this->MaterialInfo.size();k++)
-          //  {
-          //  if (this->MaterialInfo[k].Name==materialName)
-          //    {
-          //    //binfo.MaterialId = k;
-          //    this->MaterialInfo[k].BlockIndices.push_back(blockIdx);
-          //    found=1;
-          //    }
-          //  }
-          // if (!found)
-          //  {
-          //  MaterialInfoType matinfo;
-          //  matinfo.Name = materialName;
-          //  matinfo.Id = static_cast<int>( this->MaterialInfo.size() );
-          //  //binfo.MaterialId = k;
-          //  matinfo.BlockIndices.push_back(blockIdx);
-          //  this->MaterialInfo.push_back(matinfo);
-          //  }
-          //
-          // for (k=0;k<localAssemblyNames.size();k++)
-          //  {
-          //  std::string assemblyName=localAssemblyNames[k];
-          //  found=0;
-          //  for (unsigned int n=0;n<this->AssemblyInfo.size();n++)
-          //    {
-          //    if (this->AssemblyInfo[n].Name==assemblyName) {
-          //      //binfo.AssemblyIds.push_back(j);
-          //      this->AssemblyInfo[n].BlockIndices.push_back(blockIdx);
-          //      found=1;
-          //      }
-          //    }
-          //  if (!found)
-          //    {
-          //    AssemblyInfoType ainfo;
-          //    ainfo.Name = assemblyName;
-          //    ainfo.Id = static_cast<int>( this->AssemblyInfo.size() );
-          //    //binfo.AssemblyIds.push_back(k);
-          //    ainfo.BlockIndices.push_back(blockIdx);
-          //    this->AssemblyInfo.push_back(ainfo);
-          //    }
-          //  }
         }
 
         sortedObjects[binfo.Id] = static_cast<int>(this->BlockInfo[obj_types[i]].size());
@@ -4301,16 +4631,15 @@ int vtkExodusIIReaderPrivate::RequestInformation()
       }
       else if (OBJTYPE_IS_SET(i))
       {
-
-        sinfo.Name = obj_names[obj];
+        const std::vector<vtkTypeInt64>& params = meta.Parameters[obj];
+        sinfo.Name = meta.Names[obj];
         sinfo.Status = 0;
-        sinfo.Id = ids[obj];
+        sinfo.Id = id;
         sinfo.CachedConnectivity = nullptr;
         sinfo.NextSqueezePoint = 0;
+        sinfo.Size = static_cast<int>(params[0]);
+        sinfo.DistFact = static_cast<int>(params[1]);
 
-        VTK_EXO_FUNC(ex_get_set_param(exoid, static_cast<ex_entity_type>(obj_types[i]), ids[obj],
-                       &sinfo.Size, &sinfo.DistFact),
-          "Could not read set parameters.");
         // num_entries = sinfo.Size;
         sinfo.FileOffset = setEntryFileOffset;
         setEntryFileOffset += sinfo.Size;
@@ -4323,7 +4652,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 #else
             "Unnamed set ID: %d",
 #endif
-            ids[obj]);
+            id);
           sinfo.Name = tmpName;
         }
         sortedObjects[sinfo.Id] = (int)this->SetInfo[obj_types[i]].size();
@@ -4332,7 +4661,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
       else
       { /* object is map */
 
-        minfo.Id = ids[obj];
+        minfo.Id = id;
         minfo.Status = obj == 0 ? 1 : 0; // only load the first map by default
         switch (obj_types[i])
         {
@@ -4351,7 +4680,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
           default:
             minfo.Size = 0;
         }
-        minfo.Name = obj_names[obj];
+        minfo.Name = meta.Names[obj];
         if (minfo.Name.length() == 0)
         {
           snprintf(tmpName, sizeof(tmpName),
@@ -4360,7 +4689,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 #else
             "Unnamed map ID: %d",
 #endif
-            ids[obj]);
+            id);
           minfo.Name = tmpName;
         }
         sortedObjects[minfo.Id] = (int)this->MapInfo[obj_types[i]].size();
@@ -4382,106 +4711,127 @@ int vtkExodusIIReaderPrivate::RequestInformation()
     {
       this->ArrayInfo[obj_types[i]].clear();
       // Fill in ArrayInfo entries, combining array names into vectors/tensors where appropriate:
-      this->GlomArrayNames(obj_types[i], nids, num_vars, var_names, truth_tab);
-    }
-
-    if (var_names)
-    {
-      for (j = 0; j < num_vars; ++j)
-        free(var_names[j]);
-      free(var_names);
-    }
-    if (truth_tab)
-      free(truth_tab);
-
-    if (nids)
-    {
-      free(ids);
-
-      for (obj = 0; obj < nids; ++obj)
-        free(obj_names[obj]);
-      free(obj_names);
-
-      if (OBJTYPE_IS_BLOCK(i))
-      {
-        for (obj = 0; obj < nids; ++obj)
-          free(obj_typenames[obj]);
-        free(obj_typenames);
-      }
+      vtkExodusIINamePointers var_names(meta.VariableNames);
+      std::vector<int> truth_tab(meta.TruthTable);
+      this->GlomArrayNames(obj_types[i], nids, num_vars, var_names.Get(), truth_tab.data());
     }
 
   } // end of loop over all object types
   // this->ComputeGridOffsets();
 
-  // Now read information for nodal arrays
-  VTK_EXO_FUNC(
-    ex_get_var_param(exoid, "n", &num_vars), "Unable to read number of nodal variables.");
+  // Now fill information for nodal arrays
+  num_vars = static_cast<int>(index.NodalVariableNames.size());
   if (num_vars > 0)
   {
-    var_names = (char**)malloc(num_vars * sizeof(char*));
-    for (j = 0; j < num_vars; ++j)
-    {
-      var_names[j] = (char*)malloc((maxNameLength + 1) * sizeof(char));
-    }
-
-    VTK_EXO_FUNC(
-      ex_get_var_names(exoid, "n", num_vars, var_names), "Could not read nodal variable names.");
-    this->RemoveBeginningAndTrailingSpaces(num_vars, var_names, maxNameLength);
+    std::vector<int> dummy_truth(num_vars, 1);
+    vtkExodusIINamePointers var_names(index.NodalVariableNames);
+    this->GlomArrayNames(
+      vtkExodusIIReader::NODAL, 1, num_vars, var_names.Get(), dummy_truth.data());
+  }
 
-    nids = 1;
-    std::vector<int> dummy_truth;
-    dummy_truth.reserve(num_vars);
-    for (j = 0; j < num_vars; ++j)
-    {
-      dummy_truth.push_back(1);
-    }
+  // Now fill information for global variables
+  num_vars = static_cast<int>(index.GlobalVariableNames.size());
+  if (num_vars > 0)
+  {
+    std::vector<int> dummy_truth(num_vars, 1);
+    vtkExodusIINamePointers var_names(index.GlobalVariableNames);
+    this->GlomArrayNames(
+      vtkExodusIIReader::GLOBAL, 1, num_vars, var_names.Get(), dummy_truth.data());
+  }
 
-    this->GlomArrayNames(vtkExodusIIReader::NODAL, nids, num_vars, var_names, dummy_truth.data());
+  return 0;
+}
 
-    for (j = 0; j < num_vars; ++j)
+//------------------------------------------------------------------------------
+double vtkExodusIIReaderPrivate::PrefetchResultArrays(vtkIdType timeStep)
+{
+  // Collect the result arrays that RequestData() is about to assemble,
+  // with the same keys as AssembleOutputPointArrays() and
+  // AssembleOutputCellArrays() use, along with their estimated size in MiB.
+  std::vector<vtkExodusIICacheKey> keys;
+  double size = 0.;
+  bool anyObject = false;
+  for (int conntypidx = 0; conntypidx < num_conn_types; ++conntypidx)
+  {
+    int otypidx = conn_obj_idx_cvt[conntypidx];
+    int otyp = obj_types[otypidx];
+    std::map<int, std::vector<ArrayInfoType>>::iterator ami = this->ArrayInfo.find(otyp);
+    int numObj = this->GetNumberOfObjectsOfType(otyp);
+    for (int obj = 0; obj < numObj; ++obj)
     {
-      free(var_names[j]);
+      BlockSetInfoType* bsinfop = static_cast<BlockSetInfoType*>(this->GetObjectInfo(otypidx, obj));
+      if (!bsinfop->Status)
+      {
+        continue;
+      }
+      anyObject = true;
+      if (ami == this->ArrayInfo.end())
+      {
+        continue;
+      }
+      int aidx = 0;
+      for (auto ai = ami->second.begin(); ai != ami->second.end(); ++ai, ++aidx)
+      {
+        if (ai->Status && ai->ObjectTruth[obj])
+        {
+          keys.emplace_back(timeStep, otyp, obj, aidx);
+          size += static_cast<double>(bsinfop->Size) * ai->Components *
+            vtkDataArray::GetDataTypeSize(ai->StorageType) / 1048576.;
+        }
+      }
     }
-    free(var_names);
-    var_names = nullptr;
   }
-
-  // Now read information for global variables
-  VTK_EXO_FUNC(
-    ex_get_var_param(exoid, "g", &num_vars), "Unable to read number of global variables.");
-  if (num_vars > 0)
+  if (anyObject)
   {
-    var_names = (char**)malloc(num_vars * sizeof(char*));
-    for (j = 0; j < num_vars; ++j)
+    int aidx = 0;
+    for (const auto& ai : this->ArrayInfo[vtkExodusIIReader::NODAL])
     {
-      var_names[j] = (char*)malloc((maxNameLength + 1) * sizeof(char));
+      if (ai.Status)
+      {
+        keys.emplace_back(timeStep, vtkExodusIIReader::NODAL, 0, aidx);
+        size += static_cast<double>(this->ModelParameters.num_nodes) * ai.Components *
+          vtkDataArray::GetDataTypeSize(ai.StorageType) / 1048576.;
+      }
+      ++aidx;
     }
+  }
+  if (keys.size() < 2)
+  {
+    return 0.;
+  }
 
-    VTK_EXO_FUNC(
-      ex_get_var_names(exoid, "g", num_vars, var_names), "Could not read global variable names.");
-    this->RemoveBeginningAndTrailingSpaces(num_vars, var_names, maxNameLength);
-
-    nids = 1;
-    std::vector<int> dummy_truth;
-    dummy_truth.reserve(num_vars);
-    for (j = 0; j < num_vars; ++j)
-    {
-      dummy_truth.push_back(1);
-    }
+  // Make room for all of them so that they are still cached when RequestData()
+  // assembles the output. RequestData() restores the capacity once done.
+  this->Cache->SetCacheCapacity(this->CacheSize + size);
 
-    this->GlomArrayNames(vtkExodusIIReader::GLOBAL, nids, num_vars, var_names, dummy_truth.data());
+  int numberOfThreads = this->Parent->GetNumberOfThreads();
+  if (numberOfThreads <= 0)
+  {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  }
+  numberOfThreads = static_cast<int>(std::min<size_t>(numberOfThreads, keys.size()));
 
-    for (j = 0; j < num_vars; ++j)
+  std::atomic<size_t> next(0);
+  auto worker = [this, &keys, &next]() {
+    for (size_t index = next++; index < keys.size(); index = next++)
     {
-      free(var_names[j]);
+      this->GetCacheOrRead(keys[index]);
     }
-    free(var_names);
-    var_names = nullptr;
+  };
+  std::vector<std::thread> threads;
+  for (int thread = 1; thread < numberOfThreads; ++thread)
+  {
+    threads.emplace_back(worker);
   }
-
-  return 0;
+  worker();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  return size;
 }
 
+//------------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataSet* output)
 {
   // The work done here depends on several conditions:
@@ -4518,6 +4868,14 @@ int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataS
     vtkErrorMacro("You must specify an output mesh");
   }
 
+  // Read the result arrays of all the selected objects concurrently first,
+  // assembling the output then only hits the cache for them.
+  double prefetchedSize = 0.;
+  if (this->Parent->GetNumberOfThreads() != 1)
+  {
+    prefetchedSize = this->PrefetchResultArrays(timeStep);
+  }
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4609,6 +4967,11 @@ int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataS
     }
   }
 
+  if (prefetchedSize > 0.)
+  {
+    this->Cache->SetCacheCapacity(this->CacheSize);
+  }
+
   this->CloseFile();
 
   return 0;
@@ -5329,6 +5692,8 @@ vtkExodusIIReader::vtkExodusIIReader()
   this->DisplayType = 0;
   this->SILUpdateStamp = -1;
   this->UseLegacyBlockNames = false;
+  this->NumberOfThreads = 1;
+  this->MetadataIndexFileName = nullptr;
   this->SetNumberOfInputPorts(0);
 }
 
@@ -5336,6 +5701,7 @@ vtkExodusIIReader::~vtkExodusIIReader()
 {
   this->SetXMLFileName(nullptr);
   this->SetFileName(nullptr);
+  this->SetMetadataIndexFileName(nullptr);
 
   this->SetMetadata(nullptr);
   // this->SetExodusModel( 0 );
@@ -842,6 +842,35 @@ public:
   vtkGetMacro(UseLegacyBlockNames, bool);
   vtkBooleanMacro(UseLegacyBlockNames, bool);
   ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of threads used to read the result variables of the
+   * selected blocks and sets. The Exodus and netCDF libraries do not support
+   * concurrent calls on a file, so the reads themselves are serialized: only
+   * the conversion of the values read (interleaving vector and tensor
+   * components) runs concurrently. Scalar variables are read directly into
+   * their arrays and are not read any faster. A value of 0 or less uses
+   * vtkMultiThreader::GetGlobalDefaultNumberOfThreads(). Default is 1, i.e.
+   * arrays are read as they are assembled into the output.
+   */
+  vtkSetMacro(NumberOfThreads, int);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the name of a metadata index file. When set, the block, set and
+   * map ids, names and parameters and the variable names found when scanning
+   * the Exodus file are saved to this file, and later reads of the same,
+   * unmodified Exodus file load them from it instead of scanning the file
+   * again. The index is ignored and rewritten when it was written for another
+   * file, or when the Exodus file size, modification time or model parameters
+   * changed. Default is nullptr, i.e. no index.
+   */
+  vtkSetFilePathMacro(MetadataIndexFileName);
+  vtkGetFilePathMacro(MetadataIndexFileName);
+  ///@}
 protected:
   vtkExodusIIReader();
   ~vtkExodusIIReader() override;
@@ -904,6 +933,8 @@ private:
   int ModeShapesRange[2];
 
   bool UseLegacyBlockNames;
+  int NumberOfThreads;
+  char* MetadataIndexFileName;
 };
 
 VTK_ABI_NAMESPACE_END
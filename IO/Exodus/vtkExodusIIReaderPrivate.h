@@ -13,6 +13,8 @@
 #include "vtksys/RegularExpression.hxx" // for vtksys::RegularExpression
 
 #include <map>    // for std::map
+#include <mutex>  // for std::mutex
+#include <string> // for std::string
 #include <vector> // for std::vector
 
 #include "vtkIOExodusModule.h" // For export macro
@@ -414,6 +416,39 @@ public:
     Generated = 3  //!< The array is procedurally generated (e.g., BlockId)
   };
 
+  /** Object ids, names, parameters and variable names of one object type
+   * (EX_ELEM_BLOCK, EX_NODE_SET, ...) as read from the file, before any
+   * processing by RequestInformation().
+   */
+  struct ObjectTypeMetadataType
+  {
+    std::vector<vtkIdType> Ids;
+    std::vector<std::string> Names;
+    /// Element type of each block (blocks only).
+    std::vector<std::string> TypeNames;
+    /** For blocks: number of entries, nodes, edges and faces per entry, and
+     * attributes per entry. For sets: number of entries and distribution
+     * factors.
+     */
+    std::vector<std::vector<vtkTypeInt64>> Parameters;
+    /// Attribute names of each block (blocks only).
+    std::vector<std::vector<std::string>> AttributeNames;
+    std::vector<std::string> VariableNames;
+    /// Truth table, Ids.size() rows of VariableNames.size() entries.
+    std::vector<int> TruthTable;
+  };
+
+  /** Everything RequestInformation() reads from the file apart from the
+   * model parameters and time values. This is what the metadata index stores.
+   */
+  struct MetadataIndexType
+  {
+    /// One entry per object type, in the order of obj_types.
+    std::vector<ObjectTypeMetadataType> ObjectTypes;
+    std::vector<std::string> NodalVariableNames;
+    std::vector<std::string> GlobalVariableNames;
+  };
+
   /// Time stamp from last time we were in RequestInformation
   vtkTimeStamp InformationTimeStamp;
 
@@ -522,6 +557,29 @@ protected:
   /// Add generated array information to array info lists.
   void PrepareGeneratedArrayInfo();
 
+  /// Read the metadata used by RequestInformation() from the open file.
+  /// Returns 0 on success.
+  int ScanMetadata(MetadataIndexType& index);
+
+  /** Read the metadata index stored in \a indexFileName. Returns false if the
+   * index cannot be read or was not written for the current version of the
+   * open file, in which case the file has to be scanned.
+   */
+  bool ReadMetadataIndex(const char* indexFileName, MetadataIndexType& index);
+
+  /// Write the metadata index of the open file to \a indexFileName.
+  bool WriteMetadataIndex(const char* indexFileName, const MetadataIndexType& index);
+
+  /** Read the result arrays RequestData() is about to assemble for the given
+   * time step into the cache, using the number of threads set on the parent
+   * reader. Calls into the Exodus library are serialized by HandleMutex, so
+   * the reads gain nothing from the threads; only the interleaving of vector
+   * and tensor components and the cache insertions run concurrently.
+   * Returns the amount of memory, in MiB, the cache was enlarged by to hold
+   * the prefetched arrays.
+   */
+  double PrefetchResultArrays(vtkIdType timeStep);
+
   /** Read connectivity information and populate an unstructured grid with cells corresponding to a
    * single block or set.
    *
@@ -813,6 +871,12 @@ protected:
 
   /// A least-recently-used cache to hold raw arrays.
   vtkExodusIICache* Cache;
+  /// Protects Cache while result arrays are prefetched.
+  std::mutex CacheMutex;
+  /** Serializes calls into the Exodus library while result arrays are
+   * prefetched: neither it nor netCDF may be called concurrently on a handle.
+   */
+  std::mutex HandleMutex;
   //
   /// The size of the cache in MiB.
   double CacheSize;
@@ -144,7 +144,16 @@ int TestDataSet(vtkDataSet* data, vtkDataSet* expectedData, bool includeFieldDat
 
       using Dispatcher = vtkArrayDispatch::Dispatch2;
       ArrayTypeTester tester;
-      Dispatcher::Execute(array, expectedArray, tester);
+      if (!Dispatcher::Execute(array, expectedArray, tester))
+      {
+        // arrays outside of the dispatch list, such as lazy arrays
+        auto isReal = [](vtkDataArray* a) {
+          return a->GetDataType() == VTK_FLOAT || a->GetDataType() == VTK_DOUBLE;
+        };
+        tester.ArraysArePointerCompatible =
+          array->GetDataTypeSize() == expectedArray->GetDataTypeSize() &&
+          isReal(array) == isReal(expectedArray);
+      }
       if (!tester.ArraysArePointerCompatible)
       {
         vtkLog(ERROR,
@@ -179,7 +188,26 @@ int TestDataSet(vtkDataSet* data, vtkDataSet* expectedData, bool includeFieldDat
   return EXIT_SUCCESS;
 }
 
-int TestImageData(const std::string& dataRoot)
+bool TestArraysNotLoaded(vtkDataSet* data)
+{
+  for (int attributeType = 0; attributeType < vtkDataObject::FIELD; ++attributeType)
+  {
+    vtkDataSetAttributes* attributes = data->GetAttributes(attributeType);
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+    {
+      // lazy arrays hold no memory until they are loaded
+      if (attributes->GetArray(i)->GetActualMemorySize() != 0)
+      {
+        std::cerr << "Error: array " << attributes->GetArray(i)->GetName()
+                  << " loaded before being accessed" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int TestImageData(const std::string& dataRoot, bool lazyArrays = false)
 {
   // ImageData file
   // ------------------------------------------------------------
@@ -191,8 +219,13 @@ int TestImageData(const std::string& dataRoot)
     return EXIT_FAILURE;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetLazyArrays(lazyArrays);
   reader->Update();
   vtkImageData* data = vtkImageData::SafeDownCast(reader->GetOutput());
+  if (lazyArrays && !TestArraysNotLoaded(data))
+  {
+    return EXIT_FAILURE;
+  }
   vtkSmartPointer<vtkImageData> expectedData = ReadImageData(dataRoot + "/Data/mandelbrot.vti");
 
   int* dims = data->GetDimensions();
@@ -210,7 +243,7 @@ int TestImageData(const std::string& dataRoot)
   return TestDataSet(data, expectedData, true);
 }
 
-int TestImageCellData(const std::string& dataRoot)
+int TestImageCellData(const std::string& dataRoot, bool lazyArrays = false)
 {
   // ImageData file with cell data
   // ------------------------------------------------------------
@@ -222,8 +255,13 @@ int TestImageCellData(const std::string& dataRoot)
     return EXIT_FAILURE;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetLazyArrays(lazyArrays);
   reader->Update();
   vtkImageData* data = vtkImageData::SafeDownCast(reader->GetOutput());
+  if (lazyArrays && !TestArraysNotLoaded(data))
+  {
+    return EXIT_FAILURE;
+  }
   vtkSmartPointer<vtkImageData> expectedData =
     ReadImageData(dataRoot + "/Data/wavelet_cell_data.vti");
 
@@ -370,6 +408,12 @@ int TestHDFReader(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  if (TestImageData(dataRoot, true /*lazyArrays*/) ||
+    TestImageCellData(dataRoot, true /*lazyArrays*/))
+  {
+    return EXIT_FAILURE;
+  }
+
   if (TestUnstructuredGrid<false /*parallel*/>(dataRoot))
   {
     return EXIT_FAILURE;
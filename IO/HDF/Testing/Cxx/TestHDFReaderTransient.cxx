@@ -34,9 +34,10 @@ struct OpenerWorklet;
 struct CheckerWorklet;
 
 // assemblies
-int TestUGTransient(const std::string& dataRoot);
-int TestImageDataTransient(const std::string& dataRoot);
-int TestPolyDataTransient(const std::string& dataRoot);
+int TestUGTransient(const std::string& dataRoot, bool useCache);
+int TestImageDataTransient(const std::string& dataRoot, bool useCache);
+int TestPolyDataTransient(const std::string& dataRoot, bool useCache);
+int TestCacheAndPrefetch(const std::string& dataRoot);
 }
 
 int TestHDFReaderTransient(int argc, char* argv[])
@@ -44,9 +45,15 @@ int TestHDFReaderTransient(int argc, char* argv[])
   vtkNew<vtkTesting> testUtils;
   testUtils->AddArguments(argc, argv);
   std::string dataRoot = testUtils->GetDataRoot();
-  int res = ::TestUGTransient(dataRoot);
-  res |= ::TestImageDataTransient(dataRoot);
-  res |= ::TestPolyDataTransient(dataRoot);
+  int res = EXIT_SUCCESS;
+  // Read without and with the array cache and step prefetching
+  for (bool useCache : { false, true })
+  {
+    res |= ::TestUGTransient(dataRoot, useCache);
+    res |= ::TestImageDataTransient(dataRoot, useCache);
+    res |= ::TestPolyDataTransient(dataRoot, useCache);
+  }
+  res |= ::TestCacheAndPrefetch(dataRoot);
   return res;
 }
 
@@ -62,9 +69,11 @@ double Sin11T(double time, const Vec& point)
 struct OpenerWorklet
 {
 public:
-  OpenerWorklet(const std::string& filePath)
+  OpenerWorklet(const std::string& filePath, bool useCache)
   {
     this->Reader->SetFileName(filePath.c_str());
+    this->Reader->SetUseCache(useCache);
+    this->Reader->SetNumberOfStepsToPrefetch(useCache ? 2 : 0);
     this->Reader->Update();
   }
 
@@ -244,9 +253,9 @@ bool GeometryCheckerWorklet::operator()(vtkPolyData* lhs, vtkPolyData* rhs)
   return true;
 }
 
-int TestUGTransient(const std::string& dataRoot)
+int TestUGTransient(const std::string& dataRoot, bool useCache)
 {
-  OpenerWorklet opener(dataRoot + "/Data/transient_sphere.hdf");
+  OpenerWorklet opener(dataRoot + "/Data/transient_sphere.hdf", useCache);
 
   // Generic Time data checks
   if (opener.GetReader()->GetNumberOfSteps() != 10)
@@ -341,9 +350,9 @@ int TestUGTransient(const std::string& dataRoot)
   return EXIT_SUCCESS;
 }
 
-int TestImageDataTransient(const std::string& dataRoot)
+int TestImageDataTransient(const std::string& dataRoot, bool useCache)
 {
-  OpenerWorklet opener(dataRoot + "/Data/transient_wavelet.hdf");
+  OpenerWorklet opener(dataRoot + "/Data/transient_wavelet.hdf", useCache);
 
   // Generic Time data checks
   if (opener.GetReader()->GetNumberOfSteps() != 10)
@@ -436,9 +445,9 @@ int TestImageDataTransient(const std::string& dataRoot)
   return EXIT_SUCCESS;
 }
 
-int TestPolyDataTransient(const std::string& dataRoot)
+int TestPolyDataTransient(const std::string& dataRoot, bool useCache)
 {
-  OpenerWorklet opener(dataRoot + "/Data/test_transient_poly_data.hdf");
+  OpenerWorklet opener(dataRoot + "/Data/test_transient_poly_data.hdf", useCache);
 
   // Generic Time data checks
   if (opener.GetReader()->GetNumberOfSteps() != 10)
@@ -533,4 +542,75 @@ int TestPolyDataTransient(const std::string& dataRoot)
   return EXIT_SUCCESS;
 }
 
+int TestCacheAndPrefetch(const std::string& dataRoot)
+{
+  const std::string fileName = dataRoot + "/Data/transient_wavelet.hdf";
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UseCacheOn();
+  reader->SetStep(0);
+  reader->Update();
+  const vtkIdType misses = reader->GetNumberOfCacheMisses();
+  const vtkIdType hits = reader->GetNumberOfCacheHits();
+  vtkSmartPointer<vtkDataArray> first = reader->GetOutputAsDataSet()->GetPointData()->GetArray(0);
+  if (misses == 0 || !first)
+  {
+    std::cout << "Cache: first read did not go through the cache" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Reading the same step again only hits the cache, and hands out a new array
+  // sharing the cached memory that the pipeline may not overwrite.
+  reader->Modified();
+  reader->Update();
+  vtkDataArray* second = reader->GetOutputAsDataSet()->GetPointData()->GetArray(0);
+  if (reader->GetNumberOfCacheMisses() != misses ||
+    reader->GetNumberOfCacheHits() != 2 * hits + misses)
+  {
+    std::cout << "Cache: second read of step 0 was not served from the cache (" << misses << " "
+              << hits << " -> " << reader->GetNumberOfCacheMisses() << " "
+              << reader->GetNumberOfCacheHits() << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!second || second == first || second->GetVoidPointer(0) != first->GetVoidPointer(0) ||
+    second->IsMemoryExclusivelyOwned())
+  {
+    std::cout << "Cache: cached array was not handed out as a shallow copy" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Steps prefetched after reading step 0 are read without any cache miss,
+  // the next one is not in the cache.
+  vtkNew<vtkHDFReader> prefetching;
+  prefetching->SetFileName(fileName.c_str());
+  prefetching->UseCacheOn();
+  prefetching->SetNumberOfStepsToPrefetch(2);
+  prefetching->SetStep(0);
+  prefetching->Update();
+  prefetching->WaitForPrefetchedSteps();
+  prefetching->SetNumberOfStepsToPrefetch(0);
+  const vtkIdType prefetchedMisses = prefetching->GetNumberOfCacheMisses();
+  const vtkIdType prefetchedHits = prefetching->GetNumberOfCacheHits();
+  for (int step : { 1, 2 })
+  {
+    prefetching->SetStep(step);
+    prefetching->Update();
+  }
+  if (prefetching->GetNumberOfCacheMisses() != prefetchedMisses ||
+    prefetching->GetNumberOfCacheHits() <= prefetchedHits)
+  {
+    std::cout << "Prefetch: steps 1 and 2 were not prefetched" << std::endl;
+    return EXIT_FAILURE;
+  }
+  prefetching->SetStep(3);
+  prefetching->Update();
+  if (prefetching->GetNumberOfCacheMisses() == prefetchedMisses)
+  {
+    std::cout << "Prefetch: step 3 should not have been prefetched" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
 }
@@ -15,6 +15,7 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLazyArray.h"
 #include "vtkMatrix3x3.h"
 #include "vtkObjectFactory.h"
 #include "vtkOverlappingAMR.h"
@@ -30,17 +31,141 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <locale>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkHDFReader);
 
+//----------------------------------------------------------------------------
+/**
+ * Reads time steps in the background with a second reader sharing the
+ * array cache of the main reader. Only the arrays put in the cache are of
+ * interest, the outputs of the second reader are discarded.
+ */
+class vtkHDFReader::Prefetcher
+{
+public:
+  Prefetcher()
+    : Reader(vtkSmartPointer<vtkHDFReader>::New())
+  {
+    this->Thread = std::thread(&Prefetcher::Run, this);
+  }
+
+  ~Prefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+      this->Times.clear();
+    }
+    this->CV.notify_all();
+    this->Thread.join();
+  }
+
+  /**
+   * Drops the steps that are not read yet and waits for the step being read.
+   * Must not be called while holding the I/O mutex of the cache.
+   */
+  void Cancel()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Times.clear();
+    this->CV.wait(lock, [this] { return !this->Busy; });
+  }
+
+  /**
+   * Waits until all the scheduled steps are read.
+   */
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->CV.wait(lock, [this] { return this->Times.empty() && !this->Busy; });
+  }
+
+  /**
+   * Queues the given time values for reading. Cancel() must have been
+   * called before reconfiguring the reader.
+   */
+  void Schedule(std::deque<double>&& times)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Times = std::move(times);
+    }
+    this->CV.notify_all();
+  }
+
+  vtkSmartPointer<vtkHDFReader> Reader;
+  int Piece = -1;
+  int NumberOfPieces = 1;
+  int GhostLevels = 0;
+  std::array<int, 6> Extent;
+  bool HasExtent = false;
+
+private:
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->CV.wait(lock, [this] { return this->Done || !this->Times.empty(); });
+      if (this->Done)
+      {
+        break;
+      }
+      double time = this->Times.front();
+      this->Times.pop_front();
+      this->Busy = true;
+      lock.unlock();
+      this->Reader->UpdateTimeStep(time, this->Piece, this->NumberOfPieces, this->GhostLevels,
+        this->HasExtent ? this->Extent.data() : nullptr);
+      lock.lock();
+      this->Busy = false;
+      this->CV.notify_all();
+    }
+  }
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable CV;
+  std::deque<double> Times;
+  bool Busy = false;
+  bool Done = false;
+};
+
 namespace
 {
+//----------------------------------------------------------------------------
+/**
+ * Serializes the HDF5 calls of the readers with the ones of the lazy arrays
+ * they published, which may be loaded from any thread at any time.
+ */
+std::mutex& GetLazyArraysMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+vtkDataArray* NewLazyArray(const std::function<vtkSmartPointer<vtkDataArray>()>& loader,
+  vtkIdType numberOfTuples, int numberOfComponents)
+{
+  vtkLazyArray<ValueType>* array = vtkLazyArray<ValueType>::New();
+  array->ConstructBackend(loader, numberOfTuples, numberOfComponents);
+  array->SetNumberOfComponents(numberOfComponents);
+  array->SetNumberOfTuples(numberOfTuples);
+  return array;
+}
+
 //----------------------------------------------------------------------------
 constexpr std::size_t NUM_POLY_DATA_TOPOS = 4;
 const std::vector<std::string> POLY_DATA_TOPOS{ "Vertices", "Lines", "Polygons", "Strips" };
@@ -204,7 +329,18 @@ vtkHDFReader::vtkHDFReader()
 //----------------------------------------------------------------------------
 vtkHDFReader::~vtkHDFReader()
 {
-  delete this->Impl;
+  this->StepPrefetcher.reset();
+  {
+    // closing the file calls HDF5, which lazy arrays and the readers sharing
+    // the cache may use from other threads
+    std::unique_lock<std::mutex> ioLock;
+    if (this->Cache)
+    {
+      ioLock = std::unique_lock<std::mutex>(this->Cache->IOMutex);
+    }
+    std::lock_guard<std::mutex> lock(::GetLazyArraysMutex());
+    delete this->Impl;
+  }
   this->SetFileName(nullptr);
   for (int i = 0; i < vtkHDFReader::GetNumberOfAttributeTypes(); ++i)
   {
@@ -228,6 +364,10 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "UseCache: " << (this->UseCache ? "true" : "false") << "\n";
+  os << indent << "MaximumCacheSize: " << this->MaximumCacheSize << "\n";
+  os << indent << "NumberOfStepsToPrefetch: " << this->NumberOfStepsToPrefetch << "\n";
+  os << indent << "LazyArrays: " << (this->LazyArrays ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -262,6 +402,12 @@ int vtkHDFReader::CanReadFile(const char* name)
     vtkErrorMacro("File does not exist: " << name);
     return 0;
   }
+  std::unique_lock<std::mutex> ioLock;
+  if (this->Cache)
+  {
+    ioLock = std::unique_lock<std::mutex>(this->Cache->IOMutex);
+  }
+  std::unique_lock<std::mutex> lazyArraysLock(::GetLazyArraysMutex());
   if (!this->Impl->Open(name))
   {
     return 0;
@@ -335,6 +481,12 @@ int vtkHDFReader::RequestDataObject(vtkInformation*, vtkInformationVector** vtkN
     return 0;
   }
 
+  std::unique_lock<std::mutex> ioLock;
+  if (this->Cache)
+  {
+    ioLock = std::unique_lock<std::mutex>(this->Cache->IOMutex);
+  }
+  std::unique_lock<std::mutex> lazyArraysLock(::GetLazyArraysMutex());
   if (!this->Impl->Open(this->FileName))
   {
     return 0;
@@ -398,6 +550,14 @@ int vtkHDFReader::RequestInformation(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro("Requires valid input file name");
     return 0;
   }
+  // the step values are read here, through the cache once it is enabled.
+  this->UpdateCacheSettings();
+  std::unique_lock<std::mutex> ioLock;
+  if (this->Cache)
+  {
+    ioLock = std::unique_lock<std::mutex>(this->Cache->IOMutex);
+  }
+  std::unique_lock<std::mutex> lazyArraysLock(::GetLazyArraysMutex());
   // Ensures a new file is open. This happen for vtkFileSeriesReader
   // which does not call RequestDataObject for every time step.
   if (!this->Impl->Open(this->FileName))
@@ -552,8 +712,40 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
           // Add one to the extent for the time dimension if needed
           fileExtent[1] += 1;
         }
-        if ((array = vtk::TakeSmartPointer(
-               this->Impl->NewArray(attributeType, name.c_str(), fileExtent))) == nullptr)
+        if (this->LazyArrays)
+        {
+          // only the metadata is read now, the loader opens the file again
+          int dataType = -1;
+          vtkIdType numberOfTuples = 0;
+          int numberOfComponents = 0;
+          if (this->Impl->GetArrayInformation(attributeType, name.c_str(), fileExtent, dataType,
+                numberOfTuples, numberOfComponents))
+          {
+            const std::string fileName = this->FileName;
+            auto loader = [fileName, attributeType, name, fileExtent]() {
+              std::lock_guard<std::mutex> lock(::GetLazyArraysMutex());
+              vtkHDFReader::Implementation impl(nullptr);
+              vtkSmartPointer<vtkDataArray> loaded;
+              if (impl.Open(fileName.c_str()))
+              {
+                loaded =
+                  vtk::TakeSmartPointer(impl.NewArray(attributeType, name.c_str(), fileExtent));
+              }
+              return loaded;
+            };
+            switch (dataType)
+            {
+              vtkTemplateMacro(array = vtk::TakeSmartPointer(::NewLazyArray<VTK_TT>(
+                                 loader, numberOfTuples, numberOfComponents)));
+            }
+          }
+        }
+        else
+        {
+          array =
+            vtk::TakeSmartPointer(this->Impl->NewArray(attributeType, name.c_str(), fileExtent));
+        }
+        if (!array)
         {
           vtkErrorMacro("Error reading array " << name);
           return 0;
@@ -946,6 +1138,19 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
   {
     return 0;
   }
+  this->UpdateCacheSettings();
+  if (this->StepPrefetcher)
+  {
+    // the steps being prefetched may not be needed anymore, the one being
+    // read will be in the cache.
+    this->StepPrefetcher->Cancel();
+  }
+  std::unique_lock<std::mutex> ioLock;
+  if (this->Cache)
+  {
+    ioLock = std::unique_lock<std::mutex>(this->Cache->IOMutex);
+  }
+  std::unique_lock<std::mutex> lazyArraysLock(::GetLazyArraysMutex());
   if (this->HasTransientData)
   {
     double* values = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
@@ -987,6 +1192,112 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro("HDF dataset type unknown: " << dataSetType);
     return 0;
   }
-  return ok && this->AddFieldArrays(output);
+  ok = ok && this->AddFieldArrays(output);
+  lazyArraysLock.unlock();
+  if (ioLock.owns_lock())
+  {
+    ioLock.unlock();
+  }
+  if (ok)
+  {
+    this->PrefetchNextSteps(outInfo);
+  }
+  return ok;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::UpdateCacheSettings()
+{
+  if (!this->UseCache && this->NumberOfStepsToPrefetch <= 0)
+  {
+    this->StepPrefetcher.reset();
+    this->Cache.reset();
+    this->Impl->SetCache(nullptr);
+    return;
+  }
+  if (!this->Cache)
+  {
+    this->Cache = std::make_shared<ArrayCache>();
+    this->Impl->SetCache(this->Cache);
+  }
+  this->Cache->SetMaximumSize(this->MaximumCacheSize);
+  if (this->NumberOfStepsToPrefetch <= 0)
+  {
+    this->StepPrefetcher.reset();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::WaitForPrefetchedSteps()
+{
+  if (this->StepPrefetcher)
+  {
+    this->StepPrefetcher->Wait();
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkHDFReader::GetNumberOfCacheHits()
+{
+  return this->Cache ? this->Cache->GetNumberOfHits() : 0;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkHDFReader::GetNumberOfCacheMisses()
+{
+  return this->Cache ? this->Cache->GetNumberOfMisses() : 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::PrefetchNextSteps(vtkInformation* outInfo)
+{
+  if (!this->HasTransientData || this->NumberOfStepsToPrefetch <= 0 ||
+    this->Step + 1 >= this->NumberOfSteps)
+  {
+    return;
+  }
+  if (!this->StepPrefetcher)
+  {
+    this->StepPrefetcher.reset(new Prefetcher());
+  }
+  Prefetcher* prefetcher = this->StepPrefetcher.get();
+  prefetcher->Cancel();
+
+  // mirror the configuration of this reader
+  vtkHDFReader* reader = prefetcher->Reader;
+  reader->SetFileName(this->FileName);
+  reader->SetMaximumLevelsToReadByDefaultForAMR(this->MaximumLevelsToReadByDefaultForAMR);
+  for (int i = 0; i < vtkHDFReader::GetNumberOfAttributeTypes(); ++i)
+  {
+    reader->DataArraySelection[i]->CopySelections(this->DataArraySelection[i]);
+  }
+  reader->UseCache = true;
+  reader->MaximumCacheSize = this->MaximumCacheSize;
+  if (reader->Cache != this->Cache)
+  {
+    reader->Cache = this->Cache;
+    reader->Impl->SetCache(this->Cache);
+  }
+
+  prefetcher->Piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  prefetcher->NumberOfPieces =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  prefetcher->GhostLevels =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  prefetcher->HasExtent = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) != 0;
+  if (prefetcher->HasExtent)
+  {
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), prefetcher->Extent.data());
+  }
+
+  double* values = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  std::deque<double> times;
+  vtkIdType lastStep =
+    std::min(this->NumberOfSteps - 1, this->Step + this->NumberOfStepsToPrefetch);
+  for (vtkIdType step = this->Step + 1; step <= lastStep; ++step)
+  {
+    times.push_back(values[step]);
+  }
+  prefetcher->Schedule(std::move(times));
 }
 VTK_ABI_NAMESPACE_END
@@ -12,6 +12,7 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkIOHDFModule.h" // For export macro
 #include <array>            // For storing the time range
+#include <memory>           // For std::shared_ptr
 #include <vector>           // For storing list of values
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -121,6 +122,80 @@ public:
   vtkSetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
   vtkGetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
 
+  ///@{
+  /**
+   * Enable caching of the arrays read from the file. Arrays are cached
+   * with their offsets in the file, so that arrays shared by several time
+   * steps, such as a static geometry and topology, are read only once when
+   * changing the time step. The outputs of the reader get shallow copies of
+   * the cached arrays, which share their values but are never overwritten in
+   * place by downstream filters, and the least recently used arrays are
+   * discarded once the cache exceeds MaximumCacheSize. Field data arrays are
+   * never cached. Default is false.
+   */
+  vtkSetMacro(UseCache, bool);
+  vtkGetMacro(UseCache, bool);
+  vtkBooleanMacro(UseCache, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum size of the cache in kibibytes. Default is 1048576 (1 GiB).
+   */
+  vtkSetClampMacro(MaximumCacheSize, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(MaximumCacheSize, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * For transient data, number of time steps following the one that was
+   * just read to read in the background into the cache, in anticipation of
+   * an animation playback. Setting a non zero value implies UseCache.
+   *
+   * The prefetching uses a second file handle on a background thread. Since
+   * the HDF5 library is not thread safe, HDF5 calls of this reader and of its
+   * prefetching thread are serialized, but the application must not use
+   * HDF5 through other objects while steps are prefetched. Default is 0.
+   */
+  vtkSetClampMacro(NumberOfStepsToPrefetch, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfStepsToPrefetch, int);
+  ///@}
+
+  /**
+   * Block until the time steps scheduled for prefetching by the last update
+   * are in the cache. Does nothing when no step is prefetched.
+   */
+  void WaitForPrefetchedSteps();
+
+  ///@{
+  /**
+   * Number of arrays found in the cache, and of arrays read from the file
+   * into the cache, by this reader and its prefetching thread since the
+   * cache was created. Both are 0 when no cache is used.
+   */
+  vtkIdType GetNumberOfCacheHits();
+  vtkIdType GetNumberOfCacheMisses();
+  ///@}
+
+  ///@{
+  /**
+   * Publish the point and cell arrays of image data as lazy arrays (see
+   * vtkLazyArray), which read their values from the file the first time they
+   * are accessed, so that enabled arrays that are not used downstream are
+   * never read. Each lazy array opens the file again on its first access, and
+   * is neither cached nor prefetched, so it reads the content of the file at
+   * that time: changes made to the file after Update() are picked up by the
+   * arrays that were not loaded yet. The HDF5 calls of the lazy arrays are
+   * serialized with the ones of the readers, but the application must not use
+   * HDF5 through other objects while lazy arrays may load. Unstructured grids
+   * and polydata are always read eagerly, since their pieces are appended.
+   * Default is false.
+   */
+  vtkSetMacro(LazyArrays, bool);
+  vtkGetMacro(LazyArrays, bool);
+  vtkBooleanMacro(LazyArrays, bool);
+  ///@}
+
 protected:
   vtkHDFReader();
   ~vtkHDFReader() override;
@@ -228,8 +303,36 @@ protected:
 
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
+  ///@{
+  /**
+   * Array cache and prefetching properties
+   */
+  bool UseCache = false;
+  vtkIdType MaximumCacheSize = 1048576;
+  int NumberOfStepsToPrefetch = 0;
+  ///@}
+
+  bool LazyArrays = false;
+
   class Implementation;
   Implementation* Impl;
+
+private:
+  /**
+   * Creates, updates or releases the array cache and the prefetcher
+   * according to UseCache and NumberOfStepsToPrefetch.
+   */
+  void UpdateCacheSettings();
+
+  /**
+   * Queues the steps following the current one for prefetching.
+   */
+  void PrefetchNextSteps(vtkInformation* outInfo);
+
+  class ArrayCache;
+  std::shared_ptr<ArrayCache> Cache;
+  class Prefetcher;
+  std::unique_ptr<Prefetcher> StepPrefetcher;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 #include "vtkAMRBox.h"
 #include "vtkAMRUtilities.h"
@@ -43,6 +44,16 @@ namespace
 const std::map<int, std::string> ARRAY_OFFSET_GROUPS = { { 0, "PointDataOffsets" },
   { 1, "CellDataOffsets" }, { 2, "FieldDataOffsets" } };
 
+// Cached arrays never leave the cache: readers get shallow copies, which
+// share their values but not their name, and which filters do not overwrite
+// in place since they do not own their memory.
+vtkDataArray* NewShallowCopy(vtkDataArray* array)
+{
+  vtkDataArray* copy = array->NewInstance();
+  copy->ShallowCopy(array);
+  return copy;
+}
+
 herr_t AddName(hid_t group, const char* name, const H5L_info_t*, void* op_data)
 {
   auto array = static_cast<std::vector<std::string>*>(op_data);
@@ -57,6 +68,97 @@ herr_t AddName(hid_t group, const char* name, const H5L_info_t*, void* op_data)
 }
 };
 
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkHDFReader::ArrayCache::Get(const Key& key)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  auto it = this->Entries.find(key);
+  if (it == this->Entries.end())
+  {
+    ++this->NumberOfMisses;
+    return nullptr;
+  }
+  ++this->NumberOfHits;
+  this->RecentlyUsed.splice(
+    this->RecentlyUsed.begin(), this->RecentlyUsed, it->second.Position);
+  return it->second.Array;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::ArrayCache::Put(const Key& key, vtkDataArray* array)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  if (this->Entries.count(key))
+  {
+    return;
+  }
+  this->RecentlyUsed.push_front(key);
+  Entry& entry = this->Entries[key];
+  entry.Array = array;
+  entry.Size = static_cast<vtkIdType>(array->GetActualMemorySize());
+  entry.Position = this->RecentlyUsed.begin();
+  this->Size += entry.Size;
+  this->Evict();
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::ArrayCache::SetMaximumSize(vtkIdType size)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->MaximumSize = size;
+  this->Evict();
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::ArrayCache::SetFileName(const std::string& fileName)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  if (this->FileName != fileName)
+  {
+    this->FileName = fileName;
+    this->Entries.clear();
+    this->RecentlyUsed.clear();
+    this->Size = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::ArrayCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Entries.clear();
+  this->RecentlyUsed.clear();
+  this->Size = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkHDFReader::ArrayCache::GetNumberOfHits()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->NumberOfHits;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkHDFReader::ArrayCache::GetNumberOfMisses()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->NumberOfMisses;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::ArrayCache::Evict()
+{
+  // keep at least the most recently used array, even if it is bigger than
+  // the maximum size, since it is probably in use.
+  while (this->Size > this->MaximumSize && this->RecentlyUsed.size() > 1)
+  {
+    auto it = this->Entries.find(this->RecentlyUsed.back());
+    this->Size -= it->second.Size;
+    this->Entries.erase(it);
+    this->RecentlyUsed.pop_back();
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkHDFReader::Implementation::TypeDescription vtkHDFReader::Implementation::GetTypeDescription(
   hid_t type)
@@ -140,6 +242,10 @@ bool vtkHDFReader::Implementation::Open(const char* fileName)
     vtkErrorWithObjectMacro(this->Reader, "Invalid filename: " << fileName);
     return false;
   }
+  if (this->Cache)
+  {
+    this->Cache->SetFileName(fileName);
+  }
   if (this->FileName.empty() || this->FileName != fileName)
   {
     this->FileName = fileName;
@@ -423,6 +529,30 @@ void vtkHDFReader::Implementation::BuildTypeReaderMap()
     &vtkHDFReader::Implementation::NewArray<double>;
 }
 
+//------------------------------------------------------------------------------
+int vtkHDFReader::Implementation::GetVTKDataType(hid_t nativeType)
+{
+  const std::pair<hid_t, int> types[] = { { H5T_NATIVE_CHAR, VTK_CHAR },
+    { H5T_NATIVE_UCHAR, VTK_UNSIGNED_CHAR }, { H5T_NATIVE_SHORT, VTK_SHORT },
+    { H5T_NATIVE_USHORT, VTK_UNSIGNED_SHORT }, { H5T_NATIVE_INT, VTK_INT },
+    { H5T_NATIVE_UINT, VTK_UNSIGNED_INT }, { H5T_NATIVE_LONG, VTK_LONG },
+    { H5T_NATIVE_ULONG, VTK_UNSIGNED_LONG }, { H5T_NATIVE_LLONG, VTK_LONG_LONG },
+    { H5T_NATIVE_ULLONG, VTK_UNSIGNED_LONG_LONG }, { H5T_NATIVE_FLOAT, VTK_FLOAT },
+    { H5T_NATIVE_DOUBLE, VTK_DOUBLE } };
+  // like BuildTypeReaderMap, the first type wins when long is the same as int
+  // or long long is the same as long
+  const TypeDescription description = this->GetTypeDescription(nativeType);
+  for (const auto& type : types)
+  {
+    const TypeDescription candidate = this->GetTypeDescription(type.first);
+    if (!(description < candidate) && !(candidate < description))
+    {
+      return type.second;
+    }
+  }
+  return -1;
+}
+
 //------------------------------------------------------------------------------
 template <typename T>
 hid_t vtkHDFReader::Implementation::TemplateTypeToHdfNativeType()
@@ -751,6 +881,43 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   return NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFReader::Implementation::GetArrayInformation(int attributeType, const char* name,
+  const std::vector<hsize_t>& fileExtent, int& dataType, vtkIdType& numberOfTuples,
+  int& numberOfComponents)
+{
+  std::vector<hsize_t> dims;
+  hid_t tempNativeType = H5I_INVALID_HID;
+  vtkHDF::ScopedH5DHandle dataset =
+    this->OpenDataSet(this->AttributeDataGroup[attributeType], name, &tempNativeType, dims);
+  vtkHDF::ScopedH5THandle nativeType = tempNativeType;
+  if (dataset < 0)
+  {
+    return false;
+  }
+  const std::size_t ndims = fileExtent.size() >> 1;
+  if (dims.size() != ndims && dims.size() != ndims + 1)
+  {
+    vtkErrorWithObjectMacro(this->Reader,
+      "Dataset: " << name << " has " << dims.size() << " dimensions, expected " << ndims
+                  << " or " << ndims + 1);
+    return false;
+  }
+  dataType = this->GetVTKDataType(nativeType);
+  if (dataType < 0)
+  {
+    vtkErrorWithObjectMacro(this->Reader, "Unknown native datatype: " << nativeType);
+    return false;
+  }
+  numberOfComponents = dims.size() == ndims ? 1 : static_cast<int>(dims.back());
+  numberOfTuples = 1;
+  for (std::size_t i = 0; i < ndims; ++i)
+  {
+    numberOfTuples *= static_cast<vtkIdType>(fileExtent[2 * i + 1] - fileExtent[2 * i]);
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 vtkStringArray* vtkHDFReader::Implementation::NewStringArray(hid_t dataset, hsize_t size)
 {
@@ -865,10 +1032,46 @@ std::vector<vtkIdType> vtkHDFReader::Implementation::GetMetadata(
   return v;
 }
 
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::SetCache(const std::shared_ptr<vtkHDFReader::ArrayCache>& cache)
+{
+  this->Cache = cache;
+  if (this->Cache && !this->FileName.empty())
+  {
+    this->Cache->SetFileName(this->FileName);
+  }
+}
+
+//------------------------------------------------------------------------------
+std::string vtkHDFReader::Implementation::GetGroupPath(hid_t group)
+{
+  ssize_t length = H5Iget_name(group, nullptr, 0);
+  if (length <= 0)
+  {
+    return std::string();
+  }
+  std::vector<char> buffer(length + 1, '\0');
+  H5Iget_name(group, buffer.data(), buffer.size());
+  return std::string(buffer.data());
+}
+
 //------------------------------------------------------------------------------
 vtkDataArray* vtkHDFReader::Implementation::NewArrayForGroup(
   hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent)
 {
+  // field arrays are reshaped by the reader after reading, do not share them.
+  vtkHDFReader::ArrayCache::Key key;
+  bool useCache = this->Cache && group != this->AttributeDataGroup[vtkDataObject::FIELD];
+  if (useCache)
+  {
+    key.Path = this->GetGroupPath(group) + "/" + name;
+    key.Extent = parameterExtent;
+    if (vtkSmartPointer<vtkDataArray> cached = this->Cache->Get(key))
+    {
+      return ::NewShallowCopy(cached);
+    }
+  }
+
   std::vector<hsize_t> dims;
   hid_t tempNativeType = H5I_INVALID_HID;
   vtkHDF::ScopedH5DHandle dataset = this->OpenDataSet(group, name, &tempNativeType, dims);
@@ -878,7 +1081,15 @@ vtkDataArray* vtkHDFReader::Implementation::NewArrayForGroup(
     return nullptr;
   }
 
-  return this->NewArrayForGroup(dataset, nativeType, dims, parameterExtent);
+  vtkDataArray* array = this->NewArrayForGroup(dataset, nativeType, dims, parameterExtent);
+  if (useCache && array)
+  {
+    this->Cache->Put(key, array);
+    vtkDataArray* copy = ::NewShallowCopy(array);
+    array->Delete();
+    return copy;
+  }
+  return array;
 }
 
 //------------------------------------------------------------------------------
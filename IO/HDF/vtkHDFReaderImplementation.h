@@ -10,9 +10,13 @@
 #define vtkHDFReaderImplementation_h
 
 #include "vtkHDFReader.h"
+#include "vtkSmartPointer.h"
 #include "vtk_hdf5.h"
 #include <array>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -21,6 +25,83 @@ class vtkAbstractArray;
 class vtkDataArray;
 class vtkStringArray;
 
+/**
+ * Least-recently-used cache of the arrays read from a VTK HDF file, keyed by
+ * the HDF path of the dataset and the extent read from it. The cache may be
+ * shared by several readers of the same file (see
+ * vtkHDFReader::SetNumberOfStepsToPrefetch), in which case IOMutex is used to
+ * serialize their HDF5 calls.
+ */
+class vtkHDFReader::ArrayCache
+{
+public:
+  struct Key
+  {
+    std::string Path;
+    std::vector<hsize_t> Extent;
+    bool operator<(const Key& other) const
+    {
+      return this->Path < other.Path || (this->Path == other.Path && this->Extent < other.Extent);
+    }
+  };
+
+  /**
+   * Returns the cached array for 'key' or nullptr, and marks it as most
+   * recently used. Counts a hit or a miss.
+   */
+  vtkSmartPointer<vtkDataArray> Get(const Key& key);
+
+  /**
+   * Adds an array to the cache, evicting the least recently used ones if the
+   * cache exceeds its maximum size.
+   */
+  void Put(const Key& key, vtkDataArray* array);
+
+  /**
+   * Maximum size of the cached arrays in kibibytes.
+   */
+  void SetMaximumSize(vtkIdType size);
+
+  /**
+   * Clears the cache if 'fileName' is not the file the cached arrays were read from.
+   */
+  void SetFileName(const std::string& fileName);
+
+  void Clear();
+
+  ///@{
+  /**
+   * Number of calls to Get() that found, or did not find, the array.
+   */
+  vtkIdType GetNumberOfHits();
+  vtkIdType GetNumberOfMisses();
+  ///@}
+
+  /**
+   * Serializes the HDF5 calls of the readers sharing this cache, the HDF5
+   * library not being thread safe.
+   */
+  std::mutex IOMutex;
+
+private:
+  void Evict();
+
+  struct Entry
+  {
+    vtkSmartPointer<vtkDataArray> Array;
+    vtkIdType Size;
+    std::list<Key>::iterator Position;
+  };
+  std::mutex Mutex;
+  std::string FileName;
+  std::map<Key, Entry> Entries;
+  std::list<Key> RecentlyUsed;
+  vtkIdType Size = 0;
+  vtkIdType MaximumSize = 0;
+  vtkIdType NumberOfHits = 0;
+  vtkIdType NumberOfMisses = 0;
+};
+
 /**
  * Implementation for the vtkHDFReader. Opens, closes and
  * reads information from a VTK HDF file.
@@ -86,6 +167,15 @@ public:
   vtkAbstractArray* NewFieldArray(const char* name, vtkIdType offset = -1, vtkIdType size = -1);
   ///@}
 
+  /**
+   * Gets the VTK data type, the number of tuples and the number of components
+   * of the array NewArray would read for the same parameters, without reading
+   * its values. Returns false in case of an error.
+   */
+  bool GetArrayInformation(int attributeType, const char* name,
+    const std::vector<hsize_t>& fileExtent, int& dataType, vtkIdType& numberOfTuples,
+    int& numberOfComponents);
+
   ///@{
   /**
    * Reads a 1D metadata array in a DataArray or a vector of vtkIdType.
@@ -132,6 +222,12 @@ public:
    */
   vtkIdType GetArrayOffset(vtkIdType step, int attributeType, std::string name);
 
+  /**
+   * Sets the cache used to avoid re-reading arrays. Field arrays, which
+   * the reader modifies after reading, are never cached.
+   */
+  void SetCache(const std::shared_ptr<vtkHDFReader::ArrayCache>& cache);
+
 protected:
   /**
    * Used to store HDF native types in a map
@@ -208,6 +304,16 @@ protected:
    * key in a map.
    */
   TypeDescription GetTypeDescription(hid_t type);
+  /**
+   * Returns the VTK data type read for a HDF native type, or -1 if the type
+   * is not supported.
+   */
+  int GetVTKDataType(hid_t nativeType);
+
+  /**
+   * Returns the HDF path of a group.
+   */
+  std::string GetGroupPath(hid_t group);
 
 private:
   std::string FileName;
@@ -222,6 +328,7 @@ private:
   using ArrayReader = vtkDataArray* (vtkHDFReader::Implementation::*)(hid_t dataset,
     const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents);
   std::map<TypeDescription, ArrayReader> TypeReaderMap;
+  std::shared_ptr<vtkHDFReader::ArrayCache> Cache;
 
   bool ReadDataSetType();
 
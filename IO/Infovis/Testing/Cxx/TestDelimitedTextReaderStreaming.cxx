@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <vtkAbstractArray.h>
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
+#include <vtkDelimitedTextReader.h>
+#include <vtkNew.h>
+#include <vtkTable.h>
+#include <vtkVariant.h>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+struct ProgressRecord
+{
+  int NumberOfEvents = 0;
+  double Progress = 0.0;
+};
+
+void RecordProgress(vtkObject*, unsigned long, void* clientData, void* callData)
+{
+  ProgressRecord* record = static_cast<ProgressRecord*>(clientData);
+  ++record->NumberOfEvents;
+  record->Progress = *static_cast<double*>(callData);
+}
+
+bool SameTables(vtkTable* expected, vtkTable* actual)
+{
+  if (expected->GetNumberOfColumns() != actual->GetNumberOfColumns() ||
+    expected->GetNumberOfRows() != actual->GetNumberOfRows())
+  {
+    cout << "ERROR: Expected " << expected->GetNumberOfColumns() << " columns and "
+         << expected->GetNumberOfRows() << " rows, got " << actual->GetNumberOfColumns()
+         << " columns and " << actual->GetNumberOfRows() << " rows." << endl;
+    return false;
+  }
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+  {
+    vtkAbstractArray* e = expected->GetColumn(c);
+    vtkAbstractArray* a = actual->GetColumn(c);
+    if (std::string(e->GetName()) != a->GetName() ||
+      std::string(e->GetClassName()) != a->GetClassName())
+    {
+      cout << "ERROR: Expected column " << e->GetName() << " of type " << e->GetClassName()
+           << ", got " << a->GetName() << " of type " << a->GetClassName() << endl;
+      return false;
+    }
+    for (vtkIdType r = 0; r < e->GetNumberOfValues(); ++r)
+    {
+      if (e->GetVariantValue(r).ToString() != a->GetVariantValue(r).ToString())
+      {
+        cout << "ERROR: Value " << r << " of column " << e->GetName() << " differs: "
+             << e->GetVariantValue(r).ToString() << " != " << a->GetVariantValue(r).ToString()
+             << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Read the input with and without StreamingMode and compare the outputs.
+bool CompareModes(const std::string& input, bool detectNumericColumns,
+  const char* const* selectedColumns, vtkIdType firstRecord, vtkIdType maxRecords)
+{
+  vtkNew<vtkDelimitedTextReader> readers[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkDelimitedTextReader* reader = readers[i];
+    reader->SetReadFromInputString(true);
+    reader->SetInputString(input);
+    reader->SetHaveHeaders(true);
+    reader->SetDetectNumericColumns(detectNumericColumns);
+    for (const char* const* column = selectedColumns; column && *column; ++column)
+    {
+      reader->AddSelectedColumn(*column);
+    }
+    reader->SetFirstRecord(firstRecord);
+    reader->SetMaxRecords(maxRecords);
+    reader->SetStreamingMode(i == 1);
+    // Small chunks so that records span chunk boundaries.
+    reader->SetChunkSize(100);
+    reader->Update();
+  }
+  return ::SameTables(readers[0]->GetOutput(), readers[1]->GetOutput());
+}
+}
+
+int TestDelimitedTextReaderStreaming(int, char*[])
+{
+  // "late" holds integers up to record 2000, then a double: the type
+  // inferred from the first records does not fit and the input has to be
+  // parsed again. "tag" becomes a string column the same way.
+  std::ostringstream input;
+  input << "id,value,name,late,tag,empty\n";
+  for (int i = 0; i < 3000; ++i)
+  {
+    input << i << "," << i * 0.25 << ",\"name, " << i << "\"," << (i == 2000 ? "2.5" : "7") << ","
+          << (i == 2999 ? "abc" : "1") << ",\n";
+    if (i % 500 == 0)
+    {
+      input << "  \n";
+    }
+  }
+  const std::string text = input.str();
+
+  const char* const projection[] = { "value", "name", "tag", "unknown", nullptr };
+  if (!::CompareModes(text, true, nullptr, 0, 0) || !::CompareModes(text, false, nullptr, 0, 0) ||
+    !::CompareModes(text, true, projection, 0, 0) ||
+    !::CompareModes(text, true, projection, 10, 100) ||
+    !::CompareModes(text, true, nullptr, 2500, 0) || !::CompareModes(text, false, nullptr, 5, 1))
+  {
+    return 1;
+  }
+
+  vtkNew<vtkDelimitedTextReader> reader;
+  reader->SetReadFromInputString(true);
+  reader->SetInputString(text);
+  reader->SetHaveHeaders(true);
+  reader->SetDetectNumericColumns(true);
+  reader->SetStreamingMode(true);
+  reader->AddSelectedColumn("late");
+  reader->AddSelectedColumn("id");
+  reader->SetFirstRecord(1990);
+  reader->SetMaxRecords(20);
+  reader->Update();
+  vtkTable* table = reader->GetOutput();
+  if (table->GetNumberOfColumns() != 2 || table->GetNumberOfRows() != 20 ||
+    std::string(table->GetColumn(0)->GetClassName()) != "vtkIntArray" ||
+    std::string(table->GetColumn(1)->GetClassName()) != "vtkDoubleArray" ||
+    table->GetValue(0, 0).ToInt() != 1990 || table->GetValue(10, 1).ToDouble() != 2.5)
+  {
+    cout << "ERROR: Unexpected projected output." << endl;
+    table->Dump();
+    return 1;
+  }
+
+  // Progress is reported after each chunk.
+  ProgressRecord progress;
+  vtkNew<vtkCallbackCommand> progressCallback;
+  progressCallback->SetCallback(::RecordProgress);
+  progressCallback->SetClientData(&progress);
+  vtkNew<vtkDelimitedTextReader> progressReader;
+  progressReader->SetReadFromInputString(true);
+  progressReader->SetInputString(text);
+  progressReader->SetHaveHeaders(true);
+  progressReader->SetStreamingMode(true);
+  progressReader->SetChunkSize(1000);
+  progressReader->AddObserver(vtkCommand::ProgressEvent, progressCallback);
+  progressReader->Update();
+  const int numberOfChunks = static_cast<int>(text.size() / 1000);
+  if (progress.NumberOfEvents < numberOfChunks || progress.Progress != 1.0)
+  {
+    cout << "ERROR: Expected at least " << numberOfChunks << " progress events ending at 1, got "
+         << progress.NumberOfEvents << " ending at " << progress.Progress << "." << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -5,15 +5,19 @@
 #include "vtkDelimitedTextReader.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStringToNumeric.h"
 #include "vtkTable.h"
+#include "vtkValueFromString.h"
 
 #include "vtkTextCodec.h"
 #include "vtkTextCodecFactory.h"
@@ -22,6 +26,8 @@
 #include <vtk_utf8.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <set>
@@ -289,6 +295,611 @@ private:
   vtkTypeUInt32 WithinString;
 };
 
+// Parses ASCII or UTF-8 delimited text chunk by chunk. Records are split
+// serially, which only needs to look for record delimiters, then the fields
+// of the records of a chunk are converted in parallel directly into the
+// output columns. The parsing rules are the ones of DelimitedTextIterator.
+class ChunkedTextParser
+{
+public:
+  enum ColumnType
+  {
+    INTEGER_COLUMN,
+    DOUBLE_COLUMN,
+    STRING_COLUMN
+  };
+
+  // Parser settings, copied from the reader.
+  struct Settings
+  {
+    std::string RecordDelimiters;
+    std::string FieldDelimiters;
+    std::string StringDelimiters;
+    std::string Whitespace;
+    std::string Escape;
+    bool HaveHeaders;
+    bool MergeConsecutiveDelimiters;
+    bool UseStringDelimiter;
+    bool DetectNumericColumns;
+    bool ForceDouble;
+    bool TrimWhitespace;
+    int DefaultIntegerValue;
+    double DefaultDoubleValue;
+    vtkIdType FirstRecord;
+    vtkIdType MaxRecords;
+    vtkIdType ChunkSize;
+    std::vector<std::string> SelectedColumns;
+  };
+
+  // Progress is reported to the given algorithm after each chunk.
+  ChunkedTextParser(const Settings& settings, vtkAlgorithm* algorithm)
+    : Options(settings)
+    , Algorithm(algorithm)
+  {
+    SetLookupTable(this->IsRecordDelimiter, settings.RecordDelimiters);
+    SetLookupTable(this->IsFieldDelimiter, settings.FieldDelimiters);
+    SetLookupTable(this->IsStringDelimiter, settings.StringDelimiters);
+    SetLookupTable(this->IsWhitespace, settings.Whitespace);
+    SetLookupTable(this->IsEscape, settings.Escape);
+  }
+
+  // Parse the whole input into the output table.
+  void Parse(istream& input, vtkTable* output)
+  {
+    const std::streampos start = input.tellg();
+    input.seekg(0, ios::end);
+    this->InputSize = input.tellg() - start;
+    input.seekg(start);
+    // Parse again with wider column types as long as some values do not fit
+    // the types inferred from the beginning of the input.
+    while (!this->ParsePass(input, output))
+    {
+      input.clear();
+      input.seekg(start);
+      if (!input)
+      {
+        throw std::runtime_error("Unable to rewind the input to parse it again");
+      }
+    }
+  }
+
+private:
+  struct Record
+  {
+    const char* Begin;
+    const char* End;
+  };
+
+  static const vtkIdType NumberOfRecordsForTypeInference = 1024;
+
+  bool ParsePass(istream& input, vtkTable* output)
+  {
+    output->Initialize();
+    this->ColumnIndices.clear();
+    this->ColumnNames.clear();
+    this->Columns.clear();
+
+    std::vector<char> buffer;
+    std::vector<Record> records;
+    size_t carried = 0;
+    std::streamoff bytesRead = 0;
+    bool haveColumns = false;
+    vtkIdType dataRecordIndex = 0;
+    vtkIdType numberOfRows = 0;
+    const vtkIdType lastRecord = this->Options.MaxRecords > 0
+      ? this->Options.FirstRecord + this->Options.MaxRecords
+      : VTK_ID_MAX;
+    const size_t chunkSize = static_cast<size_t>(this->Options.ChunkSize);
+
+    bool endOfInput = false;
+    while (!endOfInput && dataRecordIndex < lastRecord)
+    {
+      buffer.resize(carried + chunkSize);
+      input.read(buffer.data() + carried, static_cast<std::streamsize>(chunkSize));
+      const size_t size = carried + static_cast<size_t>(input.gcount());
+      bytesRead += input.gcount();
+      endOfInput = !input;
+      if (input.bad())
+      {
+        throw std::runtime_error("Error while reading the input");
+      }
+
+      carried = this->SplitRecords(buffer.data(), size, endOfInput, records);
+
+      auto record = records.begin();
+      if (!haveColumns && record != records.end())
+      {
+        this->SetUpColumns(*record);
+        haveColumns = true;
+        if (this->Options.HaveHeaders)
+        {
+          ++record;
+        }
+      }
+
+      // Restrict the records of this chunk to the requested range.
+      std::vector<Record> selected;
+      for (; record != records.end() && dataRecordIndex < lastRecord; ++record, ++dataRecordIndex)
+      {
+        if (dataRecordIndex >= this->Options.FirstRecord)
+        {
+          selected.push_back(*record);
+        }
+      }
+
+      if (!selected.empty())
+      {
+        if (this->Columns.empty())
+        {
+          this->CreateColumns(selected);
+        }
+        if (!this->ParseRecords(selected, numberOfRows))
+        {
+          return false;
+        }
+        numberOfRows += static_cast<vtkIdType>(selected.size());
+      }
+
+      // Move the incomplete record at the end of the chunk to the beginning
+      // of the buffer, the next chunk completes it.
+      if (carried)
+      {
+        std::memmove(buffer.data(), buffer.data() + size - carried, carried);
+      }
+      if (this->InputSize > 0)
+      {
+        this->Algorithm->UpdateProgress(
+          std::min(1.0, static_cast<double>(bytesRead) / static_cast<double>(this->InputSize)));
+      }
+    }
+
+    if (haveColumns && this->Columns.empty())
+    {
+      this->CreateColumns(std::vector<Record>());
+    }
+    for (auto& column : this->Columns)
+    {
+      column->SetNumberOfTuples(numberOfRows);
+      column->Squeeze();
+      output->AddColumn(column);
+    }
+    return true;
+  }
+
+  // Find the records in the buffer, skipping the empty or blank ones.
+  // Return the number of bytes of the incomplete record at the end.
+  size_t SplitRecords(
+    const char* buffer, size_t size, bool endOfInput, std::vector<Record>& records)
+  {
+    records.clear();
+    size_t recordStart = 0;
+    bool blank = true;
+    for (size_t i = 0; i < size; ++i)
+    {
+      const unsigned char c = static_cast<unsigned char>(buffer[i]);
+      if (this->IsRecordDelimiter[c])
+      {
+        if (!blank)
+        {
+          records.push_back(Record{ buffer + recordStart, buffer + i });
+        }
+        recordStart = i + 1;
+        blank = true;
+      }
+      else if (blank && !this->IsWhitespace[c])
+      {
+        blank = false;
+      }
+    }
+    if (endOfInput)
+    {
+      if (!blank)
+      {
+        records.push_back(Record{ buffer + recordStart, buffer + size });
+      }
+      return 0;
+    }
+    return size - recordStart;
+  }
+
+  // Split a record into its fields, return the number of fields.
+  size_t SplitFields(const Record& record, std::vector<std::string>& fields) const
+  {
+    size_t count = 0;
+    auto field = [&]() -> std::string& {
+      if (count == fields.size())
+      {
+        fields.emplace_back();
+      }
+      return fields[count];
+    };
+
+    const char* it = record.Begin;
+    // Leading whitespace is stripped.
+    while (it != record.End && this->IsWhitespace[static_cast<unsigned char>(*it)])
+    {
+      ++it;
+    }
+
+    field().clear();
+    char withinString = 0;
+    bool escape = false;
+    for (; it != record.End; ++it)
+    {
+      const char c = *it;
+      const unsigned char uc = static_cast<unsigned char>(c);
+      if (!withinString && this->IsFieldDelimiter[uc])
+      {
+        if (!(field().empty() && this->Options.MergeConsecutiveDelimiters))
+        {
+          ++count;
+          field().clear();
+        }
+        continue;
+      }
+      if (!escape && this->IsEscape[uc])
+      {
+        escape = true;
+        continue;
+      }
+      if (escape)
+      {
+        escape = false;
+        switch (c)
+        {
+          case 'a':
+            field() += '\a';
+            break;
+          case 'b':
+            field() += '\b';
+            break;
+          case 't':
+            field() += '\t';
+            break;
+          case 'n':
+            field() += '\n';
+            break;
+          case 'v':
+            field() += '\v';
+            break;
+          case 'f':
+            field() += '\f';
+            break;
+          case 'r':
+            field() += '\r';
+            break;
+          case '0':
+            break;
+          default:
+            field() += c;
+        }
+        continue;
+      }
+      if (this->Options.UseStringDelimiter)
+      {
+        if (!withinString && this->IsStringDelimiter[uc])
+        {
+          withinString = c;
+          field().clear();
+          continue;
+        }
+        if (withinString && c == withinString)
+        {
+          withinString = 0;
+          continue;
+        }
+      }
+      field() += c;
+    }
+    return count + 1;
+  }
+
+  // Find the columns from the first record, and which of them are selected.
+  void SetUpColumns(const Record& record)
+  {
+    std::vector<std::string> fields;
+    const size_t count = this->SplitFields(record, fields);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (this->Options.HaveHeaders)
+      {
+        names.push_back(fields[i]);
+      }
+      else
+      {
+        std::stringstream buffer;
+        buffer << "Field " << i;
+        names.push_back(buffer.str());
+      }
+    }
+
+    const auto& selection = this->Options.SelectedColumns;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (selection.empty() ||
+        std::find(selection.begin(), selection.end(), names[i]) != selection.end())
+      {
+        this->ColumnIndices.push_back(i);
+        this->ColumnNames.push_back(names[i]);
+      }
+    }
+    if (this->ColumnTypes.size() != this->ColumnIndices.size())
+    {
+      this->ColumnTypes.clear();
+    }
+  }
+
+  // Value of a field used for numeric conversions.
+  void GetNumericField(const std::string& field, const char*& begin, const char*& end) const
+  {
+    begin = field.data();
+    end = field.data() + field.size();
+    if (this->Options.TrimWhitespace)
+    {
+      static const char* whitespace = " \n\t\r";
+      while (begin != end && std::strchr(whitespace, *begin))
+      {
+        ++begin;
+      }
+      while (end != begin && std::strchr(whitespace, *(end - 1)))
+      {
+        --end;
+      }
+    }
+  }
+
+  // Same rules as vtkVariant::ToInt() and vtkVariant::ToDouble().
+  template <typename T>
+  static bool ToNumeric(const char* begin, const char* end, T& value)
+  {
+    auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+    begin = std::find_if_not(begin, end, isSpace);
+    const size_t consumed = vtkValueFromString(begin, end, value);
+    if (consumed == 0)
+    {
+      return false;
+    }
+    return std::find_if_not(begin + consumed, end, isSpace) == end;
+  }
+
+  ColumnType GetValueType(const std::string& field) const
+  {
+    const char* begin;
+    const char* end;
+    this->GetNumericField(field, begin, end);
+    if (begin == end)
+    {
+      return INTEGER_COLUMN;
+    }
+    int intValue;
+    if (ToNumeric(begin, end, intValue))
+    {
+      return INTEGER_COLUMN;
+    }
+    double doubleValue;
+    return ToNumeric(begin, end, doubleValue) ? DOUBLE_COLUMN : STRING_COLUMN;
+  }
+
+  // Infer the column types from the first records, unless known from a
+  // previous pass, and create the output columns.
+  void CreateColumns(const std::vector<Record>& records)
+  {
+    const size_t numberOfColumns = this->ColumnIndices.size();
+    if (this->ColumnTypes.empty())
+    {
+      this->ColumnTypes.assign(numberOfColumns,
+        this->Options.DetectNumericColumns ? INTEGER_COLUMN : STRING_COLUMN);
+      if (this->Options.DetectNumericColumns)
+      {
+        std::vector<std::string> fields;
+        const size_t numberOfRecords = std::min<size_t>(records.size(),
+          static_cast<size_t>(NumberOfRecordsForTypeInference));
+        for (size_t r = 0; r < numberOfRecords; ++r)
+        {
+          const size_t count = this->SplitFields(records[r], fields);
+          for (size_t c = 0; c < numberOfColumns; ++c)
+          {
+            const size_t index = this->ColumnIndices[c];
+            if (this->ColumnTypes[c] != STRING_COLUMN)
+            {
+              this->ColumnTypes[c] = std::max(this->ColumnTypes[c],
+                this->GetValueType(index < count ? fields[index] : std::string()));
+            }
+          }
+        }
+        for (auto& type : this->ColumnTypes)
+        {
+          // Like vtkStringToNumeric, columns without values are doubles.
+          if (type == INTEGER_COLUMN && (this->Options.ForceDouble || records.empty()))
+          {
+            type = DOUBLE_COLUMN;
+          }
+        }
+      }
+    }
+
+    for (size_t c = 0; c < numberOfColumns; ++c)
+    {
+      vtkSmartPointer<vtkAbstractArray> column;
+      switch (this->ColumnTypes[c])
+      {
+        case INTEGER_COLUMN:
+          column = vtkSmartPointer<vtkIntArray>::New();
+          break;
+        case DOUBLE_COLUMN:
+          column = vtkSmartPointer<vtkDoubleArray>::New();
+          break;
+        default:
+          column = vtkSmartPointer<vtkStringArray>::New();
+      }
+      column->SetName(this->ColumnNames[c].c_str());
+      this->Columns.push_back(column);
+    }
+  }
+
+  // Parse the records into the columns, starting at the given row. Return
+  // false when some values do not fit the column types, which are widened.
+  bool ParseRecords(const std::vector<Record>& records, vtkIdType firstRow)
+  {
+    const size_t numberOfColumns = this->Columns.size();
+    const vtkIdType numberOfRows = firstRow + static_cast<vtkIdType>(records.size());
+    for (auto& column : this->Columns)
+    {
+      // Grow geometrically, the columns are squeezed once complete.
+      if (column->GetSize() < numberOfRows)
+      {
+        column->Resize(std::max(numberOfRows, 2 * column->GetNumberOfTuples()));
+      }
+      column->SetNumberOfTuples(numberOfRows);
+    }
+
+    // Values are written through raw pointers: vtkStringArray::SetValue()
+    // is not thread-safe.
+    std::vector<int*> intColumns(numberOfColumns, nullptr);
+    std::vector<double*> doubleColumns(numberOfColumns, nullptr);
+    std::vector<vtkStdString*> stringColumns(numberOfColumns, nullptr);
+    for (size_t c = 0; c < numberOfColumns; ++c)
+    {
+      vtkAbstractArray* column = this->Columns[c];
+      if (auto intColumn = vtkIntArray::SafeDownCast(column))
+      {
+        intColumns[c] = intColumn->GetPointer(0);
+      }
+      else if (auto doubleColumn = vtkDoubleArray::SafeDownCast(column))
+      {
+        doubleColumns[c] = doubleColumn->GetPointer(0);
+      }
+      else
+      {
+        stringColumns[c] = vtkStringArray::SafeDownCast(column)->GetPointer(0);
+      }
+    }
+
+    std::vector<std::atomic<int>> requiredTypes(numberOfColumns);
+    for (size_t c = 0; c < numberOfColumns; ++c)
+    {
+      requiredTypes[c] = this->ColumnTypes[c];
+    }
+
+    const vtkIdType numberOfRecords = static_cast<vtkIdType>(records.size());
+    vtkSMPTools::For(0, numberOfRecords, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<std::string> fields;
+      static const std::string empty;
+      for (vtkIdType r = begin; r < end; ++r)
+      {
+        const size_t count = this->SplitFields(records[r], fields);
+        const vtkIdType row = firstRow + r;
+        for (size_t c = 0; c < numberOfColumns; ++c)
+        {
+          const size_t index = this->ColumnIndices[c];
+          const std::string& field = index < count ? fields[index] : empty;
+          if (stringColumns[c])
+          {
+            stringColumns[c][row] = field;
+            continue;
+          }
+
+          const char* fieldBegin;
+          const char* fieldEnd;
+          this->GetNumericField(field, fieldBegin, fieldEnd);
+          bool fits;
+          if (intColumns[c])
+          {
+            int value = this->Options.DefaultIntegerValue;
+            fits = fieldBegin == fieldEnd || ToNumeric(fieldBegin, fieldEnd, value);
+            intColumns[c][row] = value;
+          }
+          else
+          {
+            double value = this->Options.DefaultDoubleValue;
+            fits = fieldBegin == fieldEnd || ToNumeric(fieldBegin, fieldEnd, value);
+            doubleColumns[c][row] = value;
+          }
+          if (!fits)
+          {
+            const int type = this->GetValueType(field);
+            int required = requiredTypes[c];
+            while (type > required && !requiredTypes[c].compare_exchange_weak(required, type))
+            {
+            }
+          }
+        }
+      }
+    });
+
+    bool typesFit = true;
+    for (size_t c = 0; c < numberOfColumns; ++c)
+    {
+      this->Columns[c]->DataChanged();
+      if (requiredTypes[c] != this->ColumnTypes[c])
+      {
+        this->ColumnTypes[c] = static_cast<ColumnType>(static_cast<int>(requiredTypes[c]));
+        typesFit = false;
+      }
+    }
+    return typesFit;
+  }
+
+  static void SetLookupTable(bool (&table)[256], const std::string& characters)
+  {
+    std::fill(table, table + 256, false);
+    for (char c : characters)
+    {
+      table[static_cast<unsigned char>(c)] = true;
+    }
+  }
+
+  Settings Options;
+  vtkAlgorithm* Algorithm;
+  std::streamoff InputSize = 0;
+  bool IsRecordDelimiter[256];
+  bool IsFieldDelimiter[256];
+  bool IsStringDelimiter[256];
+  bool IsWhitespace[256];
+  bool IsEscape[256];
+
+  std::vector<size_t> ColumnIndices;
+  std::vector<std::string> ColumnNames;
+  std::vector<ColumnType> ColumnTypes;
+  std::vector<vtkSmartPointer<vtkAbstractArray>> Columns;
+};
+
+// Keep only the selected columns, and the records starting at firstRecord.
+void SelectColumnsAndRecords(
+  vtkTable* table, const std::vector<std::string>& selection, vtkIdType firstRecord)
+{
+  if (!selection.empty())
+  {
+    for (vtkIdType i = table->GetNumberOfColumns() - 1; i >= 0; --i)
+    {
+      const char* name = table->GetColumnName(i);
+      if (!name || std::find(selection.begin(), selection.end(), name) == selection.end())
+      {
+        table->RemoveColumn(i);
+      }
+    }
+  }
+
+  if (firstRecord > 0)
+  {
+    for (vtkIdType i = 0; i < table->GetNumberOfColumns(); ++i)
+    {
+      vtkAbstractArray* column = table->GetColumn(i);
+      vtkSmartPointer<vtkAbstractArray> records =
+        vtkSmartPointer<vtkAbstractArray>::Take(column->NewInstance());
+      records->SetName(column->GetName());
+      records->SetNumberOfComponents(column->GetNumberOfComponents());
+      const vtkIdType numberOfRecords = column->GetNumberOfTuples() - firstRecord;
+      if (numberOfRecords > 0)
+      {
+        records->InsertTuples(0, numberOfRecords, firstRecord, column);
+      }
+      table->GetRowData()->AddArray(records);
+    }
+  }
+}
+
 } // End anonymous namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -307,6 +918,9 @@ vtkDelimitedTextReader::vtkDelimitedTextReader()
   , UnicodeEscapeCharacter("\\")
   , HaveHeaders(false)
   , ReplacementCharacter('x')
+  , StreamingMode(false)
+  , ChunkSize(1 << 24)
+  , FirstRecord(0)
 {
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
@@ -380,6 +994,15 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OutputPedigreeIds: " << (this->OutputPedigreeIds ? "true" : "false") << endl;
   os << indent << "AddTabFieldDelimiter: " << (this->AddTabFieldDelimiter ? "true" : "false")
      << endl;
+  os << indent << "StreamingMode: " << (this->StreamingMode ? "true" : "false") << endl;
+  os << indent << "ChunkSize: " << this->ChunkSize << endl;
+  os << indent << "FirstRecord: " << this->FirstRecord << endl;
+  os << indent << "SelectedColumns:";
+  for (const auto& column : this->SelectedColumns)
+  {
+    os << " '" << column << "'";
+  }
+  os << endl;
 }
 
 void vtkDelimitedTextReader::SetInputString(const char* in)
@@ -459,6 +1082,56 @@ vtkStdString vtkDelimitedTextReader::GetLastError()
   return this->LastError;
 }
 
+void vtkDelimitedTextReader::AddSelectedColumn(const char* name)
+{
+  if (name &&
+    std::find(this->SelectedColumns.begin(), this->SelectedColumns.end(), name) ==
+      this->SelectedColumns.end())
+  {
+    this->SelectedColumns.emplace_back(name);
+    this->Modified();
+  }
+}
+
+void vtkDelimitedTextReader::ClearSelectedColumns()
+{
+  if (!this->SelectedColumns.empty())
+  {
+    this->SelectedColumns.clear();
+    this->Modified();
+  }
+}
+
+int vtkDelimitedTextReader::GetNumberOfSelectedColumns()
+{
+  return static_cast<int>(this->SelectedColumns.size());
+}
+
+const char* vtkDelimitedTextReader::GetSelectedColumn(int index)
+{
+  if (index < 0 || index >= static_cast<int>(this->SelectedColumns.size()))
+  {
+    return nullptr;
+  }
+  return this->SelectedColumns[index].c_str();
+}
+
+bool vtkDelimitedTextReader::CanStream(
+  const std::string& fieldDelimiters, const std::string& stringDelimiters)
+{
+  // The chunked parser works on bytes, which is only possible when the input
+  // is ASCII or UTF-8 and the delimiters are ASCII characters.
+  if (this->UnicodeCharacterSet && strcmp(this->UnicodeCharacterSet, "US-ASCII") != 0 &&
+    strcmp(this->UnicodeCharacterSet, "UTF-8") != 0)
+  {
+    return false;
+  }
+  const std::string characters = this->UnicodeRecordDelimiters + fieldDelimiters +
+    stringDelimiters + this->UnicodeWhitespace + this->UnicodeEscapeCharacter;
+  return std::none_of(characters.begin(), characters.end(),
+    [](char c) { return static_cast<unsigned char>(c) > 127; });
+}
+
 int vtkDelimitedTextReader::RequestData(
   vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
 {
@@ -567,20 +1240,60 @@ int vtkDelimitedTextReader::ReadData(vtkTable* output_table)
     this->UnicodeFieldDelimiters = fieldDelimiterCharacters;
     this->UnicodeStringDelimiters = tstring;
 
-    if (nullptr == transCodec)
+    const bool streaming = this->StreamingMode &&
+      this->CanStream(this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters);
+
+    if (streaming)
     {
-      // should this use the locale instead??
-      return 1;
-    }
+      if (transCodec)
+      {
+        transCodec->Delete();
+      }
 
-    DelimitedTextIterator iterator(this->MaxRecords, this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter, this->HaveHeaders, this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter, output_table);
+      ChunkedTextParser::Settings settings;
+      settings.RecordDelimiters = this->UnicodeRecordDelimiters;
+      settings.FieldDelimiters = this->UnicodeFieldDelimiters;
+      settings.StringDelimiters = this->UnicodeStringDelimiters;
+      settings.Whitespace = this->UnicodeWhitespace;
+      settings.Escape = this->UnicodeEscapeCharacter;
+      settings.HaveHeaders = this->HaveHeaders;
+      settings.MergeConsecutiveDelimiters = this->MergeConsecutiveDelimiters;
+      settings.UseStringDelimiter = this->UseStringDelimiter;
+      settings.DetectNumericColumns = this->DetectNumericColumns;
+      settings.ForceDouble = this->ForceDouble;
+      settings.TrimWhitespace = this->TrimWhitespacePriorToNumericConversion;
+      settings.DefaultIntegerValue = this->DefaultIntegerValue;
+      settings.DefaultDoubleValue = this->DefaultDoubleValue;
+      settings.FirstRecord = this->FirstRecord;
+      settings.MaxRecords = this->MaxRecords;
+      settings.ChunkSize = this->ChunkSize;
+      settings.SelectedColumns = this->SelectedColumns;
+
+      ChunkedTextParser parser(settings, this);
+      parser.Parse(*input_stream_pt, output_table);
+    }
+    else
+    {
+      if (nullptr == transCodec)
+      {
+        // should this use the locale instead??
+        return 1;
+      }
 
-    transCodec->ToUnicode(*input_stream_pt, iterator);
-    iterator.ReachedEndOfInput();
-    transCodec->Delete();
+      // Records before FirstRecord are parsed, then removed.
+      const vtkIdType maxRecords = this->MaxRecords ? this->FirstRecord + this->MaxRecords : 0;
+      {
+        DelimitedTextIterator iterator(maxRecords, this->UnicodeRecordDelimiters,
+          this->UnicodeFieldDelimiters, this->UnicodeStringDelimiters, this->UnicodeWhitespace,
+          this->UnicodeEscapeCharacter, this->HaveHeaders, this->MergeConsecutiveDelimiters,
+          this->UseStringDelimiter, output_table);
+
+        transCodec->ToUnicode(*input_stream_pt, iterator);
+        iterator.ReachedEndOfInput();
+        transCodec->Delete();
+      }
+      ::SelectColumnsAndRecords(output_table, this->SelectedColumns, this->FirstRecord);
+    }
 
     if (this->OutputPedigreeIds)
     {
@@ -592,7 +1305,7 @@ int vtkDelimitedTextReader::ReadData(vtkTable* output_table)
         pedigreeIds->SetName(this->PedigreeIdArrayName);
         for (vtkIdType i = 0; i < numRows; ++i)
         {
-          pedigreeIds->InsertValue(i, i);
+          pedigreeIds->InsertValue(i, this->FirstRecord + i);
         }
         output_table->GetRowData()->SetPedigreeIds(pedigreeIds);
       }
@@ -611,7 +1324,8 @@ int vtkDelimitedTextReader::ReadData(vtkTable* output_table)
       }
     }
 
-    if (this->DetectNumericColumns)
+    // The streaming parser already outputs numeric columns.
+    if (this->DetectNumericColumns && !streaming)
     {
       vtkStringToNumeric* converter = vtkStringToNumeric::New();
       converter->SetForceDouble(this->ForceDouble);
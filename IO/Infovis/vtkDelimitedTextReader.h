@@ -33,6 +33,16 @@
  *
  * This class emits ProgressEvent for every 100 lines it reads.
  *
+ * When StreamingMode is on, ASCII and UTF-8 input is read in chunks of
+ * ChunkSize bytes. The records of each chunk are parsed in parallel using
+ * vtkSMPTools and their fields are written directly into the output columns,
+ * which are typed up front when DetectNumericColumns is on: the peak memory
+ * is then the output table plus one chunk, instead of a table of strings
+ * converted afterwards. ProgressEvent is then emitted after each chunk. In
+ * both modes the output can be restricted to some columns with
+ * AddSelectedColumn() and to a range of records with FirstRecord and
+ * MaxRecords.
+ *
  * @par Thanks:
  * Thanks to Andy Wilson, Brian Wylie, Tim Shead, and Thomas Otahal
  * from Sandia National Laboratories for implementing this class.
@@ -51,6 +61,9 @@
 #include "vtkStdString.h"       // Needed for vtkStdString
 #include "vtkTableAlgorithm.h"
 
+#include <string> // For std::string
+#include <vector> // For std::vector
+
 VTK_ABI_NAMESPACE_BEGIN
 class VTKIOINFOVIS_EXPORT vtkDelimitedTextReader : public vtkTableAlgorithm
 {
@@ -290,6 +303,51 @@ public:
   vtkBooleanMacro(AddTabFieldDelimiter, bool);
   ///@}
 
+  ///@{
+  /**
+   * When on, read ASCII or UTF-8 input chunk by chunk and parse the records
+   * of each chunk in parallel directly into typed columns. The column types
+   * are inferred from the first records of the first chunk; when a later
+   * value does not fit the inferred type, the input is parsed again with the
+   * wider type, so the output is the same as when it is off. Input using
+   * another character set, or non-ASCII delimiters, is always read as when
+   * it is off. Default is off.
+   */
+  vtkSetMacro(StreamingMode, bool);
+  vtkGetMacro(StreamingMode, bool);
+  vtkBooleanMacro(StreamingMode, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Size in bytes of the chunks read at once when StreamingMode is on.
+   * Default is 16 MiB.
+   */
+  vtkSetClampMacro(ChunkSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(ChunkSize, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Restrict the output to the given columns, identified by their header, or
+   * by "Field N" when HaveHeaders is off. Names that do not match a column
+   * are ignored. When no column is selected (default), all columns are read.
+   */
+  void AddSelectedColumn(const char* name);
+  void ClearSelectedColumns();
+  int GetNumberOfSelectedColumns();
+  const char* GetSelectedColumn(int index);
+  ///@}
+
+  ///@{
+  /**
+   * Index of the first record to output, not counting the header line.
+   * Together with MaxRecords, it selects a range of records. Default is 0.
+   */
+  vtkSetClampMacro(FirstRecord, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(FirstRecord, vtkIdType);
+  ///@}
+
   /**
    * Returns a human-readable description of the most recent error, if any.
    * Otherwise, returns an empty string.  Note that the result is only valid
@@ -316,6 +374,9 @@ protected:
   // Read the content of the input file.
   int ReadData(vtkTable* output_table);
 
+  // Whether the input can be parsed with StreamingMode on.
+  bool CanStream(const std::string& fieldDelimiters, const std::string& stringDelimiters);
+
   char* FileName;
   vtkTypeBool ReadFromInputString;
   char* InputString;
@@ -343,6 +404,10 @@ protected:
   bool AddTabFieldDelimiter;
   vtkStdString LastError;
   vtkTypeUInt32 ReplacementCharacter;
+  bool StreamingMode;
+  vtkIdType ChunkSize;
+  vtkIdType FirstRecord;
+  std::vector<std::string> SelectedColumns;
 
 private:
   vtkDelimitedTextReader(const vtkDelimitedTextReader&) = delete;
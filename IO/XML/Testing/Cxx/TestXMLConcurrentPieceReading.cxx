@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that reading the pieces of a parallel file, or the leaves of a
+// composite file, with several threads produces the same output as reading
+// them serially.
+#include <vtkDataArray.h>
+#include <vtkElevationFilter.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkTesting.h>
+#include <vtkXMLMultiBlockDataReader.h>
+#include <vtkXMLMultiBlockDataWriter.h>
+#include <vtkXMLPPolyDataReader.h>
+#include <vtkXMLPPolyDataWriter.h>
+
+#include <string>
+
+namespace
+{
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (!a || !b)
+  {
+    return false;
+  }
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkDataArray* ea = a->GetPointData()->GetArray("Elevation");
+  vtkDataArray* eb = b->GetPointData()->GetArray("Elevation");
+  if (!ea || !eb)
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(i, pa);
+    b->GetPoint(i, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2] ||
+      ea->GetComponent(i, 0) != eb->GetComponent(i, 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLConcurrentPieceReading(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDir = testing->GetTempDirectory();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+
+  const int numberOfPieces = 6;
+
+  // Parallel poly data file.
+  const std::string pvtpName = tempDir + "/TestXMLConcurrentPieceReading.pvtp";
+  vtkNew<vtkXMLPPolyDataWriter> pwriter;
+  pwriter->SetInputConnection(elevation->GetOutputPort());
+  pwriter->SetFileName(pvtpName.c_str());
+  pwriter->SetNumberOfPieces(numberOfPieces);
+  pwriter->SetStartPiece(0);
+  pwriter->SetEndPiece(numberOfPieces - 1);
+  if (!pwriter->Write())
+  {
+    cerr << "ERROR: Could not write " << pvtpName << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkXMLPPolyDataReader> serialReader;
+  serialReader->SetFileName(pvtpName.c_str());
+  serialReader->Update();
+
+  vtkNew<vtkXMLPPolyDataReader> threadedReader;
+  threadedReader->SetFileName(pvtpName.c_str());
+  threadedReader->SetNumberOfThreads(4);
+  threadedReader->Update();
+
+  if (serialReader->GetOutput()->GetNumberOfPoints() == 0 ||
+    !::SamePolyData(serialReader->GetOutput(), threadedReader->GetOutput()))
+  {
+    cerr << "ERROR: Pieces read concurrently differ from pieces read serially." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Multiblock file with one leaf file per piece.
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  for (int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    elevation->UpdatePiece(piece, numberOfPieces, 0);
+    vtkNew<vtkPolyData> block;
+    block->DeepCopy(elevation->GetOutput());
+    blocks->SetBlock(piece, block);
+  }
+
+  const std::string vtmName = tempDir + "/TestXMLConcurrentPieceReading.vtm";
+  vtkNew<vtkXMLMultiBlockDataWriter> mbwriter;
+  mbwriter->SetInputDataObject(blocks);
+  mbwriter->SetFileName(vtmName.c_str());
+  if (!mbwriter->Write())
+  {
+    cerr << "ERROR: Could not write " << vtmName << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkXMLMultiBlockDataReader> mbreader;
+  mbreader->SetFileName(vtmName.c_str());
+  mbreader->SetNumberOfThreads(4);
+  mbreader->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(mbreader->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfBlocks() != static_cast<unsigned int>(numberOfPieces))
+  {
+    cerr << "ERROR: Unexpected number of blocks." << endl;
+    return EXIT_FAILURE;
+  }
+  for (int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    if (!::SamePolyData(vtkPolyData::SafeDownCast(blocks->GetBlock(piece)),
+          vtkPolyData::SafeDownCast(output->GetBlock(piece))))
+    {
+      cerr << "ERROR: Block " << piece << " read concurrently differs from the written one."
+           << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -63,11 +64,33 @@ struct vtkXMLCompositeDataReaderInternals
   unsigned int NumDataSets;
   std::set<int> UpdateIndices;
   bool HasUpdateRestriction;
+
+  // State used by LoadDataObjects(): while collecting, ReadDataObject() only
+  // records the files to read. The data objects loaded concurrently are then
+  // looked up by file name.
+  bool CollectingFileNames = false;
+  std::vector<std::string> FileNamesToLoad;
+  std::map<std::string, vtkSmartPointer<vtkDataObject>> LoadedDataObjects;
+
+  static const char* GetReaderTypeForFile(const std::string& fileName);
+  static vtkXMLReader* NewReaderOfType(const char* type);
 };
 
+namespace
+{
+// Records errors of the readers used by LoadDataObjects(), which also keeps
+// them from being displayed from the reading threads.
+struct ErrorObserver
+{
+  bool Error = false;
+  void OnError(vtkObject*, unsigned long, void*) { this->Error = true; }
+};
+}
+
 //------------------------------------------------------------------------------
 vtkXMLCompositeDataReader::vtkXMLCompositeDataReader()
   : PieceDistribution(Block)
+  , NumberOfThreads(1)
 {
   this->Internal = new vtkXMLCompositeDataReaderInternals;
 }
@@ -96,6 +119,7 @@ void vtkXMLCompositeDataReader::PrintSelf(ostream& os, vtkIndent indent)
       os << "Invalid (!!)\n";
       break;
   }
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 
   this->Superclass::PrintSelf(os, indent);
 }
@@ -212,22 +236,14 @@ std::string vtkXMLCompositeDataReader::GetFileNameFromXML(
 }
 
 //------------------------------------------------------------------------------
-vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
+vtkXMLReader* vtkXMLCompositeDataReaderInternals::NewReaderOfType(const char* type)
 {
+  vtkXMLReader* reader = nullptr;
   if (!type)
   {
     return nullptr;
   }
-
-  vtkXMLCompositeDataReaderInternals::ReadersType::iterator iter =
-    this->Internal->Readers.find(type);
-  if (iter != this->Internal->Readers.end())
-  {
-    return iter->second;
-  }
-
-  vtkXMLReader* reader = nullptr;
-  if (strcmp(type, "vtkXMLImageDataReader") == 0)
+  else if (strcmp(type, "vtkXMLImageDataReader") == 0)
   {
     reader = vtkXMLImageDataReader::New();
   }
@@ -255,26 +271,11 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
   {
     reader = vtkXMLHyperTreeGridReader::New();
   }
-  if (reader)
-  {
-    if (this->GetParserErrorObserver())
-    {
-      reader->SetParserErrorObserver(this->GetParserErrorObserver());
-    }
-    if (this->HasObserver("ErrorEvent"))
-    {
-      vtkNew<vtkEventForwarderCommand> fwd;
-      fwd->SetTarget(this);
-      reader->AddObserver("ErrorEvent", fwd);
-    }
-    this->Internal->Readers[type] = reader;
-    reader->Delete();
-  }
   return reader;
 }
 
 //------------------------------------------------------------------------------
-vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fileName)
+const char* vtkXMLCompositeDataReaderInternals::GetReaderTypeForFile(const std::string& fileName)
 {
   // Get the file extension.
   std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
@@ -285,18 +286,56 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fil
   }
 
   // Search for the reader matching this extension.
-  const char* rname = nullptr;
   for (const vtkXMLCompositeDataReaderEntry* readerEntry =
          vtkXMLCompositeDataReaderInternals::ReaderList;
-       !rname && readerEntry->extension; ++readerEntry)
+       readerEntry->extension; ++readerEntry)
   {
     if (ext == readerEntry->extension)
     {
-      rname = readerEntry->name;
+      return readerEntry->name;
+    }
+  }
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
+{
+  if (!type)
+  {
+    return nullptr;
+  }
+
+  vtkXMLCompositeDataReaderInternals::ReadersType::iterator iter =
+    this->Internal->Readers.find(type);
+  if (iter != this->Internal->Readers.end())
+  {
+    return iter->second;
+  }
+
+  vtkXMLReader* reader = vtkXMLCompositeDataReaderInternals::NewReaderOfType(type);
+  if (reader)
+  {
+    if (this->GetParserErrorObserver())
+    {
+      reader->SetParserErrorObserver(this->GetParserErrorObserver());
     }
+    if (this->HasObserver("ErrorEvent"))
+    {
+      vtkNew<vtkEventForwarderCommand> fwd;
+      fwd->SetTarget(this);
+      reader->AddObserver("ErrorEvent", fwd);
+    }
+    this->Internal->Readers[type] = reader;
+    reader->Delete();
   }
+  return reader;
+}
 
-  return this->GetReaderOfType(rname);
+//------------------------------------------------------------------------------
+vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fileName)
+{
+  return this->GetReaderOfType(vtkXMLCompositeDataReaderInternals::GetReaderTypeForFile(fileName));
 }
 
 //------------------------------------------------------------------------------
@@ -374,8 +413,80 @@ void vtkXMLCompositeDataReader::ReadXMLData()
 
   // All processes create the entire tree structure however, but each one only
   // reads the datasets assigned to it.
+  if (this->NumberOfThreads != 1)
+  {
+    this->LoadDataObjects(this->GetPrimaryElement(), composite, filePath.c_str());
+  }
+
   unsigned int dataSetIndex = 0;
   this->ReadComposite(this->GetPrimaryElement(), composite, filePath.c_str(), dataSetIndex);
+  this->Internal->LoadedDataObjects.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::LoadDataObjects(
+  vtkXMLDataElement* element, vtkCompositeDataSet* composite, const char* filePath)
+{
+  vtkXMLCompositeDataReaderInternals* internal = this->Internal;
+
+  // Traverse the tree once on a scratch output to find out which leaves the
+  // current request needs, without reading them.
+  vtkSmartPointer<vtkCompositeDataSet> scratch;
+  scratch.TakeReference(composite->NewInstance());
+  internal->FileNamesToLoad.clear();
+  internal->CollectingFileNames = true;
+  unsigned int dataSetIndex = 0;
+  this->ReadComposite(element, scratch, filePath, dataSetIndex);
+  internal->CollectingFileNames = false;
+
+  std::vector<std::string> fileNames;
+  fileNames.swap(internal->FileNamesToLoad);
+  std::sort(fileNames.begin(), fileNames.end());
+  fileNames.erase(std::unique(fileNames.begin(), fileNames.end()), fileNames.end());
+  if (fileNames.size() < 2)
+  {
+    return;
+  }
+
+  // Each file is read by its own reader. Events are not forwarded from the
+  // reading threads: a file that fails to load here is read again by
+  // ReadDataObject(), which reports the error.
+  std::vector<vtkSmartPointer<vtkDataObject>> dataObjects(fileNames.size());
+  vtkXMLReader::ConcurrentFor(0, static_cast<int>(fileNames.size()), this->NumberOfThreads,
+    [&](int i) {
+      if (this->AbortExecute)
+      {
+        return;
+      }
+      vtkSmartPointer<vtkXMLReader> reader;
+      reader.TakeReference(vtkXMLCompositeDataReaderInternals::NewReaderOfType(
+        vtkXMLCompositeDataReaderInternals::GetReaderTypeForFile(fileNames[i])));
+      if (!reader)
+      {
+        return;
+      }
+      ErrorObserver errorObserver;
+      reader->AddObserver(vtkCommand::ErrorEvent, &errorObserver, &ErrorObserver::OnError);
+      reader->SetFileName(fileNames[i].c_str());
+      reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+      reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+      reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
+      reader->Update();
+      vtkDataObject* output = reader->GetOutputDataObject(0);
+      if (output && !errorObserver.Error)
+      {
+        dataObjects[i].TakeReference(output->NewInstance());
+        dataObjects[i]->ShallowCopy(output);
+      }
+    });
+
+  for (size_t i = 0; i < fileNames.size(); ++i)
+  {
+    if (dataObjects[i])
+    {
+      internal->LoadedDataObjects[fileNames[i]] = dataObjects[i];
+    }
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -468,6 +579,18 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
   { // No filename in XML element. Not necessarily an error.
     return nullptr;
   }
+  if (this->Internal->CollectingFileNames)
+  {
+    this->Internal->FileNamesToLoad.push_back(fileName);
+    return nullptr;
+  }
+  auto loaded = this->Internal->LoadedDataObjects.find(fileName);
+  if (loaded != this->Internal->LoadedDataObjects.end())
+  {
+    vtkDataObject* outputCopy = loaded->second->NewInstance();
+    outputCopy->ShallowCopy(loaded->second);
+    return outputCopy;
+  }
   vtkXMLReader* reader = this->GetReaderForFile(fileName);
   if (!reader)
   {
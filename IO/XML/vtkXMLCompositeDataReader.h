@@ -13,6 +13,11 @@
  * for that group. If the number of sub-blocks is larger than the
  * number of processors, each processor will possibly have more than
  * 1 sub-block.
+ *
+ * By default the leaf files assigned to the current process are read one
+ * after the other. Set NumberOfThreads to read several leaf files
+ * concurrently, each with its own reader, before the composite dataset is
+ * assembled. The resulting output is the same whatever the number of threads.
  */
 
 #ifndef vtkXMLCompositeDataReader_h
@@ -60,6 +65,16 @@ public:
   vtkGetMacro(PieceDistribution, int);
   /**@}*/
 
+  ///@{
+  /**
+   * Set/Get the maximum number of leaf files read concurrently. A value of 0
+   * or less uses vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+   * Default is 1, i.e. leaf files are read serially.
+   */
+  vtkSetMacro(NumberOfThreads, int);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
   ///@{
   /**
    * Get the output data object for a port on this algorithm.
@@ -158,7 +173,16 @@ private:
     unsigned int datasetIndex, unsigned int numDatasets, int numPieces);
   ///@}
 
+  /**
+   * Find the leaf files the current process has to read for the given
+   * composite tree and read them using up to NumberOfThreads threads. The
+   * loaded data objects are then picked up by ReadDataObject().
+   */
+  void LoadDataObjects(
+    vtkXMLDataElement* element, vtkCompositeDataSet* composite, const char* filePath);
+
   int PieceDistribution;
+  int NumberOfThreads;
 
   vtkXMLCompositeDataReaderInternals* Internal;
 };
@@ -23,6 +23,7 @@ vtkXMLPDataReader::vtkXMLPDataReader()
 {
   this->GhostLevel = 0;
   this->PieceReaders = nullptr;
+  this->NumberOfThreads = 1;
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +40,7 @@ void vtkXMLPDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -319,6 +321,44 @@ int vtkXMLPDataReader::ReadPieceData(int index)
   return this->ReadPieceData();
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLPDataReader::UpdatePieceReaders(int startPiece, int endPiece)
+{
+  if (this->NumberOfThreads == 1 || endPiece - startPiece < 2)
+  {
+    return;
+  }
+
+  // Progress events would be invoked from the reading threads: detach the
+  // observers while loading. Progress is reported when the loaded pieces are
+  // copied to the output.
+  for (int i = startPiece; i < endPiece; ++i)
+  {
+    if (vtkXMLDataReader* reader = this->PieceReaders[i])
+    {
+      reader->SetAbortExecute(0);
+      reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+      reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+      reader->RemoveObserver(this->PieceProgressObserver);
+    }
+  }
+
+  vtkXMLReader::ConcurrentFor(startPiece, endPiece, this->NumberOfThreads, [this](int i) {
+    if (this->PieceReaders[i] && !this->AbortExecute)
+    {
+      this->UpdatePieceReader(i);
+    }
+  });
+
+  for (int i = startPiece; i < endPiece; ++i)
+  {
+    if (vtkXMLDataReader* reader = this->PieceReaders[i])
+    {
+      reader->AddObserver(vtkCommand::ProgressEvent, this->PieceProgressObserver);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLPDataReader::ReadPieceData()
 {
@@ -8,6 +8,14 @@
  * file readers that read vtkDataSets. Concrete subclasses call upon
  * this functionality when needed.
  *
+ * By default the piece files assigned to the current request are read one
+ * after the other. Set NumberOfThreads to read and decode several piece
+ * files concurrently, each with its own piece reader; the pieces are then
+ * appended to the output in order, so the result does not depend on the
+ * number of threads. Concurrent piece loading is currently implemented by
+ * the readers of unstructured data (vtkXMLPPolyDataReader and
+ * vtkXMLPUnstructuredGridReader).
+ *
  * @sa
  * vtkXMLDataReader
  */
@@ -35,6 +43,16 @@ public:
    */
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  ///@{
+  /**
+   * Set/Get the maximum number of piece files read concurrently. A value of
+   * 0 or less uses vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+   * Default is 1, i.e. pieces are read serially.
+   */
+  vtkSetMacro(NumberOfThreads, int);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
 protected:
   vtkXMLPDataReader();
   ~vtkXMLPDataReader() override;
@@ -96,6 +114,20 @@ protected:
    */
   virtual int ReadPieceData();
 
+  /**
+   * Execute the readers of the pieces in [startPiece, endPiece) using up to
+   * NumberOfThreads threads, so that the following calls to ReadPieceData()
+   * only have to copy the already loaded data. Does nothing when reading
+   * serially.
+   */
+  void UpdatePieceReaders(int startPiece, int endPiece);
+
+  /**
+   * Execute the reader of the given piece for the current request. Called by
+   * UpdatePieceReaders(), possibly concurrently for different pieces.
+   */
+  virtual void UpdatePieceReader(int vtkNotUsed(index)) {}
+
   /**
    * Read the information relative to the dataset and allocate the needed structures according to it
    */
@@ -125,6 +157,8 @@ protected:
   vtkXMLDataElement* PPointDataElement;
   vtkXMLDataElement* PCellDataElement;
 
+  int NumberOfThreads;
+
 private:
   vtkXMLPDataReader(const vtkXMLPDataReader&) = delete;
   void operator=(const vtkXMLPDataReader&) = delete;
@@ -292,6 +292,9 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
     fractions[index + 1] = fractions[index + 1] / fractions[this->EndPiece - this->StartPiece];
   }
 
+  // Load the pieces concurrently if requested.
+  this->UpdatePieceReaders(this->StartPiece, this->EndPiece);
+
   // Read the data needed from each piece.
   for (int i = this->StartPiece; (i < this->EndPiece && !this->AbortExecute && !this->DataError);
        ++i)
@@ -310,11 +313,18 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
   delete[] fractions;
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataReader::UpdatePieceReader(int index)
+{
+  this->PieceReaders[index]->UpdatePiece(0, 1, this->UpdateGhostLevel);
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLPUnstructuredDataReader::ReadPieceData()
 {
-  // Use the internal reader to read the piece.
-  this->PieceReaders[this->Piece]->UpdatePiece(0, 1, this->UpdateGhostLevel);
+  // Use the internal reader to read the piece. This does nothing if the piece
+  // was already loaded by UpdatePieceReaders().
+  this->UpdatePieceReader(this->Piece);
 
   vtkPointSet* input = this->GetPieceInputAsPointSet(this->Piece);
   vtkPointSet* output = vtkPointSet::SafeDownCast(this->GetCurrentOutput());
@@ -24,6 +24,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLZ4DataCompressor.h"
 #include "vtkLZMADataCompressor.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkQuadratureSchemeDefinition.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -39,6 +40,7 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <cmath>
@@ -46,6 +48,7 @@
 #include <locale> // C++ locale
 #include <numeric>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -2041,6 +2044,47 @@ int vtkXMLReader::IsTimeStepInArray(int timestep, int* timesteps, int length)
   return 0;
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLReader::ConcurrentFor(
+  int begin, int end, int numberOfThreads, const std::function<void(int)>& functor)
+{
+  if (numberOfThreads <= 0)
+  {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  }
+  numberOfThreads = std::min(numberOfThreads, end - begin);
+  if (numberOfThreads <= 1)
+  {
+    for (int i = begin; i < end; ++i)
+    {
+      functor(i);
+    }
+    return;
+  }
+
+  // Reading files is mostly bound by I/O and decompression, so plain threads
+  // pulling indices from a shared counter are used rather than vtkSMPTools,
+  // whose concurrency depends on the backend VTK was built with.
+  std::atomic<int> next(begin);
+  auto worker = [&]() {
+    for (int i = next++; i < end; i = next++)
+    {
+      functor(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(numberOfThreads - 1);
+  for (int t = 1; t < numberOfThreads; ++t)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkDataObject* vtkXMLReader::GetCurrentOutput()
 {
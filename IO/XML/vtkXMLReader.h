@@ -16,7 +16,8 @@
 #include "vtkIOXMLModule.h"  // For export macro
 #include "vtkSmartPointer.h" // for vtkSmartPointer.
 
-#include <string> // for std::string
+#include <functional> // for std::function
+#include <string>     // for std::string
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractArray;
@@ -468,6 +469,14 @@ protected:
   // Helper function useful to know if a timestep is found in an array of timestep
   static int IsTimeStepInArray(int timestep, int* timesteps, int length);
 
+  // Helper function calling functor(i) for every i in [begin, end) using up to
+  // numberOfThreads threads, used by readers that load several files. A value
+  // of 0 or less uses vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+  // Indices are handed out in increasing order. When only one thread is
+  // requested, the calls are made on the calling thread.
+  static void ConcurrentFor(
+    int begin, int end, int numberOfThreads, const std::function<void(int)>& functor);
+
   vtkDataObject* GetCurrentOutput();
   vtkInformation* GetCurrentOutputInformation();
 
@@ -4,6 +4,7 @@
 
 #include "vtkCachedStreamingDemandDrivenPipeline.h"
 #include "vtkImageData.h"
+#include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
@@ -61,9 +62,15 @@ int vtkImageCacheFilter::GetCacheSize()
 }
 
 //------------------------------------------------------------------------------
-// This method simply copies by reference the input data to the output.
-void vtkImageCacheFilter::ExecuteData(vtkDataObject*)
+// This method simply copies by reference the input data to the output, the
+// executive keeps the outputs of previous updates.
+int vtkImageCacheFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  // do nothing just override superclass to prevent warning
+  vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+  vtkImageData* output = vtkImageData::GetData(outputVector);
+  output->SetExtent(input->GetExtent());
+  output->GetPointData()->PassData(input->GetPointData());
+  return 1;
 }
 VTK_ABI_NAMESPACE_END
@@ -42,7 +42,7 @@ protected:
 
   // Create a default executive.
   vtkExecutive* CreateDefaultExecutive() override;
-  void ExecuteData(vtkDataObject*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
 private:
   vtkImageCacheFilter(const vtkImageCacheFilter&) = delete;
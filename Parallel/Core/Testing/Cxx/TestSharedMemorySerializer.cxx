@@ -0,0 +1,266 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Checks that vtkSharedMemorySerializer round-trips datasets and that the
+// deserialized arrays point into the serialized block.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMatrix3x3.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSharedMemorySerializer.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h> // For getpid
+#endif
+
+namespace
+{
+#define CHECK(cond)                                                                                \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "ERROR: " << #cond << " failed at line " << __LINE__ << std::endl;              \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  CHECK(a && b);
+  CHECK(a->GetDataType() == b->GetDataType());
+  CHECK(a->GetNumberOfComponents() == b->GetNumberOfComponents());
+  CHECK(a->GetNumberOfTuples() == b->GetNumberOfTuples());
+  CHECK((a->GetName() == nullptr) == (b->GetName() == nullptr));
+  CHECK(!a->GetName() || std::string(a->GetName()) == b->GetName());
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    CHECK(a->GetVariantValue(i) == b->GetVariantValue(i));
+  }
+  return true;
+}
+
+// Checks that the array is not a copy
+bool InBlock(vtkDataArray* array, const std::vector<char>& block)
+{
+  const char* begin = static_cast<const char*>(array->GetVoidPointer(0));
+  CHECK(begin >= block.data() && begin <= block.data() + block.size());
+  return true;
+}
+
+vtkSmartPointer<vtkDataObject> RoundTrip(vtkDataObject* input, std::vector<char>& block)
+{
+  block.resize(vtkSharedMemorySerializer::GetSerializedSize(input));
+  if (block.empty() || !vtkSharedMemorySerializer::Serialize(input, block.data(), block.size()))
+  {
+    return nullptr;
+  }
+  return vtkSharedMemorySerializer::Deserialize(block.data(), block.size());
+}
+
+bool TestPolyData()
+{
+  vtkNew<vtkPolyData> pdata;
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 20; ++i)
+  {
+    points->InsertNextPoint(i, i % 4, 0.5 * i);
+  }
+  pdata->SetPoints(points);
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i < 16; ++i)
+  {
+    polys->InsertNextCell({ i, i + 1, i + 4 });
+  }
+  polys->InsertNextCell({ 0, 1, 2, 3 });
+  pdata->SetPolys(polys);
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 0, 19 });
+  pdata->SetLines(lines);
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkSOADataArrayTemplate<float>> soa;
+  soa->SetName("SOA");
+  soa->SetNumberOfComponents(2);
+  for (int i = 0; i < 20; ++i)
+  {
+    scalars->InsertNextValue(0.1 * i);
+    soa->InsertNextTuple2(i, -i);
+  }
+  pdata->GetPointData()->SetScalars(scalars);
+  pdata->GetPointData()->AddArray(soa);
+  vtkNew<vtkIntArray> cellIds;
+  for (int i = 0; i < 18; ++i)
+  {
+    cellIds->InsertNextValue(100 + i);
+  }
+  pdata->GetCellData()->AddArray(cellIds);
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Skipped");
+  strings->InsertNextValue("not serialized");
+  pdata->GetFieldData()->AddArray(strings);
+  vtkNew<vtkFloatArray> time;
+  time->SetName("Time");
+  time->InsertNextValue(4.5);
+  pdata->GetFieldData()->AddArray(time);
+
+  std::vector<char> block;
+  vtkSmartPointer<vtkPolyData> output = vtkPolyData::SafeDownCast(::RoundTrip(pdata, block));
+  CHECK(output);
+  CHECK(output->GetNumberOfCells() == 18);
+  CHECK(::SameValues(pdata->GetPoints()->GetData(), output->GetPoints()->GetData()));
+  CHECK(::InBlock(output->GetPoints()->GetData(), block));
+  CHECK(::SameValues(polys->GetConnectivityArray(), output->GetPolys()->GetConnectivityArray()));
+  CHECK(::SameValues(polys->GetOffsetsArray(), output->GetPolys()->GetOffsetsArray()));
+  CHECK(::InBlock(output->GetPolys()->GetConnectivityArray(), block));
+  CHECK(output->GetLines()->GetNumberOfCells() == 1);
+  CHECK(output->GetVerts()->GetNumberOfCells() == 0);
+  CHECK(::SameValues(scalars, output->GetPointData()->GetScalars()));
+  CHECK(::InBlock(output->GetPointData()->GetScalars(), block));
+  CHECK(::SameValues(soa, output->GetPointData()->GetArray("SOA")));
+  CHECK(::SameValues(cellIds, output->GetCellData()->GetArray(0)));
+  CHECK(output->GetFieldData()->GetNumberOfArrays() == 1);
+  CHECK(::SameValues(time, output->GetFieldData()->GetArray("Time")));
+  return true;
+}
+
+bool TestUnstructuredGrid()
+{
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int i = 0; i < 8; ++i)
+  {
+    points->InsertNextPoint(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+  }
+  ugrid->SetPoints(points);
+  // Fixed-size storage
+  vtkNew<vtkCellArray> tetras;
+  tetras->UseFixedSizeDefaultStorage(4);
+  tetras->InsertNextCell({ 0, 1, 2, 4 });
+  tetras->InsertNextCell({ 1, 2, 4, 7 });
+  ugrid->SetCells(VTK_TETRA, tetras);
+
+  std::vector<char> block;
+  vtkSmartPointer<vtkUnstructuredGrid> output =
+    vtkUnstructuredGrid::SafeDownCast(::RoundTrip(ugrid, block));
+  CHECK(output);
+  CHECK(output->GetNumberOfCells() == 2);
+  CHECK(output->GetCellType(1) == VTK_TETRA);
+  CHECK(output->GetCells()->IsStorageFixedSize());
+  CHECK(::SameValues(tetras->GetConnectivityArray(), output->GetCells()->GetConnectivityArray()));
+  CHECK(::InBlock(output->GetCells()->GetConnectivityArray(), block));
+  CHECK(::InBlock(output->GetCellTypesArray(), block));
+  double bounds[6];
+  output->GetBounds(bounds);
+  CHECK(bounds[0] == 0.0 && bounds[1] == 1.0 && bounds[5] == 1.0);
+  return true;
+}
+
+bool TestImageDataAndTable()
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 3, 1, 4, 0, 2);
+  image->SetSpacing(0.5, 1, 2);
+  image->SetOrigin(1, 2, 3);
+  image->SetDirectionMatrix(0, 1, 0, -1, 0, 0, 0, 0, 1);
+  image->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    image->GetPointData()->GetScalars()->SetTuple1(i, 3 * i);
+  }
+  std::vector<char> block;
+  vtkSmartPointer<vtkImageData> output = vtkImageData::SafeDownCast(::RoundTrip(image, block));
+  CHECK(output);
+  CHECK(output->GetExtent()[2] == 1 && output->GetExtent()[3] == 4);
+  CHECK(output->GetSpacing()[2] == 2 && output->GetOrigin()[1] == 2);
+  CHECK(output->GetDirectionMatrix()->GetElement(1, 0) == -1.0);
+  CHECK(::SameValues(image->GetPointData()->GetScalars(), output->GetPointData()->GetScalars()));
+
+  vtkNew<vtkTable> table;
+  vtkNew<vtkIntArray> column;
+  column->SetName("Column");
+  column->InsertNextValue(7);
+  column->InsertNextValue(8);
+  table->AddColumn(column);
+  vtkSmartPointer<vtkTable> outputTable = vtkTable::SafeDownCast(::RoundTrip(table, block));
+  CHECK(outputTable);
+  CHECK(outputTable->GetNumberOfRows() == 2);
+  CHECK(::SameValues(column, vtkDataArray::SafeDownCast(outputTable->GetColumnByName("Column"))));
+
+  // The owner is referenced until the buffers of the arrays are freed
+  vtkNew<vtkObject> owner;
+  vtkSmartPointer<vtkDataObject> owned =
+    vtkSharedMemorySerializer::Deserialize(block.data(), block.size(), owner);
+  CHECK(owned && owner->GetReferenceCount() > 1);
+  owned = nullptr;
+  CHECK(owner->GetReferenceCount() == 1);
+
+  // Corrupted block
+  block[0] = 'x';
+  CHECK(!vtkSharedMemorySerializer::Deserialize(block.data(), block.size()));
+  return true;
+}
+
+bool TestSharedMemory()
+{
+#if !defined(_WIN32)
+  vtkNew<vtkPolyData> pdata;
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(1, 2, 3);
+  points->InsertNextPoint(4, 5, 6);
+  pdata->SetPoints(points);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ 0 });
+  verts->InsertNextCell({ 1 });
+  pdata->SetVerts(verts);
+
+  const std::string name = "/vtkSharedMemorySerializer-" + std::to_string(getpid());
+  CHECK(vtkSharedMemorySerializer::WriteSharedMemory(pdata, name.c_str()));
+  vtkSmartPointer<vtkPolyData> output =
+    vtkPolyData::SafeDownCast(vtkSharedMemorySerializer::ReadSharedMemory(name.c_str()));
+  CHECK(vtkSharedMemorySerializer::RemoveSharedMemory(name.c_str()));
+  CHECK(output);
+
+  // The mapping outlives the data object as long as one of its arrays, or a
+  // shallow copy of it, is used
+  vtkSmartPointer<vtkDataArray> kept;
+  kept.TakeReference(output->GetPoints()->GetData()->NewInstance());
+  kept->ShallowCopy(output->GetPoints()->GetData());
+  output = nullptr;
+  CHECK(kept->GetComponent(1, 2) == 6.0);
+  // The mapping is private
+  kept->SetComponent(1, 2, 7.0);
+  CHECK(kept->GetComponent(1, 2) == 7.0);
+#endif
+  return true;
+}
+}
+
+int TestSharedMemorySerializer(int, char*[])
+{
+  if (!::TestPolyData() || !::TestUnstructuredGrid() || !::TestImageDataAndTable() ||
+    !::TestSharedMemory())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
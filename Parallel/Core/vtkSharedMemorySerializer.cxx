@@ -0,0 +1,850 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSharedMemorySerializer.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring> // For memcpy
+#include <map>     // For std::multimap
+#include <mutex>   // For std::mutex
+#include <vector>  // For std::vector
+
+#if !defined(_WIN32)
+#include <fcntl.h>    // For O_* constants
+#include <sys/mman.h> // For shm_open, mmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For ftruncate, close
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkSharedMemorySerializer);
+
+#if !defined(_WIN32)
+//------------------------------------------------------------------------------
+// Private mapping of a shared memory segment, unmapped on destruction.
+class vtkSharedMemorySerializerMapping : public vtkObject
+{
+public:
+  static vtkSharedMemorySerializerMapping* New();
+  vtkTypeMacro(vtkSharedMemorySerializerMapping, vtkObject);
+
+  void* Address = nullptr;
+  std::size_t Length = 0;
+
+protected:
+  vtkSharedMemorySerializerMapping() = default;
+  ~vtkSharedMemorySerializerMapping() override
+  {
+    if (this->Address)
+    {
+      munmap(this->Address, this->Length);
+    }
+  }
+
+private:
+  vtkSharedMemorySerializerMapping(const vtkSharedMemorySerializerMapping&) = delete;
+  void operator=(const vtkSharedMemorySerializerMapping&) = delete;
+};
+vtkStandardNewMacro(vtkSharedMemorySerializerMapping);
+#endif
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The block starts with this header, followed by the metadata stream and the
+// values of the arrays, from PayloadOffset on.
+struct BlockHeader
+{
+  char Magic[8];
+  vtkTypeUInt64 MetaDataSize;
+  vtkTypeUInt64 PayloadOffset;
+  vtkTypeUInt64 TotalSize;
+};
+const char BlockMagic[8] = { 'v', 't', 'k', 'S', 'H', 'M', '0', '1' };
+const std::size_t BlockAlignment = 64;
+
+std::size_t Align(std::size_t size)
+{
+  return (size + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+}
+
+//------------------------------------------------------------------------------
+// Owners of the memory the deserialized arrays point into, by array address.
+// Array free functions are plain function pointers, so ReleaseBuffer() finds
+// the owner back from the address of the buffer being freed. The buffer is
+// shared by shallow copies of the array and only freed by the last of them.
+// Both containers are leaked so that arrays can be freed during static
+// destruction.
+std::mutex& BufferOwnersMutex()
+{
+  static std::mutex* mutex = new std::mutex;
+  return *mutex;
+}
+
+std::multimap<void*, vtkObjectBase*>& BufferOwners()
+{
+  static auto* owners = new std::multimap<void*, vtkObjectBase*>;
+  return *owners;
+}
+
+void AcquireBuffer(void* address, vtkObjectBase* owner)
+{
+  owner->Register(nullptr);
+  std::lock_guard<std::mutex> lock(BufferOwnersMutex());
+  BufferOwners().emplace(address, owner);
+}
+
+void ReleaseBuffer(void* address)
+{
+  vtkObjectBase* owner = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(BufferOwnersMutex());
+    auto& owners = BufferOwners();
+    auto it = owners.find(address);
+    if (it == owners.end())
+    {
+      return;
+    }
+    owner = it->second;
+    owners.erase(it);
+  }
+  owner->UnRegister(nullptr);
+}
+
+// Kinds of data objects, stored along their actual type
+enum DataObjectKind
+{
+  IMAGE_DATA,
+  RECTILINEAR_GRID,
+  STRUCTURED_GRID,
+  POLY_DATA,
+  UNSTRUCTURED_GRID,
+  TABLE
+};
+
+//------------------------------------------------------------------------------
+// Builds the metadata stream of a data object and the layout of its arrays.
+class LayoutBuilder
+{
+public:
+  struct ArrayLayout
+  {
+    vtkDataArray* Array;
+    std::size_t Offset;
+    std::size_t Size;
+  };
+
+  bool Build(vtkDataObject* dataObject);
+
+  vtkMultiProcessStream Stream;
+  std::vector<ArrayLayout> Arrays;
+  std::size_t PayloadSize = 0;
+
+private:
+  static bool IsSerializable(vtkAbstractArray* array)
+  {
+    return vtkDataArray::SafeDownCast(array) && array->GetDataType() != VTK_BIT;
+  }
+
+  void AddArray(vtkDataArray* array);
+  void AddOptionalArray(vtkDataArray* array);
+  void AddPoints(vtkPoints* points)
+  {
+    this->AddOptionalArray(points ? points->GetData() : nullptr);
+  }
+  void AddCellArray(vtkCellArray* cells);
+  void AddFieldData(vtkFieldData* fieldData);
+};
+
+//------------------------------------------------------------------------------
+void LayoutBuilder::AddArray(vtkDataArray* array)
+{
+  const std::size_t size = static_cast<std::size_t>(array->GetNumberOfValues()) *
+    static_cast<std::size_t>(array->GetDataTypeSize());
+  const char* name = array->GetName();
+  this->Stream << (name != nullptr);
+  if (name)
+  {
+    this->Stream << std::string(name);
+  }
+  this->Stream << array->GetDataType() << array->GetNumberOfComponents()
+               << static_cast<vtkTypeInt64>(array->GetNumberOfTuples())
+               << static_cast<vtkTypeUInt64>(this->PayloadSize);
+  this->Arrays.push_back(ArrayLayout{ array, this->PayloadSize, size });
+  this->PayloadSize = Align(this->PayloadSize + size);
+}
+
+//------------------------------------------------------------------------------
+void LayoutBuilder::AddOptionalArray(vtkDataArray* array)
+{
+  this->Stream << (array != nullptr);
+  if (array)
+  {
+    this->AddArray(array);
+  }
+}
+
+//------------------------------------------------------------------------------
+void LayoutBuilder::AddCellArray(vtkCellArray* cells)
+{
+  this->Stream << (cells != nullptr);
+  if (!cells)
+  {
+    return;
+  }
+  // Fixed-size storage only needs the cell size, see vtkCellArray::SetData().
+  const bool fixedSize = cells->IsStorageFixedSize();
+  this->Stream << fixedSize;
+  if (fixedSize)
+  {
+    const vtkIdType numCells = cells->GetNumberOfCells();
+    this->Stream << static_cast<vtkTypeInt64>(numCells > 0 ? cells->GetCellSize(0) : 0);
+  }
+  else
+  {
+    this->AddArray(cells->GetOffsetsArray());
+  }
+  this->AddArray(cells->GetConnectivityArray());
+}
+
+//------------------------------------------------------------------------------
+void LayoutBuilder::AddFieldData(vtkFieldData* fieldData)
+{
+  auto attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+  std::vector<int> indices;
+  for (int i = 0; fieldData && i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    if (IsSerializable(fieldData->GetAbstractArray(i)))
+    {
+      indices.push_back(i);
+    }
+    else
+    {
+      const char* name = fieldData->GetAbstractArray(i)->GetName();
+      vtkGenericWarningMacro("Array " << (name ? name : "(unnamed)")
+                                      << " cannot be serialized without copy, it is skipped.");
+    }
+  }
+  this->Stream << static_cast<int>(indices.size());
+  for (int i : indices)
+  {
+    this->Stream << (attributes ? attributes->IsArrayAnAttribute(i) : -1);
+    this->AddArray(fieldData->GetArray(i));
+  }
+}
+
+//------------------------------------------------------------------------------
+bool LayoutBuilder::Build(vtkDataObject* dataObject)
+{
+  this->Stream.Reset();
+  this->Arrays.clear();
+  this->PayloadSize = 0;
+
+  int kind;
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(dataObject);
+  if (auto image = vtkImageData::SafeDownCast(dataObject))
+  {
+    kind = IMAGE_DATA;
+    this->Stream << kind << dataObject->GetDataObjectType();
+    const int* extent = image->GetExtent();
+    const double* origin = image->GetOrigin();
+    const double* spacing = image->GetSpacing();
+    const double* direction = image->GetDirectionMatrix()->GetData();
+    for (int i = 0; i < 6; ++i)
+    {
+      this->Stream << extent[i];
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Stream << origin[i] << spacing[i];
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+      this->Stream << direction[i];
+    }
+  }
+  else if (auto rgrid = vtkRectilinearGrid::SafeDownCast(dataObject))
+  {
+    kind = RECTILINEAR_GRID;
+    this->Stream << kind << dataObject->GetDataObjectType();
+    const int* extent = rgrid->GetExtent();
+    for (int i = 0; i < 6; ++i)
+    {
+      this->Stream << extent[i];
+    }
+    this->AddOptionalArray(rgrid->GetXCoordinates());
+    this->AddOptionalArray(rgrid->GetYCoordinates());
+    this->AddOptionalArray(rgrid->GetZCoordinates());
+  }
+  else if (auto sgrid = vtkStructuredGrid::SafeDownCast(dataObject))
+  {
+    kind = STRUCTURED_GRID;
+    this->Stream << kind << dataObject->GetDataObjectType();
+    const int* extent = sgrid->GetExtent();
+    for (int i = 0; i < 6; ++i)
+    {
+      this->Stream << extent[i];
+    }
+    this->AddPoints(sgrid->GetPoints());
+  }
+  else if (auto pdata = vtkPolyData::SafeDownCast(dataObject))
+  {
+    kind = POLY_DATA;
+    this->Stream << kind << dataObject->GetDataObjectType();
+    this->AddPoints(pdata->GetPoints());
+    this->AddCellArray(pdata->GetVerts());
+    this->AddCellArray(pdata->GetLines());
+    this->AddCellArray(pdata->GetPolys());
+    this->AddCellArray(pdata->GetStrips());
+  }
+  else if (auto ugrid = vtkUnstructuredGrid::SafeDownCast(dataObject))
+  {
+    kind = UNSTRUCTURED_GRID;
+    this->Stream << kind << dataObject->GetDataObjectType();
+    this->AddPoints(ugrid->GetPoints());
+    this->AddOptionalArray(ugrid->GetCellTypesArray());
+    this->AddCellArray(ugrid->GetCells());
+    this->AddOptionalArray(ugrid->GetFaceLocations());
+    this->AddOptionalArray(ugrid->GetFaces());
+  }
+  else if (auto table = vtkTable::SafeDownCast(dataObject))
+  {
+    kind = TABLE;
+    this->Stream << kind << dataObject->GetDataObjectType();
+    this->AddFieldData(table->GetRowData());
+  }
+  else
+  {
+    vtkGenericWarningMacro(
+      "Unsupported data object " << (dataObject ? dataObject->GetClassName() : "(nullptr)"));
+    return false;
+  }
+
+  if (dataSet)
+  {
+    this->AddFieldData(dataSet->GetPointData());
+    this->AddFieldData(dataSet->GetCellData());
+  }
+  this->AddFieldData(dataObject->GetFieldData());
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Reads a data object from the metadata stream, wrapping the payload.
+class BlockReader
+{
+public:
+  BlockReader(vtkMultiProcessStream& stream, char* payload, std::size_t payloadSize,
+    vtkObjectBase* owner)
+    : Stream(stream)
+    , Payload(payload)
+    , PayloadSize(payloadSize)
+    , Owner(owner)
+  {
+  }
+
+  vtkSmartPointer<vtkDataObject> Read();
+
+private:
+  bool ReadArray(vtkSmartPointer<vtkDataArray>& array, bool cellArrayData = false);
+  bool ReadOptionalArray(vtkSmartPointer<vtkDataArray>& array);
+  bool ReadPoints(vtkSmartPointer<vtkPoints>& points);
+  bool ReadCellArray(vtkSmartPointer<vtkCellArray>& cells);
+  bool ReadFieldData(vtkFieldData* fieldData);
+
+  vtkMultiProcessStream& Stream;
+  char* Payload;
+  std::size_t PayloadSize;
+  vtkObjectBase* Owner;
+};
+
+//------------------------------------------------------------------------------
+bool BlockReader::ReadArray(vtkSmartPointer<vtkDataArray>& array, bool cellArrayData)
+{
+  bool hasName;
+  std::string name;
+  int dataType, numComps;
+  vtkTypeInt64 numTuples;
+  vtkTypeUInt64 offset;
+  this->Stream >> hasName;
+  if (hasName)
+  {
+    this->Stream >> name;
+  }
+  this->Stream >> dataType >> numComps >> numTuples >> offset;
+
+  // vtkCellArray uses its own array types directly
+  if (cellArrayData && dataType == VTK_TYPE_INT64)
+  {
+    array = vtkSmartPointer<vtkCellArray::ArrayType64>::New();
+  }
+  else if (cellArrayData && dataType == VTK_TYPE_INT32)
+  {
+    array = vtkSmartPointer<vtkCellArray::ArrayType32>::New();
+  }
+  else
+  {
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  }
+  if (!array || dataType == VTK_BIT || numComps < 1 || numTuples < 0)
+  {
+    return false;
+  }
+  const std::size_t numValues = static_cast<std::size_t>(numTuples) * numComps;
+  const std::size_t size = numValues * static_cast<std::size_t>(array->GetDataTypeSize());
+  if (offset > this->PayloadSize || size > this->PayloadSize - offset)
+  {
+    return false;
+  }
+  array->SetNumberOfComponents(numComps);
+  array->SetVoidArray(this->Payload + offset, static_cast<vtkIdType>(numValues), 1);
+  if (hasName)
+  {
+    array->SetName(name.c_str());
+  }
+  if (this->Owner)
+  {
+    ::AcquireBuffer(this->Payload + offset, this->Owner);
+    array->SetArrayFreeFunction(::ReleaseBuffer);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool BlockReader::ReadOptionalArray(vtkSmartPointer<vtkDataArray>& array)
+{
+  bool present;
+  this->Stream >> present;
+  array = nullptr;
+  return !present || this->ReadArray(array);
+}
+
+//------------------------------------------------------------------------------
+bool BlockReader::ReadPoints(vtkSmartPointer<vtkPoints>& points)
+{
+  vtkSmartPointer<vtkDataArray> data;
+  if (!this->ReadOptionalArray(data))
+  {
+    return false;
+  }
+  points = nullptr;
+  if (data)
+  {
+    points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(data);
+  }
+  return !data || points->GetData() == data;
+}
+
+//------------------------------------------------------------------------------
+bool BlockReader::ReadCellArray(vtkSmartPointer<vtkCellArray>& cells)
+{
+  bool present, fixedSize;
+  this->Stream >> present;
+  cells = nullptr;
+  if (!present)
+  {
+    return true;
+  }
+  this->Stream >> fixedSize;
+  cells = vtkSmartPointer<vtkCellArray>::New();
+  if (fixedSize)
+  {
+    vtkTypeInt64 cellSize;
+    this->Stream >> cellSize;
+    vtkSmartPointer<vtkDataArray> connectivity;
+    if (!this->ReadArray(connectivity, true))
+    {
+      return false;
+    }
+    if (cellSize > 0)
+    {
+      // SetData() keeps the fixed-size storage selected here.
+      cells->UseFixedSizeDefaultStorage(cellSize);
+    }
+    return connectivity->GetNumberOfValues() == 0 || cells->SetData(cellSize, connectivity);
+  }
+  vtkSmartPointer<vtkDataArray> offsets, connectivity;
+  return this->ReadArray(offsets, true) && this->ReadArray(connectivity, true) &&
+    cells->SetData(offsets, connectivity);
+}
+
+//------------------------------------------------------------------------------
+bool BlockReader::ReadFieldData(vtkFieldData* fieldData)
+{
+  auto attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+  int numArrays;
+  this->Stream >> numArrays;
+  for (int i = 0; i < numArrays; ++i)
+  {
+    int attribute;
+    vtkSmartPointer<vtkDataArray> array;
+    this->Stream >> attribute;
+    if (!this->ReadArray(array))
+    {
+      return false;
+    }
+    const int idx = fieldData->AddArray(array);
+    if (attributes && attribute >= 0)
+    {
+      attributes->SetActiveAttribute(idx, attribute);
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> BlockReader::Read()
+{
+  int kind, type;
+  this->Stream >> kind >> type;
+  vtkSmartPointer<vtkDataObject> dataObject;
+  dataObject.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+  bool valid = true;
+  switch (kind)
+  {
+    case IMAGE_DATA:
+    {
+      auto image = vtkImageData::SafeDownCast(dataObject);
+      int extent[6];
+      double origin[3], spacing[3], direction[9];
+      for (int i = 0; i < 6; ++i)
+      {
+        this->Stream >> extent[i];
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Stream >> origin[i] >> spacing[i];
+      }
+      for (int i = 0; i < 9; ++i)
+      {
+        this->Stream >> direction[i];
+      }
+      valid = image != nullptr;
+      if (valid)
+      {
+        image->SetExtent(extent);
+        image->SetOrigin(origin);
+        image->SetSpacing(spacing);
+        image->SetDirectionMatrix(direction);
+      }
+      break;
+    }
+    case RECTILINEAR_GRID:
+    {
+      auto rgrid = vtkRectilinearGrid::SafeDownCast(dataObject);
+      int extent[6];
+      for (int i = 0; i < 6; ++i)
+      {
+        this->Stream >> extent[i];
+      }
+      vtkSmartPointer<vtkDataArray> x, y, z;
+      valid = rgrid && this->ReadOptionalArray(x) && this->ReadOptionalArray(y) &&
+        this->ReadOptionalArray(z);
+      if (valid)
+      {
+        rgrid->SetExtent(extent);
+        rgrid->SetXCoordinates(x);
+        rgrid->SetYCoordinates(y);
+        rgrid->SetZCoordinates(z);
+      }
+      break;
+    }
+    case STRUCTURED_GRID:
+    {
+      auto sgrid = vtkStructuredGrid::SafeDownCast(dataObject);
+      int extent[6];
+      for (int i = 0; i < 6; ++i)
+      {
+        this->Stream >> extent[i];
+      }
+      vtkSmartPointer<vtkPoints> points;
+      valid = sgrid && this->ReadPoints(points);
+      if (valid)
+      {
+        sgrid->SetExtent(extent);
+        sgrid->SetPoints(points);
+      }
+      break;
+    }
+    case POLY_DATA:
+    {
+      auto pdata = vtkPolyData::SafeDownCast(dataObject);
+      vtkSmartPointer<vtkPoints> points;
+      vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+      valid = pdata && this->ReadPoints(points) && this->ReadCellArray(verts) &&
+        this->ReadCellArray(lines) && this->ReadCellArray(polys) && this->ReadCellArray(strips);
+      if (valid)
+      {
+        pdata->SetPoints(points);
+        pdata->SetVerts(verts);
+        pdata->SetLines(lines);
+        pdata->SetPolys(polys);
+        pdata->SetStrips(strips);
+      }
+      break;
+    }
+    case UNSTRUCTURED_GRID:
+    {
+      auto ugrid = vtkUnstructuredGrid::SafeDownCast(dataObject);
+      vtkSmartPointer<vtkPoints> points;
+      vtkSmartPointer<vtkDataArray> types, faceLocations, faces;
+      vtkSmartPointer<vtkCellArray> cells;
+      valid = ugrid && this->ReadPoints(points) && this->ReadOptionalArray(types) &&
+        this->ReadCellArray(cells) && this->ReadOptionalArray(faceLocations) &&
+        this->ReadOptionalArray(faces);
+      if (valid)
+      {
+        ugrid->SetPoints(points);
+        if (types && cells)
+        {
+          ugrid->SetCells(vtkUnsignedCharArray::SafeDownCast(types), cells,
+            vtkIdTypeArray::SafeDownCast(faceLocations), vtkIdTypeArray::SafeDownCast(faces));
+        }
+      }
+      break;
+    }
+    case TABLE:
+    {
+      auto table = vtkTable::SafeDownCast(dataObject);
+      valid = table && this->ReadFieldData(table->GetRowData());
+      break;
+    }
+    default:
+      valid = false;
+  }
+
+  if (valid)
+  {
+    if (auto dataSet = vtkDataSet::SafeDownCast(dataObject))
+    {
+      valid = this->ReadFieldData(dataSet->GetPointData()) &&
+        this->ReadFieldData(dataSet->GetCellData());
+    }
+    valid = valid && this->ReadFieldData(dataObject->GetFieldData());
+  }
+  return valid ? dataObject : nullptr;
+}
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkSharedMemorySerializer::vtkSharedMemorySerializer() = default;
+
+//------------------------------------------------------------------------------
+vtkSharedMemorySerializer::~vtkSharedMemorySerializer() = default;
+
+//------------------------------------------------------------------------------
+void vtkSharedMemorySerializer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkSharedMemorySerializer::GetSerializedSize(vtkDataObject* dataObject)
+{
+  LayoutBuilder layout;
+  if (!layout.Build(dataObject))
+  {
+    return 0;
+  }
+  return Align(sizeof(BlockHeader) + layout.Stream.GetRawData().size()) + layout.PayloadSize;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSharedMemorySerializer::Serialize(vtkDataObject* dataObject, void* buffer, std::size_t size)
+{
+  LayoutBuilder layout;
+  if (!buffer || !layout.Build(dataObject))
+  {
+    return false;
+  }
+  std::vector<unsigned char> metaData;
+  layout.Stream.GetRawData(metaData);
+
+  BlockHeader header;
+  std::memcpy(header.Magic, BlockMagic, sizeof(BlockMagic));
+  header.MetaDataSize = metaData.size();
+  header.PayloadOffset = Align(sizeof(BlockHeader) + metaData.size());
+  header.TotalSize = header.PayloadOffset + layout.PayloadSize;
+  if (size < header.TotalSize)
+  {
+    vtkGenericWarningMacro("Buffer too small to serialize " << dataObject->GetClassName() << ": "
+                                                            << size << " < " << header.TotalSize);
+    return false;
+  }
+
+  char* block = static_cast<char*>(buffer);
+  std::memcpy(block, &header, sizeof(BlockHeader));
+  std::memcpy(block + sizeof(BlockHeader), metaData.data(), metaData.size());
+  char* payload = block + header.PayloadOffset;
+  for (const auto& arrayLayout : layout.Arrays)
+  {
+    vtkDataArray* array = arrayLayout.Array;
+    if (array->HasStandardMemoryLayout())
+    {
+      std::memcpy(payload + arrayLayout.Offset, array->GetVoidPointer(0), arrayLayout.Size);
+    }
+    else if (array->GetNumberOfValues() > 0)
+    {
+      // Convert other layouts through an AOS array wrapping the block
+      vtkSmartPointer<vtkDataArray> wrapper;
+      wrapper.TakeReference(vtkDataArray::CreateDataArray(array->GetDataType()));
+      wrapper->SetNumberOfComponents(array->GetNumberOfComponents());
+      wrapper->SetVoidArray(payload + arrayLayout.Offset, array->GetNumberOfValues(), 1);
+      for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+      {
+        wrapper->SetTuple(i, i, array);
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkSharedMemorySerializer::Deserialize(
+  void* buffer, std::size_t size, vtkObjectBase* owner)
+{
+  BlockHeader header;
+  if (!buffer || size < sizeof(BlockHeader))
+  {
+    return nullptr;
+  }
+  const char* block = static_cast<const char*>(buffer);
+  std::memcpy(&header, block, sizeof(BlockHeader));
+  if (std::memcmp(header.Magic, BlockMagic, sizeof(BlockMagic)) != 0 || header.TotalSize > size ||
+    header.PayloadOffset > header.TotalSize ||
+    sizeof(BlockHeader) + header.MetaDataSize > header.PayloadOffset)
+  {
+    vtkGenericWarningMacro("Invalid serialized data object.");
+    return nullptr;
+  }
+
+  vtkMultiProcessStream stream;
+  stream.SetRawData(reinterpret_cast<const unsigned char*>(block + sizeof(BlockHeader)),
+    static_cast<unsigned int>(header.MetaDataSize));
+  BlockReader reader(stream, static_cast<char*>(buffer) + header.PayloadOffset,
+    header.TotalSize - header.PayloadOffset, owner);
+  auto dataObject = reader.Read();
+  if (!dataObject)
+  {
+    vtkGenericWarningMacro("Invalid serialized data object.");
+  }
+  return dataObject;
+}
+
+#if !defined(_WIN32)
+//------------------------------------------------------------------------------
+bool vtkSharedMemorySerializer::WriteSharedMemory(vtkDataObject* dataObject, const char* name)
+{
+  const std::size_t size = vtkSharedMemorySerializer::GetSerializedSize(dataObject);
+  if (size == 0 || !name)
+  {
+    return false;
+  }
+  // An existing segment is unlinked rather than truncated, so that processes
+  // still using it keep a valid mapping of the previous data.
+  shm_unlink(name);
+  const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0)
+  {
+    vtkGenericWarningMacro("Cannot create shared memory segment " << name);
+    return false;
+  }
+  void* address = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    vtkGenericWarningMacro("Cannot map shared memory segment " << name << " of " << size
+                                                               << " bytes");
+    shm_unlink(name);
+    return false;
+  }
+  const bool result = vtkSharedMemorySerializer::Serialize(dataObject, address, size);
+  munmap(address, size);
+  if (!result)
+  {
+    shm_unlink(name);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkSharedMemorySerializer::ReadSharedMemory(const char* name)
+{
+  const int fd = name ? shm_open(name, O_RDONLY, 0) : -1;
+  if (fd < 0)
+  {
+    vtkGenericWarningMacro("Cannot open shared memory segment " << (name ? name : "(nullptr)"));
+    return nullptr;
+  }
+  struct stat status;
+  void* address = MAP_FAILED;
+  std::size_t size = 0;
+  if (fstat(fd, &status) == 0 && status.st_size > 0)
+  {
+    // A private mapping lets the arrays be modified without affecting the segment.
+    size = static_cast<std::size_t>(status.st_size);
+    address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    vtkGenericWarningMacro("Cannot map shared memory segment " << name);
+    return nullptr;
+  }
+  vtkNew<vtkSharedMemorySerializerMapping> mapping;
+  mapping->Address = address;
+  mapping->Length = size;
+  return vtkSharedMemorySerializer::Deserialize(address, size, mapping);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSharedMemorySerializer::RemoveSharedMemory(const char* name)
+{
+  return name && shm_unlink(name) == 0;
+}
+
+#else
+//------------------------------------------------------------------------------
+bool vtkSharedMemorySerializer::WriteSharedMemory(vtkDataObject*, const char*)
+{
+  vtkGenericWarningMacro("POSIX shared memory is not available on this platform.");
+  return false;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkSharedMemorySerializer::ReadSharedMemory(const char*)
+{
+  vtkGenericWarningMacro("POSIX shared memory is not available on this platform.");
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSharedMemorySerializer::RemoveSharedMemory(const char*)
+{
+  return false;
+}
+#endif
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkSharedMemorySerializer
+ * @brief   zero-copy serialization of datasets in a contiguous memory block
+ *
+ * vtkSharedMemorySerializer lays out a dataset in a single memory block, e.g.
+ * a POSIX shared memory segment, so that another process on the same node can
+ * use it without copying or parsing the data. The block starts with a small
+ * header and the structure of the dataset (types, extents, names and layout
+ * of the arrays), serialized with a vtkMultiProcessStream, followed by the
+ * values of each array, aligned on 64 bytes relative to the start of the block.
+ *
+ * Deserialize() builds a dataset whose arrays are vtkAOSDataArrayTemplate
+ * instances pointing directly into the block. The block must outlive these
+ * arrays: an optional owner object is kept alive by the buffer of each array
+ * and released by its free function, so that shallow copies of the arrays
+ * keep the owner alive too. ReadSharedMemory() maps a POSIX
+ * shared memory segment privately (copy-on-write) and releases the mapping
+ * once all the arrays using it are deleted, so that modifying the arrays
+ * never affects the producer of the segment.
+ *
+ * Supported data objects are vtkImageData, vtkRectilinearGrid,
+ * vtkStructuredGrid, vtkPolyData, vtkUnstructuredGrid and vtkTable, with
+ * their point, cell, row and field data. Arrays that are not vtkDataArray
+ * instances (e.g. vtkStringArray) and bit arrays are skipped with a warning.
+ * Arrays of other memory layouts (e.g. SOA or implicit arrays) are converted
+ * to the AOS layout on serialization.
+ *
+ * The shared memory methods are only available on POSIX systems.
+ *
+ * @sa
+ * vtkCommunicator vtkFieldDataSerializer vtkMultiProcessStream
+ */
+
+#ifndef vtkSharedMemorySerializer_h
+#define vtkSharedMemorySerializer_h
+
+#include "vtkObject.h"
+#include "vtkParallelCoreModule.h" // For export macro
+#include "vtkSmartPointer.h"        // For vtkSmartPointer
+
+#include <cstddef> // For std::size_t
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkDataObject;
+
+class VTKPARALLELCORE_EXPORT vtkSharedMemorySerializer : public vtkObject
+{
+public:
+  static vtkSharedMemorySerializer* New();
+  vtkTypeMacro(vtkSharedMemorySerializer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return the size in bytes of the block needed to serialize the given data
+   * object, 0 if it is not supported.
+   */
+  static std::size_t GetSerializedSize(vtkDataObject* dataObject);
+
+  /**
+   * Serialize the data object in the given block, which must be at least
+   * GetSerializedSize() bytes long. Returns false on failure.
+   */
+  static bool Serialize(vtkDataObject* dataObject, void* buffer, std::size_t size);
+
+  /**
+   * Build a data object from a block filled by Serialize(). The arrays of the
+   * returned data object point into the block, which must outlive them. If
+   * given, owner is referenced by the buffer of each array until this buffer
+   * is freed. Returns nullptr if the block is not valid.
+   */
+  static vtkSmartPointer<vtkDataObject> Deserialize(
+    void* buffer, std::size_t size, vtkObjectBase* owner = nullptr);
+
+  /**
+   * Serialize the data object in a new POSIX shared memory segment with the
+   * given name, e.g. "/simulation-step-42". An existing segment with the same
+   * name is unlinked first and replaced by a new one, processes that mapped
+   * it keep the previous data. The segment persists until
+   * RemoveSharedMemory() is called. Returns false on failure.
+   */
+  static bool WriteSharedMemory(vtkDataObject* dataObject, const char* name);
+
+  /**
+   * Map the POSIX shared memory segment with the given name and deserialize
+   * the data object it holds, without copying its arrays. The segment is
+   * unmapped once the data object and all its arrays are deleted. Returns
+   * nullptr on failure.
+   */
+  static vtkSmartPointer<vtkDataObject> ReadSharedMemory(const char* name);
+
+  /**
+   * Remove the name of the POSIX shared memory segment. Processes that
+   * already mapped it keep their mapping. Returns false on failure.
+   */
+  static bool RemoveSharedMemory(const char* name);
+
+protected:
+  vtkSharedMemorySerializer();
+  ~vtkSharedMemorySerializer() override;
+
+private:
+  vtkSharedMemorySerializer(const vtkSharedMemorySerializer&) = delete;
+  void operator=(const vtkSharedMemorySerializer&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
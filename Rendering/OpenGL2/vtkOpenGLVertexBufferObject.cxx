@@ -538,9 +538,11 @@ void vtkOpenGLVertexBufferObject::UploadDataArray(vtkDataArray* array)
   // handle any shift scale calcs required before upload
   this->UpdateShiftScale(array);
 
-  // can we use the fast path and just upload the raw array?
+  // can we use the fast path and just upload the raw array? Arrays without a
+  // contiguous buffer (e.g. implicit arrays) are packed by the worker instead
+  // of being densified through GetVoidPointer.
   if (!this->GetCoordShiftAndScaleEnabled() && this->DataType == array->GetDataType() &&
-    extraComponents == 0)
+    extraComponents == 0 && array->HasStandardMemoryLayout())
   {
     this->NumberOfTuples = array->GetNumberOfTuples();
     this->PackedVBO.resize(0);